@@ -0,0 +1,302 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Amiraslan Haghrah
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#ifndef ATTRIBUTE_HANDLE_H
+#define ATTRIBUTE_HANDLE_H
+
+#include "attribute.h"
+#include "object-base.h"
+#include "ptr.h"
+#include "type-id.h"
+#include <string>
+#include <type_traits>
+#include <utility>
+
+/**
+ * \file
+ * \ingroup attribute
+ * ns3::AttributeHandle declaration and template implementation.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup attribute
+ *
+ * \brief The part of AttributeHandle which does not depend on the
+ * value type.
+ */
+class AttributeHandleBase
+{
+public:
+  /** \returns \c true if the handle refers to an Attribute. */
+  bool IsValid (void) const;
+  /** \returns The TypeId given when the handle was resolved. */
+  TypeId GetTypeId (void) const;
+  /** \returns The name of the Attribute. */
+  std::string GetName (void) const;
+
+protected:
+  /** Constructor for a handle which refers to no Attribute. */
+  AttributeHandleBase ();
+  /**
+   * Resolve an Attribute of a TypeId, or of its parents.
+   *
+   * \param [in] tid The TypeId.
+   * \param [in] name The name of the Attribute.
+   * \param [in] probe A value of the type expected by the handle.
+   * \param [in] failSafe If \c false, a missing Attribute, or an
+   *             Attribute of another value type, is a fatal error.
+   *             Otherwise the handle is left invalid.
+   */
+  AttributeHandleBase (TypeId tid, std::string name,
+                       const AttributeValue &probe, bool failSafe);
+
+  /**
+   * Check that an object can be accessed through this handle.
+   * \param [in] object The object.
+   * \param [in] set \c true for a Set, \c false for a Get.
+   * \returns \c true if the object can be accessed.
+   */
+  bool CanAccess (const ObjectBase *object, bool set) const;
+  /**
+   * Report a failed access.
+   * \param [in] object The object.
+   * \param [in] what What failed.
+   */
+  void Fail (const ObjectBase *object, std::string what) const;
+
+  TypeId m_tid;                            //!< The TypeId given at resolution.
+  std::string m_name;                      //!< The Attribute name.
+  Ptr<const AttributeAccessor> m_accessor; //!< The Attribute accessor.
+  Ptr<const AttributeChecker> m_checker;   //!< The Attribute checker.
+  bool m_settable;                         //!< The Attribute can be set.
+  bool m_gettable;                         //!< The Attribute can be read.
+};
+
+/**
+ * \ingroup attribute
+ *
+ * \brief A typed handle on an Attribute, resolved once.
+ *
+ * ObjectBase::SetAttribute and ObjectBase::GetAttribute look up the
+ * Attribute by name at each call, and copy the value into a new
+ * AttributeValue.  An AttributeHandle looks up the Attribute once, for
+ * a TypeId; its Set and Get methods then call the AttributeAccessor
+ * directly, with a \p V value on the stack.  The values given to Set
+ * are still checked by the AttributeChecker.
+ *
+ * \code
+ *   AttributeHandle<DoubleValue> txPower (LteEnbPhy::GetTypeId (), "TxPower");
+ *   for (uint32_t i = 0; i < phys.size (); ++i)
+ *     {
+ *       txPower.Set (phys[i], 30.0 + i);
+ *     }
+ * \endcode
+ *
+ * A handle applies to the objects of its TypeId and of its subclasses.
+ *
+ * \tparam V \explicit The AttributeValue type of the Attribute,
+ *           such as DoubleValue or TimeValue.
+ */
+template <typename V>
+class AttributeHandle : public AttributeHandleBase
+{
+public:
+  /** The type held by \p V values. */
+  typedef typename std::decay<decltype (std::declval<const V &> ().Get ())>::type ValueType;
+
+  /** Constructor for a handle which refers to no Attribute. */
+  AttributeHandle ();
+  /**
+   * Resolve an Attribute of a TypeId, or of its parents.
+   *
+   * It is a fatal error if there is no such Attribute, or if its
+   * values are not of type \p V.
+   *
+   * \param [in] tid The TypeId.
+   * \param [in] name The name of the Attribute.
+   */
+  AttributeHandle (TypeId tid, std::string name);
+  /**
+   * Resolve an Attribute of a TypeId, or of its parents.
+   * \param [in] tid The TypeId.
+   * \param [in] name The name of the Attribute.
+   * \returns A handle, invalid if there is no such Attribute with
+   *          values of type \p V.
+   */
+  static AttributeHandle<V> LookupFailSafe (TypeId tid, std::string name);
+
+  /**
+   * Set the Attribute of an object.
+   *
+   * It is a fatal error if the value is not valid for the Attribute.
+   *
+   * \param [in] object The object.
+   * \param [in] value The value.
+   */
+  void Set (ObjectBase *object, const ValueType &value) const;
+  /**
+   * Set the Attribute of an object.
+   * \param [in] object The object.
+   * \param [in] value The value.
+   * \returns \c true if the Attribute was set.
+   */
+  bool SetFailSafe (ObjectBase *object, const ValueType &value) const;
+  /**
+   * Get the Attribute of an object.
+   * \param [in] object The object.
+   * \returns The value of the Attribute.
+   */
+  ValueType Get (const ObjectBase *object) const;
+  /**
+   * Get the Attribute of an object.
+   * \param [in] object The object.
+   * \param [out] value The value of the Attribute.
+   * \returns \c true if the value was read.
+   */
+  bool GetFailSafe (const ObjectBase *object, ValueType &value) const;
+
+  /**
+   * \copydoc Set(ObjectBase*,const ValueType&)const
+   * \tparam T \deduced The type of the object.
+   */
+  template <typename T>
+  void Set (const Ptr<T> &object, const ValueType &value) const;
+  /**
+   * \copydoc Get(const ObjectBase*)const
+   * \tparam T \deduced The type of the object.
+   */
+  template <typename T>
+  ValueType Get (const Ptr<T> &object) const;
+
+private:
+  /**
+   * Resolve an Attribute.
+   * \param [in] tid The TypeId.
+   * \param [in] name The name of the Attribute.
+   * \param [in] failSafe Leave the handle invalid, rather than abort.
+   */
+  AttributeHandle (TypeId tid, std::string name, bool failSafe);
+};
+
+} // namespace ns3
+
+
+/********************************************************************
+ *  Implementation of the templates declared above.
+ ********************************************************************/
+
+namespace ns3 {
+
+template <typename V>
+AttributeHandle<V>::AttributeHandle ()
+  : AttributeHandleBase ()
+{}
+
+template <typename V>
+AttributeHandle<V>::AttributeHandle (TypeId tid, std::string name)
+  : AttributeHandleBase (tid, name, V (), false)
+{}
+
+template <typename V>
+AttributeHandle<V>::AttributeHandle (TypeId tid, std::string name, bool failSafe)
+  : AttributeHandleBase (tid, name, V (), failSafe)
+{}
+
+template <typename V>
+AttributeHandle<V>
+AttributeHandle<V>::LookupFailSafe (TypeId tid, std::string name)
+{
+  return AttributeHandle<V> (tid, name, true);
+}
+
+template <typename V>
+void
+AttributeHandle<V>::Set (ObjectBase *object, const ValueType &value) const
+{
+  if (!SetFailSafe (object, value))
+    {
+      Fail (object, "could not be set");
+    }
+}
+
+template <typename V>
+bool
+AttributeHandle<V>::SetFailSafe (ObjectBase *object, const ValueType &value) const
+{
+  if (!CanAccess (object, true))
+    {
+      return false;
+    }
+  V v (value);
+  if (!m_checker->Check (v))
+    {
+      return false;
+    }
+  return m_accessor->Set (object, v);
+}
+
+template <typename V>
+typename AttributeHandle<V>::ValueType
+AttributeHandle<V>::Get (const ObjectBase *object) const
+{
+  ValueType value;
+  if (!GetFailSafe (object, value))
+    {
+      Fail (object, "could not be read");
+    }
+  return value;
+}
+
+template <typename V>
+bool
+AttributeHandle<V>::GetFailSafe (const ObjectBase *object, ValueType &value) const
+{
+  if (!CanAccess (object, false))
+    {
+      return false;
+    }
+  V v;
+  if (!m_accessor->Get (object, v))
+    {
+      return false;
+    }
+  value = v.Get ();
+  return true;
+}
+
+template <typename V>
+template <typename T>
+void
+AttributeHandle<V>::Set (const Ptr<T> &object, const ValueType &value) const
+{
+  Set (PeekPointer (object), value);
+}
+
+template <typename V>
+template <typename T>
+typename AttributeHandle<V>::ValueType
+AttributeHandle<V>::Get (const Ptr<T> &object) const
+{
+  return Get (PeekPointer (object));
+}
+
+} // namespace ns3
+
+#endif /* ATTRIBUTE_HANDLE_H */
@@ -0,0 +1,684 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Amiraslan Haghrah
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef BINARY_TRACE_FILE_H
+#define BINARY_TRACE_FILE_H
+
+#include "ns3/core-config.h"
+#include "ns3/assert.h"
+#include "ns3/callback.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/packet.h"
+#ifdef HAVE_PTHREAD_H
+#include "ns3/system-condition.h"
+#include "ns3/system-mutex.h"
+#include "ns3/system-thread.h"
+#endif
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdint.h>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup network
+ * ns3::BinaryTraceFile and ns3::BinaryTraceReader declarations.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup network
+ * \brief A file of typed, fixed-width trace records, written by a
+ * background thread.
+ *
+ * Trace sinks which format their arguments as text and flush a stream at
+ * each hit spend most of a long run formatting. A BinaryTraceFile instead
+ * makes sinks for any TracedCallback signature which copy the arguments,
+ * with the current simulation time, in a buffer: MakeSink and
+ * MakeSinkWithContext describe the columns of the trace once, from the
+ * types of the arguments, in a schema record written before its first
+ * record. The full buffers are written to the file by a background thread
+ * while the simulation fills another one.
+ *
+ * \code
+ *   Ptr<BinaryTraceFile> file = Create<BinaryTraceFile> ("handover.btr");
+ *   Config::Connect ("/NodeList/[*]/DeviceList/[*]/LteUeRrc/HandoverEndOk",
+ *                    file->MakeSinkWithContext<uint64_t, uint16_t, uint16_t>
+ *                      ("HandoverEndOk", {"imsi", "cellId", "rnti"}));
+ * \endcode
+ *
+ * The supported argument types are the arithmetic and enumeration types,
+ * Time, stored as a number of time steps, and Ptr<Packet> or
+ * Ptr<const Packet>, stored as two columns: the packet uid and size.
+ * The context strings of the sinks with context are stored once, in
+ * dictionary records, and the records refer to them by index.
+ *
+ * The file is written in the byte order of the host. BinaryTraceReader
+ * reads it back, and converts it to CSV or columnar files; see
+ * the \c binary-trace-convert program.
+ *
+ * The file is closed by Close, or when the simulation is destroyed.
+ */
+class BinaryTraceFile : public SimpleRefCount<BinaryTraceFile>
+{
+public:
+  /** The type of a column. */
+  enum ColumnType
+  {
+    UINT8 = 1,    //!< uint8_t, and bool
+    INT8,         //!< int8_t
+    UINT16,       //!< uint16_t
+    INT16,        //!< int16_t
+    UINT32,       //!< uint32_t
+    INT32,        //!< int32_t
+    UINT64,       //!< uint64_t
+    INT64,        //!< int64_t
+    FLOAT,        //!< float
+    DOUBLE,       //!< double
+    TIME,         //!< Time, as int64_t time steps
+    CONTEXT       //!< a context string, as the uint32_t index of the string
+  };
+
+  /** A column of a trace. */
+  struct Column
+  {
+    std::string name;   //!< The name of the column.
+    ColumnType type;    //!< The type of the column.
+  };
+
+  /** The first bytes of a file. */
+  static const char MAGIC[8];
+  /** The version of the format. */
+  static const uint32_t VERSION = 1;
+  /** The trace id of the schema records. */
+  static const uint16_t SCHEMA_RECORD = 0xffff;
+  /** The trace id of the context dictionary records. */
+  static const uint16_t CONTEXT_RECORD = 0xfffe;
+
+  /**
+   * Create a file, and start its writer thread.
+   *
+   * \param [in] filename The name of the file.
+   * \param [in] bufferSize The size of each of the two buffers, in bytes.
+   * \param [in] async Write the buffers from a background thread; if
+   *             \c false, or without thread support, the buffers are
+   *             written when full by the simulation thread.
+   */
+  BinaryTraceFile (const std::string &filename, uint32_t bufferSize = 1 << 20,
+                   bool async = true);
+  /** Destructor. Closes the file. */
+  ~BinaryTraceFile ();
+
+  /**
+   * Make a sink which records its arguments in a new trace.
+   *
+   * \tparam Args \deduced The argument types of the TracedCallback.
+   * \param [in] name The name of the trace.
+   * \param [in] columnNames The names of the columns, one per argument;
+   *             if empty, the columns are named \c c0, \c c1...
+   * \returns The sink.
+   */
+  template <typename... Args>
+  Callback<void, Args...> MakeSink (const std::string &name,
+                                    const std::vector<std::string> &columnNames
+                                      = std::vector<std::string> ());
+  /**
+   * Make a sink for Config::Connect, which records its context and
+   * arguments in a new trace. The context is the first column,
+   * named \c context.
+   *
+   * \tparam Args \deduced The argument types of the TracedCallback.
+   * \param [in] name The name of the trace.
+   * \param [in] columnNames The names of the columns, one per argument
+   *             after the context.
+   * \returns The sink.
+   */
+  template <typename... Args>
+  Callback<void, std::string, Args...> MakeSinkWithContext (const std::string &name,
+                                                            const std::vector<std::string> &columnNames
+                                                              = std::vector<std::string> ());
+
+  /**
+   * Add a trace, and write its schema record.
+   *
+   * \param [in] name The name of the trace.
+   * \param [in] columns The columns of the trace.
+   * \returns The trace id.
+   */
+  uint16_t AddTrace (const std::string &name, const std::vector<Column> &columns);
+  /**
+   * Start a record of a trace at the current time.
+   *
+   * \param [in] traceId The trace id.
+   * \param [in] size The size of the columns of the trace.
+   * \returns Where to write the columns, or 0 if the file is closed.
+   */
+  uint8_t * BeginRecord (uint16_t traceId, uint32_t size);
+  /**
+   * Get the index of a context string, writing a dictionary record the
+   * first time.
+   *
+   * \param [in] context The context string.
+   * \returns The index of the string.
+   */
+  uint32_t GetContextIndex (const std::string &context);
+
+  /** Write the records so far to the file, and wait for the write. */
+  void Flush (void);
+  /** Write the records so far, stop the writer thread and close the file. */
+  void Close (void);
+  /** \returns The number of trace records, not counting the schema records. */
+  uint64_t GetNRecords (void) const;
+
+  /**
+   * \param [in] type A column type.
+   * \returns The size of the column, in bytes.
+   */
+  static uint32_t GetColumnSize (ColumnType type);
+
+private:
+  /** Hand the current buffer to the writer. */
+  void Submit (void);
+  /**
+   * Write a buffer to the file.
+   * \param [in] data The buffer.
+   * \param [in] size The number of bytes.
+   */
+  void Write (const uint8_t *data, std::size_t size);
+  /**
+   * Reserve bytes at the end of the current buffer.
+   * \param [in] size The number of bytes.
+   * \returns The reserved bytes.
+   */
+  uint8_t * Reserve (std::size_t size);
+#ifdef HAVE_PTHREAD_H
+  /** Wait until the writer is done with the pending buffer. */
+  void WaitIdle (void);
+  /** The loop of the writer thread. */
+  void DoWrite (void);
+#endif
+
+  std::ofstream m_file;               //!< The file.
+  bool m_open;                        //!< \c false once closed.
+  std::vector<uint8_t> m_buffer;      //!< The buffer being filled.
+  std::size_t m_used;                 //!< The number of bytes used in m_buffer.
+  uint16_t m_nTraces;                 //!< The number of traces.
+  uint64_t m_nRecords;                //!< The number of trace records.
+  /** The index of each context string. */
+  std::unordered_map<std::string, uint32_t> m_contexts;
+#ifdef HAVE_PTHREAD_H
+  Ptr<SystemThread> m_thread;         //!< The writer thread, if any.
+  SystemMutex m_mutex;                //!< Protects the fields below.
+  SystemCondition m_ready;            //!< Set when a buffer is pending, or to stop.
+  SystemCondition m_idle;             //!< Set when the pending buffer is written.
+  std::vector<uint8_t> m_pending;     //!< The buffer owned by the writer.
+  std::size_t m_pendingUsed;          //!< The bytes to write, 0 if none.
+  bool m_stop;                        //!< Ask the writer thread to return.
+#endif
+};
+
+
+/**
+ * \ingroup network
+ * \brief The description of a type as columns of a BinaryTraceFile.
+ *
+ * \tparam T \explicit The type.
+ *
+ * The specializations define \c SIZE, the size of the columns, and
+ * \c Describe and \c Write.
+ */
+template <typename T, typename Enable = void>
+struct BinaryTraceColumns;
+
+/**
+ * \ingroup network
+ * \brief Arithmetic and enumeration types are a single column.
+ * \tparam T \explicit The type.
+ */
+template <typename T>
+struct BinaryTraceColumns<T, typename std::enable_if<std::is_arithmetic<T>::value
+                                                     || std::is_enum<T>::value>::type>
+{
+  /** The stored type. */
+  typedef typename std::conditional<std::is_enum<T>::value,
+                                    std::underlying_type<T>,
+                                    std::common_type<T> >::type::type Stored;
+  static_assert (!std::is_floating_point<Stored>::value || sizeof (Stored) <= 8,
+                 "long double is not supported");
+  /** The size of the column. */
+  static const uint32_t SIZE = sizeof (Stored);
+
+  /**
+   * Describe the column.
+   * \param [in] name The name of the column.
+   * \param [in,out] columns The columns to append to.
+   */
+  static void Describe (const std::string &name, std::vector<BinaryTraceFile::Column> &columns)
+  {
+    BinaryTraceFile::Column column;
+    column.name = name;
+    if (std::is_floating_point<Stored>::value)
+      {
+        column.type = sizeof (Stored) == 4 ? BinaryTraceFile::FLOAT : BinaryTraceFile::DOUBLE;
+      }
+    else
+      {
+        // UINT8, INT8, UINT16... by size and signedness
+        uint32_t log = SIZE == 1 ? 0 : SIZE == 2 ? 1 : SIZE == 4 ? 2 : 3;
+        column.type = static_cast<BinaryTraceFile::ColumnType>
+          (BinaryTraceFile::UINT8 + 2 * log + (std::is_signed<Stored>::value ? 1 : 0));
+      }
+    columns.push_back (column);
+  }
+  /**
+   * Write the column.
+   * \param [in] p Where to write.
+   * \param [in] value The value.
+   * \returns Where to write the next column.
+   */
+  static uint8_t * Write (uint8_t *p, T value)
+  {
+    Stored stored = static_cast<Stored> (value);
+    std::memcpy (p, &stored, SIZE);
+    return p + SIZE;
+  }
+};
+
+/**
+ * \ingroup network
+ * \brief Time is a single column of time steps.
+ */
+template <>
+struct BinaryTraceColumns<Time>
+{
+  /** The size of the column. */
+  static const uint32_t SIZE = 8;
+
+  /**
+   * Describe the column.
+   * \param [in] name The name of the column.
+   * \param [in,out] columns The columns to append to.
+   */
+  static void Describe (const std::string &name, std::vector<BinaryTraceFile::Column> &columns)
+  {
+    BinaryTraceFile::Column column;
+    column.name = name;
+    column.type = BinaryTraceFile::TIME;
+    columns.push_back (column);
+  }
+  /**
+   * Write the column.
+   * \param [in] p Where to write.
+   * \param [in] value The value.
+   * \returns Where to write the next column.
+   */
+  static uint8_t * Write (uint8_t *p, const Time &value)
+  {
+    int64_t step = value.GetTimeStep ();
+    std::memcpy (p, &step, SIZE);
+    return p + SIZE;
+  }
+};
+
+/**
+ * \ingroup network
+ * \brief A packet is two columns, its uid and size.
+ */
+template <>
+struct BinaryTraceColumns<Ptr<const Packet> >
+{
+  /** The size of the columns. */
+  static const uint32_t SIZE = 12;
+
+  /**
+   * Describe the columns, suffixed with \c _uid and \c _size.
+   * \param [in] name The name of the argument.
+   * \param [in,out] columns The columns to append to.
+   */
+  static void Describe (const std::string &name, std::vector<BinaryTraceFile::Column> &columns)
+  {
+    BinaryTraceFile::Column column;
+    column.name = name + "_uid";
+    column.type = BinaryTraceFile::UINT64;
+    columns.push_back (column);
+    column.name = name + "_size";
+    column.type = BinaryTraceFile::UINT32;
+    columns.push_back (column);
+  }
+  /**
+   * Write the columns.
+   * \param [in] p Where to write.
+   * \param [in] packet The packet.
+   * \returns Where to write the next column.
+   */
+  static uint8_t * Write (uint8_t *p, const Ptr<const Packet> &packet)
+  {
+    uint64_t uid = packet->GetUid ();
+    uint32_t size = packet->GetSize ();
+    std::memcpy (p, &uid, 8);
+    std::memcpy (p + 8, &size, 4);
+    return p + SIZE;
+  }
+};
+
+/**
+ * \ingroup network
+ * \brief A non-const packet is stored as a const one.
+ */
+template <>
+struct BinaryTraceColumns<Ptr<Packet> > : public BinaryTraceColumns<Ptr<const Packet> >
+{};
+
+
+/**
+ * \ingroup network
+ * \brief The sinks made by BinaryTraceFile::MakeSink and
+ * BinaryTraceFile::MakeSinkWithContext.
+ *
+ * \tparam Args \explicit The argument types of the TracedCallback.
+ */
+template <typename... Args>
+class BinaryTraceSink : public SimpleRefCount<BinaryTraceSink<Args...> >
+{
+public:
+  /**
+   * Constructor.
+   * \param [in] file The file.
+   * \param [in] name The name of the trace.
+   * \param [in] columnNames The names of the arguments.
+   * \param [in] withContext \c true to add a context column first.
+   */
+  BinaryTraceSink (Ptr<BinaryTraceFile> file, const std::string &name,
+                   const std::vector<std::string> &columnNames, bool withContext)
+    : m_file (file),
+      m_size (Size<typename std::decay<Args>::type...> ())
+  {
+    NS_ASSERT_MSG (columnNames.empty () || columnNames.size () == sizeof... (Args),
+                   "BinaryTraceFile: " << columnNames.size () << " column names for "
+                   << sizeof... (Args) << " arguments");
+    std::vector<BinaryTraceFile::Column> columns;
+    if (withContext)
+      {
+        BinaryTraceFile::Column context;
+        context.name = "context";
+        context.type = BinaryTraceFile::CONTEXT;
+        columns.push_back (context);
+        m_size += 4;
+      }
+    Describe<typename std::decay<Args>::type...> (columnNames, 0, columns);
+    m_traceId = file->AddTrace (name, columns);
+  }
+
+  /**
+   * Record the arguments.
+   * \param [in] args The arguments.
+   */
+  void Record (Args... args)
+  {
+    uint8_t *p = m_file->BeginRecord (m_traceId, m_size);
+    if (p != 0)
+      {
+        WriteColumns (p, args...);
+      }
+  }
+  /**
+   * Record the context and the arguments.
+   * \param [in] context The context.
+   * \param [in] args The arguments.
+   */
+  void RecordWithContext (std::string context, Args... args)
+  {
+    uint32_t index = m_file->GetContextIndex (context);
+    uint8_t *p = m_file->BeginRecord (m_traceId, m_size);
+    if (p != 0)
+      {
+        std::memcpy (p, &index, 4);
+        WriteColumns (p + 4, args...);
+      }
+  }
+
+private:
+  /** \returns 0, the size of no column. */
+  template <int DUMMY = 0>
+  static uint32_t Size (void)
+  {
+    return 0;
+  }
+  /**
+   * \tparam T \explicit The first type.
+   * \tparam Rest \explicit The other types.
+   * \returns The size of the columns of the types.
+   */
+  template <typename T, typename... Rest>
+  static uint32_t Size (void)
+  {
+    return BinaryTraceColumns<T>::SIZE + Size<Rest...> ();
+  }
+  /** End of the column descriptions. */
+  template <int DUMMY = 0>
+  static void Describe (const std::vector<std::string> &, uint32_t,
+                        std::vector<BinaryTraceFile::Column> &)
+  {}
+  /**
+   * Describe the columns of the arguments.
+   * \tparam T \explicit The type of the first argument.
+   * \tparam Rest \explicit The types of the other arguments.
+   * \param [in] names The names of the arguments.
+   * \param [in] i The index of the first argument.
+   * \param [in,out] columns The columns to append to.
+   */
+  template <typename T, typename... Rest>
+  static void Describe (const std::vector<std::string> &names, uint32_t i,
+                        std::vector<BinaryTraceFile::Column> &columns)
+  {
+    std::string name;
+    if (names.empty ())
+      {
+        std::ostringstream oss;
+        oss << "c" << i;
+        name = oss.str ();
+      }
+    else
+      {
+        name = names[i];
+      }
+    BinaryTraceColumns<T>::Describe (name, columns);
+    Describe<Rest...> (names, i + 1, columns);
+  }
+  /** End of the columns. */
+  static void WriteColumns (uint8_t *)
+  {}
+  /**
+   * Write the columns of the arguments.
+   * \param [in] p Where to write.
+   * \param [in] value The first argument.
+   * \param [in] rest The other arguments.
+   */
+  template <typename T, typename... Rest>
+  static void WriteColumns (uint8_t *p, const T &value, const Rest &... rest)
+  {
+    WriteColumns (BinaryTraceColumns<T>::Write (p, value), rest...);
+  }
+
+  Ptr<BinaryTraceFile> m_file;  //!< The file.
+  uint16_t m_traceId;           //!< The trace id.
+  uint32_t m_size;              //!< The size of the columns.
+};
+
+
+template <typename... Args>
+Callback<void, Args...>
+BinaryTraceFile::MakeSink (const std::string &name, const std::vector<std::string> &columnNames)
+{
+  Ptr<BinaryTraceSink<Args...> > sink =
+    Create<BinaryTraceSink<Args...> > (Ptr<BinaryTraceFile> (this), name, columnNames, false);
+  return Callback<void, Args...> (sink, &BinaryTraceSink<Args...>::Record);
+}
+
+template <typename... Args>
+Callback<void, std::string, Args...>
+BinaryTraceFile::MakeSinkWithContext (const std::string &name,
+                                      const std::vector<std::string> &columnNames)
+{
+  Ptr<BinaryTraceSink<Args...> > sink =
+    Create<BinaryTraceSink<Args...> > (Ptr<BinaryTraceFile> (this), name, columnNames, true);
+  return Callback<void, std::string, Args...> (sink, &BinaryTraceSink<Args...>::RecordWithContext);
+}
+
+
+/**
+ * \ingroup network
+ * \brief Read a BinaryTraceFile, and convert it to other formats.
+ *
+ * The schema and dictionary records are processed as they are read, so
+ * that Next returns the trace records only.
+ */
+class BinaryTraceReader
+{
+public:
+  /** A trace of the file. */
+  struct Trace
+  {
+    std::string name;                             //!< The name of the trace.
+    std::vector<BinaryTraceFile::Column> columns;  //!< The columns.
+    std::vector<uint32_t> offsets;                //!< The offset of each column.
+    uint32_t size;                                //!< The size of the columns.
+  };
+
+  /**
+   * Open a file and read its header.
+   * \param [in] filename The name of the file.
+   */
+  BinaryTraceReader (const std::string &filename);
+
+  /**
+   * \returns \c true if the file could not be opened, is not a
+   *          BinaryTraceFile, or is truncated.
+   */
+  bool Fail (void) const;
+  /**
+   * Read the next trace record.
+   * \returns \c false at the end of the file.
+   */
+  bool Next (void);
+  /** \returns The trace id of the record. */
+  uint16_t GetTraceId (void) const;
+  /** \returns The trace of the record. */
+  const Trace & GetTrace (void) const;
+  /** \returns The time of the record, in time steps of the file. */
+  int64_t GetTimeStep (void) const;
+  /** \returns The time of the record, in seconds. */
+  double GetSeconds (void) const;
+  /**
+   * \param [in] i The index of a column of the record.
+   * \returns The value of the column, converted to double. Time columns
+   *          are converted to seconds.
+   */
+  double GetDouble (uint32_t i) const;
+  /**
+   * \param [in] i The index of a column of the record.
+   * \returns The value of the column, converted to an integer. Time
+   *          columns are in time steps of the file.
+   */
+  int64_t GetInteger (uint32_t i) const;
+  /**
+   * \param [in] i The index of a column of the record.
+   * \returns The value of the column as text; context strings are
+   *          looked up.
+   */
+  std::string GetString (uint32_t i) const;
+  /**
+   * \param [in] i The index of a column of the record.
+   * \returns The bytes of the column.
+   */
+  const uint8_t * GetColumnData (uint32_t i) const;
+  /** \returns The traces read so far, by trace id. */
+  const std::vector<Trace> & GetTraces (void) const;
+  /** \returns The context strings read so far, by index. */
+  const std::vector<std::string> & GetContexts (void) const;
+
+  /**
+   * Convert a file to one CSV file per trace, named
+   * <em>prefix</em>-<em>trace</em>.csv. The first column is the time,
+   * in seconds.
+   *
+   * \param [in] filename The name of the BinaryTraceFile.
+   * \param [in] prefix The prefix of the names of the CSV files.
+   * \returns \c false if the file could not be read.
+   */
+  static bool ConvertToCsv (const std::string &filename, const std::string &prefix);
+  /**
+   * Convert a file to one raw file per column of each trace, named
+   * <em>prefix</em>-<em>trace</em>-<em>column</em>.bin, in the byte order of
+   * the host, with a <em>prefix</em>-<em>trace</em>.schema text file which
+   * lists the columns and their types. The first column, \c time, is the
+   * time in int64 time steps. The context strings are listed in
+   * <em>prefix</em>-contexts.txt, one per line, by index.
+   *
+   * \param [in] filename The name of the BinaryTraceFile.
+   * \param [in] prefix The prefix of the names of the column files.
+   * \returns \c false if the file could not be read.
+   */
+  static bool ConvertToColumns (const std::string &filename, const std::string &prefix);
+  /**
+   * \param [in] type A column type.
+   * \returns The name of the type.
+   */
+  static std::string GetTypeName (BinaryTraceFile::ColumnType type);
+
+private:
+  /**
+   * Read bytes from the file.
+   * \param [out] data Where to store the bytes.
+   * \param [in] size The number of bytes.
+   * \returns \c false at the end of the file.
+   */
+  bool Read (void *data, std::size_t size);
+  /**
+   * Read a string, prefixed by its uint16_t length.
+   * \param [out] s The string.
+   * \returns \c false at the end of the file.
+   */
+  bool ReadString (std::string &s);
+  /** \returns \c false if the schema record could not be read. */
+  bool ReadSchema (void);
+  /** \returns \c false if the dictionary record could not be read. */
+  bool ReadContext (void);
+
+  std::ifstream m_file;                 //!< The file.
+  bool m_fail;                          //!< The fail state.
+  double m_secondsPerStep;              //!< The time resolution of the file.
+  std::vector<Trace> m_traces;          //!< The traces, by trace id.
+  std::vector<std::string> m_contexts;  //!< The context strings, by index.
+  uint16_t m_traceId;                   //!< The trace id of the record.
+  int64_t m_timeStep;                   //!< The time of the record.
+  std::vector<uint8_t> m_record;        //!< The columns of the record.
+};
+
+} // namespace ns3
+
+#endif /* BINARY_TRACE_FILE_H */
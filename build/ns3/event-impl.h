@@ -0,0 +1,139 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2005,2006 INRIA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
+ */
+#ifndef EVENT_IMPL_H
+#define EVENT_IMPL_H
+
+#include <stdint.h>
+#include <cstddef>
+#include "simple-ref-count.h"
+
+/**
+ * \file
+ * \ingroup events
+ * ns3::EventImpl declarations.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup events
+ * \brief A simulation event.
+ *
+ * Each subclass of this base class represents a simulation event. The
+ * Invoke() method will be called by the simulation engine
+ * when it reaches the time associated to this event. Most subclasses
+ * are usually created by one of the many Simulator::Schedule
+ * methods.
+ *
+ * The events, including the bound arguments stored by the MakeEvent
+ * subclasses, are allocated from a pool: each thread keeps the freed
+ * events in free lists by size class, and reuses them for the next events
+ * of the same size class instead of going through malloc.
+ */
+class EventImpl : public SimpleRefCount<EventImpl>
+{
+public:
+  /** Default constructor. */
+  EventImpl ();
+  /** Destructor. */
+  virtual ~EventImpl () = 0;
+
+  /**
+   * Allocate an event from the pool of the calling thread.
+   * \param size the size of the event
+   * \return the event memory
+   */
+  static void * operator new (std::size_t size);
+  /**
+   * Release an event to the pool of the calling thread.
+   * \param p the event memory
+   * \param size the size of the event
+   */
+  static void operator delete (void *p, std::size_t size);
+  /**
+   * Allocate the events with malloc from now on, e.g., to compare the
+   * performance or to check the memory accesses with valgrind.
+   *
+   * This should be called before scheduling any event.
+   */
+  static void DisablePool (void);
+  /**
+   * Allocate the events from the pool from now on (the default).
+   */
+  static void EnablePool (void);
+  /**
+   * Called by the simulation engine to notify the event that it is time
+   * to execute.
+   */
+  void Invoke (void);
+  /**
+   * Marks the event as 'canceled'. The event is not removed from
+   * the event list but the simulation engine will check its canceled status
+   * before calling Invoke().
+   */
+  void Cancel (void);
+  /**
+   * \returns true if the event has been canceled.
+   *
+   * Checked by the simulation engine before calling Invoke().
+   */
+  bool IsCancelled (void);
+  /**
+   * Get the position of the event in the event list, as last set by the
+   * scheduler holding the event.
+   *
+   * Schedulers which support the removal of an event in less than
+   * linear time store there the index of the event in their data
+   * structure, and update it when the event moves. The value is
+   * meaningless for other schedulers.
+   *
+   * 
+eturns The scheduler handle of the event.
+   */
+  uint32_t GetSchedulerHandle (void) const
+  {
+    return m_schedulerHandle;
+  }
+  /**
+   * Set the position of the event in the event list.
+   * \param [in] handle The scheduler handle of the event.
+   */
+  void SetSchedulerHandle (uint32_t handle)
+  {
+    m_schedulerHandle = handle;
+  }
+
+protected:
+  /**
+   * Implementation for Invoke().
+   *
+   * This typically calls a method or function pointer with the
+   * arguments bound by a call to one of the MakeEvent() functions.
+   */
+  virtual void Notify (void) = 0;
+
+private:
+  uint32_t m_schedulerHandle;  /**< The position of the event in the event list. */
+  bool m_cancel;  /**< Has this event been cancelled. */
+};
+
+} // namespace ns3
+
+#endif /* EVENT_IMPL_H */
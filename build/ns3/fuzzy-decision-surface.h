@@ -0,0 +1,167 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Amiraslan Haghrah
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Amiraslan Haghrah <amiraslanhaghrah@gmail.com>
+ */
+
+#ifndef FUZZY_DECISION_SURFACE_H
+#define FUZZY_DECISION_SURFACE_H
+
+#include <ns3/fuzzy-handover-controller.h>
+#include <ns3/callback.h>
+#include <ns3/ptr.h>
+
+#include <stdint.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup lte
+ * \brief Crisp output of a two-input fuzzy inference system tabulated over a
+ *        regular grid.
+ *
+ * The surface is evaluated once over the grid; each lookup then clamps the
+ * inputs to the grid bounds and returns the bilinear interpolation of the
+ * four surrounding grid points, in constant time.
+ */
+class FuzzyDecisionSurface
+{
+public:
+  FuzzyDecisionSurface ();
+
+  /**
+   * Constructor
+   *
+   * \param xMin lower bound of the first input
+   * \param xMax upper bound of the first input
+   * \param nx number of grid points along the first input
+   * \param yMin lower bound of the second input
+   * \param yMax upper bound of the second input
+   * \param ny number of grid points along the second input
+   */
+  FuzzyDecisionSurface (double xMin, double xMax, uint32_t nx,
+                        double yMin, double yMax, uint32_t ny);
+
+  /**
+   * \brief Evaluate the surface at every grid point.
+   * \param f the function to tabulate
+   */
+  void Build (Callback<double, double, double> f);
+
+  /**
+   * \param x the first input
+   * \param y the second input
+   * \return the interpolated value of the surface
+   */
+  double Lookup (double x, double y) const;
+
+  /**
+   * \brief Write the grid definition and the values.
+   * \param os the output stream
+   */
+  void Save (std::ostream &os) const;
+  /**
+   * \brief Read a surface written by Save.
+   * \param is the input stream
+   * \return true if a complete surface matching the grid definition of this
+   *         instance has been read
+   */
+  bool Load (std::istream &is);
+
+private:
+  double m_xMin;  ///< lower bound of the first input
+  double m_xStep; ///< grid step of the first input
+  uint32_t m_nx;  ///< number of grid points along the first input
+  double m_yMin;  ///< lower bound of the second input
+  double m_yStep; ///< grid step of the second input
+  uint32_t m_ny;  ///< number of grid points along the second input
+  std::vector<float> m_values; ///< surface values, row-major in x
+};
+
+
+/**
+ * \ingroup lte
+ * \brief Fuzzy handover controller answering from precomputed decision
+ *        surfaces.
+ *
+ * The three inference systems of another controller are tabulated once:
+ * the RLQ estimators over RSRQ in [0, 34] (step 0.25) and deltaRSRQ in
+ * [-8, 8] (step 0.125), the handover trigger over the 101-point RLQ grids.
+ * The handover trigger threshold of the tabulated controller is kept.
+ *
+ * The surfaces can be saved to a text file and loaded back, so that many
+ * simulation runs can share one table. The file records the name of the
+ * tabulated controller and is rejected if it does not match.
+ */
+class TabulatedFuzzyHandoverController : public FuzzyHandoverController
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param controller the controller to tabulate
+   */
+  TabulatedFuzzyHandoverController (Ptr<const FuzzyHandoverController> controller);
+
+  /// Evaluate the surfaces of the tabulated controller.
+  void Build ();
+
+  /**
+   * \param filename the file to write
+   * \return true if the file has been written
+   */
+  bool Save (std::string filename) const;
+  /**
+   * \param filename the file to read
+   * \return true if the surfaces of the tabulated controller have been read
+   */
+  bool Load (std::string filename);
+
+  /**
+   * \brief Tabulate a controller, reusing a saved table if possible.
+   *
+   * If the file exists and holds the tables of the controller, they are
+   * loaded; otherwise the tables are built and, if a file name is given,
+   * saved to the file.
+   *
+   * \param controller the controller to tabulate
+   * \param filename the table file, or an empty string
+   * \return the tabulated controller
+   */
+  static Ptr<TabulatedFuzzyHandoverController> Tabulate (Ptr<const FuzzyHandoverController> controller,
+                                                         std::string filename);
+
+  // inherited from FuzzyHandoverController
+  virtual std::string GetName () const;
+  virtual double EvaluateServingCellRlq (double rsrq, double deltaRsrq) const;
+  virtual double EvaluateNeighbourCellRlq (double rsrq, double deltaRsrq) const;
+  virtual double EvaluateHandoverTrigger (double servingCellRlq, double neighbourCellRlq) const;
+  virtual bool IsHandoverTriggered (double handoverTrigger) const;
+
+private:
+  Ptr<const FuzzyHandoverController> m_controller; ///< the tabulated controller
+  FuzzyDecisionSurface m_servingCellRlq;   ///< serving cell RLQ surface
+  FuzzyDecisionSurface m_neighbourCellRlq; ///< neighbour cell RLQ surface
+  FuzzyDecisionSurface m_handoverTrigger;  ///< handover trigger surface
+};
+
+} // namespace ns3
+
+#endif /* FUZZY_DECISION_SURFACE_H */
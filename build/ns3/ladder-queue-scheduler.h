@@ -0,0 +1,201 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Amiraslan Haghrah
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef LADDER_QUEUE_SCHEDULER_H
+#define LADDER_QUEUE_SCHEDULER_H
+
+#include "scheduler.h"
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::LadderQueueScheduler declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a ladder queue event scheduler
+ *
+ * This event scheduler is an implementation of the Ladder Queue of
+ * W. T. Tang, R. S. M. Goh and I. L.-J. Thng, "Ladder Queue: An O(1)
+ * Priority Queue Structure for Large-Scale Discrete Event Simulation",
+ * ACM TOMACS, 2005. The events are kept in three tiers:
+ *
+ *  - Top: an unsorted vector of the far future events, the ones
+ *    at or after the end of the Ladder,
+ *  - Ladder: rungs of buckets of unsorted events; each rung
+ *    divides one bucket of the rung above into finer buckets,
+ *  - Bottom: a sorted vector of the events which precede the current
+ *    bucket of the deepest rung.
+ *
+ * When Bottom is empty, the events of the first non-empty bucket of
+ * the deepest rung are sorted into Bottom, unless they are more than
+ * \c BOTTOM_THRESHOLD: the bucket is then split into a new rung. When the
+ * Ladder is empty, the events of Top are spread over a new first rung,
+ * sized by the number of events and their time span. Each event is thus
+ * copied a bounded number of times before it is sorted, in a small
+ * Bottom, whatever the distribution of the timestamps: events clustered
+ * near now, as with periodic TTI or beacon events, spawn finer rungs,
+ * while sparse far future timers stay in Top.
+ *
+ * All the events are stored by value in vectors, which keep their capacity
+ * between uses, so that no allocation is done per event in steady state.
+ * The events of Top and of the buckets keep their index in their vector
+ * as their scheduler handle (see EventImpl::GetSchedulerHandle), so that
+ * Remove() does not search them.
+ *
+ * \par Time Complexity
+ *
+ * Operation    | Amortized %Time | Reason
+ * :----------- | :-------------- | :-----
+ * Insert()     | Constant        | Append to Top or a bucket; Bottom is short
+ * IsEmpty()    | Constant        | Explicit queue size
+ * PeekNext()   | Constant        | Bottom is kept sorted and not empty
+ * Remove()     | Constant        | Handle in Top or a bucket; Bottom is short
+ * RemoveNext() | Constant        | Events are sorted by small batches
+ *
+ * \par Memory Complexity
+ *
+ * Category  | Memory                           | Reason
+ * :-------- | :------------------------------- | :-----
+ * Overhead  | `MAX_RUNGS` rungs of up to `MAX_BUCKETS` buckets | `std::vector` per bucket
+ * Per Event | 0                                | Events stored in `std::vector` directly
+ */
+class LadderQueueScheduler : public Scheduler
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  LadderQueueScheduler ();
+  /** Destructor. */
+  virtual ~LadderQueueScheduler ();
+
+  // Inherited
+  virtual void Insert (const Scheduler::Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Scheduler::Event PeekNext (void) const;
+  virtual Scheduler::Event RemoveNext (void);
+  virtual void Remove (const Scheduler::Event &ev);
+  virtual bool IsRemoveFast (void) const;
+
+private:
+  /** Maximum number of events sorted into Bottom at once. */
+  static const uint32_t BOTTOM_THRESHOLD = 50;
+  /** Maximum number of rungs. */
+  static const uint32_t MAX_RUNGS = 8;
+  /** Maximum number of buckets of a rung. */
+  static const uint32_t MAX_BUCKETS = 65536;
+
+  /** Unsorted events. */
+  typedef std::vector<Scheduler::Event> Bucket;
+
+  /** A rung of the Ladder. */
+  struct Rung
+  {
+    uint64_t start;     //!< the timestamp of the start of the first bucket
+    uint64_t width;     //!< the time span of each bucket
+    uint32_t current;   //!< the index of the first bucket not yet emptied
+    uint32_t nBuckets;  //!< the number of buckets used
+    uint32_t count;     //!< the number of events in the rung
+    std::vector<Bucket> buckets;  //!< the buckets, maybe more than used
+  };
+
+  /**
+   * \param [in] rung A rung.
+   * \returns The timestamp of the start of the current bucket of the rung.
+   */
+  inline uint64_t GetCurrentStart (const Rung &rung) const;
+  /**
+   * Find the rung holding or which would hold an event.
+   *
+   * \param [in] ts The timestamp of the event.
+   * \returns The index of the rung, or the number of rungs if the event
+   *          belongs to Bottom.
+   */
+  uint32_t FindRung (uint64_t ts) const;
+  /**
+   * Set up a new deepest rung.
+   *
+   * \param [in] start The timestamp of the start of the rung.
+   * \param [in] span The time span covered by the rung.
+   * \param [in] n The number of events which will be added to the rung.
+   * \returns The new rung.
+   */
+  Rung & AddRung (uint64_t start, uint64_t span, uint32_t n);
+  /**
+   * Add an event to a bucket of a rung.
+   *
+   * \param [in] rung The rung.
+   * \param [in] ev The event.
+   */
+  void InsertInRung (Rung &rung, const Scheduler::Event &ev);
+  /**
+   * Add an event to Bottom, keeping it sorted, or spread Bottom over a new
+   * rung if it grew too long.
+   *
+   * \param [in] ev The event.
+   */
+  void InsertInBottom (const Scheduler::Event &ev);
+  /**
+   * Refill Bottom from the Ladder, and the Ladder from Top, if Bottom
+   * is empty.
+   */
+  void FillBottom (void);
+  /** Spread the events of Top over a new first rung. */
+  void TransferTop (void);
+
+  /** Top: the unsorted far future events. */
+  Bucket m_top;
+  /** The smallest timestamp in Top. */
+  uint64_t m_topMin;
+  /** The largest timestamp in Top. */
+  uint64_t m_topMax;
+  /** The events at or after this timestamp go to Top. */
+  uint64_t m_topStart;
+  /** The rungs, including the unused ones kept for their buckets. */
+  std::vector<Rung> m_rungs;
+  /** The number of rungs used. */
+  uint32_t m_nRungs;
+  /** Bottom: the sorted events, from m_bottomHead to the end. */
+  Bucket m_bottom;
+  /** The index of the first event of Bottom. */
+  std::size_t m_bottomHead;
+  /**
+   * The number of events above which Bottom is spread over a new rung:
+   * twice its size when it was last filled, so that it is not spread at
+   * each insertion when it was filled with more than BOTTOM_THRESHOLD
+   * events.
+   */
+  std::size_t m_bottomLimit;
+  /** The number of events. */
+  uint32_t m_size;
+};
+
+} // namespace ns3
+
+#endif /* LADDER_QUEUE_SCHEDULER_H */
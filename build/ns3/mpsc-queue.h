@@ -0,0 +1,208 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Amiraslan Haghrah
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include "non-copyable.h"
+#include "assert.h"
+
+#include <stdint.h>
+#include <atomic>
+
+/**
+ * \file
+ * \ingroup thread
+ * ns3::MpscQueue declaration and template implementation.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup thread
+ * \brief A bounded, lock-free, multiple producer single consumer FIFO.
+ *
+ * \tparam T \explicit the type of the items, copyable and default
+ *           constructible
+ *
+ * Any number of threads may Push concurrently, while one thread, the
+ * consumer, calls Pop and IsEmpty. Producers never block each other: each
+ * claims a cell of a ring with a compare-and-swap, then publishes its item
+ * with a per-cell sequence number, which the consumer reads without any
+ * read-modify-write operation. Push fails instead of waiting when the ring
+ * is full; the caller decides what to do with the item.
+ *
+ * An item whose cell was claimed but not yet published hides the items
+ * pushed after it until it is published, so the items of one producer are
+ * always popped in the order they were pushed.
+ */
+template <typename T>
+class MpscQueue : private NonCopyable
+{
+public:
+  /**
+   * \param capacity the maximum number of items in the queue, a power of 2
+   */
+  MpscQueue (uint32_t capacity);
+  ~MpscQueue ();
+
+  /**
+   * Add an item at the tail of the queue. Thread-safe.
+   * \param item the item to add
+   * \return false if the queue is full, in which case the item is not added
+   */
+  bool Push (const T &item);
+  /**
+   * Remove the item at the head of the queue. Consumer only.
+   * \param [out] item the removed item
+   * \return false if the queue is empty
+   */
+  bool Pop (T &item);
+  /**
+   * Consumer only; a single atomic load.
+   * \return true if there is no item to Pop, and no item being pushed
+   */
+  bool IsEmpty (void) const;
+  /**
+   * \return the maximum number of items in the queue
+   */
+  uint32_t GetCapacity (void) const;
+
+private:
+  /** A cell of the ring. */
+  struct Cell
+  {
+    /**
+     * Position of the cell, relative to the producers and the consumer:
+     * equal to the enqueue position when the cell is free, and to the
+     * enqueue position plus 1 when its item is published.
+     */
+    std::atomic<uint64_t> sequence;
+    T item;  //!< the item stored in the cell
+  };
+
+  Cell *m_cells;      //!< the ring
+  uint64_t m_mask;    //!< capacity - 1, to wrap positions in the ring
+  /** Keep the producer position in its own cache line. */
+  char m_padding1[64];
+  /** Next position claimed by a producer. */
+  std::atomic<uint64_t> m_tail;
+  /** Keep the consumer position in its own cache line. */
+  char m_padding2[64];
+  /** Next position read by the consumer. */
+  uint64_t m_head;
+};
+
+} // namespace ns3
+
+
+/********************************************************************
+ *  Implementation of the templates declared above.
+ ********************************************************************/
+
+namespace ns3 {
+
+template <typename T>
+MpscQueue<T>::MpscQueue (uint32_t capacity)
+  : m_cells (new Cell[capacity]),
+    m_mask (capacity - 1),
+    m_tail (0),
+    m_head (0)
+{
+  NS_ASSERT_MSG (capacity >= 2 && (capacity & (capacity - 1)) == 0,
+                 "MpscQueue capacity must be a power of 2");
+  for (uint32_t i = 0; i < capacity; ++i)
+    {
+      m_cells[i].sequence.store (i, std::memory_order_relaxed);
+    }
+}
+
+template <typename T>
+MpscQueue<T>::~MpscQueue ()
+{
+  delete [] m_cells;
+}
+
+template <typename T>
+bool
+MpscQueue<T>::Push (const T &item)
+{
+  Cell *cell;
+  uint64_t position = m_tail.load (std::memory_order_relaxed);
+  for (;;)
+    {
+      cell = &m_cells[position & m_mask];
+      uint64_t sequence = cell->sequence.load (std::memory_order_acquire);
+      int64_t difference = static_cast<int64_t> (sequence - position);
+      if (difference == 0)
+        {
+          // the cell is free: claim it, unless another producer was faster
+          if (m_tail.compare_exchange_weak (position, position + 1,
+                                            std::memory_order_relaxed))
+            {
+              break;
+            }
+        }
+      else if (difference < 0)
+        {
+          // the cell still holds the item pushed one lap before
+          return false;
+        }
+      else
+        {
+          position = m_tail.load (std::memory_order_relaxed);
+        }
+    }
+  cell->item = item;
+  cell->sequence.store (position + 1, std::memory_order_release);
+  return true;
+}
+
+template <typename T>
+bool
+MpscQueue<T>::Pop (T &item)
+{
+  Cell *cell = &m_cells[m_head & m_mask];
+  if (cell->sequence.load (std::memory_order_acquire) != m_head + 1)
+    {
+      return false;
+    }
+  item = cell->item;
+  // free the cell for the producers of the next lap
+  cell->sequence.store (m_head + m_mask + 1, std::memory_order_release);
+  ++m_head;
+  return true;
+}
+
+template <typename T>
+bool
+MpscQueue<T>::IsEmpty (void) const
+{
+  return m_tail.load (std::memory_order_acquire) == m_head;
+}
+
+template <typename T>
+uint32_t
+MpscQueue<T>::GetCapacity (void) const
+{
+  return static_cast<uint32_t> (m_mask + 1);
+}
+
+} // namespace ns3
+
+#endif /* MPSC_QUEUE_H */
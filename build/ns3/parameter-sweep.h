@@ -0,0 +1,221 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Amiraslan Haghrah
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#ifndef PARAMETER_SWEEP_H
+#define PARAMETER_SWEEP_H
+
+#include "ns3/callback.h"
+
+#include <stdint.h>
+#include <iostream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-helpers
+ * ns3::ParameterSweep declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup core-helpers
+ * \brief Run the replicas of a seed x parameter grid from one program.
+ *
+ * Each point of the grid is a combination of a seed, of one value of each
+ * parameter and of a run number; all of them are run by the same replica
+ * callback, which builds and runs one simulation and reports its results.
+ * The results of all the replicas are written as one table: one row per
+ * replica, one column per grid dimension and per reported result.
+ *
+ * \code
+ *   static void
+ *   RunReplica (ParameterSweep::Replica &replica)
+ *   {
+ *     double speed = replica.GetDouble ("speed");
+ *     // build the scenario, then
+ *     Simulator::Run ();
+ *     replica.Report ("throughput", throughput);
+ *   }
+ *
+ *   ParameterSweep sweep;
+ *   sweep.SetSeeds ("6557,6688,8481");
+ *   sweep.AddParameter ("speed", "10,20,30,40");
+ *   sweep.SetReplicas (2);
+ *   sweep.Run (MakeCallback (&RunReplica), std::cout);
+ * \endcode
+ *
+ * Replicas run concurrently, up to the number of workers (by default, the
+ * number of online processors). Each replica runs in a child process forked
+ * from the calling program, so it starts with a fresh simulator, node list,
+ * configuration and seed manager while sharing, copy-on-write, whatever the
+ * program built before calling Run (propagation tables, topology
+ * templates...). Before calling the replica callback, the seed and the run
+ * number of the replica are set with RngSeedManager.
+ *
+ * Run must therefore be called before any simulation in this program, and
+ * the replica callback must not rely on side effects in the calling
+ * program: only the reported results come back.
+ */
+class ParameterSweep
+{
+public:
+  /**
+   * \brief One point of the grid, as seen by the replica callback.
+   */
+  class Replica
+  {
+  public:
+    /// \return the index of the replica in the grid, from 0
+    uint32_t GetIndex (void) const;
+    /// \return the seed of the replica
+    uint32_t GetSeed (void) const;
+    /// \return the run number of the replica, from 1
+    uint64_t GetRun (void) const;
+
+    /**
+     * \param name the name of a parameter of the sweep
+     * \return the value of the parameter for this replica
+     */
+    std::string Get (std::string name) const;
+    /**
+     * \param name the name of a parameter of the sweep
+     * \return the value of the parameter for this replica, as a number
+     */
+    double GetDouble (std::string name) const;
+    /**
+     * \param name the name of a parameter of the sweep
+     * \return the value of the parameter for this replica, as an integer
+     */
+    int64_t GetInteger (std::string name) const;
+
+    /**
+     * \brief Report a result of this replica.
+     * \param column the name of the result column
+     * \param value the value of the result
+     */
+    void Report (std::string column, std::string value);
+    /**
+     * \brief Report a numerical result of this replica.
+     * \param column the name of the result column
+     * \param value the value of the result
+     */
+    void Report (std::string column, double value);
+
+  private:
+    friend class ParameterSweep;
+
+    uint32_t m_index;  //!< index of the replica in the grid
+    uint32_t m_seed;   //!< seed of the replica
+    uint64_t m_run;    //!< run number of the replica
+    /** Parameter names and values of the replica, in sweep order. */
+    std::vector<std::pair<std::string, std::string> > m_parameters;
+    /** Results reported by the replica, in report order. */
+    std::vector<std::pair<std::string, std::string> > m_results;
+    bool m_ok;         //!< whether the replica completed
+  };
+
+  /** Callback building and running the simulation of a replica. */
+  typedef Callback<void, Replica &> ReplicaCallback;
+
+  ParameterSweep ();
+
+  /**
+   * \brief Add a dimension to the grid.
+   * \param name the name of the parameter, unique in this sweep
+   * \param values the values taken by the parameter
+   */
+  void AddParameter (std::string name, const std::vector<std::string> &values);
+  /**
+   * \brief Add a dimension to the grid.
+   * \param name the name of the parameter, unique in this sweep
+   * \param values the comma separated values taken by the parameter
+   */
+  void AddParameter (std::string name, std::string values);
+
+  /**
+   * \param seeds the seeds, one grid dimension; by default the only seed is
+   *        the one of RngSeedManager
+   */
+  void SetSeeds (const std::vector<uint32_t> &seeds);
+  /**
+   * \param seeds the comma separated seeds
+   */
+  void SetSeeds (std::string seeds);
+  /**
+   * \param replicas the number of runs, numbered from 1, of each combination
+   *        of seed and parameter values
+   */
+  void SetReplicas (uint32_t replicas);
+  /**
+   * \param workers the maximum number of replicas running concurrently, or 0
+   *        for the number of online processors
+   */
+  void SetWorkers (uint32_t workers);
+
+  /// \return the number of replicas in the grid
+  uint32_t GetNReplicas (void) const;
+
+  /**
+   * \brief Run all the replicas and write their results.
+   *
+   * The table has a header line, then one comma separated line per
+   * replica, in grid order: seeds vary slowest, then the parameters in the
+   * order they were added, then the run number. The columns are the replica
+   * index, the seed, the run number, the status ("ok" or "failed"), the
+   * parameters, and the results in the order they were first reported.
+   * The result cells of a replica which did not report them are left empty.
+   *
+   * \param replica the callback running one replica
+   * \param os the stream receiving the table
+   * \return the number of failed replicas
+   */
+  uint32_t Run (ReplicaCallback replica, std::ostream &os);
+
+private:
+  /**
+   * \param index the index of a replica in the grid
+   * \return the replica at this index, without results
+   */
+  Replica MakeReplica (uint32_t index) const;
+  /**
+   * \brief Run the replicas in forked child processes.
+   * \param callback the callback running one replica
+   * \param replicas the replicas, updated with their results and status
+   */
+  void RunProcesses (ReplicaCallback callback, std::vector<Replica> &replicas) const;
+  /**
+   * \brief Write the table of results.
+   * \param replicas the replicas
+   * \param os the output stream
+   */
+  void WriteTable (const std::vector<Replica> &replicas, std::ostream &os) const;
+
+  /** Parameter names and values, in the order they were added. */
+  std::vector<std::pair<std::string, std::vector<std::string> > > m_parameters;
+  std::vector<uint32_t> m_seeds;  //!< the seeds
+  uint32_t m_replicas;            //!< number of runs per grid point
+  uint32_t m_workers;             //!< maximum number of concurrent replicas
+};
+
+} // namespace ns3
+
+#endif /* PARAMETER_SWEEP_H */
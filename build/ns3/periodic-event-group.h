@@ -0,0 +1,231 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Amiraslan Haghrah
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef PERIODIC_EVENT_GROUP_H
+#define PERIODIC_EVENT_GROUP_H
+
+#include "callback.h"
+#include "event-id.h"
+#include "nstime.h"
+#include "ptr.h"
+#include "simple-ref-count.h"
+
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup events
+ * ns3::PeriodicEventGroup and ns3::PeriodicEventId declarations.
+ */
+
+namespace ns3 {
+
+class PeriodicEventGroup;
+
+/**
+ * \ingroup events
+ * \brief An identifier for a callback scheduled with
+ * PeriodicEventGroup::Schedule.
+ *
+ * The default identifier refers to no callback.
+ */
+class PeriodicEventId
+{
+public:
+  /** Default constructor. This PeriodicEventId does nothing. */
+  PeriodicEventId ();
+  /**
+   * Stop invoking the callback. Does nothing if the callback
+   * was already cancelled.
+   */
+  void Cancel (void);
+  /**
+   * \returns \c true if the callback is invoked periodically, that is
+   *          if it was scheduled and not cancelled.
+   */
+  bool IsRunning (void) const;
+
+private:
+  friend class PeriodicEventGroup;
+
+  /**
+   * Construct a real identifier.
+   * \param [in] group The group of the callback.
+   * \param [in] uid The identifier of the callback in the group.
+   */
+  PeriodicEventId (const Ptr<PeriodicEventGroup> &group, uint32_t uid);
+
+  Ptr<PeriodicEventGroup> m_group;  //!< The group of the callback.
+  uint32_t m_uid;                   //!< The identifier of the callback in the group.
+};
+
+/**
+ * \ingroup events
+ * \brief Invoke periodic callbacks with the same period and phase from a
+ * single scheduler event.
+ *
+ * Models made of many devices often run the same periodic timer on each
+ * device, such as the LTE subframe of each eNB and UE, or the beacon of
+ * each Wi-Fi access point. Scheduling each one separately inserts and
+ * removes one event per device and per period in the scheduler, all for
+ * the same timestamps.
+ *
+ * Instead, the callbacks given to Schedule() with the same period, and
+ * first invocation times equal modulo this period, join one group. Each
+ * group schedules one event per period, which invokes the callbacks of
+ * the group in the order they were scheduled, each one with its own
+ * context as if it were an event scheduled with
+ * Simulator::ScheduleWithContext. A group schedules no event while it has
+ * no callbacks.
+ *
+ * The groups belong to the simulation, and are released by
+ * Simulator::Destroy.
+ */
+class PeriodicEventGroup : public SimpleRefCount<PeriodicEventGroup>
+{
+public:
+  /** A callback to add to a group with the batch version of Schedule. */
+  struct Member
+  {
+    uint32_t context;         //!< The context of the invocations.
+    Callback<void> callback;  //!< The callback to invoke.
+  };
+
+  /**
+   * Invoke a callback after a delay, then every period, until the
+   * returned identifier is cancelled.
+   *
+   * \param [in] delay The delay before the first invocation.
+   * \param [in] period The period of the invocations, strictly positive.
+   * \param [in] context The context of the invocations.
+   * \param [in] callback The callback to invoke.
+   * \returns The identifier of the periodic callback.
+   */
+  static PeriodicEventId Schedule (const Time &delay, const Time &period,
+                                   uint32_t context, const Callback<void> &callback);
+  /**
+   * Schedule a batch of callbacks with the same delay and period, with a
+   * single lookup of their group.
+   *
+   * \param [in] delay The delay before the first invocation.
+   * \param [in] period The period of the invocations, strictly positive.
+   * \param [in] members The callbacks to invoke and their contexts.
+   * \returns The identifiers of the periodic callbacks, in the order of
+   *          \pname{members}.
+   */
+  static std::vector<PeriodicEventId> Schedule (const Time &delay, const Time &period,
+                                                const std::vector<Member> &members);
+  /**
+   * Cancel a batch of periodic callbacks. The callbacks of a group are
+   * removed from it in a single pass.
+   *
+   * \param [in] ids The identifiers of the callbacks.
+   */
+  static void Cancel (const std::vector<PeriodicEventId> &ids);
+
+  /**
+   * Constructor, used by Schedule.
+   * \param [in] period The period of the group, in time steps.
+   */
+  PeriodicEventGroup (uint64_t period);
+  /** Destructor. Cancels the event of the group. */
+  ~PeriodicEventGroup ();
+
+  /** \returns The period of the group. */
+  Time GetPeriod (void) const;
+  /** \returns The number of callbacks invoked by the group. */
+  uint32_t GetN (void) const;
+
+private:
+  friend class PeriodicEventId;
+
+  /**
+   * Get the group of the current simulation for callbacks first invoked
+   * at \pname{start}, creating it if needed.
+   *
+   * \param [in] start The time step of the first invocation.
+   * \param [in] period The period, in time steps.
+   * \returns The group.
+   */
+  static Ptr<PeriodicEventGroup> Find (uint64_t start, uint64_t period);
+  /**
+   * Add a callback to the group.
+   *
+   * \param [in] start The time step of the first invocation.
+   * \param [in] context The context of the invocations.
+   * \param [in] callback The callback to invoke.
+   * \returns The identifier of the callback in the group.
+   */
+  uint32_t Add (uint64_t start, uint32_t context, const Callback<void> &callback);
+  /**
+   * Schedule the event of the group, if needed, so that it fires at
+   * \pname{start}.
+   *
+   * \param [in] start The time step of the first invocation of a new
+   *             callback.
+   */
+  void Arm (uint64_t start);
+  /**
+   * Stop invoking a callback. The slot of the callback is freed by Tidy.
+   * \param [in] uid The identifier of the callback in the group.
+   */
+  void Remove (uint32_t uid);
+  /**
+   * \param [in] uid The identifier of a callback in the group.
+   * \returns \c true if the callback is invoked by the group.
+   */
+  bool IsRunning (uint32_t uid) const;
+  /**
+   * Free the slots of the removed callbacks when they are the majority,
+   * and cancel the event of the group if it has no callbacks left.
+   */
+  void Tidy (void);
+  /** Invoke the callbacks and schedule the next period. */
+  void Fire (void);
+
+  /** A callback of the group. */
+  struct Slot
+  {
+    uint32_t uid;             //!< The identifier of the callback.
+    bool running;             //!< \c false once the callback is removed.
+    uint32_t context;         //!< The context of the invocations.
+    uint64_t start;           //!< The time step of the first invocation.
+    Callback<void> callback;  //!< The callback.
+  };
+
+  /**
+   * Find the slot of a callback.
+   * \param [in] uid The identifier of the callback in the group.
+   * \returns The index of the slot, or the number of slots if not found.
+   */
+  std::size_t FindSlot (uint32_t uid) const;
+
+  uint64_t m_period;           //!< The period, in time steps.
+  std::vector<Slot> m_slots;   //!< The callbacks, sorted by identifier.
+  uint32_t m_nRunning;         //!< The number of callbacks not removed.
+  uint32_t m_nextUid;          //!< The identifier of the next callback.
+  EventId m_event;             //!< The next event of the group.
+  uint64_t m_next;             //!< The time step of m_event.
+  bool m_firing;               //!< \c true while Fire invokes the callbacks.
+};
+
+} // namespace ns3
+
+#endif /* PERIODIC_EVENT_GROUP_H */
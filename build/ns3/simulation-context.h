@@ -0,0 +1,249 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Amiraslan Haghrah
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#ifndef SIMULATION_CONTEXT_H
+#define SIMULATION_CONTEXT_H
+
+#include "simple-ref-count.h"
+#include "non-copyable.h"
+#include "ptr.h"
+
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::SimulationContext and ns3::ContextLocal declarations and template
+ * implementation.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup simulator
+ * \brief The state of one simulation, bound to the threads running it.
+ *
+ * By default, a program runs one simulation at a time: the simulator
+ * implementation, the NodeList, the ChannelList, the Names, the Config
+ * root namespace, the SimulationSingleton instances and the RngSeedManager
+ * seed, run and stream counter are process-wide.
+ *
+ * A SimulationContext holds its own copy of all of them. While a context is
+ * bound to a thread (see SimulationContext::Scope), every access to them
+ * from this thread reaches the copy of the context, so independent
+ * simulations can run concurrently, one per thread:
+ *
+ * \code
+ *   void
+ *   RunReplica (uint32_t run)
+ *   {
+ *     SimulationContext::Scope scope (Create<SimulationContext> ());
+ *     RngSeedManager::SetRun (run);
+ *     // build the scenario, then
+ *     Simulator::Run ();
+ *   } // the simulation of the context is destroyed here
+ * \endcode
+ *
+ * What is not listed above is shared by all the contexts: the TypeId
+ * registry, the attribute defaults set by Config::SetDefault, the global
+ * values other than RngSeed and RngRun, and the logging configuration. They
+ * should be set up before starting the threads, and only read afterwards.
+ * Objects built before starting the threads (e.g., read-only tables) can be
+ * used by all the simulations, as long as they are not reference counted
+ * concurrently: the reference counts of ns-3 objects are not atomic.
+ *
+ * Models may bind their own process-wide state to the contexts with
+ * ContextLocal.
+ */
+class SimulationContext : public SimpleRefCount<SimulationContext>,
+                          private NonCopyable
+{
+public:
+  SimulationContext ();
+  /**
+   * Destroy the simulation of the context (see Simulator::Destroy) and
+   * then its ContextLocal variables, in the reverse order of their
+   * creation.
+   */
+  ~SimulationContext ();
+
+  /**
+   * \return the context bound to the calling thread, or 0 if the thread
+   *         uses the process-wide state
+   */
+  static SimulationContext * GetCurrent (void);
+
+  /**
+   * \brief Bind a context to the calling thread during the lifetime of the
+   *        scope.
+   *
+   * Scopes may be nested: the previous binding is restored on destruction.
+   * A context must not be bound to two threads at the same time.
+   */
+  class Scope : private NonCopyable
+  {
+  public:
+    /**
+     * \param context the context to bind to the calling thread
+     */
+    Scope (Ptr<SimulationContext> context);
+    ~Scope ();
+
+  private:
+    Ptr<SimulationContext> m_context;  //!< the bound context
+    SimulationContext *m_previous;     //!< the context bound before
+  };
+
+private:
+  template <typename T>
+  friend class ContextLocal;
+
+  /** Function destroying the value of a ContextLocal variable. */
+  typedef void (*Deleter)(void *value);
+
+  /** Value of one ContextLocal variable in a context. */
+  struct Slot
+  {
+    void *value;       //!< the value, 0 until it is first used
+    Deleter deleter;   //!< deletes the value
+  };
+
+  /**
+   * \return a new ContextLocal variable identifier
+   */
+  static uint32_t AllocateSlot (void);
+  /**
+   * \param id the identifier of a ContextLocal variable
+   * \return the value of the variable in this context, or 0 if it does not
+   *         exist yet
+   */
+  void * PeekSlot (uint32_t id) const;
+  /**
+   * \param id the identifier of a ContextLocal variable
+   * \param value the new value of the variable in this context
+   * \param deleter the function destroying the value
+   */
+  void SetSlot (uint32_t id, void *value, Deleter deleter);
+
+  std::vector<Slot> m_slots;   //!< values, indexed by variable identifier
+  std::vector<uint32_t> m_order;  //!< identifiers, in creation order
+
+  /** The context bound to each thread. */
+  static thread_local SimulationContext *m_current;
+};
+
+
+/**
+ * \ingroup simulator
+ * \brief A process-wide variable with one more value per SimulationContext.
+ *
+ * \tparam T \explicit the type of the variable, default constructible
+ *
+ * Get returns the value of the context bound to the calling thread,
+ * default constructed the first time it is used in this context, or the
+ * process-wide value if no context is bound. ContextLocal variables should
+ * be function local statics, so that they are constructed before their
+ * first use:
+ *
+ * \code
+ *   static Ptr<MyRegistry> *
+ *   PeekRegistry (void)
+ *   {
+ *     static ContextLocal<Ptr<MyRegistry> > registry;
+ *     return &registry.Get ();
+ *   }
+ * \endcode
+ */
+template <typename T>
+class ContextLocal : private NonCopyable
+{
+public:
+  ContextLocal ();
+
+  /**
+   * \return the value of the variable in the context bound to the calling
+   *         thread
+   */
+  T & Get (void);
+
+private:
+  /**
+   * \param value the value to delete
+   */
+  static void Delete (void *value);
+
+  uint32_t m_id;   //!< identifier of the variable in the contexts
+  T m_default;     //!< the process-wide value
+};
+
+} // namespace ns3
+
+
+/********************************************************************
+ *  Implementation of the templates declared above.
+ ********************************************************************/
+
+namespace ns3 {
+
+inline SimulationContext *
+SimulationContext::GetCurrent (void)
+{
+  return m_current;
+}
+
+inline void *
+SimulationContext::PeekSlot (uint32_t id) const
+{
+  return (id < m_slots.size ()) ? m_slots[id].value : 0;
+}
+
+template <typename T>
+ContextLocal<T>::ContextLocal ()
+  : m_id (SimulationContext::AllocateSlot ()),
+    m_default ()
+{}
+
+template <typename T>
+T &
+ContextLocal<T>::Get (void)
+{
+  SimulationContext *context = SimulationContext::GetCurrent ();
+  if (context == 0)
+    {
+      return m_default;
+    }
+  void *value = context->PeekSlot (m_id);
+  if (value == 0)
+    {
+      value = new T ();
+      context->SetSlot (m_id, value, &ContextLocal<T>::Delete);
+    }
+  return *static_cast<T *> (value);
+}
+
+template <typename T>
+void
+ContextLocal<T>::Delete (void *value)
+{
+  delete static_cast<T *> (value);
+}
+
+} // namespace ns3
+
+#endif /* SIMULATION_CONTEXT_H */
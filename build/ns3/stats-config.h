@@ -0,0 +1,14 @@
+/* WARNING! All changes made to this file will be lost! */
+
+#ifndef W_NS3_STATS_CONFIG_H_WAF
+#define W_NS3_STATS_CONFIG_H_WAF
+
+#define HAVE_SYS_IOCTL_H 1
+#define HAVE_IF_NETS_H 1
+#define HAVE_NET_ETHERNET_H 1
+#define HAVE_IF_TUN_H 1
+#define HAVE_PACKET_H 1
+#define HAVE_SQLITE3 1
+#define HAVE_SEMAPHORE_H 1
+
+#endif /* W_NS3_STATS_CONFIG_H_WAF */
@@ -1,24 +1,10 @@
 #!/bin/bash
 ./waf
-for seed in 6557 6688 8481 4198 2697 8559 1065 4754 2587 5501
-do
-    for speed in 80 70 60 50 40 30 20 10
-    do
-        # for type in 4 #3 2 1 0
-        # do
-        #     echo "seed: $seed, speed: $speed, type: $type"
-        #     ./waf --run "fuzzyH $seed $type $speed"                      
-        # done
-
-        echo "seed: $seed, speed: $speed"
-        ./waf --run "fuzzyH $seed 0 $speed" &
-        ./waf --run "fuzzyH $seed 1 $speed" &         
-        ./waf --run "fuzzyH $seed 2 $speed" &           
-        ./waf --run "fuzzyH $seed 3 $speed" &           
-        ./waf --run "fuzzyH $seed 4 $speed" & 
-        
-        wait
-    done
-done
-
-
+# the fuzzy decision tables are built by the first run and reused by the others
+mkdir -p output
+# every seed x speed x type replica runs from a single fuzzyH program, one
+# replica per processor; the handover statistics of the replicas are
+# collected in output/sweep.csv
+./waf --run "fuzzyH --sweep --useLookupTable=1 \
+    --seeds=6557,6688,8481,4198,2697,8559,1065,4754,2587,5501 \
+    --speeds=80,70,60,50,40,30,20,10 --types=0,1,2,3,4"
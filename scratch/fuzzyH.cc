@@ -37,15 +37,6 @@
 #include <iostream>
 #include <string>
 
-#ifdef _DEBUG
-    #undef _DEBUG
-    #include <python.h>
-    #define _DEBUG
-#else
-    #include <Python.h>    
-#endif
-
-PyObject* pName, * pModule, * pDict, * pClass, * pInstance;
 int handoverType = 0;
 
 using namespace ns3;
@@ -60,6 +51,9 @@ std::ofstream osHandoverStartUe;
 std::ofstream osHandoverEndOkUe;
 std::ofstream osRadioLinkFailure;
 
+uint32_t handoverCount = 0;
+uint32_t radioLinkFailureCount = 0;
+
 void
 NotifyConnectionEstablishedUe (std::string context,
                                uint64_t imsi,
@@ -108,6 +102,7 @@ NotifyHandoverEndOkUe (std::string context,
             << std::endl;
   
   osHandoverEndOkUe << Simulator::Now() << "," << imsi << "," << cellid << "," << rnti << "," << context << std::endl;
+  ++handoverCount;
 }
 
 void
@@ -122,14 +117,6 @@ NotifyConnectionEstablishedEnb (std::string context,
             << ": successful connection of UE with IMSI " << imsi
             << " RNTI " << rnti
             << std::endl;
-  if (handoverType == 3 || handoverType == 4)
-  {
-    PyObject_CallMethod ( pInstance, "UpdateServingCellId", "(diii)", 
-                          Simulator::Now ().GetSeconds(), 
-                          imsi, 
-                          cellid, 
-                          rnti);
-  }
   osConnectionEstablishedEnb << Simulator::Now() << "," << cellid << "," << imsi << "," << rnti << "," << context  << std::endl;
 }
 
@@ -164,14 +151,6 @@ NotifyHandoverEndOkEnb (std::string context,
             << " RNTI " << rnti
             << std::endl;
 
-  if (handoverType == 3 || handoverType == 4)
-  {
-    PyObject_CallMethod ( pInstance, "UpdateServingCellId", "(diii)", 
-                          Simulator::Now ().GetSeconds(), 
-                          imsi, 
-                          cellid, 
-                          rnti);
-  }
   osHandoverEndOkEnb << Simulator::Now() << "," << cellid << "," << imsi << "," << rnti << "," << context << std::endl;
 }
 
@@ -191,6 +170,7 @@ NotifyRadioLinkFailure (std::string context,
             << std::endl;  
 
   osRadioLinkFailure << Simulator::Now() << "," << imsi << "," << cellid << "," << rnti << "," << context << std::endl;
+  ++radioLinkFailureCount;
 }
 
 void 
@@ -272,50 +252,22 @@ SaveUeInitialPosition ( NodeContainer nodes,
 
 
 
-int
-main (int argc, char *argv[])
-{  
-  CommandLine cmd;
-  cmd.Parse (argc, argv);
+/**
+ * Build and run one scenario, logging in output/<speed>/<type>/<seed>/.
+ */
+void
+RunScenario (int seed, int type, int speed, bool useLookupTable)
+{
+  handoverCount = 0;
+  radioLinkFailureCount = 0;
 
-  srand (time(NULL));
-  // uint64_t seed = rand () % 10000;
-  int seed;
-  seed = std::atoi(argv[1]);
   std::cout << "Simulation random seed: " << seed << std::endl;
   RngSeedManager::SetSeed (seed + 1);  
   
-      handoverType = std::atoi(argv[2]);
-  int speed = std::atoi(argv[3]);
+  handoverType = type;
   int speedMin = speed - 5;
   int speedMax = speed + 5;
  
-  if (handoverType == 3 || handoverType == 4)
-  {
-    setenv("PYTHONPATH", "/mnt/data/Ph.D./ns-3/ns-3-dev/src/lte/model/fuzzy/", 1);
-
-    Py_Initialize();
-
-    if (handoverType == 3)
-    {
-      pName = PyUnicode_FromString("type1fuzzy");
-    }
-    else if (handoverType == 4)
-    {
-      pName = PyUnicode_FromString("type2fuzzy");
-    }
-    pModule = PyImport_Import(pName);
-    pDict = PyModule_GetDict(pModule);
-
-    // Build the name of a callable class 
-    pClass = PyDict_GetItemString(pDict, "FuzzyHandover");
-
-    // Create an instance of the class
-    if (PyCallable_Check(pClass)) {
-        pInstance = PyObject_CallObject(pClass, NULL);
-    }
-  }
-
   char path[256] = "output/";
   char* speedStr = new char[std::to_string(speed).length() + 1];
   strcpy(speedStr, std::to_string(speed).c_str());
@@ -475,10 +427,18 @@ main (int argc, char *argv[])
   else if (handoverType == 3)
     {
       lteHelper->SetHandoverAlgorithmType ("ns3::Type1FuzzyHandoverAlgorithm");
+      lteHelper->SetHandoverAlgorithmAttribute ("UseLookupTable",
+                                                BooleanValue (useLookupTable));
+      lteHelper->SetHandoverAlgorithmAttribute ("LookupTableFile",
+                                                StringValue ("output/fuzzy-type1.table"));
     }
   else if (handoverType == 4)
     {
       lteHelper->SetHandoverAlgorithmType ("ns3::Type2FuzzyHandoverAlgorithm");
+      lteHelper->SetHandoverAlgorithmAttribute ("UseLookupTable",
+                                                BooleanValue (useLookupTable));
+      lteHelper->SetHandoverAlgorithmAttribute ("LookupTableFile",
+                                                StringValue ("output/fuzzy-type2.table"));
     }
 
   Ptr<Node> pgw = epcHelper->GetPgwNode ();
@@ -760,11 +720,69 @@ main (int argc, char *argv[])
 
   Simulator::Run ();
   Simulator::Destroy ();
-  if (handoverType == 3 || handoverType == 4)
-  {
-    // Clean up
-    Py_DECREF(pName);
-    Py_Finalize();
-  }
+}
+
+bool sweepUseLookupTable = false;
+
+/**
+ * Run one replica of the sweep and report its handover statistics.
+ */
+void
+RunReplica (ParameterSweep::Replica &replica)
+{
+  RunScenario (replica.GetSeed (), replica.GetInteger ("type"),
+               replica.GetInteger ("speed"), sweepUseLookupTable);
+  replica.Report ("handovers", handoverCount);
+  replica.Report ("radioLinkFailures", radioLinkFailureCount);
+}
+
+
+int
+main (int argc, char *argv[])
+{  
+  bool useLookupTable = false;
+  bool sweep = false;
+  std::string seeds = "6557,6688,8481,4198,2697,8559,1065,4754,2587,5501";
+  std::string speeds = "80,70,60,50,40,30,20,10";
+  std::string types = "0,1,2,3,4";
+  uint32_t workers = 0;
+  std::string sweepOutput = "output/sweep.csv";
+  CommandLine cmd;
+  cmd.AddValue ("useLookupTable",
+                "Interpolate the fuzzy handover decisions from tables shared "
+                "by all runs (saved in output/)",
+                useLookupTable);
+  cmd.AddValue ("sweep",
+                "Run the seeds x speeds x types grid from this program "
+                "instead of the single scenario given by the arguments "
+                "<seed> <type> <speed>",
+                sweep);
+  cmd.AddValue ("seeds", "Comma separated seeds of the sweep", seeds);
+  cmd.AddValue ("speeds", "Comma separated UE speeds of the sweep", speeds);
+  cmd.AddValue ("types", "Comma separated handover types of the sweep", types);
+  cmd.AddValue ("workers",
+                "Number of concurrent replicas of the sweep, 0 for one per processor",
+                workers);
+  cmd.AddValue ("sweepOutput", "File receiving the results of the sweep", sweepOutput);
+  cmd.Parse (argc, argv);
+
+  if (sweep)
+    {
+      mkdir ("output", S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH);
+      sweepUseLookupTable = useLookupTable;
+      ParameterSweep parameterSweep;
+      parameterSweep.SetSeeds (seeds);
+      parameterSweep.AddParameter ("speed", speeds);
+      parameterSweep.AddParameter ("type", types);
+      parameterSweep.SetWorkers (workers);
+      std::ofstream os (sweepOutput.c_str ());
+      uint32_t failed = parameterSweep.Run (MakeCallback (&RunReplica), os);
+      std::cout << parameterSweep.GetNReplicas () << " replicas, " << failed
+                << " failed, results in " << sweepOutput << std::endl;
+      return failed == 0 ? 0 : 1;
+    }
+
+  RunScenario (std::atoi (argv[1]), std::atoi (argv[2]), std::atoi (argv[3]),
+               useLookupTable);
   return 0;
 }
@@ -0,0 +1,141 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Amiraslan Haghrah
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/core-module.h"
+
+#include <list>
+
+/**
+ * \file
+ * \ingroup core-examples
+ * \ingroup core-helpers
+ * Example of a seed x parameter sweep run from one program.
+ *
+ * Each replica simulates a single server queue with exponential
+ * inter-arrival and service times, and reports the mean sojourn time of
+ * the customers. The table of results is written on the standard output.
+ *
+ * \code
+ *   ./waf --run "parameter-sweep-example --seeds=1,2,3 --loads=0.5,0.9 --replicas=4"
+ * \endcode
+ */
+
+using namespace ns3;
+
+namespace {
+
+/** Mean service time of the queue, in seconds. */
+const double SERVICE_TIME = 1.0;
+
+/** State of the queue of a replica. */
+struct Queue
+{
+  Ptr<ExponentialRandomVariable> arrival;  //!< inter-arrival times
+  Ptr<ExponentialRandomVariable> service;  //!< service times
+  std::list<Time> waiting;                 //!< arrival times of the customers
+  uint32_t served;                         //!< number of customers served
+  Time sojourn;                            //!< total sojourn time
+  Time end;                                //!< end of the arrivals
+};
+
+void Depart (Queue *queue);
+
+/**
+ * A customer arrives.
+ * \param queue the queue
+ */
+void
+Arrive (Queue *queue)
+{
+  queue->waiting.push_back (Simulator::Now ());
+  if (queue->waiting.size () == 1)
+    {
+      Simulator::Schedule (Seconds (queue->service->GetValue ()), &Depart, queue);
+    }
+  if (Simulator::Now () < queue->end)
+    {
+      Simulator::Schedule (Seconds (queue->arrival->GetValue ()), &Arrive, queue);
+    }
+}
+
+/**
+ * The customer at the head of the queue departs.
+ * \param queue the queue
+ */
+void
+Depart (Queue *queue)
+{
+  queue->sojourn += Simulator::Now () - queue->waiting.front ();
+  queue->waiting.pop_front ();
+  ++queue->served;
+  if (!queue->waiting.empty ())
+    {
+      Simulator::Schedule (Seconds (queue->service->GetValue ()), &Depart, queue);
+    }
+}
+
+/**
+ * Run one replica.
+ * \param replica the replica
+ */
+void
+RunReplica (ParameterSweep::Replica &replica)
+{
+  Queue queue;
+  queue.arrival = CreateObject<ExponentialRandomVariable> ();
+  queue.arrival->SetAttribute ("Mean", DoubleValue (SERVICE_TIME / replica.GetDouble ("load")));
+  queue.service = CreateObject<ExponentialRandomVariable> ();
+  queue.service->SetAttribute ("Mean", DoubleValue (SERVICE_TIME));
+  queue.served = 0;
+  queue.end = Seconds (10000);
+
+  Simulator::ScheduleNow (&Arrive, &queue);
+  Simulator::Run ();
+
+  replica.Report ("served", queue.served);
+  replica.Report ("sojourn", queue.sojourn.GetSeconds () / queue.served);
+}
+
+} // unnamed namespace
+
+
+int
+main (int argc, char *argv[])
+{
+  std::string seeds = "1,2";
+  std::string loads = "0.5,0.7,0.9";
+  uint32_t replicas = 2;
+  uint32_t workers = 0;
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("seeds", "Comma separated seeds", seeds);
+  cmd.AddValue ("loads", "Comma separated loads of the queue", loads);
+  cmd.AddValue ("replicas", "Number of runs per seed and load", replicas);
+  cmd.AddValue ("workers", "Number of concurrent replicas, 0 for one per processor", workers);
+  cmd.Parse (argc, argv);
+
+  ParameterSweep sweep;
+  sweep.SetSeeds (seeds);
+  sweep.AddParameter ("load", loads);
+  sweep.SetReplicas (replicas);
+  sweep.SetWorkers (workers);
+  uint32_t failed = sweep.Run (MakeCallback (&RunReplica), std::cout);
+
+  return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,506 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Amiraslan Haghrah
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "parameter-sweep.h"
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/abort.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/**
+ * \file
+ * \ingroup core-helpers
+ * ns3::ParameterSweep implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("ParameterSweep");
+
+namespace {
+
+/**
+ * \ingroup core-helpers
+ * \param list a comma separated list
+ * \return the items of the list, without surrounding blanks
+ */
+std::vector<std::string>
+SplitList (std::string list)
+{
+  std::vector<std::string> items;
+  std::istringstream iss (list);
+  std::string item;
+  while (std::getline (iss, item, ','))
+    {
+      std::string::size_type first = item.find_first_not_of (" \t");
+      std::string::size_type last = item.find_last_not_of (" \t");
+      if (first != std::string::npos)
+        {
+          items.push_back (item.substr (first, last - first + 1));
+        }
+    }
+  return items;
+}
+
+/**
+ * \ingroup core-helpers
+ * \param s a column name or a value
+ * \return s, with the characters used by the result pipe and by the table
+ *         replaced by blanks
+ */
+std::string
+Sanitize (std::string s)
+{
+  std::replace (s.begin (), s.end (), '\t', ' ');
+  std::replace (s.begin (), s.end (), '\n', ' ');
+  std::replace (s.begin (), s.end (), ',', ' ');
+  return s;
+}
+
+/**
+ * \ingroup core-helpers
+ * \brief Write a whole buffer to a file descriptor.
+ * \param fd the file descriptor
+ * \param data the buffer
+ * \return true on success
+ */
+bool
+WriteAll (int fd, const std::string &data)
+{
+  std::string::size_type written = 0;
+  while (written < data.size ())
+    {
+      ssize_t n = write (fd, data.data () + written, data.size () - written);
+      if (n < 0 && errno == EINTR)
+        {
+          continue;
+        }
+      if (n <= 0)
+        {
+          return false;
+        }
+      written += n;
+    }
+  return true;
+}
+
+} // unnamed namespace
+
+
+uint32_t
+ParameterSweep::Replica::GetIndex (void) const
+{
+  return m_index;
+}
+
+uint32_t
+ParameterSweep::Replica::GetSeed (void) const
+{
+  return m_seed;
+}
+
+uint64_t
+ParameterSweep::Replica::GetRun (void) const
+{
+  return m_run;
+}
+
+std::string
+ParameterSweep::Replica::Get (std::string name) const
+{
+  for (std::vector<std::pair<std::string, std::string> >::const_iterator it = m_parameters.begin ();
+       it != m_parameters.end (); ++it)
+    {
+      if (it->first == name)
+        {
+          return it->second;
+        }
+    }
+  NS_FATAL_ERROR ("Unknown sweep parameter \"" << name << "\"");
+  return "";
+}
+
+double
+ParameterSweep::Replica::GetDouble (std::string name) const
+{
+  std::istringstream iss (Get (name));
+  double value;
+  iss >> value;
+  NS_ABORT_MSG_IF (iss.fail () || !iss.eof (),
+                   "Sweep parameter \"" << name << "\" is not a number: " << Get (name));
+  return value;
+}
+
+int64_t
+ParameterSweep::Replica::GetInteger (std::string name) const
+{
+  std::istringstream iss (Get (name));
+  int64_t value;
+  iss >> value;
+  NS_ABORT_MSG_IF (iss.fail () || !iss.eof (),
+                   "Sweep parameter \"" << name << "\" is not an integer: " << Get (name));
+  return value;
+}
+
+void
+ParameterSweep::Replica::Report (std::string column, std::string value)
+{
+  NS_LOG_FUNCTION (this << column << value);
+  column = Sanitize (column);
+  value = Sanitize (value);
+  for (std::vector<std::pair<std::string, std::string> >::iterator it = m_results.begin ();
+       it != m_results.end (); ++it)
+    {
+      if (it->first == column)
+        {
+          it->second = value;
+          return;
+        }
+    }
+  m_results.push_back (std::make_pair (column, value));
+}
+
+void
+ParameterSweep::Replica::Report (std::string column, double value)
+{
+  std::ostringstream oss;
+  oss << std::setprecision (15) << value;
+  Report (column, oss.str ());
+}
+
+
+ParameterSweep::ParameterSweep ()
+  : m_replicas (1),
+    m_workers (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+ParameterSweep::AddParameter (std::string name, const std::vector<std::string> &values)
+{
+  NS_LOG_FUNCTION (this << name << values.size ());
+  NS_ABORT_MSG_IF (values.empty (), "Sweep parameter \"" << name << "\" has no value");
+  for (std::vector<std::pair<std::string, std::vector<std::string> > >::const_iterator it = m_parameters.begin ();
+       it != m_parameters.end (); ++it)
+    {
+      NS_ABORT_MSG_IF (it->first == name, "Sweep parameter \"" << name << "\" added twice");
+    }
+  std::vector<std::string> sanitized;
+  for (std::vector<std::string>::const_iterator it = values.begin (); it != values.end (); ++it)
+    {
+      sanitized.push_back (Sanitize (*it));
+    }
+  m_parameters.push_back (std::make_pair (Sanitize (name), sanitized));
+}
+
+void
+ParameterSweep::AddParameter (std::string name, std::string values)
+{
+  AddParameter (name, SplitList (values));
+}
+
+void
+ParameterSweep::SetSeeds (const std::vector<uint32_t> &seeds)
+{
+  NS_LOG_FUNCTION (this << seeds.size ());
+  m_seeds = seeds;
+}
+
+void
+ParameterSweep::SetSeeds (std::string seeds)
+{
+  NS_LOG_FUNCTION (this << seeds);
+  std::vector<uint32_t> values;
+  std::vector<std::string> items = SplitList (seeds);
+  for (std::vector<std::string>::const_iterator it = items.begin (); it != items.end (); ++it)
+    {
+      std::istringstream iss (*it);
+      uint32_t seed;
+      iss >> seed;
+      NS_ABORT_MSG_IF (iss.fail () || !iss.eof () || seed == 0, "Invalid seed: " << *it);
+      values.push_back (seed);
+    }
+  SetSeeds (values);
+}
+
+void
+ParameterSweep::SetReplicas (uint32_t replicas)
+{
+  NS_LOG_FUNCTION (this << replicas);
+  NS_ABORT_MSG_IF (replicas == 0, "A sweep needs at least one replica per point");
+  m_replicas = replicas;
+}
+
+void
+ParameterSweep::SetWorkers (uint32_t workers)
+{
+  NS_LOG_FUNCTION (this << workers);
+  m_workers = workers;
+}
+
+uint32_t
+ParameterSweep::GetNReplicas (void) const
+{
+  uint32_t n = std::max<uint32_t> (m_seeds.size (), 1) * m_replicas;
+  for (std::vector<std::pair<std::string, std::vector<std::string> > >::const_iterator it = m_parameters.begin ();
+       it != m_parameters.end (); ++it)
+    {
+      n *= it->second.size ();
+    }
+  return n;
+}
+
+ParameterSweep::Replica
+ParameterSweep::MakeReplica (uint32_t index) const
+{
+  Replica replica;
+  replica.m_index = index;
+  replica.m_ok = false;
+
+  // the run number varies fastest, then the last parameter, ..., the seed
+  uint32_t rest = index;
+  replica.m_run = rest % m_replicas + 1;
+  rest /= m_replicas;
+  std::vector<std::pair<std::string, std::string> > parameters (m_parameters.size ());
+  for (uint32_t i = m_parameters.size (); i > 0; --i)
+    {
+      const std::vector<std::string> &values = m_parameters[i - 1].second;
+      parameters[i - 1] = std::make_pair (m_parameters[i - 1].first, values[rest % values.size ()]);
+      rest /= values.size ();
+    }
+  replica.m_parameters = parameters;
+  replica.m_seed = m_seeds.empty () ? RngSeedManager::GetSeed () : m_seeds.at (rest);
+  return replica;
+}
+
+uint32_t
+ParameterSweep::Run (ReplicaCallback callback, std::ostream &os)
+{
+  NS_LOG_FUNCTION (this);
+  std::vector<Replica> replicas;
+  for (uint32_t i = 0; i < GetNReplicas (); ++i)
+    {
+      replicas.push_back (MakeReplica (i));
+    }
+
+  RunProcesses (callback, replicas);
+
+  WriteTable (replicas, os);
+  uint32_t failed = 0;
+  for (std::vector<Replica>::const_iterator it = replicas.begin (); it != replicas.end (); ++it)
+    {
+      if (!it->m_ok)
+        {
+          NS_LOG_WARN ("replica " << it->m_index << " failed");
+          ++failed;
+        }
+    }
+  return failed;
+}
+
+void
+ParameterSweep::RunProcesses (ReplicaCallback callback, std::vector<Replica> &replicas) const
+{
+  NS_LOG_FUNCTION (this << replicas.size ());
+
+  uint32_t workers = m_workers;
+  if (workers == 0)
+    {
+      long cpus = sysconf (_SC_NPROCESSORS_ONLN);
+      workers = (cpus > 0) ? cpus : 1;
+    }
+
+  /// A replica running in a child process
+  struct Child
+  {
+    pid_t pid;          //!< child process
+    int fd;             //!< read end of the result pipe
+    uint32_t index;     //!< index of the replica
+    std::string output; //!< results received so far
+  };
+  std::vector<Child> children;
+  uint32_t next = 0;
+
+  while (next < replicas.size () || !children.empty ())
+    {
+      while (next < replicas.size () && children.size () < workers)
+        {
+          int fds[2];
+          NS_ABORT_MSG_IF (pipe (fds) != 0, "pipe failed: " << std::strerror (errno));
+          // do not let the child flush what the parent buffered
+          std::cout.flush ();
+          std::cerr.flush ();
+          pid_t pid = fork ();
+          NS_ABORT_MSG_IF (pid < 0, "fork failed: " << std::strerror (errno));
+          if (pid == 0)
+            {
+              close (fds[0]);
+              Replica &replica = replicas[next];
+              RngSeedManager::SetSeed (replica.m_seed);
+              RngSeedManager::SetRun (replica.m_run);
+              callback (replica);
+              Simulator::Destroy ();
+              std::cout.flush ();
+              std::cerr.flush ();
+
+              std::ostringstream oss;
+              for (std::vector<std::pair<std::string, std::string> >::const_iterator it = replica.m_results.begin ();
+                   it != replica.m_results.end (); ++it)
+                {
+                  oss << it->first << "\t" << it->second << "\n";
+                }
+              bool ok = WriteAll (fds[1], oss.str ());
+              close (fds[1]);
+              // skip the destructors of the state shared with the parent
+              _exit (ok ? 0 : 1);
+            }
+          close (fds[1]);
+          NS_LOG_LOGIC ("replica " << next << " started, pid " << pid);
+          Child child;
+          child.pid = pid;
+          child.fd = fds[0];
+          child.index = next;
+          children.push_back (child);
+          ++next;
+        }
+
+      std::vector<struct pollfd> pfds (children.size ());
+      for (uint32_t i = 0; i < children.size (); ++i)
+        {
+          pfds[i].fd = children[i].fd;
+          pfds[i].events = POLLIN;
+          pfds[i].revents = 0;
+        }
+      if (poll (&pfds[0], pfds.size (), -1) < 0)
+        {
+          NS_ABORT_MSG_IF (errno != EINTR, "poll failed: " << std::strerror (errno));
+          continue;
+        }
+
+      for (uint32_t i = children.size (); i > 0; --i)
+        {
+          Child &child = children[i - 1];
+          if (pfds[i - 1].revents == 0)
+            {
+              continue;
+            }
+          char buffer[4096];
+          ssize_t n = read (child.fd, buffer, sizeof (buffer));
+          if (n > 0)
+            {
+              child.output.append (buffer, n);
+              continue;
+            }
+          if (n < 0 && errno == EINTR)
+            {
+              continue;
+            }
+
+          // end of the results: the child is exiting
+          close (child.fd);
+          int status = 0;
+          while (waitpid (child.pid, &status, 0) < 0 && errno == EINTR)
+            {
+            }
+          Replica &replica = replicas[child.index];
+          replica.m_ok = WIFEXITED (status) && WEXITSTATUS (status) == 0;
+          std::istringstream iss (child.output);
+          std::string line;
+          while (std::getline (iss, line))
+            {
+              std::string::size_type tab = line.find ('\t');
+              if (tab != std::string::npos)
+                {
+                  replica.Report (line.substr (0, tab), line.substr (tab + 1));
+                }
+            }
+          NS_LOG_LOGIC ("replica " << child.index << (replica.m_ok ? " completed" : " failed"));
+          children.erase (children.begin () + (i - 1));
+        }
+    }
+}
+
+void
+ParameterSweep::WriteTable (const std::vector<Replica> &replicas, std::ostream &os) const
+{
+  NS_LOG_FUNCTION (this);
+
+  // result columns, in the order they were first reported
+  std::vector<std::string> columns;
+  for (std::vector<Replica>::const_iterator r = replicas.begin (); r != replicas.end (); ++r)
+    {
+      for (std::vector<std::pair<std::string, std::string> >::const_iterator it = r->m_results.begin ();
+           it != r->m_results.end (); ++it)
+        {
+          if (std::find (columns.begin (), columns.end (), it->first) == columns.end ())
+            {
+              columns.push_back (it->first);
+            }
+        }
+    }
+
+  os << "replica,seed,run,status";
+  for (std::vector<std::pair<std::string, std::vector<std::string> > >::const_iterator it = m_parameters.begin ();
+       it != m_parameters.end (); ++it)
+    {
+      os << "," << it->first;
+    }
+  for (std::vector<std::string>::const_iterator it = columns.begin (); it != columns.end (); ++it)
+    {
+      os << "," << *it;
+    }
+  os << std::endl;
+
+  for (std::vector<Replica>::const_iterator r = replicas.begin (); r != replicas.end (); ++r)
+    {
+      os << r->m_index << "," << r->m_seed << "," << r->m_run << ","
+         << (r->m_ok ? "ok" : "failed");
+      for (std::vector<std::pair<std::string, std::string> >::const_iterator it = r->m_parameters.begin ();
+           it != r->m_parameters.end (); ++it)
+        {
+          os << "," << it->second;
+        }
+      std::map<std::string, std::string> results (r->m_results.begin (), r->m_results.end ());
+      for (std::vector<std::string>::const_iterator it = columns.begin (); it != columns.end (); ++it)
+        {
+          os << ",";
+          std::map<std::string, std::string>::const_iterator result = results.find (*it);
+          if (result != results.end ())
+            {
+              os << result->second;
+            }
+        }
+      os << std::endl;
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Amiraslan Haghrah
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#include "attribute-handle.h"
+#include "abort.h"
+#include "log.h"
+#include <typeinfo>
+
+/**
+ * \file
+ * \ingroup attribute
+ * ns3::AttributeHandleBase implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("AttributeHandle");
+
+AttributeHandleBase::AttributeHandleBase ()
+  : m_settable (false),
+    m_gettable (false)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+AttributeHandleBase::AttributeHandleBase (TypeId tid, std::string name,
+                                          const AttributeValue &probe, bool failSafe)
+  : m_tid (tid),
+    m_name (name),
+    m_settable (false),
+    m_gettable (false)
+{
+  NS_LOG_FUNCTION (this << tid.GetName () << name << &probe << failSafe);
+  struct TypeId::AttributeInformation info;
+  if (!tid.LookupAttributeByName (name, &info))
+    {
+      NS_ABORT_MSG_IF (!failSafe, "Attribute name=" << name << " does not exist for tid=" << tid.GetName ());
+      return;
+    }
+  // The values created by the checker tell the value type of the attribute.
+  Ptr<AttributeValue> value = info.checker->Create ();
+  if (typeid (*PeekPointer (value)) != typeid (probe))
+    {
+      NS_ABORT_MSG_IF (!failSafe, "Attribute name=" << name << " tid=" << tid.GetName () <<
+                       " does not hold values of the handle type");
+      return;
+    }
+  m_accessor = info.accessor;
+  m_checker = info.checker;
+  m_settable = (info.flags & TypeId::ATTR_SET) && info.accessor->HasSetter ();
+  m_gettable = (info.flags & TypeId::ATTR_GET) && info.accessor->HasGetter ();
+}
+
+bool
+AttributeHandleBase::IsValid (void) const
+{
+  return m_accessor != 0;
+}
+
+TypeId
+AttributeHandleBase::GetTypeId (void) const
+{
+  return m_tid;
+}
+
+std::string
+AttributeHandleBase::GetName (void) const
+{
+  return m_name;
+}
+
+bool
+AttributeHandleBase::CanAccess (const ObjectBase *object, bool set) const
+{
+  if (!(set ? m_settable : m_gettable))
+    {
+      return false;
+    }
+  NS_ASSERT_MSG (object->GetInstanceTypeId () == m_tid
+                 || object->GetInstanceTypeId ().IsChildOf (m_tid),
+                 "Attribute name=" << m_name << " of tid=" << m_tid.GetName () <<
+                 " used on an object of tid=" << object->GetInstanceTypeId ().GetName ());
+  return true;
+}
+
+void
+AttributeHandleBase::Fail (const ObjectBase *object, std::string what) const
+{
+  NS_FATAL_ERROR ("Attribute name=" << m_name << " " << what << " for this object: tid=" <<
+                  (IsValid () ? object->GetInstanceTypeId ().GetName () : m_tid.GetName ()));
+}
+
+} // namespace ns3
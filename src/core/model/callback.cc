@@ -20,6 +20,7 @@
 
 #include "callback.h"
 #include "log.h"
+#include "pool-allocator.h"
 
 /**
  * \file
@@ -73,6 +74,67 @@ CallbackValue::DeserializeFromString (std::string value, Ptr<const AttributeChec
 
 ATTRIBUTE_CHECKER_IMPLEMENT (Callback);
 
+/**
+ * \ingroup callbackimpl
+ * The memory of a CallbackImpl of up to \p N bytes, the unit of a
+ * PoolAllocator free list.
+ * \tparam N \explicit The size class.
+ */
+template <std::size_t N>
+struct CallbackImplStorage
+{
+  char data[N];  //!< The CallbackImpl.
+};
+
+void *
+CallbackImplBase::operator new (std::size_t size)
+{
+  // Function pointers take 24 bytes, member functions of an object 40,
+  // and bound arguments add their size.
+  if (size <= 32)
+    {
+      return PoolAllocator<CallbackImplStorage<32> >::Allocate (32);
+    }
+  else if (size <= 48)
+    {
+      return PoolAllocator<CallbackImplStorage<48> >::Allocate (48);
+    }
+  else if (size <= 64)
+    {
+      return PoolAllocator<CallbackImplStorage<64> >::Allocate (64);
+    }
+  else if (size <= 96)
+    {
+      return PoolAllocator<CallbackImplStorage<96> >::Allocate (96);
+    }
+  return ::operator new (size);
+}
+
+void
+CallbackImplBase::operator delete (void *p, std::size_t size)
+{
+  if (size <= 32)
+    {
+      PoolAllocator<CallbackImplStorage<32> >::Deallocate (p, 32);
+    }
+  else if (size <= 48)
+    {
+      PoolAllocator<CallbackImplStorage<48> >::Deallocate (p, 48);
+    }
+  else if (size <= 64)
+    {
+      PoolAllocator<CallbackImplStorage<64> >::Deallocate (p, 64);
+    }
+  else if (size <= 96)
+    {
+      PoolAllocator<CallbackImplStorage<96> >::Deallocate (p, 96);
+    }
+  else
+    {
+      ::operator delete (p);
+    }
+}
+
 } // namespace ns3
 
 #if (__GNUC__ >= 3)
@@ -28,6 +28,7 @@
 #include "attribute.h"
 #include "attribute-helper.h"
 #include "simple-ref-count.h"
+#include <cstddef>
 #include <typeinfo>
 
 /**
@@ -123,7 +124,42 @@ public:
    */
   virtual std::string GetTypeid (void) const = 0;
 
+  /**
+   * Allocate a CallbackImpl.  A CallbackImpl is made for each
+   * MakeCallback and each Bind, so the small ones are recycled through
+   * per-thread free lists of a few sizes, see PoolAllocator.
+   *
+   * \param [in] size The size of the CallbackImpl.
+   * \returns The memory of the CallbackImpl.
+   */
+  static void * operator new (std::size_t size);
+  /**
+   * Release a CallbackImpl to the free list of its size.
+   *
+   * \param [in] p The memory of the CallbackImpl.
+   * \param [in] size The size of the CallbackImpl.
+   */
+  static void operator delete (void *p, std::size_t size);
+
 protected:
+  /**
+   * Cast another CallbackImpl to the type of this one, for IsEqual.
+   * Comparing the dynamic types is cheaper than a dynamic_cast.
+   *
+   * \tparam T \deduced The type of this CallbackImpl.
+   * \param [in] self This CallbackImpl.
+   * \param [in] other The other CallbackImpl, or 0.
+   * \returns \pname{other} as a \pname{T}, or 0 if it is of another type.
+   */
+  template <typename T>
+  static T const * PeekSameType (T const *self, const CallbackImplBase *other)
+  {
+    if (other != 0 && typeid (*other) == typeid (*self))
+      {
+        return static_cast<T const *> (other);
+      }
+    return 0;
+  }
   /**
    * \param [in] mangled The mangled string
    * \return The demangled form of mangled
@@ -572,7 +608,7 @@ public:
   virtual bool IsEqual (Ptr<const CallbackImplBase> other) const
   {
     FunctorCallbackImpl<T,R,T1,T2,T3,T4,T5,T6,T7,T8,T9> const *otherDerived =
-      dynamic_cast<FunctorCallbackImpl<T,R,T1,T2,T3,T4,T5,T6,T7,T8,T9> const *> (PeekPointer (other));
+      CallbackImplBase::PeekSameType (this, PeekPointer (other));
     if (otherDerived == 0)
       {
         return false;
@@ -736,7 +772,7 @@ public:
   virtual bool IsEqual (Ptr<const CallbackImplBase> other) const
   {
     MemPtrCallbackImpl<OBJ_PTR,MEM_PTR,R,T1,T2,T3,T4,T5,T6,T7,T8,T9> const *otherDerived =
-      dynamic_cast<MemPtrCallbackImpl<OBJ_PTR,MEM_PTR,R,T1,T2,T3,T4,T5,T6,T7,T8,T9> const *> (PeekPointer (other));
+      CallbackImplBase::PeekSameType (this, PeekPointer (other));
     if (otherDerived == 0)
       {
         return false;
@@ -890,7 +926,7 @@ public:
   virtual bool IsEqual (Ptr<const CallbackImplBase> other) const
   {
     BoundFunctorCallbackImpl<T,R,TX,T1,T2,T3,T4,T5,T6,T7,T8> const *otherDerived =
-      dynamic_cast<BoundFunctorCallbackImpl<T,R,TX,T1,T2,T3,T4,T5,T6,T7,T8> const *> (PeekPointer (other));
+      CallbackImplBase::PeekSameType (this, PeekPointer (other));
     if (otherDerived == 0)
       {
         return false;
@@ -1033,7 +1069,7 @@ public:
   virtual bool IsEqual (Ptr<const CallbackImplBase> other) const
   {
     TwoBoundFunctorCallbackImpl<T,R,TX1,TX2,T1,T2,T3,T4,T5,T6,T7> const *otherDerived =
-      dynamic_cast<TwoBoundFunctorCallbackImpl<T,R,TX1,TX2,T1,T2,T3,T4,T5,T6,T7> const *> (PeekPointer (other));
+      CallbackImplBase::PeekSameType (this, PeekPointer (other));
     if (otherDerived == 0)
       {
         return false;
@@ -1167,7 +1203,7 @@ public:
   virtual bool IsEqual (Ptr<const CallbackImplBase> other) const
   {
     ThreeBoundFunctorCallbackImpl<T,R,TX1,TX2,TX3,T1,T2,T3,T4,T5,T6> const *otherDerived =
-      dynamic_cast<ThreeBoundFunctorCallbackImpl<T,R,TX1,TX2,TX3,T1,T2,T3,T4,T5,T6> const *> (PeekPointer (other));
+      CallbackImplBase::PeekSameType (this, PeekPointer (other));
     if (otherDerived == 0)
       {
         return false;
@@ -18,7 +18,8 @@
  * Authors: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 #include "config.h"
-#include "singleton.h"
+#include "non-copyable.h"
+#include "simulation-context.h"
 #include "object.h"
 #include "global-value.h"
 #include "object-ptr-container.h"
@@ -26,6 +27,8 @@
 #include "pointer.h"
 #include "log.h"
 
+#include <algorithm>
+#include <limits>
 #include <sstream>
 
 /**
@@ -182,6 +185,8 @@ MatchContainer::DisconnectWithoutContext (std::string name, const CallbackBase &
 /**
  * \ingroup config-impl
  * Helper to test if an array entry matches a config path specification.
+ *
+ * The specification is compiled once into a list of index ranges.
  */
 class ArrayMatcher
 {
@@ -201,6 +206,13 @@ public:
   bool Matches (std::size_t i) const;
 
 private:
+  /**
+   * Add the index ranges of a Config path specification.
+   *
+   * \param [in] element The Config path specification, or one of
+   *             its alternatives.
+   */
+  void Compile (std::string element);
   /**
    * Convert a string to an \c uint32_t.
    *
@@ -211,6 +223,8 @@ private:
   bool StringToUint32 (std::string str, uint32_t *value) const;
   /** The Config path element. */
   std::string m_element;
+  /** The inclusive ranges of the matching indices. */
+  std::vector<std::pair<std::size_t, std::size_t> > m_ranges;
 
 };  // class ArrayMatcher
 
@@ -219,66 +233,60 @@ ArrayMatcher::ArrayMatcher (std::string element)
   : m_element (element)
 {
   NS_LOG_FUNCTION (this << element);
+  Compile (element);
 }
-bool
-ArrayMatcher::Matches (std::size_t i) const
+void
+ArrayMatcher::Compile (std::string element)
 {
-  NS_LOG_FUNCTION (this << i);
-  if (m_element == "*")
+  NS_LOG_FUNCTION (this << element);
+  if (element == "*")
     {
-      NS_LOG_DEBUG ("Array " << i << " matches *");
-      return true;
+      m_ranges.push_back (std::make_pair (0, std::numeric_limits<std::size_t>::max ()));
+      return;
     }
   std::string::size_type tmp;
-  tmp = m_element.find ("|");
+  tmp = element.find ("|");
   if (tmp != std::string::npos)
     {
-      std::string left = m_element.substr (0, tmp - 0);
-      std::string right = m_element.substr (tmp + 1, m_element.size () - (tmp + 1));
-      ArrayMatcher matcher = ArrayMatcher (left);
-      if (matcher.Matches (i))
-        {
-          NS_LOG_DEBUG ("Array " << i << " matches " << left);
-          return true;
-        }
-      matcher = ArrayMatcher (right);
-      if (matcher.Matches (i))
-        {
-          NS_LOG_DEBUG ("Array " << i << " matches " << right);
-          return true;
-        }
-      NS_LOG_DEBUG ("Array " << i << " does not match " << m_element);
-      return false;
+      Compile (element.substr (0, tmp - 0));
+      Compile (element.substr (tmp + 1, element.size () - (tmp + 1)));
+      return;
     }
-  std::string::size_type leftBracket = m_element.find ("[");
-  std::string::size_type rightBracket = m_element.find ("]");
-  std::string::size_type dash = m_element.find ("-");
-  if (leftBracket == 0 && rightBracket == m_element.size () - 1
+  std::string::size_type leftBracket = element.find ("[");
+  std::string::size_type rightBracket = element.find ("]");
+  std::string::size_type dash = element.find ("-");
+  if (leftBracket == 0 && rightBracket == element.size () - 1
       && dash > leftBracket && dash < rightBracket)
     {
-      std::string lowerBound = m_element.substr (leftBracket + 1, dash - (leftBracket + 1));
-      std::string upperBound = m_element.substr (dash + 1, rightBracket - (dash + 1));
+      std::string lowerBound = element.substr (leftBracket + 1, dash - (leftBracket + 1));
+      std::string upperBound = element.substr (dash + 1, rightBracket - (dash + 1));
       uint32_t min;
       uint32_t max;
       if (StringToUint32 (lowerBound, &min)
-          && StringToUint32 (upperBound, &max)
-          && i >= min && i <= max)
-        {
-          NS_LOG_DEBUG ("Array " << i << " matches " << m_element);
-          return true;
-        }
-      else
+          && StringToUint32 (upperBound, &max))
         {
-          NS_LOG_DEBUG ("Array " << i << " does not " << m_element);
-          return false;
+          m_ranges.push_back (std::make_pair (min, max));
         }
+      return;
     }
   uint32_t value;
-  if (StringToUint32 (m_element, &value)
-      && i == value)
+  if (StringToUint32 (element, &value))
     {
-      NS_LOG_DEBUG ("Array " << i << " matches " << m_element);
-      return true;
+      m_ranges.push_back (std::make_pair (value, value));
+    }
+}
+bool
+ArrayMatcher::Matches (std::size_t i) const
+{
+  NS_LOG_FUNCTION (this << i);
+  for (std::vector<std::pair<std::size_t, std::size_t> >::const_iterator j = m_ranges.begin ();
+       j != m_ranges.end (); ++j)
+    {
+      if (i >= j->first && i <= j->second)
+        {
+          NS_LOG_DEBUG ("Array " << i << " matches " << m_element);
+          return true;
+        }
     }
   NS_LOG_DEBUG ("Array " << i << " does not match " << m_element);
   return false;
@@ -294,6 +302,222 @@ ArrayMatcher::StringToUint32 (std::string str, uint32_t *value) const
   return !iss.bad () && !iss.fail ();
 }
 
+
+/**
+ * \ingroup config-impl
+ * A Config path split into its elements, each one compiled for the
+ * Resolver.
+ */
+class PathImpl : public SimpleRefCount<PathImpl>
+{
+public:
+  /** An element of the Config path. */
+  struct Element
+  {
+    /**
+     * Compile an element.
+     * \param [in] name The element.
+     */
+    Element (std::string name);
+
+    std::string name;      //!< The element.
+    bool isGetObject;      //!< \c true if the element is \c $ and a TypeId name.
+    bool hasTid;           //!< \c true if the TypeId was registered when compiled.
+    TypeId tid;            //!< The TypeId, if \c hasTid.
+    ArrayMatcher matcher;  //!< The element, as an index specification.
+  };
+
+  /**
+   * Split a Config path into its elements.
+   *
+   * \param [in] path The Config path.
+   */
+  PathImpl (std::string path);
+
+  /** \returns The Config path, as given to the constructor. */
+  std::string GetPath (void) const;
+  /** \returns The number of elements. */
+  std::size_t GetN (void) const;
+  /**
+   * \param [in] i The index of an element.
+   * \returns The element.
+   */
+  const Element & Get (std::size_t i) const;
+
+private:
+  /** The Config path. */
+  std::string m_path;
+  /** The elements of the path. */
+  std::vector<Element> m_elements;
+
+};  // class PathImpl
+
+PathImpl::Element::Element (std::string name)
+  : name (name),
+    isGetObject (name.find ("$") == 0),
+    hasTid (false),
+    matcher (name)
+{
+  if (isGetObject)
+    {
+      hasTid = TypeId::LookupByNameFailSafe (name.substr (1, name.size () - 1), &tid);
+    }
+}
+
+PathImpl::PathImpl (std::string path)
+  : m_path (path)
+{
+  NS_LOG_FUNCTION (this << path);
+  // each element ends with a '/', including the last one, and a
+  // missing leading '/' is implied
+  std::string::size_type start = (path.find ("/") == 0) ? 1 : 0;
+  while (start < path.size ())
+    {
+      std::string::size_type next = path.find ("/", start);
+      if (next == std::string::npos)
+        {
+          next = path.size ();
+        }
+      m_elements.push_back (Element (path.substr (start, next - start)));
+      start = next + 1;
+    }
+}
+std::string
+PathImpl::GetPath (void) const
+{
+  return m_path;
+}
+std::size_t
+PathImpl::GetN (void) const
+{
+  return m_elements.size ();
+}
+const PathImpl::Element &
+PathImpl::Get (std::size_t i) const
+{
+  return m_elements[i];
+}
+
+
+/**
+ * \ingroup config-impl
+ * The attributes of each TypeId which the Resolver can follow, the
+ * pointer and object container attributes, indexed by name.
+ *
+ * The attributes of a TypeId and of its parents are collected at the
+ * first lookup of the TypeId, so that the Resolver does not scan all the
+ * attributes of each object on the path.
+ */
+class AttributeIndex
+{
+public:
+  /** A pointer or object container attribute. */
+  struct Attribute
+  {
+    std::string name;                   //!< The name of the attribute.
+    const AttributeAccessor *accessor;  //!< The accessor, held by the TypeId.
+    bool isContainer;                   //!< \c true for an object container.
+  };
+  /** A list of attributes. */
+  typedef std::vector<Attribute> Attributes;
+
+  /**
+   * Find the pointer and object container attributes of a TypeId
+   * and of its parents, in this order.
+   *
+   * \param [in] tid The TypeId.
+   * \param [in] name The name of the attributes, or \c * for all of them.
+   * \returns The attributes.
+   */
+  const Attributes & Find (TypeId tid, const std::string &name);
+
+private:
+  /** The attributes of a TypeId. */
+  struct Entry
+  {
+    bool built;                                  //!< \c true once filled.
+    Attributes all;                              //!< All the attributes.
+    std::map<std::string, Attributes> byName;    //!< The attributes by name.
+  };
+
+  /**
+   * Fill the entry of a TypeId.
+   * \param [in] tid The TypeId.
+   * \param [out] entry The entry.
+   */
+  void Build (TypeId tid, Entry &entry) const;
+
+  /** The entries, by TypeId uid. */
+  std::vector<Entry> m_entries;
+  /** The empty list of attributes. */
+  Attributes m_none;
+
+};  // class AttributeIndex
+
+const AttributeIndex::Attributes &
+AttributeIndex::Find (TypeId tid, const std::string &name)
+{
+  uint16_t uid = tid.GetUid ();
+  if (uid >= m_entries.size ())
+    {
+      Entry empty;
+      empty.built = false;
+      m_entries.resize (uid + 1, empty);
+    }
+  Entry &entry = m_entries[uid];
+  if (!entry.built)
+    {
+      Build (tid, entry);
+    }
+  if (name == "*")
+    {
+      return entry.all;
+    }
+  std::map<std::string, Attributes>::const_iterator i = entry.byName.find (name);
+  if (i == entry.byName.end ())
+    {
+      return m_none;
+    }
+  return i->second;
+}
+
+void
+AttributeIndex::Build (TypeId tid, Entry &entry) const
+{
+  NS_LOG_FUNCTION (this << tid.GetName ());
+  TypeId nextTid = tid;
+  do
+    {
+      tid = nextTid;
+      for (uint32_t i = 0; i < tid.GetAttributeN (); i++)
+        {
+          struct TypeId::AttributeInformation info = tid.GetAttribute (i);
+          Attribute attribute;
+          attribute.name = info.name;
+          attribute.accessor = PeekPointer (info.accessor);
+          if (dynamic_cast<const PointerChecker *> (PeekPointer (info.checker)) != 0)
+            {
+              attribute.isContainer = false;
+            }
+          else if (dynamic_cast<const ObjectPtrContainerChecker *> (PeekPointer (info.checker)) != 0)
+            {
+              attribute.isContainer = true;
+            }
+          else
+            {
+              // this could be anything else and we don't know what to do with it.
+              continue;
+            }
+          entry.all.push_back (attribute);
+          entry.byName[attribute.name].push_back (attribute);
+        }
+      nextTid = tid.GetParent ();
+    }
+  while (nextTid != tid);
+  entry.built = true;
+}
+
+
 /**
  * \ingroup config-impl
  * Abstract class to parse Config paths into object references.
@@ -302,11 +526,12 @@ class Resolver
 {
 public:
   /**
-   * Construct from a base Config path.
+   * Construct from a compiled Config path.
    *
    * \param [in] path The Config path.
+   * \param [in] index The index of the attributes to follow.
    */
-  Resolver (std::string path);
+  Resolver (const PathImpl &path, AttributeIndex &index);
   /** Destructor. */
   virtual ~Resolver ();
 
@@ -318,25 +543,35 @@ public:
    *                  in the Config path.
    */
   void Resolve (Ptr<Object> root);
+  /**
+   * Only visit the entries of the containers of the root objects which
+   * were not visited by a previous resolution, and only match once the
+   * objects found outside these entries.
+   *
+   * \param [in,out] visited The index of the first entry not visited yet
+   *                 of each container.
+   * \param [in,out] matched The paths of the objects matched outside
+   *                 the entries of the containers.
+   */
+  void SetIncremental (Path::VisitedEntries *visited,
+                       std::set<std::string> *matched);
 
 private:
-  /** Ensure the Config path starts and ends with a '/'. */
-  void Canonicalize (void);
   /**
    * Parse the next element in the Config path.
    *
-   * \param [in] path The remaining portion of the Config path.
+   * \param [in] element The index of the next element of the Config path.
    * \param [in] root The object corresponding to the current position
    *                  in the Config path.
    */
-  void DoResolve (std::string path, Ptr<Object> root);
+  void DoResolve (std::size_t element, Ptr<Object> root);
   /**
    * Parse an index on the Config path.
    *
-   * \param [in] path The remaining Config path.
+   * \param [in] element The index of the next element of the Config path.
    * \param [in,out] vector The resulting list of matching objects.
    */
-  void DoArrayResolve (std::string path, const ObjectPtrContainerValue &vector);
+  void DoArrayResolve (std::size_t element, const ObjectPtrContainerValue &vector);
   /**
    * Handle one object found on the path.
    *
@@ -360,38 +595,44 @@ private:
   /** Current list of path tokens. */
   std::vector<std::string> m_workStack;
   /** The Config path. */
-  std::string m_path;
+  const PathImpl &m_path;
+  /** The index of the attributes to follow. */
+  AttributeIndex &m_index;
+  /** The entries visited, if incremental. */
+  Path::VisitedEntries *m_visited;
+  /** The objects matched outside the entries, if incremental. */
+  std::set<std::string> *m_matched;
+  /** \c true while resolving below an entry of a container of a root object. */
+  bool m_inEntry;
+  /** \c true while resolving in the "/Names" namespace. */
+  bool m_inNames;
+  /** The root object of the resolution. */
+  Ptr<Object> m_root;
 
 };  // class Resolver
 
-Resolver::Resolver (std::string path)
-  : m_path (path)
+Resolver::Resolver (const PathImpl &path, AttributeIndex &index)
+  : m_path (path),
+    m_index (index),
+    m_visited (0),
+    m_matched (0),
+    m_inEntry (false),
+    m_inNames (false)
 {
-  NS_LOG_FUNCTION (this << path);
-  Canonicalize ();
+  NS_LOG_FUNCTION (this << path.GetPath ());
 }
 Resolver::~Resolver ()
 {
   NS_LOG_FUNCTION (this);
 }
+
 void
-Resolver::Canonicalize (void)
+Resolver::SetIncremental (Path::VisitedEntries *visited,
+                          std::set<std::string> *matched)
 {
-  NS_LOG_FUNCTION (this);
-
-  // ensure that we start and end with a '/'
-  std::string::size_type tmp = m_path.find ("/");
-  if (tmp != 0)
-    {
-      // no slash at start
-      m_path = "/" + m_path;
-    }
-  tmp = m_path.find_last_of ("/");
-  if (tmp != (m_path.size () - 1))
-    {
-      // no slash at end
-      m_path = m_path + "/";
-    }
+  NS_LOG_FUNCTION (this << visited << matched);
+  m_visited = visited;
+  m_matched = matched;
 }
 
 void
@@ -399,7 +640,10 @@ Resolver::Resolve (Ptr<Object> root)
 {
   NS_LOG_FUNCTION (this << root);
 
-  DoResolve (m_path, root);
+  m_inNames = (root == 0);
+  m_root = root;
+  DoResolve (0, root);
+  m_root = 0;
 }
 
 std::string
@@ -420,18 +664,22 @@ Resolver::DoResolveOne (Ptr<Object> object)
 {
   NS_LOG_FUNCTION (this << object);
 
-  NS_LOG_DEBUG ("resolved=" << GetResolvedPath ());
-  DoOne (object, GetResolvedPath ());
+  std::string path = GetResolvedPath ();
+  if (m_matched != 0 && !m_inEntry && !m_matched->insert (path).second)
+    {
+      NS_LOG_DEBUG ("already matched=" << path);
+      return;
+    }
+  NS_LOG_DEBUG ("resolved=" << path);
+  DoOne (object, path);
 }
 
 void
-Resolver::DoResolve (std::string path, Ptr<Object> root)
+Resolver::DoResolve (std::size_t element, Ptr<Object> root)
 {
-  NS_LOG_FUNCTION (this << path << root);
-  NS_ASSERT ((path.find ("/")) == 0);
-  std::string::size_type next = path.find ("/", 1);
+  NS_LOG_FUNCTION (this << element << root);
 
-  if (next == std::string::npos)
+  if (element == m_path.GetN ())
     {
       //
       // If root is zero, we're beginning to see if we can use the object name
@@ -447,8 +695,7 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
         }
       return;
     }
-  std::string item = path.substr (1, next - 1);
-  std::string pathLeft = path.substr (next, path.size () - next);
+  const PathImpl::Element &item = m_path.Get (element);
 
   //
   // If root is zero, we're beginning to see if we can use the object name
@@ -457,16 +704,12 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
   // the root of the "/Names" namespace, so we just ignore it and move on to
   // the next segment.
   //
-  if (root == 0)
+  if (root == 0 && item.name == "Names")
     {
-      std::string::size_type offset = path.find ("/Names");
-      if (offset == 0)
-        {
-          m_workStack.push_back (item);
-          DoResolve (pathLeft, root);
-          m_workStack.pop_back ();
-          return;
-        }
+      m_workStack.push_back (item.name);
+      DoResolve (element + 1, root);
+      m_workStack.pop_back ();
+      return;
     }
 
   //
@@ -475,12 +718,12 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
   // zero, this means to look in the root of the "/Names" name space, otherwise
   // it refers to a name space context (level).
   //
-  Ptr<Object> namedObject = Names::Find<Object> (root, item);
+  Ptr<Object> namedObject = Names::Find<Object> (root, item.name);
   if (namedObject)
     {
-      NS_LOG_DEBUG ("Name system resolved item = " << item << " to " << namedObject);
-      m_workStack.push_back (item);
-      DoResolve (pathLeft, namedObject);
+      NS_LOG_DEBUG ("Name system resolved item = " << item.name << " to " << namedObject);
+      m_workStack.push_back (item.name);
+      DoResolve (element + 1, namedObject);
       m_workStack.pop_back ();
       return;
     }
@@ -496,127 +739,119 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
     {
       return;
     }
-  std::string::size_type dollarPos = item.find ("$");
-  if (dollarPos == 0)
+  if (item.isGetObject)
     {
       // This is a call to GetObject
-      std::string tidString = item.substr (1, item.size () - 1);
-      NS_LOG_DEBUG ("GetObject=" << tidString << " on path=" << GetResolvedPath ());
-      TypeId tid = TypeId::LookupByName (tidString);
+      NS_LOG_DEBUG ("GetObject=" << item.name << " on path=" << GetResolvedPath ());
+      TypeId tid = item.hasTid ? item.tid : TypeId::LookupByName (item.name.substr (1, item.name.size () - 1));
       Ptr<Object> object = root->GetObject<Object> (tid);
       if (object == 0)
         {
-          NS_LOG_DEBUG ("GetObject (" << tidString << ") failed on path=" << GetResolvedPath ());
+          NS_LOG_DEBUG ("GetObject (" << item.name << ") failed on path=" << GetResolvedPath ());
           return;
         }
-      m_workStack.push_back (item);
-      DoResolve (pathLeft, object);
+      m_workStack.push_back (item.name);
+      DoResolve (element + 1, object);
       m_workStack.pop_back ();
     }
   else
     {
       // this is a normal attribute.
-      TypeId tid;
-      TypeId nextTid = root->GetInstanceTypeId ();
-      bool foundMatch = false;
-
-      do
+      const AttributeIndex::Attributes &attributes = m_index.Find (root->GetInstanceTypeId (), item.name);
+      for (AttributeIndex::Attributes::const_iterator i = attributes.begin (); i != attributes.end (); ++i)
         {
-          tid = nextTid;
-
-          for (uint32_t i = 0; i < tid.GetAttributeN (); i++)
+          if (!i->isContainer)
             {
-              struct TypeId::AttributeInformation info;
-              info = tid.GetAttribute (i);
-              if (info.name != item && item != "*")
+              NS_LOG_DEBUG ("GetAttribute(ptr)=" << i->name << " on path=" << GetResolvedPath ());
+              PointerValue pValue;
+              i->accessor->Get (PeekPointer (root), pValue);
+              Ptr<Object> object = pValue.Get<Object> ();
+              if (object == 0)
                 {
+                  NS_LOG_ERROR ("Requested object name=\"" << item.name <<
+                                "\" exists on path=\"" << GetResolvedPath () << "\""
+                                " but is null.");
                   continue;
                 }
-              // attempt to cast to a pointer checker.
-              const PointerChecker *pChecker = dynamic_cast<const PointerChecker *> (PeekPointer (info.checker));
-              if (pChecker != 0)
-                {
-                  NS_LOG_DEBUG ("GetAttribute(ptr)=" << info.name << " on path=" << GetResolvedPath ());
-                  PointerValue pValue;
-                  root->GetAttribute (info.name, pValue);
-                  Ptr<Object> object = pValue.Get<Object> ();
-                  if (object == 0)
-                    {
-                      NS_LOG_ERROR ("Requested object name=\"" << item <<
-                                    "\" exists on path=\"" << GetResolvedPath () << "\""
-                                    " but is null.");
-                      continue;
-                    }
-                  foundMatch = true;
-                  m_workStack.push_back (info.name);
-                  DoResolve (pathLeft, object);
-                  m_workStack.pop_back ();
-                }
-              // attempt to cast to an object vector.
-              const ObjectPtrContainerChecker *vectorChecker =
-                dynamic_cast<const ObjectPtrContainerChecker *> (PeekPointer (info.checker));
-              if (vectorChecker != 0)
-                {
-                  NS_LOG_DEBUG ("GetAttribute(vector)=" << info.name << " on path=" << GetResolvedPath () << pathLeft);
-                  foundMatch = true;
-                  ObjectPtrContainerValue vector;
-                  root->GetAttribute (info.name, vector);
-                  m_workStack.push_back (info.name);
-                  DoArrayResolve (pathLeft, vector);
-                  m_workStack.pop_back ();
-                }
-              // this could be anything else and we don't know what to do with it.
-              // So, we just ignore it.
+              m_workStack.push_back (i->name);
+              DoResolve (element + 1, object);
+              m_workStack.pop_back ();
+            }
+          else
+            {
+              NS_LOG_DEBUG ("GetAttribute(vector)=" << i->name << " on path=" << GetResolvedPath ());
+              ObjectPtrContainerValue vector;
+              i->accessor->Get (PeekPointer (root), vector);
+              m_workStack.push_back (i->name);
+              DoArrayResolve (element + 1, vector);
+              m_workStack.pop_back ();
             }
-
-          nextTid = tid.GetParent ();
         }
-      while (nextTid != tid);
 
-      if (!foundMatch)
+      if (attributes.empty ())
         {
-          NS_LOG_DEBUG ("Requested item=" << item << " does not exist on path=" << GetResolvedPath ());
+          NS_LOG_DEBUG ("Requested item=" << item.name << " does not exist on path=" << GetResolvedPath ());
           return;
         }
     }
 }
 
 void
-Resolver::DoArrayResolve (std::string path, const ObjectPtrContainerValue &container)
+Resolver::DoArrayResolve (std::size_t element, const ObjectPtrContainerValue &container)
 {
-  NS_LOG_FUNCTION (this << path << &container);
-  NS_ASSERT (path != "");
-  NS_ASSERT ((path.find ("/")) == 0);
-  std::string::size_type next = path.find ("/", 1);
-  if (next == std::string::npos)
+  NS_LOG_FUNCTION (this << element << &container);
+  if (element == m_path.GetN ())
     {
       return;
     }
-  std::string item = path.substr (1, next - 1);
-  std::string pathLeft = path.substr (next, path.size () - next);
+  const ArrayMatcher &matcher = m_path.Get (element).matcher;
+
+  // with an incremental resolution, the entries of the containers of the
+  // root objects are visited once
+  bool track = m_visited != 0 && !m_inEntry && !m_inNames;
+  std::size_t first = 0;
+  std::size_t end = 0;
+  std::pair<const Object *, std::string> key;
+  if (track)
+    {
+      key = std::make_pair (PeekPointer (m_root), GetResolvedPath ());
+      first = (*m_visited)[key];
+      end = first;
+      m_inEntry = true;
+    }
 
-  ArrayMatcher matcher = ArrayMatcher (item);
   ObjectPtrContainerValue::Iterator it;
   for (it = container.Begin (); it != container.End (); ++it)
     {
-      if (matcher.Matches ((*it).first))
+      end = std::max<std::size_t> (end, (*it).first + 1);
+      if ((*it).first >= first && matcher.Matches ((*it).first))
         {
           std::ostringstream oss;
           oss << (*it).first;
           m_workStack.push_back (oss.str ());
-          DoResolve (pathLeft, (*it).second);
+          DoResolve (element + 1, (*it).second);
           m_workStack.pop_back ();
         }
     }
+
+  if (track)
+    {
+      (*m_visited)[key] = end;
+      m_inEntry = false;
+    }
 }
 
+
 /**
  * \ingroup config-impl
- * Config system implementation class.
+ * Config system implementation class, one per SimulationContext.
  */
-class ConfigImpl : public Singleton<ConfigImpl>
+class ConfigImpl : private NonCopyable
 {
 public:
+  /** \return The Config implementation of the current SimulationContext. */
+  static ConfigImpl * Get (void);
+
   // Keep Set and SetFailSafe since their errors are triggered
   // by the underlying ObjecBase functions.
   /** \copydoc Config::Set() */
@@ -633,6 +868,20 @@ public:
   void Disconnect (std::string path, const CallbackBase &cb);
   /** \copydoc Config::LookupMatches() */
   MatchContainer LookupMatches (std::string path);
+  /**
+   * Find the objects which match a compiled Config path.
+   *
+   * \param [in] path The Config path.
+   * \param [in,out] visited The visited entries of the containers of the
+   *                 root objects, or 0 to find all the matches.
+   * \param [in,out] matched The objects matched outside these entries,
+   *                 or 0 to find all the matches.
+   * \returns The matching objects.
+   * \see Resolver::SetIncremental
+   */
+  MatchContainer LookupMatches (const PathImpl &path,
+                                Path::VisitedEntries *visited,
+                                std::set<std::string> *matched);
 
   /** \copydoc Config::RegisterRootNamespaceObject() */
   void RegisterRootNamespaceObject (Ptr<Object> obj);
@@ -659,6 +908,8 @@ private:
 
   /** The list of Config path roots. */
   Roots m_roots;
+  /** The attributes followed by the Resolver. */
+  AttributeIndex m_index;
 
 };  // class ConfigImpl
 
@@ -751,11 +1002,20 @@ MatchContainer
 ConfigImpl::LookupMatches (std::string path)
 {
   NS_LOG_FUNCTION (this << path);
+  return LookupMatches (PathImpl (path), 0, 0);
+}
+
+MatchContainer
+ConfigImpl::LookupMatches (const PathImpl &path,
+                           Path::VisitedEntries *visited,
+                           std::set<std::string> *matched)
+{
+  NS_LOG_FUNCTION (this << path.GetPath () << visited << matched);
   class LookupMatchesResolver : public Resolver
   {
 public:
-    LookupMatchesResolver (std::string path)
-      : Resolver (path)
+    LookupMatchesResolver (const PathImpl &path, AttributeIndex &index)
+      : Resolver (path, index)
     {
     }
     virtual void DoOne (Ptr<Object> object, std::string path)
@@ -765,7 +1025,8 @@ public:
     }
     std::vector<Ptr<Object> > m_objects;
     std::vector<std::string> m_contexts;
-  } resolver = LookupMatchesResolver (path);
+  } resolver = LookupMatchesResolver (path, m_index);
+  resolver.SetIncremental (visited, matched);
   for (Roots::const_iterator i = m_roots.begin (); i != m_roots.end (); i++)
     {
       resolver.Resolve (*i);
@@ -778,7 +1039,7 @@ public:
   //
   resolver.Resolve (0);
 
-  return MatchContainer (resolver.m_objects, resolver.m_contexts, path);
+  return MatchContainer (resolver.m_objects, resolver.m_contexts, path.GetPath ());
 }
 
 void
@@ -803,6 +1064,13 @@ ConfigImpl::UnregisterRootNamespaceObject (Ptr<Object> obj)
     }
 }
 
+ConfigImpl *
+ConfigImpl::Get (void)
+{
+  static ContextLocal<ConfigImpl> config;
+  return &config.Get ();
+}
+
 std::size_t
 ConfigImpl::GetRootNamespaceObjectN (void) const
 {
@@ -817,6 +1085,111 @@ ConfigImpl::GetRootNamespaceObject (std::size_t i) const
 }
 
 
+Path::Path (std::string path)
+  : m_applied (false)
+{
+  NS_LOG_FUNCTION (this << path);
+  std::string::size_type slash = path.find_last_of ("/");
+  NS_ASSERT_MSG (slash != std::string::npos, "Config::Path: no leaf in " << path);
+  m_impl = Create<PathImpl> (path.substr (0, slash));
+  m_leaf = path.substr (slash + 1, path.size () - (slash + 1));
+}
+Path::Path (const Path &o)
+  : m_impl (o.m_impl),
+    m_leaf (o.m_leaf),
+    m_applied (false)
+{
+  NS_LOG_FUNCTION (this << &o);
+}
+Path &
+Path::operator = (const Path &o)
+{
+  NS_LOG_FUNCTION (this << &o);
+  if (this != &o)
+    {
+      m_impl = o.m_impl;
+      m_leaf = o.m_leaf;
+      m_applied = false;
+      m_visited.clear ();
+      m_matched.clear ();
+    }
+  return *this;
+}
+Path::~Path ()
+{
+  NS_LOG_FUNCTION (this);
+}
+std::string
+Path::GetPath (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_impl->GetPath () + "/" + m_leaf;
+}
+MatchContainer
+Path::LookupMatches (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return ConfigImpl::Get ()->LookupMatches (*m_impl, 0, 0);
+}
+MatchContainer
+Path::LookupNewMatches (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_applied = true;
+  return ConfigImpl::Get ()->LookupMatches (*m_impl, &m_visited, &m_matched);
+}
+void
+Path::Set (const AttributeValue &value)
+{
+  NS_LOG_FUNCTION (this << &value);
+  MatchContainer container = LookupNewMatches ();
+  container.Set (m_leaf, value);
+}
+bool
+Path::SetFailSafe (const AttributeValue &value)
+{
+  NS_LOG_FUNCTION (this << &value);
+  MatchContainer container = LookupNewMatches ();
+  return container.SetFailSafe (m_leaf, value);
+}
+void
+Path::Connect (const CallbackBase &cb)
+{
+  NS_LOG_FUNCTION (this << &cb);
+  bool first = !m_applied;
+  MatchContainer container = LookupNewMatches ();
+  if ((first || container.GetN () > 0) && !container.ConnectFailSafe (m_leaf, cb))
+    {
+      NS_FATAL_ERROR ("Could not connect callback to " << GetPath ());
+    }
+}
+bool
+Path::ConnectFailSafe (const CallbackBase &cb)
+{
+  NS_LOG_FUNCTION (this << &cb);
+  MatchContainer container = LookupNewMatches ();
+  return container.ConnectFailSafe (m_leaf, cb);
+}
+void
+Path::ConnectWithoutContext (const CallbackBase &cb)
+{
+  NS_LOG_FUNCTION (this << &cb);
+  bool first = !m_applied;
+  MatchContainer container = LookupNewMatches ();
+  if ((first || container.GetN () > 0) && !container.ConnectWithoutContextFailSafe (m_leaf, cb))
+    {
+      NS_FATAL_ERROR ("Could not connect callback to " << GetPath ());
+    }
+}
+bool
+Path::ConnectWithoutContextFailSafe (const CallbackBase &cb)
+{
+  NS_LOG_FUNCTION (this << &cb);
+  MatchContainer container = LookupNewMatches ();
+  return container.ConnectWithoutContextFailSafe (m_leaf, cb);
+}
+
+
 void Reset (void)
 {
   NS_LOG_FUNCTION_NOARGS ();
@@ -870,21 +1243,20 @@ bool SetDefaultFailSafe (std::string fullName, const AttributeValue &value)
     {
       return false;
     }
-  for (uint32_t j = 0; j < tid.GetAttributeN (); j++)
+  // only the attributes defined by tid itself have their defaults here
+  TypeId owner;
+  std::size_t j;
+  if (!tid.LookupAttributeIndexByName (paramName, &owner, &j) || owner != tid)
     {
-      struct TypeId::AttributeInformation tmp = tid.GetAttribute (j);
-      if (tmp.name == paramName)
-        {
-          Ptr<AttributeValue> v = tmp.checker->CreateValidValue (value);
-          if (v == 0)
-            {
-              return false;
-            }
-          tid.SetAttributeInitialValue (j, v);
-          return true;
-        }
+      return false;
     }
-  return false;
+  Ptr<AttributeValue> v = tid.PeekAttribute (j).checker->CreateValidValue (value);
+  if (v == 0)
+    {
+      return false;
+    }
+  tid.SetAttributeInitialValue (j, v);
+  return true;
 }
 void SetGlobal (std::string name, const AttributeValue &value)
 {
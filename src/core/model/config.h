@@ -21,7 +21,10 @@
 #define CONFIG_H
 
 #include "ptr.h"
+#include <map>
+#include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 /**
@@ -288,6 +291,135 @@ private:
  */
 MatchContainer LookupMatches (std::string path);
 
+class PathImpl;
+
+/**
+ * \ingroup config
+ * \brief A Config path parsed once, to be applied repeatedly.
+ *
+ * The functions of the Config namespace parse their path at each call.
+ * A Path parses it once: the path is split into its elements, the
+ * TypeIds of the \c $ elements are looked up and the index specifications,
+ * such as \c [0-3]|7, are compiled. Each element is then resolved with
+ * an index of the pointer and container attributes of each TypeId, so
+ * that the cost of a resolution grows with the number of objects visited
+ * along the path, not with the number of attributes of their types.
+ *
+ * A Path can also be applied again as the simulation grows. The
+ * operations of a Path (Set, Connect, ConnectWithoutContext, and
+ * LookupNewMatches) only visit the entries of the containers of the
+ * root namespace objects, such as the nodes of \c /NodeList, not visited
+ * by a previous operation, and only match the objects of the \c /Names
+ * namespace not matched by a previous operation. Objects added later
+ * below entries already visited, such as a device installed on an
+ * existing node, are not matched again.
+ *
+ * \code
+ *   Config::Path path ("/NodeList/[0-99]/DeviceList/0/LteUeRrc/HandoverStart");
+ *   path.Connect (MakeCallback (&NotifyHandoverStartUe));
+ *   // ... create and install more UEs ...
+ *   path.Connect (MakeCallback (&NotifyHandoverStartUe));  // the new UEs only
+ * \endcode
+ *
+ * Copies of a Path share the parsed path, but not the record of the
+ * visited objects.
+ */
+class Path
+{
+public:
+  /**
+   * The index of the first entry not visited yet of each container of
+   * the root namespace objects, by root object and path of the container.
+   */
+  typedef std::map<std::pair<const Object *, std::string>, std::size_t> VisitedEntries;
+
+  /**
+   * Parse a Config path.
+   *
+   * \param [in] path A path to match attributes or trace sources, as given
+   *             to Config::Set or Config::Connect.
+   */
+  Path (std::string path);
+  /**
+   * Copy constructor.
+   * \param [in] o The Path to copy.
+   */
+  Path (const Path &o);
+  /**
+   * Assignment.
+   * \param [in] o The Path to copy.
+   * \returns This Path.
+   */
+  Path & operator = (const Path &o);
+  /** Destructor. */
+  ~Path ();
+
+  /** \returns The path, as given to the constructor. */
+  std::string GetPath (void) const;
+
+  /**
+   * \returns All the objects which match the path without its last
+   *          element, that is the objects holding the attribute or trace
+   *          source named by the last element.
+   */
+  MatchContainer LookupMatches (void) const;
+  /**
+   * \returns The objects which match the path without its last element,
+   *          and which were not visited by a previous operation on
+   *          this Path.
+   */
+  MatchContainer LookupNewMatches (void);
+
+  /**
+   * Set the attribute named by the last element of the path in the new
+   * matches.
+   * \param [in] value The value to set.
+   */
+  void Set (const AttributeValue &value);
+  /**
+   * \copydoc Set()
+   * \returns \c true if any attributes could be set.
+   */
+  bool SetFailSafe (const AttributeValue &value);
+  /**
+   * Connect a callback, with the matched path as context, to the trace
+   * source named by the last element of the path in the new matches.
+   * It is a fatal error if no trace source could be connected, unless
+   * this is not the first operation on this Path and there is no new
+   * match.
+   * \param [in] cb The callback to connect.
+   */
+  void Connect (const CallbackBase &cb);
+  /**
+   * \copydoc Connect()
+   * \returns \c true if any trace sources could be connected.
+   */
+  bool ConnectFailSafe (const CallbackBase &cb);
+  /**
+   * Connect a callback to the trace source named by the last element
+   * of the path in the new matches.
+   * \param [in] cb The callback to connect.
+   */
+  void ConnectWithoutContext (const CallbackBase &cb);
+  /**
+   * \copydoc ConnectWithoutContext()
+   * \returns \c true if any trace sources could be connected.
+   */
+  bool ConnectWithoutContextFailSafe (const CallbackBase &cb);
+
+private:
+  /** The parsed path, without its last element. */
+  Ptr<PathImpl> m_impl;
+  /** The last element of the path. */
+  std::string m_leaf;
+  /** \c true once an operation was applied. */
+  bool m_applied;
+  /** The entries of the containers of the root objects visited. */
+  VisitedEntries m_visited;
+  /** The paths of the matches found outside these containers. */
+  std::set<std::string> m_matched;
+};
+
 /**
  * \ingroup config
  * \param [in] obj A new root object
@@ -58,6 +58,7 @@ DefaultSimulatorImpl::GetTypeId (void)
 }
 
 DefaultSimulatorImpl::DefaultSimulatorImpl ()
+  : m_eventsWithContext (4096)
 {
   NS_LOG_FUNCTION (this);
   m_stop = false;
@@ -71,8 +72,9 @@ DefaultSimulatorImpl::DefaultSimulatorImpl ()
   m_currentTs = 0;
   m_currentContext = Simulator::NO_CONTEXT;
   m_unscheduledEvents = 0;
+  m_cancelledEvents = 0;
   m_eventCount = 0;
-  m_eventsWithContextEmpty = true;
+  m_eventsWithContextOverflowing = false;
   m_main = SystemThread::Self ();
 }
 
@@ -143,6 +145,10 @@ DefaultSimulatorImpl::ProcessOneEvent (void)
   NS_ASSERT (next.key.m_ts >= m_currentTs);
   m_unscheduledEvents--;
   m_eventCount++;
+  if (next.impl->IsCancelled ())
+    {
+      m_cancelledEvents--;
+    }
 
   NS_LOG_LOGIC ("handle " << next.key.m_ts);
   m_currentTs = next.key.m_ts;
@@ -163,31 +169,48 @@ DefaultSimulatorImpl::IsFinished (void) const
 void
 DefaultSimulatorImpl::ProcessEventsWithContext (void)
 {
-  if (m_eventsWithContextEmpty)
+  if (m_eventsWithContext.IsEmpty ()
+      && !m_eventsWithContextOverflowing.load (std::memory_order_acquire))
     {
       return;
     }
 
-  // swap queues
-  EventsWithContext eventsWithContext;
-  {
-    CriticalSection cs (m_eventsWithContextMutex);
-    m_eventsWithContext.swap (eventsWithContext);
-    m_eventsWithContextEmpty = true;
-  }
-  while (!eventsWithContext.empty ())
+  EventWithContext event;
+  while (m_eventsWithContext.Pop (event))
     {
-      EventWithContext event = eventsWithContext.front ();
-      eventsWithContext.pop_front ();
-      Scheduler::Event ev;
-      ev.impl = event.event;
-      ev.key.m_ts = m_currentTs + event.timestamp;
-      ev.key.m_context = event.context;
-      ev.key.m_uid = m_uid;
-      m_uid++;
-      m_unscheduledEvents++;
-      m_events->Insert (ev);
+      InsertEventWithContext (event);
     }
+  // the overflow list holds the most recent events of the threads which
+  // found the queue full: wait until the events being pushed in the queue
+  // are drained to keep them in order
+  if (m_eventsWithContextOverflowing.load (std::memory_order_acquire)
+      && m_eventsWithContext.IsEmpty ())
+    {
+      EventsWithContext eventsWithContext;
+      {
+        CriticalSection cs (m_eventsWithContextMutex);
+        m_eventsWithContextOverflow.swap (eventsWithContext);
+        m_eventsWithContextOverflowing.store (false, std::memory_order_release);
+      }
+      while (!eventsWithContext.empty ())
+        {
+          InsertEventWithContext (eventsWithContext.front ());
+          eventsWithContext.pop_front ();
+        }
+    }
+}
+
+void
+DefaultSimulatorImpl::InsertEventWithContext (const EventWithContext &event)
+{
+  Scheduler::Event ev;
+  ev.impl = event.event;
+  ev.key.m_ts = m_currentTs + event.timestamp;
+  ev.key.m_context = event.context;
+  ev.key.m_uid = m_uid;
+  m_uid++;
+  m_unscheduledEvents++;
+  m_events->Insert (ev);
 }
 
 void
@@ -270,11 +293,14 @@ DefaultSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &delay,
       // Current time added in ProcessEventsWithContext()
       ev.timestamp = delay.GetTimeStep ();
       ev.event = event;
-      {
-        CriticalSection cs (m_eventsWithContextMutex);
-        m_eventsWithContext.push_back (ev);
-        m_eventsWithContextEmpty = false;
-      }
+      if (!m_eventsWithContextOverflowing.load (std::memory_order_acquire)
+          && m_eventsWithContext.Push (ev))
+        {
+          return;
+        }
+      CriticalSection cs (m_eventsWithContextMutex);
+      m_eventsWithContextOverflow.push_back (ev);
+      m_eventsWithContextOverflowing.store (true, std::memory_order_release);
     }
 }
 
@@ -361,10 +387,18 @@ DefaultSimulatorImpl::Remove (const EventId &id)
 void
 DefaultSimulatorImpl::Cancel (const EventId &id)
 {
-  if (!IsExpired (id))
+  if (IsExpired (id))
     {
-      id.PeekEventImpl ()->Cancel ();
+      return;
     }
+  if (id.GetUid () == 2 || m_events->IsRemoveFast ())
+    {
+      // leave no dead event in the lists
+      Remove (id);
+      return;
+    }
+  id.PeekEventImpl ()->Cancel ();
+  m_cancelledEvents++;
 }
 
 bool
@@ -418,4 +452,25 @@ DefaultSimulatorImpl::GetEventCount (void) const
   return m_eventCount;
 }
 
+uint32_t
+DefaultSimulatorImpl::GetLiveEventCount (void) const
+{
+  return m_unscheduledEvents - m_cancelledEvents;
+}
+
+uint32_t
+DefaultSimulatorImpl::GetCancelledEventCount (void) const
+{
+  return m_cancelledEvents;
+}
+
+void
+DefaultSimulatorImpl::InvokeWithContext (uint32_t context, const Callback<void> &callback)
+{
+  uint32_t previous = m_currentContext;
+  m_currentContext = context;
+  callback ();
+  m_currentContext = previous;
+}
+
 } // namespace ns3
@@ -26,10 +26,12 @@
 #include "event-impl.h"
 #include "system-thread.h"
 #include "system-mutex.h"
+#include "mpsc-queue.h"
 
 #include "ptr.h"
 
 #include <list>
+#include <atomic>
 
 /**
  * \file
@@ -78,6 +80,9 @@ public:
   virtual uint32_t GetSystemId (void) const;
   virtual uint32_t GetContext (void) const;
   virtual uint64_t GetEventCount (void) const;
+  virtual void InvokeWithContext (uint32_t context, const Callback<void> &callback);
+  virtual uint32_t GetLiveEventCount (void) const;
+  virtual uint32_t GetCancelledEventCount (void) const;
 
 private:
   virtual void DoDispose (void);
@@ -97,16 +102,30 @@ private:
     /** The event implementation. */
     EventImpl *event;
   };
+  /**
+   * Insert an event from a different context into the main event queue.
+   * \param event the event, with its delay from now
+   */
+  void InsertEventWithContext (const EventWithContext &event);
   /** Container type for the events from a different context. */
   typedef std::list<struct EventWithContext> EventsWithContext;
-  /** The container of events from a different context. */
-  EventsWithContext m_eventsWithContext;
   /**
-   * Flag \c true if all events with context have been moved to the
-   * primary event queue.
+   * The lock-free queue of events from a different context, drained by
+   * the main thread.
+   */
+  MpscQueue<struct EventWithContext> m_eventsWithContext;
+  /**
+   * The events from a different context which did not fit in
+   * m_eventsWithContext.
    */
-  bool m_eventsWithContextEmpty;
-  /** Mutex to control access to the list of events with context. */
+  EventsWithContext m_eventsWithContextOverflow;
+  /**
+   * Flag \c true if m_eventsWithContextOverflow may hold events.  While it
+   * is set, the other threads add their events to the overflow list too, so
+   * that the events of a thread stay in order.
+   */
+  std::atomic<bool> m_eventsWithContextOverflowing;
+  /** Mutex to control access to the overflow list of events with context. */
   SystemMutex m_eventsWithContextMutex;
 
   /** Container type for the events to run at Simulator::Destroy() */
@@ -133,6 +152,11 @@ private:
    *  not counting the Destroy events; this is used for validation
    */
   int m_unscheduledEvents;
+  /**
+   * Number of cancelled events left in the event list, when Remove is
+   * too slow to remove them at once.
+   */
+  uint32_t m_cancelledEvents;
 
   /** Main execution thread. */
   SystemThread::ThreadId m_main;
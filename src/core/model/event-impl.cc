@@ -21,6 +21,9 @@
 #include "event-impl.h"
 #include "log.h"
 
+#include <atomic>
+#include <new>
+
 /**
  * \file
  * \ingroup events
@@ -31,13 +34,201 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("EventImpl");
 
+/**
+ * \ingroup events
+ * \brief The free lists of the events released by a thread.
+ *
+ * Event sizes are rounded up to a multiple of GRANULARITY, so that the
+ * events of a size class can reuse each other's memory. Events larger than
+ * MAX_SIZE are not pooled.
+ */
+class EventImplPool
+{
+public:
+  /** Size class granularity, in bytes. */
+  static const std::size_t GRANULARITY = 16;
+  /** Size of the largest pooled events, in bytes. */
+  static const std::size_t MAX_SIZE = 256;
+  /** Maximum number of free events kept by size class. */
+  static const uint32_t MAX_FREE = 16384;
+
+  EventImplPool ();
+  /** Release the free events to the system. */
+  ~EventImplPool ();
+
+  /**
+   * \return the pool of the calling thread, or 0 if it was already
+   *         destroyed, at thread exit
+   */
+  static EventImplPool * Get (void);
+  /**
+   * \param size a size
+   * \return the size of its size class
+   */
+  static std::size_t Round (std::size_t size);
+
+  /**
+   * \param size the size of a size class
+   * \return memory for an event of this size class
+   */
+  void * Allocate (std::size_t size);
+  /**
+   * \param p the memory of an event
+   * \param size the size of the size class of the event
+   */
+  void Deallocate (void *p, std::size_t size);
+
+private:
+  /** A free event. */
+  struct Block
+  {
+    Block *next;  //!< the next free event of the size class
+  };
+
+  /** Number of size classes. */
+  static const std::size_t N_CLASSES = MAX_SIZE / GRANULARITY;
+
+  Block *m_free[N_CLASSES];     //!< the free events, by size class
+  uint32_t m_nFree[N_CLASSES];  //!< the number of free events, by size class
+
+  /** The pool of each thread, trivially destructible. */
+  static thread_local EventImplPool *m_pool;
+  /** Flag set when the pool of the thread is destroyed. */
+  static thread_local bool m_destroyed;
+};
+
+thread_local EventImplPool *EventImplPool::m_pool = 0;
+thread_local bool EventImplPool::m_destroyed = false;
+
+/** Flag \c true if the events are allocated from the pools. */
+static std::atomic<bool> g_eventPoolEnabled (true);
+
+EventImplPool::EventImplPool ()
+{
+  for (std::size_t i = 0; i < N_CLASSES; ++i)
+    {
+      m_free[i] = 0;
+      m_nFree[i] = 0;
+    }
+}
+
+EventImplPool::~EventImplPool ()
+{
+  for (std::size_t i = 0; i < N_CLASSES; ++i)
+    {
+      while (m_free[i] != 0)
+        {
+          Block *block = m_free[i];
+          m_free[i] = block->next;
+          ::operator delete (block);
+        }
+    }
+  m_pool = 0;
+  m_destroyed = true;
+}
+
+EventImplPool *
+EventImplPool::Get (void)
+{
+  if (m_pool == 0 && !m_destroyed)
+    {
+      static thread_local EventImplPool pool;
+      m_pool = &pool;
+    }
+  return m_pool;
+}
+
+std::size_t
+EventImplPool::Round (std::size_t size)
+{
+  return (size + GRANULARITY - 1) & ~(GRANULARITY - 1);
+}
+
+void *
+EventImplPool::Allocate (std::size_t size)
+{
+  std::size_t i = size / GRANULARITY - 1;
+  Block *block = m_free[i];
+  if (block == 0)
+    {
+      return ::operator new (size);
+    }
+  m_free[i] = block->next;
+  m_nFree[i]--;
+  return block;
+}
+
+void
+EventImplPool::Deallocate (void *p, std::size_t size)
+{
+  std::size_t i = size / GRANULARITY - 1;
+  if (m_nFree[i] >= MAX_FREE)
+    {
+      ::operator delete (p);
+      return;
+    }
+  Block *block = static_cast<Block *> (p);
+  block->next = m_free[i];
+  m_free[i] = block;
+  m_nFree[i]++;
+}
+
+void *
+EventImpl::operator new (std::size_t size)
+{
+  // no logging: the events are allocated on the hot path
+  size = EventImplPool::Round (size);
+  if (size <= EventImplPool::MAX_SIZE
+      && g_eventPoolEnabled.load (std::memory_order_relaxed))
+    {
+      EventImplPool *pool = EventImplPool::Get ();
+      if (pool != 0)
+        {
+          return pool->Allocate (size);
+        }
+    }
+  return ::operator new (size);
+}
+
+void
+EventImpl::operator delete (void *p, std::size_t size)
+{
+  size = EventImplPool::Round (size);
+  if (size <= EventImplPool::MAX_SIZE
+      && g_eventPoolEnabled.load (std::memory_order_relaxed))
+    {
+      EventImplPool *pool = EventImplPool::Get ();
+      if (pool != 0)
+        {
+          pool->Deallocate (p, size);
+          return;
+        }
+    }
+  ::operator delete (p);
+}
+
+void
+EventImpl::DisablePool (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  g_eventPoolEnabled = false;
+}
+
+void
+EventImpl::EnablePool (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  g_eventPoolEnabled = true;
+}
+
 EventImpl::~EventImpl ()
 {
   NS_LOG_FUNCTION (this);
 }
 
 EventImpl::EventImpl ()
-  : m_cancel (false)
+  : m_schedulerHandle (0),
+    m_cancel (false)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -21,6 +21,7 @@
 #define EVENT_IMPL_H
 
 #include <stdint.h>
+#include <cstddef>
 #include "simple-ref-count.h"
 
 /**
@@ -40,6 +41,11 @@ namespace ns3 {
  * when it reaches the time associated to this event. Most subclasses
  * are usually created by one of the many Simulator::Schedule
  * methods.
+ *
+ * The events, including the bound arguments stored by the MakeEvent
+ * subclasses, are allocated from a pool: each thread keeps the freed
+ * events in free lists by size class, and reuses them for the next events
+ * of the same size class instead of going through malloc.
  */
 class EventImpl : public SimpleRefCount<EventImpl>
 {
@@ -48,6 +54,30 @@ public:
   EventImpl ();
   /** Destructor. */
   virtual ~EventImpl () = 0;
+
+  /**
+   * Allocate an event from the pool of the calling thread.
+   * \param size the size of the event
+   * \return the event memory
+   */
+  static void * operator new (std::size_t size);
+  /**
+   * Release an event to the pool of the calling thread.
+   * \param p the event memory
+   * \param size the size of the event
+   */
+  static void operator delete (void *p, std::size_t size);
+  /**
+   * Allocate the events with malloc from now on, e.g., to compare the
+   * performance or to check the memory accesses with valgrind.
+   *
+   * This should be called before scheduling any event.
+   */
+  static void DisablePool (void);
+  /**
+   * Allocate the events from the pool from now on (the default).
+   */
+  static void EnablePool (void);
   /**
    * Called by the simulation engine to notify the event that it is time
    * to execute.
@@ -65,6 +95,30 @@ public:
    * Checked by the simulation engine before calling Invoke().
    */
   bool IsCancelled (void);
+  /**
+   * Get the position of the event in the event list, as last set by the
+   * scheduler holding the event.
+   *
+   * Schedulers which support the removal of an event in less than
+   * linear time store there the index of the event in their data
+   * structure, and update it when the event moves. The value is
+   * meaningless for other schedulers.
+   *
+   * 
+eturns The scheduler handle of the event.
+   */
+  uint32_t GetSchedulerHandle (void) const
+  {
+    return m_schedulerHandle;
+  }
+  /**
+   * Set the position of the event in the event list.
+   * \param [in] handle The scheduler handle of the event.
+   */
+  void SetSchedulerHandle (uint32_t handle)
+  {
+    m_schedulerHandle = handle;
+  }
 
 protected:
   /**
@@ -76,6 +130,7 @@ protected:
   virtual void Notify (void) = 0;
 
 private:
+  uint32_t m_schedulerHandle;  /**< The position of the event in the event list. */
   bool m_cancel;  /**< Has this event been cancelled. */
 };
 
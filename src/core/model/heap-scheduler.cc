@@ -126,6 +126,8 @@ HeapScheduler::Exch (std::size_t a, std::size_t b)
   Event tmp (m_heap[a]);
   m_heap[a] = m_heap[b];
   m_heap[b] = tmp;
+  m_heap[a].impl->SetSchedulerHandle (a);
+  m_heap[b].impl->SetSchedulerHandle (b);
 }
 
 bool
@@ -150,10 +152,10 @@ HeapScheduler::IsEmpty (void) const
 }
 
 void
-HeapScheduler::BottomUp (void)
+HeapScheduler::BottomUp (std::size_t start)
 {
-  NS_LOG_FUNCTION (this);
-  std::size_t index = Last ();
+  NS_LOG_FUNCTION (this << start);
+  std::size_t index = start;
   while (!IsRoot (index)
          && IsLessStrictly (index, Parent (index)))
     {
@@ -203,7 +205,8 @@ HeapScheduler::Insert (const Event &ev)
 {
   NS_LOG_FUNCTION (this << &ev);
   m_heap.push_back (ev);
-  BottomUp ();
+  ev.impl->SetSchedulerHandle (Last ());
+  BottomUp (Last ());
 }
 
 Scheduler::Event
@@ -228,19 +231,22 @@ void
 HeapScheduler::Remove (const Event &ev)
 {
   NS_LOG_FUNCTION (this << &ev);
-  std::size_t uid = ev.key.m_uid;
-  for (std::size_t i = 1; i < m_heap.size (); i++)
+  std::size_t i = ev.impl->GetSchedulerHandle ();
+  NS_ASSERT (i < m_heap.size () && m_heap[i].key.m_uid == ev.key.m_uid);
+  Exch (i, Last ());
+  m_heap.pop_back ();
+  if (i < m_heap.size ())
     {
-      if (uid == m_heap[i].key.m_uid)
-        {
-          NS_ASSERT (m_heap[i].impl == ev.impl);
-          Exch (i, Last ());
-          m_heap.pop_back ();
-          TopDown (i);
-          return;
-        }
+      // the last item, now at i, may belong above or below i
+      BottomUp (i);
+      TopDown (i);
     }
-  NS_ASSERT (false);
+}
+
+bool
+HeapScheduler::IsRemoveFast (void) const
+{
+  return true;
 }
 
 } // namespace ns3
@@ -51,6 +51,9 @@ namespace ns3 {
  *    the index of the root is 1.
  *  - It uses a slightly non-standard while loop for top-down heapify
  *    to move one if statement out of the loop.
+ *  - Each event keeps its index in the heap as its scheduler handle
+ *    (see EventImpl::GetSchedulerHandle), so that Remove() does not
+ *    search the heap.
  *
  * \par Time Complexity
  *
@@ -59,7 +62,7 @@ namespace ns3 {
  * Insert()     | Logarithmic     | Heapify
  * IsEmpty()    | Constant        | Explicit queue size
  * PeekNext()   | Constant        | Heap kept sorted
- * Remove()     | Logarithmic     | Search, heapify
+ * Remove()     | Logarithmic     | Handle, heapify
  * RemoveNext() | Logarithmic     | Heapify
  *
  * \par Memory Complexity
@@ -89,6 +92,7 @@ public:
   virtual Scheduler::Event PeekNext (void) const;
   virtual Scheduler::Event RemoveNext (void);
   virtual void Remove (const Scheduler::Event &ev);
+  virtual bool IsRemoveFast (void) const;
 
 private:
   /** Event list type:  vector of Events, managed as a heap. */
@@ -170,8 +174,13 @@ private:
    * \param [in] b The second item.
    */
   inline void Exch (std::size_t a, std::size_t b);
-  /** Percolate a newly inserted Last item to its proper position. */
-  void BottomUp (void);
+  /**
+   * Percolate an item up the heap, e.g. a newly inserted Last item,
+   * to its proper position.
+   *
+   * \param [in] start Starting entry.
+   */
+  void BottomUp (std::size_t start);
   /**
    * Percolate a deletion bubble down the heap.
    *
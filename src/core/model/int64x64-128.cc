@@ -72,6 +72,25 @@ int64x64_t::Mul (const int64x64_t & o)
 uint128_t
 int64x64_t::Umul (const uint128_t a, const uint128_t b)
 {
+  // Fast paths, with the results of the general case below.
+  // An integer factor, such as a Time, needs a single product
+  // of 64 by 128 bits.
+  const uint64_t aLow = static_cast<uint64_t> (a);
+  const uint64_t bLow = static_cast<uint64_t> (b);
+  const uint64_t aHigh = static_cast<uint64_t> (a >> 64);
+  const uint64_t bHigh = static_cast<uint64_t> (b >> 64);
+  if (aLow == 0 || bLow == 0)
+    {
+      NS_ABORT_MSG_IF ((static_cast<uint128_t> (aHigh) * bHigh) >> 64 != 0,
+                       "High precision 128 bits multiplication error: multiplication overflow.");
+      return aLow == 0 ? aHigh * b : bHigh * a;
+    }
+  // Two fractions need a single product of 64 by 64 bits.
+  if (aHigh == 0 && bHigh == 0)
+    {
+      return (static_cast<uint128_t> (aLow) * bLow) >> 64;
+    }
+
   uint128_t aL = a & HP_MASK_LO;
   uint128_t bL = b & HP_MASK_LO;
   uint128_t aH = (a >> 64) & HP_MASK_LO;
@@ -121,6 +140,24 @@ int64x64_t::Div (const int64x64_t & o)
 uint128_t
 int64x64_t::Udiv (const uint128_t a, const uint128_t b)
 {
+  // Fast paths, with the exact quotient of the long division below.
+  const uint64_t bLow = static_cast<uint64_t> (b);
+  const uint64_t bHigh = static_cast<uint64_t> (b >> 64);
+  if (bLow == 0)
+    {
+      // An integer divisor, such as a Time: (a 2^64) / (bHigh 2^64)
+      return a / bHigh;
+    }
+  if ((a >> 64) == 0)
+    {
+      // The dividend shifted by 64 bits fits in 128 bits
+      return (a << 64) / b;
+    }
+  if (bHigh == 0)
+    {
+      // The remainder of the integer part, shifted, fits in 128 bits
+      return ((a / b) << 64) + ((a % b) << 64) / b;
+    }
 
   uint128_t rem = a;
   uint128_t den = b;
@@ -0,0 +1,327 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Amiraslan Haghrah
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ladder-queue-scheduler.h"
+#include "event-impl.h"
+#include "assert.h"
+#include "log.h"
+
+#include <algorithm>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * Implementation of ns3::LadderQueueScheduler class.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LadderQueueScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (LadderQueueScheduler);
+
+/**
+ * \ingroup scheduler
+ * Compare two events by their key.
+ * \param [in] a The first event.
+ * \param [in] b The second event.
+ * \returns \c true if \pname{a} runs before \pname{b}
+ */
+static bool
+EventLess (const Scheduler::Event &a, const Scheduler::Event &b)
+{
+  return a.key < b.key;
+}
+
+const uint32_t LadderQueueScheduler::BOTTOM_THRESHOLD;
+const uint32_t LadderQueueScheduler::MAX_RUNGS;
+const uint32_t LadderQueueScheduler::MAX_BUCKETS;
+
+TypeId
+LadderQueueScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::LadderQueueScheduler")
+    .SetParent<Scheduler> ()
+    .SetGroupName ("Core")
+    .AddConstructor<LadderQueueScheduler> ()
+  ;
+  return tid;
+}
+
+LadderQueueScheduler::LadderQueueScheduler ()
+  : m_topMin (0),
+    m_topMax (0),
+    m_topStart (0),
+    m_nRungs (0),
+    m_bottomHead (0),
+    m_bottomLimit (BOTTOM_THRESHOLD),
+    m_size (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+LadderQueueScheduler::~LadderQueueScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+uint64_t
+LadderQueueScheduler::GetCurrentStart (const Rung &rung) const
+{
+  return rung.start + rung.current * rung.width;
+}
+
+uint32_t
+LadderQueueScheduler::FindRung (uint64_t ts) const
+{
+  for (uint32_t i = 0; i < m_nRungs; ++i)
+    {
+      if (ts >= GetCurrentStart (m_rungs[i]))
+        {
+          return i;
+        }
+    }
+  return m_nRungs;
+}
+
+LadderQueueScheduler::Rung &
+LadderQueueScheduler::AddRung (uint64_t start, uint64_t span, uint32_t n)
+{
+  NS_LOG_FUNCTION (this << start << span << n);
+  NS_ASSERT (m_nRungs < MAX_RUNGS && span > 0);
+  if (m_rungs.size () == m_nRungs)
+    {
+      m_rungs.push_back (Rung ());
+    }
+  Rung &rung = m_rungs[m_nRungs];
+  m_nRungs++;
+  uint64_t nBuckets = std::min (std::max (n, 1U), MAX_BUCKETS);
+  rung.width = (span + nBuckets - 1) / nBuckets;
+  rung.start = start;
+  rung.current = 0;
+  rung.count = 0;
+  rung.nBuckets = static_cast<uint32_t> ((span + rung.width - 1) / rung.width);
+  if (rung.buckets.size () < rung.nBuckets)
+    {
+      rung.buckets.resize (rung.nBuckets);
+    }
+  return rung;
+}
+
+void
+LadderQueueScheduler::InsertInRung (Rung &rung, const Scheduler::Event &ev)
+{
+  uint64_t i = (ev.key.m_ts - rung.start) / rung.width;
+  NS_ASSERT (i >= rung.current && i < rung.nBuckets);
+  rung.buckets[i].push_back (ev);
+  ev.impl->SetSchedulerHandle (rung.buckets[i].size () - 1);
+  rung.count++;
+}
+
+void
+LadderQueueScheduler::InsertInBottom (const Scheduler::Event &ev)
+{
+  Bucket::iterator i = std::upper_bound (m_bottom.begin () + m_bottomHead,
+                                         m_bottom.end (), ev, &EventLess);
+  m_bottom.insert (i, ev);
+  if (m_bottom.size () - m_bottomHead <= m_bottomLimit || m_nRungs == MAX_RUNGS)
+    {
+      return;
+    }
+  // Bottom grew too long to keep sorted: spread it over a new rung, up to
+  // the first event of the Ladder
+  uint64_t start = m_bottom[m_bottomHead].key.m_ts;
+  uint64_t end = (m_nRungs > 0) ? GetCurrentStart (m_rungs[m_nRungs - 1]) : m_topStart;
+  NS_ASSERT (end > start);
+  Rung &rung = AddRung (start, end - start, m_bottom.size () - m_bottomHead);
+  for (std::size_t j = m_bottomHead; j < m_bottom.size (); ++j)
+    {
+      InsertInRung (rung, m_bottom[j]);
+    }
+  m_bottom.clear ();
+  m_bottomHead = 0;
+}
+
+void
+LadderQueueScheduler::TransferTop (void)
+{
+  NS_LOG_FUNCTION (this << m_top.size ());
+  NS_ASSERT (m_nRungs == 0 && !m_top.empty ());
+  Rung &rung = AddRung (m_topMin, m_topMax - m_topMin + 1, m_top.size ());
+  m_topStart = m_topMax + 1;
+  for (Bucket::const_iterator i = m_top.begin (); i != m_top.end (); ++i)
+    {
+      InsertInRung (rung, *i);
+    }
+  m_top.clear ();
+}
+
+void
+LadderQueueScheduler::FillBottom (void)
+{
+  if (m_bottomHead < m_bottom.size () || m_size == 0)
+    {
+      return;
+    }
+  m_bottom.clear ();
+  m_bottomHead = 0;
+  for (;;)
+    {
+      if (m_nRungs == 0)
+        {
+          TransferTop ();
+        }
+      Rung &rung = m_rungs[m_nRungs - 1];
+      if (rung.count == 0)
+        {
+          m_nRungs--;
+          continue;
+        }
+      while (rung.buckets[rung.current].empty ())
+        {
+          rung.current++;
+        }
+      uint64_t start = GetCurrentStart (rung);
+      uint64_t width = rung.width;
+      // Bottom is empty: use it to hold the events of the bucket
+      m_bottom.swap (rung.buckets[rung.current]);
+      rung.current++;
+      rung.count -= m_bottom.size ();
+      if (m_bottom.size () > BOTTOM_THRESHOLD && width > 1 && m_nRungs < MAX_RUNGS)
+        {
+          // too many events to sort: split the bucket into a new rung
+          Rung &child = AddRung (start, width, m_bottom.size ());
+          for (Bucket::const_iterator i = m_bottom.begin (); i != m_bottom.end (); ++i)
+            {
+              InsertInRung (child, *i);
+            }
+          m_bottom.clear ();
+          continue;
+        }
+      std::sort (m_bottom.begin (), m_bottom.end (), &EventLess);
+      m_bottomLimit = std::max<std::size_t> (BOTTOM_THRESHOLD, 2 * m_bottom.size ());
+      return;
+    }
+}
+
+void
+LadderQueueScheduler::Insert (const Scheduler::Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  uint64_t ts = ev.key.m_ts;
+  if (ts >= m_topStart)
+    {
+      if (m_top.empty ())
+        {
+          m_topMin = ts;
+          m_topMax = ts;
+        }
+      else
+        {
+          m_topMin = std::min (m_topMin, ts);
+          m_topMax = std::max (m_topMax, ts);
+        }
+      m_top.push_back (ev);
+      ev.impl->SetSchedulerHandle (m_top.size () - 1);
+    }
+  else
+    {
+      uint32_t i = FindRung (ts);
+      if (i < m_nRungs)
+        {
+          InsertInRung (m_rungs[i], ev);
+        }
+      else
+        {
+          InsertInBottom (ev);
+        }
+    }
+  m_size++;
+  FillBottom ();
+}
+
+bool
+LadderQueueScheduler::IsEmpty (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_size == 0;
+}
+
+Scheduler::Event
+LadderQueueScheduler::PeekNext (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  return m_bottom[m_bottomHead];
+}
+
+Scheduler::Event
+LadderQueueScheduler::RemoveNext (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  Scheduler::Event ev = m_bottom[m_bottomHead];
+  m_bottomHead++;
+  m_size--;
+  FillBottom ();
+  return ev;
+}
+
+void
+LadderQueueScheduler::Remove (const Scheduler::Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  uint64_t ts = ev.key.m_ts;
+  Bucket *bucket;
+  if (ts >= m_topStart)
+    {
+      bucket = &m_top;
+    }
+  else
+    {
+      uint32_t i = FindRung (ts);
+      if (i == m_nRungs)
+        {
+          Bucket::iterator j = std::lower_bound (m_bottom.begin () + m_bottomHead,
+                                                 m_bottom.end (), ev, &EventLess);
+          NS_ASSERT (j != m_bottom.end () && j->key == ev.key);
+          m_bottom.erase (j);
+          m_size--;
+          FillBottom ();
+          return;
+        }
+      Rung &rung = m_rungs[i];
+      bucket = &rung.buckets[(ts - rung.start) / rung.width];
+      rung.count--;
+    }
+  std::size_t j = ev.impl->GetSchedulerHandle ();
+  NS_ASSERT (j < bucket->size () && (*bucket)[j].key == ev.key);
+  (*bucket)[j] = bucket->back ();
+  (*bucket)[j].impl->SetSchedulerHandle (j);
+  bucket->pop_back ();
+  m_size--;
+}
+
+bool
+LadderQueueScheduler::IsRemoveFast (void) const
+{
+  return true;
+}
+
+} // namespace ns3
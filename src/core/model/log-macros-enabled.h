@@ -112,6 +112,24 @@
 #endif /* NS_LOG_APPEND_CONTEXT */
 
 
+/**
+ * \ingroup logging
+ * Check if a log level is both compiled in and enabled for the
+ * log component of the file.
+ *
+ * The first test is a constant: the statements of the levels above the
+ * compile time maximum level of the component (see ns3::LogGetMaxLevel)
+ * are removed by the compiler. The others only test the enabled levels
+ * of the component.
+ *
+ * \param [in] level The log level.
+ * \internal
+ * Logging implementation macro; should not be called directly.
+ */
+#define NS_LOG_IS_ENABLED(level)                                \
+  ((((level) & g_logMaxLevel) != 0) && g_log.IsEnabled (level))
+
+
 #ifndef NS_LOG_CONDITION
 /**
  * \ingroup logging
@@ -152,7 +170,7 @@
 #define NS_LOG(level, msg)                                      \
   NS_LOG_CONDITION                                              \
   do {                                                          \
-      if (g_log.IsEnabled (level))                              \
+      if (NS_LOG_IS_ENABLED (level))                            \
         {                                                       \
           NS_LOG_APPEND_TIME_PREFIX;                            \
           NS_LOG_APPEND_NODE_PREFIX;                            \
@@ -174,7 +192,7 @@
 #define NS_LOG_FUNCTION_NOARGS()                                \
   NS_LOG_CONDITION                                              \
   do {                                                          \
-      if (g_log.IsEnabled (ns3::LOG_FUNCTION))                  \
+      if (NS_LOG_IS_ENABLED (ns3::LOG_FUNCTION))                \
         {                                                       \
           NS_LOG_APPEND_TIME_PREFIX;                            \
           NS_LOG_APPEND_NODE_PREFIX;                            \
@@ -210,7 +228,7 @@
   NS_LOG_CONDITION                                              \
   do                                                            \
     {                                                           \
-      if (g_log.IsEnabled (ns3::LOG_FUNCTION))                  \
+      if (NS_LOG_IS_ENABLED (ns3::LOG_FUNCTION))                \
         {                                                       \
           NS_LOG_APPEND_TIME_PREFIX;                            \
           NS_LOG_APPEND_NODE_PREFIX;                            \
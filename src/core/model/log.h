@@ -27,8 +27,10 @@
 #include <map>
 #include <vector>
 
+#include "ns3/core-config.h"
 #include "node-printer.h"
 #include "time-printer.h"
+#include "unused.h"
 #include "log-macros-enabled.h"
 #include "log-macros-disabled.h"
 
@@ -81,6 +83,19 @@
  *   NS_LOG_FUNCTION (this << arg1 << args);
  * \endcode
  * Use NS_LOG_FUNCTION_NOARGS() only in static functions with no arguments.
+ *
+ * The logging statements can also be filtered at compile time, so that
+ * optimized builds keep some diagnostics at full speed:
+ * \code
+ *   $ ./waf configure -d optimized --log-max-level=warn \
+ *       --log-component-max-level=LteUeRrc=info:LteEnbRrc=info
+ * \endcode
+ * enables the logs, and compiles in the NS_LOG_ERROR and NS_LOG_WARN
+ * statements of every component, plus the NS_LOG_DEBUG and NS_LOG_INFO
+ * statements of the two RRC components. The statements of the more verbose
+ * levels are removed by the compiler; the others still have to be enabled
+ * at run time, as above. The log components of class templates, declared
+ * with NS_LOG_TEMPLATE_DECLARE, use the \c --log-max-level threshold.
  */
 /** @{ */
 
@@ -166,6 +181,67 @@ void LogComponentDisable (char const *name, enum LogLevel level);
 void LogComponentDisableAll (enum LogLevel level);
 
 
+#ifndef NS3_LOG_MAX_LEVEL
+/**
+ * The log levels compiled in by default, set by the \c --log-max-level
+ * configure option.
+ */
+#define NS3_LOG_MAX_LEVEL 0x0fffffff
+#endif
+
+#ifndef NS3_LOG_COMPONENT_MAX_LEVELS
+/**
+ * The list of LogComponentMaxLevel initializers, one per log component
+ * whose compiled in log levels differ from NS3_LOG_MAX_LEVEL, set by the
+ * \c --log-component-max-level configure option.
+ */
+#define NS3_LOG_COMPONENT_MAX_LEVELS
+#endif
+
+/**
+ * The log levels compiled in for a log component.
+ */
+struct LogComponentMaxLevel
+{
+  const char *name;  //!< The name of the log component, 0 at the end of the list.
+  int32_t levels;    //!< The levels compiled in.
+};
+
+/** The log components whose compiled in log levels are not the default. */
+static constexpr LogComponentMaxLevel g_logComponentMaxLevels[] = {
+  NS3_LOG_COMPONENT_MAX_LEVELS { 0, 0 }
+};
+
+/**
+ * Compare two log component names at compile time.
+ *
+ * \param [in] a A name.
+ * \param [in] b Another name.
+ * \returns \c true if the names are the same.
+ */
+constexpr bool
+LogIsSameName (const char *a, const char *b)
+{
+  return *a == *b && (*a == '\0' || LogIsSameName (a + 1, b + 1));
+}
+
+/**
+ * Get the log levels compiled in for a log component. This is a
+ * constant expression when \pname{name} is a string literal.
+ *
+ * \param [in] name The name of the log component.
+ * \param [in] i The first entry of g_logComponentMaxLevels to search.
+ * \returns The log levels compiled in.
+ */
+constexpr int32_t
+LogGetMaxLevel (const char *name, std::size_t i = 0)
+{
+  return g_logComponentMaxLevels[i].name == 0 ? NS3_LOG_MAX_LEVEL
+         : LogIsSameName (g_logComponentMaxLevels[i].name, name) ? g_logComponentMaxLevels[i].levels
+         : LogGetMaxLevel (name, i + 1);
+}
+
+
 } // namespace ns3
 
 
@@ -184,7 +260,7 @@ void LogComponentDisableAll (enum LogLevel level);
  *
  * This macro should be placed within namespace ns3.  If functions
  * outside of namespace ns3 require access to logging, the preferred
- * solution is to add the following 'using' directive at file scope,
+ * solution is to add the following 'using' declarations at file scope,
  * outside of namespace ns3, and after the inclusion of
  * NS_LOG_COMPONENT_DEFINE, such as follows:
  * \code
@@ -196,13 +272,19 @@ void LogComponentDisableAll (enum LogLevel level);
  *   } // namespace ns3
  *
  *   using ns3::g_log;
+ *   using ns3::g_logMaxLevel;
  *
  *   // Further definitions outside of the ns3 namespace
  *\endcode
  *
+ * The macro also defines \c g_logMaxLevel, the log levels compiled in
+ * for the component (see ns3::LogGetMaxLevel).
+ *
  * \param [in] name The log component name.
  */
 #define NS_LOG_COMPONENT_DEFINE(name)                           \
+  static const int32_t NS_UNUSED_GLOBAL (g_logMaxLevel) =       \
+    ns3::LogGetMaxLevel (name);                                 \
   static ns3::LogComponent g_log = ns3::LogComponent (name, __FILE__)
 
 /**
@@ -214,6 +296,8 @@ void LogComponentDisableAll (enum LogLevel level);
  * \param [in] mask The default mask.
  */
 #define NS_LOG_COMPONENT_DEFINE_MASK(name, mask)                \
+  static const int32_t NS_UNUSED_GLOBAL (g_logMaxLevel) =       \
+    ns3::LogGetMaxLevel (name);                                 \
   static ns3::LogComponent g_log = ns3::LogComponent (name, __FILE__, mask)
 
 /**
@@ -223,9 +307,12 @@ void LogComponentDisableAll (enum LogLevel level);
  * to allow their methods (defined in an header file) to make use of
  * the NS_LOG_* macros. This macro should be used in the private
  * section to prevent subclasses from using the same log component
- * as the base class.
+ * as the base class. The log levels compiled in are the default ones,
+ * NS3_LOG_MAX_LEVEL, since the name of the component is not known here.
  */
-#define NS_LOG_TEMPLATE_DECLARE  LogComponent & g_log
+#define NS_LOG_TEMPLATE_DECLARE                                 \
+  static const int32_t g_logMaxLevel = NS3_LOG_MAX_LEVEL;       \
+  LogComponent & g_log
 
 /**
  * Initialize a reference to a Log component.
@@ -246,7 +333,9 @@ void LogComponentDisableAll (enum LogLevel level);
  *
  * \param [in] name The log component name.
  */
-#define NS_LOG_STATIC_TEMPLATE_DEFINE(name) \
+#define NS_LOG_STATIC_TEMPLATE_DEFINE(name)                     \
+  static const int32_t NS_UNUSED_GLOBAL (g_logMaxLevel) =       \
+    ns3::LogGetMaxLevel (name);                                 \
   static LogComponent & NS_UNUSED_GLOBAL (g_log) = GetLogComponent (name)
 
 /**
@@ -354,7 +443,10 @@ public:
    * \param [in] level The level to check for.
    * \return \c true if we are enabled at \c level.
    */
-  bool IsEnabled (const enum LogLevel level) const;
+  inline bool IsEnabled (const enum LogLevel level) const
+  {
+    return (level & m_levels) != 0;
+  }
   /**
    * Check if all levels are disabled.
    *
@@ -316,6 +316,7 @@ EventImpl * MakeEvent (void (*f)(U1,U2,U3,U4,U5,U6), T1 a1, T2 a2, T3 a3, T4 a4,
 
 #include "event-impl.h"
 #include "type-traits.h"
+#include <utility>
 
 namespace ns3 {
 
@@ -363,7 +364,7 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj)
   {
   public:
     EventMemberImpl0 (OBJ obj, MEM function)
-      : m_obj (obj),
+      : m_obj (std::move (obj)),
         m_function (function)
     {}
     virtual ~EventMemberImpl0 ()
@@ -376,7 +377,7 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj)
     }
     OBJ m_obj;
     MEM m_function;
-  } *ev = new EventMemberImpl0 (obj, mem_ptr);
+  } *ev = new EventMemberImpl0 (std::move (obj), mem_ptr);
   return ev;
 }
 
@@ -390,9 +391,9 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj, T1 a1)
   {
   public:
     EventMemberImpl1 (OBJ obj, MEM function, T1 a1)
-      : m_obj (obj),
+      : m_obj (std::move (obj)),
         m_function (function),
-        m_a1 (a1)
+        m_a1 (std::move (a1))
     {}
 
   protected:
@@ -407,7 +408,7 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj, T1 a1)
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
-  } *ev = new EventMemberImpl1 (obj, mem_ptr, a1);
+  } *ev = new EventMemberImpl1 (std::move (obj), mem_ptr, std::move (a1));
   return ev;
 }
 
@@ -420,10 +421,10 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj, T1 a1, T2 a2)
   {
   public:
     EventMemberImpl2 (OBJ obj, MEM function, T1 a1, T2 a2)
-      : m_obj (obj),
+      : m_obj (std::move (obj)),
         m_function (function),
-        m_a1 (a1),
-        m_a2 (a2)
+        m_a1 (std::move (a1)),
+        m_a2 (std::move (a2))
     {}
 
   protected:
@@ -439,7 +440,7 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj, T1 a1, T2 a2)
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
-  } *ev = new EventMemberImpl2 (obj, mem_ptr, a1, a2);
+  } *ev = new EventMemberImpl2 (std::move (obj), mem_ptr, std::move (a1), std::move (a2));
   return ev;
 }
 
@@ -452,11 +453,11 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj, T1 a1, T2 a2, T3 a3)
   {
   public:
     EventMemberImpl3 (OBJ obj, MEM function, T1 a1, T2 a2, T3 a3)
-      : m_obj (obj),
+      : m_obj (std::move (obj)),
         m_function (function),
-        m_a1 (a1),
-        m_a2 (a2),
-        m_a3 (a3)
+        m_a1 (std::move (a1)),
+        m_a2 (std::move (a2)),
+        m_a3 (std::move (a3))
     {}
 
   protected:
@@ -473,7 +474,7 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj, T1 a1, T2 a2, T3 a3)
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
     typename TypeTraits<T3>::ReferencedType m_a3;
-  } *ev = new EventMemberImpl3 (obj, mem_ptr, a1, a2, a3);
+  } *ev = new EventMemberImpl3 (std::move (obj), mem_ptr, std::move (a1), std::move (a2), std::move (a3));
   return ev;
 }
 
@@ -486,12 +487,12 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj, T1 a1, T2 a2, T3 a3, T4 a4)
   {
   public:
     EventMemberImpl4 (OBJ obj, MEM function, T1 a1, T2 a2, T3 a3, T4 a4)
-      : m_obj (obj),
+      : m_obj (std::move (obj)),
         m_function (function),
-        m_a1 (a1),
-        m_a2 (a2),
-        m_a3 (a3),
-        m_a4 (a4)
+        m_a1 (std::move (a1)),
+        m_a2 (std::move (a2)),
+        m_a3 (std::move (a3)),
+        m_a4 (std::move (a4))
     {}
 
   protected:
@@ -509,7 +510,7 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj, T1 a1, T2 a2, T3 a3, T4 a4)
     typename TypeTraits<T2>::ReferencedType m_a2;
     typename TypeTraits<T3>::ReferencedType m_a3;
     typename TypeTraits<T4>::ReferencedType m_a4;
-  } *ev = new EventMemberImpl4 (obj, mem_ptr, a1, a2, a3, a4);
+  } *ev = new EventMemberImpl4 (std::move (obj), mem_ptr, std::move (a1), std::move (a2), std::move (a3), std::move (a4));
   return ev;
 }
 
@@ -523,13 +524,13 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj,
   {
   public:
     EventMemberImpl5 (OBJ obj, MEM function, T1 a1, T2 a2, T3 a3, T4 a4, T5 a5)
-      : m_obj (obj),
+      : m_obj (std::move (obj)),
         m_function (function),
-        m_a1 (a1),
-        m_a2 (a2),
-        m_a3 (a3),
-        m_a4 (a4),
-        m_a5 (a5)
+        m_a1 (std::move (a1)),
+        m_a2 (std::move (a2)),
+        m_a3 (std::move (a3)),
+        m_a4 (std::move (a4)),
+        m_a5 (std::move (a5))
     {}
 
   protected:
@@ -548,7 +549,7 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj,
     typename TypeTraits<T3>::ReferencedType m_a3;
     typename TypeTraits<T4>::ReferencedType m_a4;
     typename TypeTraits<T5>::ReferencedType m_a5;
-  } *ev = new EventMemberImpl5 (obj, mem_ptr, a1, a2, a3, a4, a5);
+  } *ev = new EventMemberImpl5 (std::move (obj), mem_ptr, std::move (a1), std::move (a2), std::move (a3), std::move (a4), std::move (a5));
   return ev;
 }
 
@@ -562,14 +563,14 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj,
   {
   public:
     EventMemberImpl6 (OBJ obj, MEM function, T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6)
-      : m_obj (obj),
+      : m_obj (std::move (obj)),
         m_function (function),
-        m_a1 (a1),
-        m_a2 (a2),
-        m_a3 (a3),
-        m_a4 (a4),
-        m_a5 (a5),
-        m_a6 (a6)
+        m_a1 (std::move (a1)),
+        m_a2 (std::move (a2)),
+        m_a3 (std::move (a3)),
+        m_a4 (std::move (a4)),
+        m_a5 (std::move (a5)),
+        m_a6 (std::move (a6))
     {}
 
   protected:
@@ -589,7 +590,7 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj,
     typename TypeTraits<T4>::ReferencedType m_a4;
     typename TypeTraits<T5>::ReferencedType m_a5;
     typename TypeTraits<T6>::ReferencedType m_a6;
-  } *ev = new EventMemberImpl6 (obj, mem_ptr, a1, a2, a3, a4, a5, a6);
+  } *ev = new EventMemberImpl6 (std::move (obj), mem_ptr, std::move (a1), std::move (a2), std::move (a3), std::move (a4), std::move (a5), std::move (a6));
   return ev;
 }
 
@@ -604,7 +605,7 @@ EventImpl * MakeEvent (void (*f)(U1), T1 a1)
 
     EventFunctionImpl1 (F function, T1 a1)
       : m_function (function),
-        m_a1 (a1)
+        m_a1 (std::move (a1))
     {}
 
   protected:
@@ -618,7 +619,7 @@ EventImpl * MakeEvent (void (*f)(U1), T1 a1)
     }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
-  } *ev = new EventFunctionImpl1 (f, a1);
+  } *ev = new EventFunctionImpl1 (f, std::move (a1));
   return ev;
 }
 
@@ -633,8 +634,8 @@ EventImpl * MakeEvent (void (*f)(U1,U2), T1 a1, T2 a2)
 
     EventFunctionImpl2 (F function, T1 a1, T2 a2)
       : m_function (function),
-        m_a1 (a1),
-        m_a2 (a2)
+        m_a1 (std::move (a1)),
+        m_a2 (std::move (a2))
     {}
 
   protected:
@@ -649,7 +650,7 @@ EventImpl * MakeEvent (void (*f)(U1,U2), T1 a1, T2 a2)
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
-  } *ev = new EventFunctionImpl2 (f, a1, a2);
+  } *ev = new EventFunctionImpl2 (f, std::move (a1), std::move (a2));
   return ev;
 }
 
@@ -665,9 +666,9 @@ EventImpl * MakeEvent (void (*f)(U1,U2,U3), T1 a1, T2 a2, T3 a3)
 
     EventFunctionImpl3 (F function, T1 a1, T2 a2, T3 a3)
       : m_function (function),
-        m_a1 (a1),
-        m_a2 (a2),
-        m_a3 (a3)
+        m_a1 (std::move (a1)),
+        m_a2 (std::move (a2)),
+        m_a3 (std::move (a3))
     {}
 
   protected:
@@ -683,7 +684,7 @@ EventImpl * MakeEvent (void (*f)(U1,U2,U3), T1 a1, T2 a2, T3 a3)
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
     typename TypeTraits<T3>::ReferencedType m_a3;
-  } *ev = new EventFunctionImpl3 (f, a1, a2, a3);
+  } *ev = new EventFunctionImpl3 (f, std::move (a1), std::move (a2), std::move (a3));
   return ev;
 }
 
@@ -699,10 +700,10 @@ EventImpl * MakeEvent (void (*f)(U1,U2,U3,U4), T1 a1, T2 a2, T3 a3, T4 a4)
 
     EventFunctionImpl4 (F function, T1 a1, T2 a2, T3 a3, T4 a4)
       : m_function (function),
-        m_a1 (a1),
-        m_a2 (a2),
-        m_a3 (a3),
-        m_a4 (a4)
+        m_a1 (std::move (a1)),
+        m_a2 (std::move (a2)),
+        m_a3 (std::move (a3)),
+        m_a4 (std::move (a4))
     {}
 
   protected:
@@ -719,7 +720,7 @@ EventImpl * MakeEvent (void (*f)(U1,U2,U3,U4), T1 a1, T2 a2, T3 a3, T4 a4)
     typename TypeTraits<T2>::ReferencedType m_a2;
     typename TypeTraits<T3>::ReferencedType m_a3;
     typename TypeTraits<T4>::ReferencedType m_a4;
-  } *ev = new EventFunctionImpl4 (f, a1, a2, a3, a4);
+  } *ev = new EventFunctionImpl4 (f, std::move (a1), std::move (a2), std::move (a3), std::move (a4));
   return ev;
 }
 
@@ -735,11 +736,11 @@ EventImpl * MakeEvent (void (*f)(U1,U2,U3,U4,U5), T1 a1, T2 a2, T3 a3, T4 a4, T5
 
     EventFunctionImpl5 (F function, T1 a1, T2 a2, T3 a3, T4 a4, T5 a5)
       : m_function (function),
-        m_a1 (a1),
-        m_a2 (a2),
-        m_a3 (a3),
-        m_a4 (a4),
-        m_a5 (a5)
+        m_a1 (std::move (a1)),
+        m_a2 (std::move (a2)),
+        m_a3 (std::move (a3)),
+        m_a4 (std::move (a4)),
+        m_a5 (std::move (a5))
     {}
 
   protected:
@@ -757,7 +758,7 @@ EventImpl * MakeEvent (void (*f)(U1,U2,U3,U4,U5), T1 a1, T2 a2, T3 a3, T4 a4, T5
     typename TypeTraits<T3>::ReferencedType m_a3;
     typename TypeTraits<T4>::ReferencedType m_a4;
     typename TypeTraits<T5>::ReferencedType m_a5;
-  } *ev = new EventFunctionImpl5 (f, a1, a2, a3, a4, a5);
+  } *ev = new EventFunctionImpl5 (f, std::move (a1), std::move (a2), std::move (a3), std::move (a4), std::move (a5));
   return ev;
 }
 
@@ -773,12 +774,12 @@ EventImpl * MakeEvent (void (*f)(U1,U2,U3,U4,U5,U6), T1 a1, T2 a2, T3 a3, T4 a4,
 
     EventFunctionImpl6 (F function, T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6)
       : m_function (function),
-        m_a1 (a1),
-        m_a2 (a2),
-        m_a3 (a3),
-        m_a4 (a4),
-        m_a5 (a5),
-        m_a6 (a6)
+        m_a1 (std::move (a1)),
+        m_a2 (std::move (a2)),
+        m_a3 (std::move (a3)),
+        m_a4 (std::move (a4)),
+        m_a5 (std::move (a5)),
+        m_a6 (std::move (a6))
     {}
 
   protected:
@@ -797,7 +798,7 @@ EventImpl * MakeEvent (void (*f)(U1,U2,U3,U4,U5,U6), T1 a1, T2 a2, T3 a3, T4 a4,
     typename TypeTraits<T4>::ReferencedType m_a4;
     typename TypeTraits<T5>::ReferencedType m_a5;
     typename TypeTraits<T6>::ReferencedType m_a6;
-  } *ev = new EventFunctionImpl6 (f, a1, a2, a3, a4, a5, a6);
+  } *ev = new EventFunctionImpl6 (f, std::move (a1), std::move (a2), std::move (a3), std::move (a4), std::move (a5), std::move (a6));
   return ev;
 }
 
@@ -109,4 +109,10 @@ MapScheduler::Remove (const Event &ev)
   m_list.erase (i);
 }
 
+bool
+MapScheduler::IsRemoveFast (void) const
+{
+  return true;
+}
+
 } // namespace ns3
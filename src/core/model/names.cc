@@ -22,7 +22,8 @@
 #include "assert.h"
 #include "abort.h"
 #include "names.h"
-#include "singleton.h"
+#include "non-copyable.h"
+#include "simulation-context.h"
 
 /**
  * \file
@@ -114,9 +115,9 @@ NameNode::~NameNode ()
 
 /**
  * \ingroup config
- * The singleton root Names object.
+ * The root Names object, one per SimulationContext.
  */
-class NamesPriv : public Singleton<NamesPriv>
+class NamesPriv : private NonCopyable
 {
 public:
   /** Constructor. */
@@ -124,6 +125,9 @@ public:
   /** Destructor. */
   ~NamesPriv ();
 
+  /** \return The root Names object of the current SimulationContext. */
+  static NamesPriv * Get (void);
+
   // Doxygen \copydoc bug: won't copy these docs, so we repeat them.
 
   /**
@@ -289,6 +293,13 @@ NamesPriv::~NamesPriv ()
   m_root.m_name = "";
 }
 
+NamesPriv *
+NamesPriv::Get (void)
+{
+  static ContextLocal<NamesPriv> names;
+  return &names.Get ();
+}
+
 void
 NamesPriv::Clear (void)
 {
@@ -32,6 +32,21 @@
 #include <ostream>
 #include <set>
 
+/**
+ * \ingroup time
+ * Qualifier of the Time functions which are \c constexpr when the
+ * resolution is fixed at compile time, with
+ * <tt>./waf configure --time-resolution=<unit></tt>.
+ * Otherwise the Time constructors record the Times, so that they can be
+ * converted if the resolution changes, and these functions are only
+ * \c inline.
+ */
+#ifdef NS3_TIME_RESOLUTION
+#define NS_TIME_CONSTEXPR constexpr
+#else
+#define NS_TIME_CONSTEXPR inline
+#endif
+
 /**
  * \file
  * \ingroup time
@@ -121,6 +136,18 @@ public:
     LAST = 10
   };
 
+  /** Default constructor, with value 0. */
+  NS_TIME_CONSTEXPR Time ()
+    : m_data (Marked (this, 0))
+  {}
+#ifdef NS3_TIME_RESOLUTION
+  // With a resolution fixed at compile time the Times are not recorded,
+  // so Time is trivially copyable and can be used in constant expressions.
+  Time (const Time & o) = default;
+  Time (Time && o) = default;
+  Time & operator = (const Time & o) = default;
+  ~Time () = default;
+#else  /* NS3_TIME_RESOLUTION */
   /**
    *  Assignment operator
    * \param [in] o Time to assign.
@@ -131,28 +158,14 @@ public:
     m_data = o.m_data;
     return *this;
   }
-  /** Default constructor, with value 0. */
-  inline Time ()
-    : m_data ()
-  {
-    if (g_markingTimes)
-      {
-        Mark (this);
-      }
-  }
   /**
    *  Copy constructor
    *
    * \param [in] o Time to copy
    */
   inline Time (const Time & o)
-    : m_data (o.m_data)
-  {
-    if (g_markingTimes)
-      {
-        Mark (this);
-      }
-  }
+    : m_data (Marked (this, o.m_data))
+  {}
 
   /**
    * Move constructor
@@ -160,13 +173,18 @@ public:
    * \param [in] o Time from which take the data
    */
   Time (Time &&o)
-    : m_data (o.m_data)
+    : m_data (Marked (this, o.m_data))
+  {}
+
+  /** Destructor */
+  ~Time ()
   {
     if (g_markingTimes)
       {
-        Mark (this);
+        Clear (this);
       }
   }
+#endif /* NS3_TIME_RESOLUTION */
   /**
    * \name Numeric constructors
    *  Construct from a numeric value.
@@ -178,69 +196,29 @@ public:
    *  \param [in] v The value.
    */
   explicit inline Time (double v)
-    : m_data (lround (v))
-  {
-    if (g_markingTimes)
-      {
-        Mark (this);
-      }
-  }
-  explicit inline Time (int v)
-    : m_data (v)
-  {
-    if (g_markingTimes)
-      {
-        Mark (this);
-      }
-  }
-  explicit inline Time (long int v)
-    : m_data (v)
-  {
-    if (g_markingTimes)
-      {
-        Mark (this);
-      }
-  }
-  explicit inline Time (long long int v)
-    : m_data (v)
-  {
-    if (g_markingTimes)
-      {
-        Mark (this);
-      }
-  }
-  explicit inline Time (unsigned int v)
-    : m_data (v)
-  {
-    if (g_markingTimes)
-      {
-        Mark (this);
-      }
-  }
-  explicit inline Time (unsigned long int v)
-    : m_data (v)
-  {
-    if (g_markingTimes)
-      {
-        Mark (this);
-      }
-  }
-  explicit inline Time (unsigned long long int v)
-    : m_data (v)
-  {
-    if (g_markingTimes)
-      {
-        Mark (this);
-      }
-  }
+    : m_data (Marked (this, lround (v)))
+  {}
+  explicit NS_TIME_CONSTEXPR Time (int v)
+    : m_data (Marked (this, v))
+  {}
+  explicit NS_TIME_CONSTEXPR Time (long int v)
+    : m_data (Marked (this, v))
+  {}
+  explicit NS_TIME_CONSTEXPR Time (long long int v)
+    : m_data (Marked (this, v))
+  {}
+  explicit NS_TIME_CONSTEXPR Time (unsigned int v)
+    : m_data (Marked (this, v))
+  {}
+  explicit NS_TIME_CONSTEXPR Time (unsigned long int v)
+    : m_data (Marked (this, v))
+  {}
+  explicit NS_TIME_CONSTEXPR Time (unsigned long long int v)
+    : m_data (Marked (this, v))
+  {}
   explicit inline Time (const int64x64_t & v)
-    : m_data (v.GetHigh ())
-  {
-    if (g_markingTimes)
-      {
-        Mark (this);
-      }
-  }
+    : m_data (Marked (this, v.GetHigh ()))
+  {}
   /**@}*/  // Numeric constructors
 
   /**
@@ -270,7 +248,7 @@ public:
    * Not to be confused with Min(Time,Time).
    * \returns the minimum representable Time.
    */
-  static Time Min ()
+  NS_TIME_CONSTEXPR static Time Min ()
   {
     return Time (std::numeric_limits<int64_t>::min ());
   }
@@ -279,20 +257,11 @@ public:
    * Not to be confused with Max(Time,Time).
    * \returns the maximum representable Time.
    */
-  static Time Max ()
+  NS_TIME_CONSTEXPR static Time Max ()
   {
     return Time (std::numeric_limits<int64_t>::max ());
   }
 
-  /** Destructor */
-  ~Time ()
-  {
-    if (g_markingTimes)
-      {
-        Clear (this);
-      }
-  }
-
   /**
    * Exactly equivalent to `t == 0`.
    * \return \c true if the time is zero, \c false otherwise.
@@ -412,7 +381,7 @@ public:
    * Get the raw time value, in the current resolution unit.
    * \returns The raw time value
    */
-  inline int64_t GetTimeStep (void) const
+  NS_TIME_CONSTEXPR int64_t GetTimeStep (void) const
   {
     return m_data;
   }
@@ -464,6 +433,14 @@ public:
    *  \param [in] unit The unit of \pname{value}
    *  \return The Time representing \pname{value} in \c unit
    */
+#ifdef NS3_TIME_RESOLUTION
+  static constexpr Time FromInteger (uint64_t value, enum Unit unit)
+  {
+    return Time (unit <= NS3_TIME_RESOLUTION
+                 ? value * UnitFactor (unit)
+                 : value / UnitFactor (unit));
+  }
+#else  /* NS3_TIME_RESOLUTION */
   inline static Time FromInteger (uint64_t value, enum Unit unit)
   {
     struct Information *info = PeekInformation (unit);
@@ -477,6 +454,7 @@ public:
       }
     return Time (value);
   }
+#endif /* NS3_TIME_RESOLUTION */
   inline static Time FromDouble (double value, enum Unit unit)
   {
     return From (int64x64_t (value), unit);
@@ -693,6 +671,73 @@ private:
    *  \param [in] time The Time instance to remove.
    */
   static void Clear (Time * const time);
+#ifdef NS3_TIME_RESOLUTION
+  /**
+   *  Initialize the value of a new Time.  The Times are not recorded
+   *  when the resolution is fixed.
+   *  \param [in] time The new Time.
+   *  \param [in] value The value of the new Time.
+   *  \return \pname{value}
+   */
+  static constexpr int64_t Marked (Time * const time, int64_t value)
+  {
+    return (void)time, value;
+  }
+  /**
+   *  \param [in] unit A unit.
+   *  \return The exponent of the power of ten in the size of \pname{unit},
+   *          in femtoseconds.
+   */
+  static constexpr int UnitPower (enum Unit unit)
+  {
+    return unit < MIN ? 17 : unit == MIN ? 16 : 15 - 3 * (unit - S);
+  }
+  /**
+   *  \param [in] unit A unit.
+   *  \return The size of \pname{unit} in femtoseconds, divided by
+   *          10 to the UnitPower().
+   */
+  static constexpr int64_t UnitCoefficient (enum Unit unit)
+  {
+    return unit == Y ? 315360 : unit == D ? 864 : unit == H ? 36 : unit == MIN ? 6 : 1;
+  }
+  /**
+   *  \param [in] n The exponent.
+   *  \return 10 to the \pname{n}.
+   */
+  static constexpr int64_t Pow10 (int n)
+  {
+    return n <= 0 ? 1 : 10 * Pow10 (n - 1);
+  }
+  /**
+   *  \param [in] unit A unit.
+   *  \return The ratio of the larger to the smaller of \pname{unit}
+   *          and the resolution.
+   */
+  static constexpr int64_t UnitFactor (enum Unit unit)
+  {
+    return unit <= NS3_TIME_RESOLUTION
+           ? Pow10 (UnitPower (unit) - UnitPower (NS3_TIME_RESOLUTION))
+           * UnitCoefficient (unit) / UnitCoefficient (NS3_TIME_RESOLUTION)
+           : Pow10 (UnitPower (NS3_TIME_RESOLUTION) - UnitPower (unit))
+           * UnitCoefficient (NS3_TIME_RESOLUTION) / UnitCoefficient (unit);
+  }
+#else  /* NS3_TIME_RESOLUTION */
+  /**
+   *  Record a new Time with the MarkedTimes, if they are recorded.
+   *  \param [in] time The new Time.
+   *  \param [in] value The value of the new Time.
+   *  \return \pname{value}
+   */
+  static inline int64_t Marked (Time * const time, int64_t value)
+  {
+    if (g_markingTimes)
+      {
+        Mark (time);
+      }
+    return value;
+  }
+#endif /* NS3_TIME_RESOLUTION */
   /**
    *  Convert existing Times to the new unit.
    *  \param [in] unit The Unit to convert existing Times to.
@@ -706,20 +751,20 @@ private:
    * \name Comparison operators
    * @{
    */
-  friend bool operator == (const Time & lhs, const Time & rhs);
-  friend bool operator != (const Time & lhs, const Time & rhs);
-  friend bool operator <= (const Time & lhs, const Time & rhs);
-  friend bool operator >= (const Time & lhs, const Time & rhs);
-  friend bool operator <  (const Time & lhs, const Time & rhs);
-  friend bool operator >  (const Time & lhs, const Time & rhs);
+  friend NS_TIME_CONSTEXPR bool operator == (const Time & lhs, const Time & rhs);
+  friend NS_TIME_CONSTEXPR bool operator != (const Time & lhs, const Time & rhs);
+  friend NS_TIME_CONSTEXPR bool operator <= (const Time & lhs, const Time & rhs);
+  friend NS_TIME_CONSTEXPR bool operator >= (const Time & lhs, const Time & rhs);
+  friend NS_TIME_CONSTEXPR bool operator <  (const Time & lhs, const Time & rhs);
+  friend NS_TIME_CONSTEXPR bool operator >  (const Time & lhs, const Time & rhs);
   friend bool operator <  (const Time & time,   const EventId & event);
   /**@}*/
   /**
    * \name Arithmetic operators
    * @{
    */
-  friend Time operator +  (const Time & lhs, const Time & rhs);
-  friend Time operator -  (const Time & lhs, const Time & rhs);
+  friend NS_TIME_CONSTEXPR Time operator +  (const Time & lhs, const Time & rhs);
+  friend NS_TIME_CONSTEXPR Time operator -  (const Time & lhs, const Time & rhs);
   friend Time operator *  (const Time & lhs, const int64x64_t & rhs);
   friend Time operator *  (const int64x64_t & lhs, const Time & rhs);
 
@@ -816,7 +861,7 @@ static bool NS_UNUSED_GLOBAL (g_TimeStaticInit) = Time::StaticInit ();
  * \param [in] rhs The second value
  * \returns \c true if the two input values are equal.
  */
-inline bool
+NS_TIME_CONSTEXPR bool
 operator == (const Time & lhs, const Time & rhs)
 {
   return lhs.m_data == rhs.m_data;
@@ -827,7 +872,7 @@ operator == (const Time & lhs, const Time & rhs)
  * \param [in] rhs The second value
  * \returns \c true if the two input values not are equal.
  */
-inline bool
+NS_TIME_CONSTEXPR bool
 operator != (const Time & lhs, const Time & rhs)
 {
   return lhs.m_data != rhs.m_data;
@@ -838,7 +883,7 @@ operator != (const Time & lhs, const Time & rhs)
  * \param [in] rhs The second value
  * \returns \c true if the first input value is less than or equal to the second input value.
  */
-inline bool
+NS_TIME_CONSTEXPR bool
 operator <= (const Time & lhs, const Time & rhs)
 {
   return lhs.m_data <= rhs.m_data;
@@ -849,7 +894,7 @@ operator <= (const Time & lhs, const Time & rhs)
  * \param [in] rhs The second value
  * \returns \c true if the first input value is greater than or equal to the second input value.
  */
-inline bool
+NS_TIME_CONSTEXPR bool
 operator >= (const Time & lhs, const Time & rhs)
 {
   return lhs.m_data >= rhs.m_data;
@@ -860,7 +905,7 @@ operator >= (const Time & lhs, const Time & rhs)
  * \param [in] rhs The second value
  * \returns \c true if the first input value is less than the second input value.
  */
-inline bool
+NS_TIME_CONSTEXPR bool
 operator < (const Time & lhs, const Time & rhs)
 {
   return lhs.m_data < rhs.m_data;
@@ -871,7 +916,7 @@ operator < (const Time & lhs, const Time & rhs)
  * \param [in] rhs The second value
  * \returns \c true if the first input value is greater than the second input value.
  */
-inline bool
+NS_TIME_CONSTEXPR bool
 operator > (const Time & lhs, const Time & rhs)
 {
   return lhs.m_data > rhs.m_data;
@@ -910,7 +955,7 @@ operator <  (const Time & time, const EventId & event)
  * \param [in] rhs The second value
  * \returns The sum of the two input values.
  */
-inline Time operator + (const Time & lhs, const Time & rhs)
+NS_TIME_CONSTEXPR Time operator + (const Time & lhs, const Time & rhs)
 {
   return Time (lhs.m_data + rhs.m_data);
 }
@@ -920,7 +965,7 @@ inline Time operator + (const Time & lhs, const Time & rhs)
  * \param [in] rhs The second value
  * \returns The difference of the two input values.
  */
-inline Time operator - (const Time & lhs, const Time & rhs)
+NS_TIME_CONSTEXPR Time operator - (const Time & lhs, const Time & rhs)
 {
   return Time (lhs.m_data - rhs.m_data);
 }
@@ -1283,7 +1328,7 @@ inline Time Seconds (int64x64_t value)
 {
   return Time::From (value, Time::S);
 }
-inline Time MilliSeconds (uint64_t value)
+NS_TIME_CONSTEXPR Time MilliSeconds (uint64_t value)
 {
   return Time::FromInteger (value, Time::MS);
 }
@@ -1291,7 +1336,7 @@ inline Time MilliSeconds (int64x64_t value)
 {
   return Time::From (value, Time::MS);
 }
-inline Time MicroSeconds (uint64_t value)
+NS_TIME_CONSTEXPR Time MicroSeconds (uint64_t value)
 {
   return Time::FromInteger (value, Time::US);
 }
@@ -1299,7 +1344,7 @@ inline Time MicroSeconds (int64x64_t value)
 {
   return Time::From (value, Time::US);
 }
-inline Time NanoSeconds (uint64_t value)
+NS_TIME_CONSTEXPR Time NanoSeconds (uint64_t value)
 {
   return Time::FromInteger (value, Time::NS);
 }
@@ -1307,7 +1352,7 @@ inline Time NanoSeconds (int64x64_t value)
 {
   return Time::From (value, Time::NS);
 }
-inline Time PicoSeconds (uint64_t value)
+NS_TIME_CONSTEXPR Time PicoSeconds (uint64_t value)
 {
   return Time::FromInteger (value, Time::PS);
 }
@@ -1315,7 +1360,7 @@ inline Time PicoSeconds (int64x64_t value)
 {
   return Time::From (value, Time::PS);
 }
-inline Time FemtoSeconds (uint64_t value)
+NS_TIME_CONSTEXPR Time FemtoSeconds (uint64_t value)
 {
   return Time::FromInteger (value, Time::FS);
 }
@@ -1334,7 +1379,7 @@ inline Time FemtoSeconds (int64x64_t value)
  * \return A Time.
  * \relates Time
  */
-inline Time TimeStep (uint64_t ts)
+NS_TIME_CONSTEXPR Time TimeStep (uint64_t ts)
 {
   return Time (ts);
 }
@@ -26,6 +26,8 @@
 
 #include <cstdlib>  // getenv
 #include <cstring>  // strlen
+#include <utility>
+#include <vector>
 
 /**
  * \file
@@ -81,6 +83,29 @@ ObjectBase::ConstructSelf (const AttributeConstructionList &attributes)
 {
   // loop over the inheritance tree back to the Object base class.
   NS_LOG_FUNCTION (this << &attributes);
+
+  // The name=value pairs of the env var, read once for all the attributes.
+  std::vector<std::pair<std::string, std::string> > envAttributes;
+  const char *envVar = getenv ("NS_ATTRIBUTE_DEFAULT");
+  if (envVar != 0 && std::strlen (envVar) > 0)
+    {
+      std::string env = envVar;
+      std::string::size_type cur = 0;
+      std::string::size_type next = 0;
+      while (next != std::string::npos)
+        {
+          next = env.find (";", cur);
+          std::string tmp = std::string (env, cur, next - cur);
+          std::string::size_type equal = tmp.find ("=");
+          if (equal != std::string::npos)
+            {
+              envAttributes.push_back (std::make_pair (tmp.substr (0, equal),
+                                                       tmp.substr (equal + 1, tmp.size () - equal - 1)));
+            }
+          cur = next + 1;
+        }
+    }
+
   TypeId tid = GetInstanceTypeId ();
   do
     {
@@ -88,7 +113,7 @@ ObjectBase::ConstructSelf (const AttributeConstructionList &attributes)
       NS_LOG_DEBUG ("construct tid=" << tid.GetName () << ", params=" << tid.GetAttributeN ());
       for (uint32_t i = 0; i < tid.GetAttributeN (); i++)
         {
-          struct TypeId::AttributeInformation info = tid.GetAttribute (i);
+          const struct TypeId::AttributeInformation &info = tid.PeekAttribute (i);
           NS_LOG_DEBUG ("try to construct \"" << tid.GetName () << "::" <<
                         info.name << "\"");
           // is this attribute stored in this AttributeConstructionList instance ?
@@ -126,32 +151,20 @@ ObjectBase::ConstructSelf (const AttributeConstructionList &attributes)
             }
 
           // No matching attribute value so we try to look at the env var.
-          const char *envVar = getenv ("NS_ATTRIBUTE_DEFAULT");
-          if (envVar != 0 && std::strlen (envVar) > 0)
+          if (!envAttributes.empty ())
             {
-              std::string env = envVar;
-              std::string::size_type cur = 0;
-              std::string::size_type next = 0;
-              while (next != std::string::npos)
+              std::string fullName = tid.GetAttributeFullName (i);
+              for (std::size_t j = 0; j < envAttributes.size (); ++j)
                 {
-                  next = env.find (";", cur);
-                  std::string tmp = std::string (env, cur, next - cur);
-                  std::string::size_type equal = tmp.find ("=");
-                  if (equal != std::string::npos)
+                  if (envAttributes[j].first == fullName)
                     {
-                      std::string name = tmp.substr (0, equal);
-                      std::string envval = tmp.substr (equal + 1, tmp.size () - equal - 1);
-                      if (name == tid.GetAttributeFullName (i))
+                      if (DoSet (info.accessor, info.checker, StringValue (envAttributes[j].second)))
                         {
-                          if (DoSet (info.accessor, info.checker, StringValue (envval)))
-                            {
-                              NS_LOG_DEBUG ("construct \"" << tid.GetName () << "::" <<
-                                            info.name << "\" from env var");
-                              break;
-                            }
+                          NS_LOG_DEBUG ("construct \"" << tid.GetName () << "::" <<
+                                        info.name << "\" from env var");
+                          break;
                         }
                     }
-                  cur = next + 1;
                 }
             }
 
@@ -172,6 +185,11 @@ ObjectBase::DoSet (Ptr<const AttributeAccessor> accessor,
                    const AttributeValue &value)
 {
   NS_LOG_FUNCTION (this << accessor << checker << &value);
+  if (checker->Check (value))
+    {
+      // the accessor copies the value out: no need for a valid copy
+      return accessor->Set (this, value);
+    }
   Ptr<AttributeValue> v = checker->CreateValidValue (value);
   if (v == 0)
     {
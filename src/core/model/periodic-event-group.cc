@@ -0,0 +1,313 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Amiraslan Haghrah
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "periodic-event-group.h"
+#include "simulator.h"
+#include "simulator-impl.h"
+#include "simulation-singleton.h"
+#include "assert.h"
+#include "log.h"
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+/**
+ * \file
+ * \ingroup events
+ * ns3::PeriodicEventGroup and ns3::PeriodicEventId implementations.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("PeriodicEventGroup");
+
+/**
+ * \ingroup events
+ * The groups of a simulation, by period and phase.
+ */
+typedef std::map<std::pair<uint64_t, uint64_t>, Ptr<PeriodicEventGroup> > PeriodicEventGroups;
+
+
+PeriodicEventId::PeriodicEventId ()
+  : m_group (0),
+    m_uid (0)
+{}
+
+PeriodicEventId::PeriodicEventId (const Ptr<PeriodicEventGroup> &group, uint32_t uid)
+  : m_group (group),
+    m_uid (uid)
+{}
+
+void
+PeriodicEventId::Cancel (void)
+{
+  if (m_group != 0)
+    {
+      m_group->Remove (m_uid);
+      m_group->Tidy ();
+      m_group = 0;
+    }
+}
+
+bool
+PeriodicEventId::IsRunning (void) const
+{
+  return m_group != 0 && m_group->IsRunning (m_uid);
+}
+
+
+PeriodicEventId
+PeriodicEventGroup::Schedule (const Time &delay, const Time &period,
+                              uint32_t context, const Callback<void> &callback)
+{
+  NS_LOG_FUNCTION (delay << period << context);
+  NS_ASSERT_MSG (delay.IsPositive () && period.IsStrictlyPositive (),
+                 "PeriodicEventGroup::Schedule(): negative delay or period");
+  uint64_t start = (Simulator::Now () + delay).GetTimeStep ();
+  Ptr<PeriodicEventGroup> group = Find (start, period.GetTimeStep ());
+  uint32_t uid = group->Add (start, context, callback);
+  group->Arm (start);
+  return PeriodicEventId (group, uid);
+}
+
+std::vector<PeriodicEventId>
+PeriodicEventGroup::Schedule (const Time &delay, const Time &period,
+                              const std::vector<Member> &members)
+{
+  NS_LOG_FUNCTION (delay << period << members.size ());
+  NS_ASSERT_MSG (delay.IsPositive () && period.IsStrictlyPositive (),
+                 "PeriodicEventGroup::Schedule(): negative delay or period");
+  std::vector<PeriodicEventId> ids;
+  if (members.empty ())
+    {
+      return ids;
+    }
+  ids.reserve (members.size ());
+  uint64_t start = (Simulator::Now () + delay).GetTimeStep ();
+  Ptr<PeriodicEventGroup> group = Find (start, period.GetTimeStep ());
+  group->m_slots.reserve (group->m_slots.size () + members.size ());
+  for (std::vector<Member>::const_iterator i = members.begin (); i != members.end (); ++i)
+    {
+      ids.push_back (PeriodicEventId (group, group->Add (start, i->context, i->callback)));
+    }
+  group->Arm (start);
+  return ids;
+}
+
+void
+PeriodicEventGroup::Cancel (const std::vector<PeriodicEventId> &ids)
+{
+  NS_LOG_FUNCTION (ids.size ());
+  for (std::vector<PeriodicEventId>::const_iterator i = ids.begin (); i != ids.end (); ++i)
+    {
+      if (i->m_group != 0)
+        {
+          i->m_group->Remove (i->m_uid);
+        }
+    }
+  // tidy each group once all its callbacks are removed
+  for (std::vector<PeriodicEventId>::const_iterator i = ids.begin (); i != ids.end (); ++i)
+    {
+      if (i->m_group != 0)
+        {
+          i->m_group->Tidy ();
+        }
+    }
+}
+
+Ptr<PeriodicEventGroup>
+PeriodicEventGroup::Find (uint64_t start, uint64_t period)
+{
+  PeriodicEventGroups *groups = SimulationSingleton<PeriodicEventGroups>::Get ();
+  Ptr<PeriodicEventGroup> &group = (*groups)[std::make_pair (period, start % period)];
+  if (group == 0)
+    {
+      NS_LOG_LOGIC ("new group, period " << period << " phase " << start % period);
+      group = Create<PeriodicEventGroup> (period);
+    }
+  return group;
+}
+
+PeriodicEventGroup::PeriodicEventGroup (uint64_t period)
+  : m_period (period),
+    m_nRunning (0),
+    m_nextUid (0),
+    m_next (0),
+    m_firing (false)
+{
+  NS_LOG_FUNCTION (this << period);
+}
+
+PeriodicEventGroup::~PeriodicEventGroup ()
+{
+  NS_LOG_FUNCTION (this);
+  m_event.Cancel ();
+}
+
+Time
+PeriodicEventGroup::GetPeriod (void) const
+{
+  return TimeStep (m_period);
+}
+
+uint32_t
+PeriodicEventGroup::GetN (void) const
+{
+  return m_nRunning;
+}
+
+uint32_t
+PeriodicEventGroup::Add (uint64_t start, uint32_t context, const Callback<void> &callback)
+{
+  NS_LOG_FUNCTION (this << start << context);
+  Slot slot;
+  slot.uid = m_nextUid++;
+  slot.running = true;
+  slot.context = context;
+  slot.start = start;
+  slot.callback = callback;
+  m_slots.push_back (slot);
+  m_nRunning++;
+  return slot.uid;
+}
+
+void
+PeriodicEventGroup::Arm (uint64_t start)
+{
+  if (m_firing)
+    {
+      // Fire schedules the next period, and invokes the callbacks added
+      // for now before returning
+      return;
+    }
+  if (m_event.IsRunning ())
+    {
+      if (m_next <= start)
+        {
+          return;
+        }
+      m_event.Cancel ();
+    }
+  m_next = start;
+  m_event = Simulator::Schedule (TimeStep (start) - Simulator::Now (),
+                                 &PeriodicEventGroup::Fire, this);
+}
+
+std::size_t
+PeriodicEventGroup::FindSlot (uint32_t uid) const
+{
+  // the slots are appended with increasing identifiers
+  std::size_t low = 0;
+  std::size_t high = m_slots.size ();
+  while (low < high)
+    {
+      std::size_t middle = low + (high - low) / 2;
+      if (m_slots[middle].uid < uid)
+        {
+          low = middle + 1;
+        }
+      else
+        {
+          high = middle;
+        }
+    }
+  if (low < m_slots.size () && m_slots[low].uid == uid)
+    {
+      return low;
+    }
+  return m_slots.size ();
+}
+
+void
+PeriodicEventGroup::Remove (uint32_t uid)
+{
+  NS_LOG_FUNCTION (this << uid);
+  std::size_t i = FindSlot (uid);
+  if (i < m_slots.size () && m_slots[i].running)
+    {
+      m_slots[i].running = false;
+      m_slots[i].callback = Callback<void> ();
+      m_nRunning--;
+    }
+}
+
+bool
+PeriodicEventGroup::IsRunning (uint32_t uid) const
+{
+  std::size_t i = FindSlot (uid);
+  return i < m_slots.size () && m_slots[i].running;
+}
+
+/**
+ * \ingroup events
+ * \param [in] slot A slot of a group.
+ * \returns \c true if the callback of the slot was removed.
+ */
+template <typename SLOT>
+static bool
+IsRemoved (const SLOT &slot)
+{
+  return !slot.running;
+}
+
+void
+PeriodicEventGroup::Tidy (void)
+{
+  if (m_firing)
+    {
+      return;
+    }
+  if (m_slots.size () - m_nRunning > m_nRunning)
+    {
+      m_slots.erase (std::remove_if (m_slots.begin (), m_slots.end (), &IsRemoved<Slot>),
+                     m_slots.end ());
+    }
+  if (m_nRunning == 0)
+    {
+      m_event.Cancel ();
+    }
+}
+
+void
+PeriodicEventGroup::Fire (void)
+{
+  NS_LOG_FUNCTION (this << m_nRunning);
+  uint64_t now = Simulator::Now ().GetTimeStep ();
+  Ptr<SimulatorImpl> impl = Simulator::GetImplementation ();
+  m_firing = true;
+  // the callbacks may add slots, so no reference to a slot is kept
+  for (std::size_t i = 0; i < m_slots.size (); ++i)
+    {
+      if (m_slots[i].running && m_slots[i].start <= now)
+        {
+          Callback<void> callback = m_slots[i].callback;
+          impl->InvokeWithContext (m_slots[i].context, callback);
+        }
+    }
+  m_firing = false;
+  Tidy ();
+  if (m_nRunning > 0)
+    {
+      m_next = now + m_period;
+      m_event = Simulator::Schedule (TimeStep (m_period), &PeriodicEventGroup::Fire, this);
+    }
+}
+
+} // namespace ns3
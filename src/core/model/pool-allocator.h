@@ -0,0 +1,265 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Amiraslan Haghrah
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#ifndef POOL_ALLOCATOR_H
+#define POOL_ALLOCATOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <stdint.h>
+
+/**
+ * \file
+ * \ingroup ptr
+ * ns3::PoolAllocator declaration and template implementation.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup ptr
+ *
+ * \brief Per-thread free lists of the objects of one class.
+ *
+ * A class which is allocated and released at a high rate, such as
+ * Packet, recycles the memory of its instances by defining its
+ * <tt>operator new</tt> and <tt>operator delete</tt> with Allocate and
+ * Deallocate:
+ *
+ * \code
+ *   void *
+ *   Packet::operator new (std::size_t size)
+ *   {
+ *     return PoolAllocator<Packet>::Allocate (size);
+ *   }
+ * \endcode
+ *
+ * Each thread keeps its own free list, so that no lock is taken; an
+ * object released by another thread than the one which allocated it
+ * goes to the free list of the releasing thread.  Only the objects of
+ * exactly \c sizeof(T) are pooled: those of subclasses are allocated
+ * by the system.  At most MAX_FREE objects are kept by thread, and the
+ * free lists are released to the system when the thread exits.
+ *
+ * \tparam T \explicit The class of the pooled objects.
+ */
+template <typename T>
+class PoolAllocator
+{
+public:
+  /** Maximum number of free objects kept by thread. */
+  static const uint32_t MAX_FREE = 16384;
+
+  /**
+   * Allocate an object from the free list of the calling thread.
+   * \param [in] size The size of the object.
+   * \return The object memory.
+   */
+  static void * Allocate (std::size_t size);
+  /**
+   * Release an object to the free list of the calling thread.
+   * \param [in] p The object memory.
+   * \param [in] size The size of the object.
+   */
+  static void Deallocate (void *p, std::size_t size);
+  /**
+   * Allocate the objects from the system from now on, e.g., to compare
+   * the performance or to check the memory accesses with valgrind.
+   */
+  static void Disable (void);
+  /** Allocate the objects from the free lists from now on (the default). */
+  static void Enable (void);
+  /** \returns \c true if the objects are allocated from the free lists. */
+  static bool IsEnabled (void);
+  /**
+   * \returns The number of objects allocated by the calling thread
+   *          while the pool was enabled.
+   */
+  static uint64_t GetNAllocations (void);
+  /**
+   * \returns The number of these allocations which reused a free
+   *          object, rather than calling the system allocator.
+   */
+  static uint64_t GetNReuses (void);
+
+private:
+  /** A free object. */
+  struct Block
+  {
+    Block *next;  //!< The next free object.
+  };
+
+  /** The free list of a thread. */
+  struct FreeList
+  {
+    FreeList ();
+    /** Release the free objects to the system. */
+    ~FreeList ();
+
+    Block *head;           //!< The free objects.
+    uint32_t nFree;        //!< The number of free objects.
+    uint64_t nAllocations; //!< The number of allocations.
+    uint64_t nReuses;      //!< The number of allocations of a free object.
+  };
+
+  /**
+   * \return The free list of the calling thread, or 0 if it was
+   *         already destroyed, at thread exit.
+   */
+  static FreeList * Get (void);
+
+  /** Flag \c true if the objects are allocated from the free lists. */
+  static std::atomic<bool> m_enabled;
+  /** The free list of each thread, trivially destructible. */
+  static thread_local FreeList *m_list;
+  /** Flag set when the free list of the thread is destroyed. */
+  static thread_local bool m_destroyed;
+};
+
+} // namespace ns3
+
+
+/********************************************************************
+ *  Implementation of the templates declared above.
+ ********************************************************************/
+
+namespace ns3 {
+
+template <typename T>
+std::atomic<bool> PoolAllocator<T>::m_enabled (true);
+template <typename T>
+thread_local typename PoolAllocator<T>::FreeList *PoolAllocator<T>::m_list = 0;
+template <typename T>
+thread_local bool PoolAllocator<T>::m_destroyed = false;
+
+template <typename T>
+PoolAllocator<T>::FreeList::FreeList ()
+  : head (0),
+    nFree (0),
+    nAllocations (0),
+    nReuses (0)
+{}
+
+template <typename T>
+PoolAllocator<T>::FreeList::~FreeList ()
+{
+  while (head != 0)
+    {
+      Block *block = head;
+      head = block->next;
+      ::operator delete (block);
+    }
+  m_list = 0;
+  m_destroyed = true;
+}
+
+template <typename T>
+typename PoolAllocator<T>::FreeList *
+PoolAllocator<T>::Get (void)
+{
+  if (m_list == 0 && !m_destroyed)
+    {
+      static thread_local FreeList list;
+      m_list = &list;
+    }
+  return m_list;
+}
+
+template <typename T>
+void *
+PoolAllocator<T>::Allocate (std::size_t size)
+{
+  if (size == sizeof (T) && m_enabled.load (std::memory_order_relaxed))
+    {
+      FreeList *list = Get ();
+      if (list != 0)
+        {
+          list->nAllocations++;
+          Block *block = list->head;
+          if (block != 0)
+            {
+              list->head = block->next;
+              list->nFree--;
+              list->nReuses++;
+              return block;
+            }
+        }
+    }
+  return ::operator new (size);
+}
+
+template <typename T>
+void
+PoolAllocator<T>::Deallocate (void *p, std::size_t size)
+{
+  if (size == sizeof (T) && m_enabled.load (std::memory_order_relaxed))
+    {
+      FreeList *list = Get ();
+      if (list != 0 && list->nFree < MAX_FREE)
+        {
+          Block *block = static_cast<Block *> (p);
+          block->next = list->head;
+          list->head = block;
+          list->nFree++;
+          return;
+        }
+    }
+  ::operator delete (p);
+}
+
+template <typename T>
+void
+PoolAllocator<T>::Disable (void)
+{
+  m_enabled = false;
+}
+
+template <typename T>
+void
+PoolAllocator<T>::Enable (void)
+{
+  m_enabled = true;
+}
+
+template <typename T>
+bool
+PoolAllocator<T>::IsEnabled (void)
+{
+  return m_enabled.load (std::memory_order_relaxed);
+}
+
+template <typename T>
+uint64_t
+PoolAllocator<T>::GetNAllocations (void)
+{
+  FreeList *list = Get ();
+  return list != 0 ? list->nAllocations : 0;
+}
+
+template <typename T>
+uint64_t
+PoolAllocator<T>::GetNReuses (void)
+{
+  FreeList *list = Get ();
+  return list != 0 ? list->nReuses : 0;
+}
+
+} // namespace ns3
+
+#endif /* POOL_ALLOCATOR_H */
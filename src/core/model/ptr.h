@@ -23,6 +23,7 @@
 
 #include <iostream>
 #include <stdint.h>
+#include <utility>
 #include "assert.h"
 
 /**
@@ -85,8 +86,9 @@ private:
     void operator delete (void *);
   };
 
-  /** Interoperate with const instances. */
-  friend class Ptr<const T>;
+  /** Interoperate with const instances, and move from derived types. */
+  template <typename U>
+  friend class Ptr;
 
   /**
    * Get a permanent pointer to the underlying object.
@@ -155,6 +157,21 @@ public:
    */
   template <typename U>
   Ptr (Ptr<U> const &o);
+  /**
+   * Move, taking over the reference of the other Ptr, which is left
+   * empty.  The reference count is not touched.
+   *
+   * \param [in] o The other Ptr instance.
+   */
+  Ptr (Ptr &&o);
+  /**
+   * Move from a Ptr to a derived, or non-const, type.
+   *
+   * \tparam U \deduced The type underlying the Ptr being moved.
+   * \param [in] o The Ptr to move.
+   */
+  template <typename U>
+  Ptr (Ptr<U> &&o);
   /** Destructor. */
   ~Ptr ();
   /**
@@ -164,6 +181,14 @@ public:
    * \return A reference to self.
    */
   Ptr<T> &operator = (Ptr const& o);
+  /**
+   * Move assignment, taking over the reference of the other Ptr,
+   * which is left empty.
+   *
+   * \param [in] o The other Ptr instance.
+   * \return A reference to self.
+   */
+  Ptr<T> &operator = (Ptr &&o);
   /**
    * An rvalue member access.
    * \returns A pointer to the underlying object.
@@ -208,6 +233,78 @@ public:
   operator Tester * () const;
 };
 
+/**
+ * \ingroup ptr
+ *
+ * \brief A borrowed, non-owning, view of an object held by a Ptr.
+ *
+ * Passing a Ptr by value costs a Ref and an Unref, and passing a
+ * <tt>const Ptr<const T> &</tt> a Ptr<T> still builds a temporary
+ * Ptr.  A PtrView is built from a Ptr, or from a Ptr to a derived or
+ * non-const type, without touching the reference count.  It is meant
+ * for parameters of functions which only use the object during the
+ * call; the caller keeps the object alive.  A function which keeps the
+ * object converts the view back to a Ptr, which takes a reference.
+ *
+ * \code
+ *   void Inspect (PtrView<const Packet> p);
+ *   Ptr<Packet> packet = Create<Packet> (100);
+ *   Inspect (packet);  // no Ref, no Unref
+ * \endcode
+ *
+ * \tparam T \explicit The type of the underlying object.
+ */
+template <typename T>
+class PtrView
+{
+public:
+  /** Create an empty view. */
+  PtrView ();
+  /**
+   * View the object held by a Ptr.
+   *
+   * \tparam U \deduced The type underlying the Ptr.
+   * \param [in] p The Ptr, which must outlive the view.
+   */
+  template <typename U>
+  PtrView (const Ptr<U> &p);
+  /**
+   * View an object by its raw pointer.
+   *
+   * \param [in] p The pointer.
+   */
+  PtrView (T *p);
+  /**
+   * Take a reference on the object.
+   * \returns A Ptr to the object.
+   */
+  operator Ptr<T> () const;
+  /**
+   * Member access.
+   * \returns A pointer to the underlying object.
+   */
+  T *operator -> () const;
+  /**
+   * Dereference.
+   * \returns A reference to the underlying object.
+   */
+  T &operator * () const;
+  /**
+   * Test for NULL pointer.
+   * \returns \c true if the view is empty.
+   */
+  bool operator! () const;
+  /**
+   * Get the underlying pointer, without taking a reference.
+   * \returns The pointer.
+   */
+  T *Peek (void) const;
+
+private:
+  /** The pointer. */
+  T *m_ptr;
+};
+
 /**
  * \ingroup ptr
  * Create class instances by constructors with varying numbers
@@ -226,7 +323,7 @@ public:
  */
 template <typename T,
           typename... Ts>
-Ptr<T> Create (Ts... args);
+Ptr<T> Create (Ts&&... args);
 
 /** @}*/
 
@@ -241,6 +338,17 @@ Ptr<T> Create (Ts... args);
 template <typename T>
 std::ostream &operator << (std::ostream &os, const Ptr<T> &p);
 
+/**
+ * \ingroup ptr
+ * Output streamer.
+ * \tparam T \deduced The type of the underlying Object.
+ * \param [in,out] os The output stream.
+ * \param [in] p The PtrView.
+ * \returns The stream.
+ */
+template <typename T>
+std::ostream &operator << (std::ostream &os, const PtrView<T> &p);
+
 /**
  * \ingroup ptr
  * Equality operator.
@@ -354,6 +462,9 @@ template <typename T>
 struct CallbackTraits<Ptr<T> >
 {
   /**
+   * The Ptr is copied on purpose: the copy keeps the object alive
+   * until the end of the call, even if the call releases the callback.
+   *
    * \param [in] p Object pointer
    * \return A reference to the object pointed to by p
    */
@@ -384,7 +495,7 @@ struct EventMemberImplObjTraits<Ptr<T> >
    * \param [in] p Object pointer
    * \return A reference to the object pointed to by p
    */
-  static T & GetReference (Ptr<T> p)
+  static T & GetReference (Ptr<T> const &p)
   {
     return *PeekPointer (p);
   }
@@ -402,9 +513,9 @@ namespace ns3 {
  ************************************************/
 
 template <typename T, typename... Ts>
-Ptr<T> Create (Ts... args)
+Ptr<T> Create (Ts&&... args)
 {
-  return Ptr<T> (new T (args...), false);
+  return Ptr<T> (new T (std::forward<Ts> (args)...), false);
 }
 
 template <typename U>
@@ -420,6 +531,20 @@ U * GetPointer (const Ptr<U> &p)
   return p.m_ptr;
 }
 
+/**
+ * \ingroup ptr
+ * Get the pointer of a PtrView.
+ *
+ * \tparam U \deduced The type of the underlying object.
+ * \param [in] p The view.
+ * \return The pointer, without taking a reference.
+ */
+template <typename U>
+U * PeekPointer (const PtrView<U> &p)
+{
+  return p.Peek ();
+}
+
 template <typename T>
 std::ostream &operator << (std::ostream &os, const Ptr<T> &p)
 {
@@ -427,6 +552,13 @@ std::ostream &operator << (std::ostream &os, const Ptr<T> &p)
   return os;
 }
 
+template <typename T>
+std::ostream &operator << (std::ostream &os, const PtrView<T> &p)
+{
+  os << PeekPointer (p);
+  return os;
+}
+
 template <typename T1, typename T2>
 bool
 operator == (Ptr<T1> const &lhs, T2 const *rhs)
@@ -597,6 +729,21 @@ Ptr<T>::Ptr (Ptr<U> const &o)
   Acquire ();
 }
 
+template <typename T>
+Ptr<T>::Ptr (Ptr &&o)
+  : m_ptr (o.m_ptr)
+{
+  o.m_ptr = 0;
+}
+
+template <typename T>
+template <typename U>
+Ptr<T>::Ptr (Ptr<U> &&o)
+  : m_ptr (o.m_ptr)
+{
+  o.m_ptr = 0;
+}
+
 template <typename T>
 Ptr<T>::~Ptr ()
 {
@@ -623,6 +770,24 @@ Ptr<T>::operator = (Ptr const& o)
   return *this;
 }
 
+template <typename T>
+Ptr<T> &
+Ptr<T>::operator = (Ptr &&o)
+{
+  if (&o == this)
+    {
+      return *this;
+    }
+  T *old = m_ptr;
+  m_ptr = o.m_ptr;
+  o.m_ptr = 0;
+  if (old != 0)
+    {
+      old->Unref ();
+    }
+  return *this;
+}
+
 template <typename T>
 T *
 Ptr<T>::operator -> ()
@@ -673,6 +838,58 @@ Ptr<T>::operator Tester * () const
   return &test;
 }
 
+template <typename T>
+PtrView<T>::PtrView ()
+  : m_ptr (0)
+{}
+
+template <typename T>
+template <typename U>
+PtrView<T>::PtrView (const Ptr<U> &p)
+  : m_ptr (PeekPointer (p))
+{}
+
+template <typename T>
+PtrView<T>::PtrView (T *p)
+  : m_ptr (p)
+{}
+
+template <typename T>
+PtrView<T>::operator Ptr<T> () const
+{
+  return Ptr<T> (m_ptr);
+}
+
+template <typename T>
+T *
+PtrView<T>::operator -> () const
+{
+  NS_ASSERT_MSG (m_ptr, "Attempted to dereference zero pointer");
+  return m_ptr;
+}
+
+template <typename T>
+T &
+PtrView<T>::operator * () const
+{
+  NS_ASSERT_MSG (m_ptr, "Attempted to dereference zero pointer");
+  return *m_ptr;
+}
+
+template <typename T>
+bool
+PtrView<T>::operator! () const
+{
+  return m_ptr == 0;
+}
+
+template <typename T>
+T *
+PtrView<T>::Peek (void) const
+{
+  return m_ptr;
+}
+
 
 } // namespace ns3
 
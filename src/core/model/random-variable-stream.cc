@@ -132,6 +132,16 @@ RandomVariableStream::GetStream (void) const
   return m_stream;
 }
 
+void
+RandomVariableStream::GetValues (double *values, std::size_t n)
+{
+  NS_LOG_FUNCTION (this << values << n);
+  for (std::size_t i = 0; i < n; ++i)
+    {
+      values[i] = GetValue ();
+    }
+}
+
 RngStream *
 RandomVariableStream::Peek (void) const
 {
@@ -209,6 +219,21 @@ UniformRandomVariable::GetInteger (void)
   NS_LOG_FUNCTION (this);
   return (uint32_t)GetValue (m_min, m_max + 1);
 }
+void
+UniformRandomVariable::GetValues (double *values, std::size_t n)
+{
+  NS_LOG_FUNCTION (this << values << n);
+  Peek ()->RandU01 (values, n);
+  for (std::size_t i = 0; i < n; ++i)
+    {
+      double v = m_min + values[i] * (m_max - m_min);
+      if (IsAntithetic ())
+        {
+          v = m_min + (m_max - v);
+        }
+      values[i] = v;
+    }
+}
 
 NS_OBJECT_ENSURE_REGISTERED (ConstantRandomVariable);
 
@@ -445,6 +470,32 @@ ExponentialRandomVariable::GetInteger (void)
   NS_LOG_FUNCTION (this);
   return (uint32_t)GetValue (m_mean, m_bound);
 }
+void
+ExponentialRandomVariable::GetValues (double *values, std::size_t n)
+{
+  NS_LOG_FUNCTION (this << values << n);
+  std::size_t i = 0;
+  while (i < n)
+    {
+      // draw a uniform number per missing value, in place; the values
+      // rejected by the bound are replaced by those of the next block
+      std::size_t end = n;
+      Peek ()->RandU01 (values + i, end - i);
+      for (std::size_t j = i; j < end; ++j)
+        {
+          double v = values[j];
+          if (IsAntithetic ())
+            {
+              v = (1 - v);
+            }
+          double r = -m_mean * std::log (v);
+          if (m_bound == 0 || r <= m_bound)
+            {
+              values[i++] = r;
+            }
+        }
+    }
+}
 
 NS_OBJECT_ENSURE_REGISTERED (ParetoRandomVariable);
 
@@ -1553,6 +1604,13 @@ EmpiricalRandomVariable::GetTypeId (void)
                    BooleanValue (false),
                    MakeBooleanAccessor (&EmpiricalRandomVariable::m_interpolate),
                    MakeBooleanChecker ())
+    .AddAttribute ("Alias",
+                   "In sampling mode, sample the CDF with a Walker alias table, "
+                   "in constant time; the distribution is the same, but not the "
+                   "sequence of values.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&EmpiricalRandomVariable::m_alias),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
@@ -1596,6 +1654,13 @@ EmpiricalRandomVariable::PreSample (double & value)
     }
  
   value = r;
+  return Extremum (value);
+}
+
+bool
+EmpiricalRandomVariable::Extremum (double & value) const
+{
+  double r = value;
   bool valid = false;
   // check extrema
   if (r <= m_emp.front ().cdf)
@@ -1616,8 +1681,52 @@ EmpiricalRandomVariable::GetValue (void)
 {
   NS_LOG_FUNCTION (this);
 
-  double value;
-  if (PreSample (value))
+  if (!m_validated)
+    {
+      Validate ();
+    }
+
+  // Get a uniform random variable in [0, 1].
+  double r = Peek ()->RandU01 ();
+  if (IsAntithetic ())
+    {
+      r = (1 - r);
+    }
+  return Sample (r);
+}
+
+void
+EmpiricalRandomVariable::GetValues (double *values, std::size_t n)
+{
+  NS_LOG_FUNCTION (this << values << n);
+
+  if (!m_validated)
+    {
+      Validate ();
+    }
+
+  Peek ()->RandU01 (values, n);
+  for (std::size_t i = 0; i < n; ++i)
+    {
+      double r = values[i];
+      if (IsAntithetic ())
+        {
+          r = (1 - r);
+        }
+      values[i] = Sample (r);
+    }
+}
+
+double
+EmpiricalRandomVariable::Sample (double r)
+{
+  if (m_alias && !m_interpolate)
+    {
+      return DoSampleAlias (r);
+    }
+
+  double value = r;
+  if (Extremum (value))
     {
       return value;
     }
@@ -1634,15 +1743,50 @@ EmpiricalRandomVariable::GetValue (void)
   return value;
 }
 
+std::size_t
+EmpiricalRandomVariable::FindUpper (double r) const
+{
+  // the grid cell of r may be off by one when r is close to its edge, so
+  // the search goes either way; the last point, with a CDF of 1, stops it
+  std::size_t k = static_cast<std::size_t> (r * m_grid.size ());
+  if (k >= m_grid.size ())
+    {
+      k = m_grid.size () - 1;
+    }
+  std::size_t i = m_grid[k];
+  while (i > 0 && m_emp[i - 1].cdf > r)
+    {
+      --i;
+    }
+  while (m_emp[i].cdf <= r)
+    {
+      ++i;
+    }
+  return i;
+}
+
 double
 EmpiricalRandomVariable::DoSampleCDF (double r)
 {
   NS_LOG_FUNCTION (this << r);
   
-  ValueCDF selector (0, r);
-  auto bound = std::upper_bound (m_emp.begin (), m_emp.end (), selector);
-  
-  return bound->value;
+  return m_emp[FindUpper (r)].value;
+}
+
+double
+EmpiricalRandomVariable::DoSampleAlias (double r) const
+{
+  double x = r * m_aliasKeep.size ();
+  std::size_t i = static_cast<std::size_t> (x);
+  if (i >= m_aliasKeep.size ())
+    {
+      i = m_aliasKeep.size () - 1;
+    }
+  if (x - i < m_aliasKeep[i])
+    {
+      return m_emp[i].value;
+    }
+  return m_emp[m_aliasIndex[i]].value;
 }
 
 double
@@ -1670,8 +1814,7 @@ EmpiricalRandomVariable::DoInterpolate (double r)
   // This code based (loosely) on code by Bruce Mah (Thanks Bruce!)
 
   // search
-  ValueCDF selector (0, r);
-  auto upper = std::upper_bound (m_emp.begin (), m_emp.end (), selector);
+  auto upper = m_emp.begin () + FindUpper (r);
   auto lower = std::prev (upper, 1);
   if (upper == m_emp.begin ())
     {
@@ -1695,6 +1838,8 @@ EmpiricalRandomVariable::CDF (double v, double c)
   // NOTE.   These MUST be inserted in non-decreasing order
   NS_LOG_FUNCTION (this << v << c);
   m_emp.push_back (ValueCDF (v, c));
+  // validate again, and rebuild the tables, on the next draw
+  m_validated = false;
 }
 
 void
@@ -1723,7 +1868,74 @@ EmpiricalRandomVariable::Validate (void)
     {
       NS_FATAL_ERROR ("CDF does not cover the whole distribution");
     }
+  BuildTables ();
   m_validated = true;
 }
 
+void
+EmpiricalRandomVariable::BuildTables (void)
+{
+  NS_LOG_FUNCTION (this);
+  std::size_t n = m_emp.size ();
+
+  // the first point above the start of each grid cell
+  m_grid.resize (n);
+  std::size_t j = 0;
+  for (std::size_t k = 0; k < n; ++k)
+    {
+      double start = static_cast<double> (k) / n;
+      while (j < n - 1 && m_emp[j].cdf <= start)
+        {
+          ++j;
+        }
+      m_grid[k] = static_cast<uint32_t> (j);
+    }
+
+  // Vose's construction of the alias table: the columns with less than
+  // the mean probability take the rest of their column from a larger one
+  m_aliasKeep.resize (n);
+  m_aliasIndex.resize (n);
+  std::vector<double> scaled (n);
+  std::vector<uint32_t> small;
+  std::vector<uint32_t> large;
+  double prior = 0;
+  for (std::size_t i = 0; i < n; ++i)
+    {
+      scaled[i] = (m_emp[i].cdf - prior) * n;
+      prior = m_emp[i].cdf;
+      m_aliasIndex[i] = static_cast<uint32_t> (i);
+      if (scaled[i] < 1.0)
+        {
+          small.push_back (static_cast<uint32_t> (i));
+        }
+      else
+        {
+          large.push_back (static_cast<uint32_t> (i));
+        }
+    }
+  while (!small.empty () && !large.empty ())
+    {
+      uint32_t less = small.back ();
+      small.pop_back ();
+      uint32_t more = large.back ();
+      m_aliasKeep[less] = scaled[less];
+      m_aliasIndex[less] = more;
+      scaled[more] = (scaled[more] + scaled[less]) - 1.0;
+      if (scaled[more] < 1.0)
+        {
+          large.pop_back ();
+          small.push_back (more);
+        }
+    }
+  // the columns left are full, but for rounding errors
+  for (std::vector<uint32_t>::const_iterator i = small.begin (); i != small.end (); ++i)
+    {
+      m_aliasKeep[*i] = 1.0;
+    }
+  for (std::vector<uint32_t>::const_iterator i = large.begin (); i != large.end (); ++i)
+    {
+      m_aliasKeep[*i] = 1.0;
+    }
+}
+
 } // namespace ns3
@@ -30,6 +30,7 @@
 #include "object.h"
 #include "attribute-helper.h"
 #include <stdint.h>
+#include <cstddef>
 
 /**
  * \file
@@ -149,6 +150,19 @@ public:
    */
   virtual uint32_t GetInteger (void) = 0;
 
+  /**
+   * \brief Get the next random values drawn from the distribution, the
+   * values which as many calls to GetValue (void) would return.
+   *
+   * The default implementation calls GetValue (void). The distributions
+   * which transform their uniform numbers one by one draw them by block
+   * from the RngStream instead.
+   *
+   * \param [out] values The random values.
+   * \param [in] n The number of values.
+   */
+  virtual void GetValues (double *values, std::size_t n);
+
 protected:
   /**
    * \brief Get the pointer to the underlying RngStream.
@@ -294,6 +308,7 @@ public:
    * \note The upper limit is included in the output range.
    */
   virtual uint32_t GetInteger (void);
+  virtual void GetValues (double *values, std::size_t n);
 
 private:
   /** The lower bound on values that can be returned by this RNG stream. */
@@ -586,6 +601,7 @@ public:
   // Inherited from RandomVariableStream
   virtual double GetValue (void);
   virtual uint32_t GetInteger (void);
+  virtual void GetValues (double *values, std::size_t n);
 
 private:
   /** The mean value of the unbounded exponential distribution. */
@@ -2475,6 +2491,17 @@ private:
  *
  * This will return continuous values on the range [0,1).
  *
+ * The point of the CDF above the uniform random value is found in
+ * constant expected time: a table, built on the first draw after the CDF
+ * changes, gives the first point above each cell of a uniform grid of
+ * [0,1], and the search starts there. The values are the same as with a
+ * binary search of the CDF.
+ *
+ * In sampling mode, the \c Alias Attribute selects a Walker alias table
+ * instead, which takes constant time whatever the CDF. The values have the
+ * same distribution, but the uniform random values map to other values of
+ * the CDF, so that the sequence of values changes.
+ *
  * See empirical-random-variable-example.cc for an example.
  */
 class EmpiricalRandomVariable : public RandomVariableStream
@@ -2548,6 +2575,15 @@ public:
    */
   bool SetInterpolate (bool interpolate);
 
+  /**
+   * \brief Get the next values in the empirical distribution, the values
+   * which as many calls to GetValue (void) would return.
+   *
+   * \param [out] values The values.
+   * \param [in] n The number of values.
+   */
+  virtual void GetValues (double *values, std::size_t n);
+
 private:
   /** \brief Helper to hold one point of the CDF. */
   class ValueCDF
@@ -2570,7 +2606,7 @@ private:
   };  // class ValueCDF
 
   /**
-   * \brief Check that the CDF is valid.
+   * \brief Check that the CDF is valid, and build the sampling tables.
    *
    * A valid CDF has
    *
@@ -2580,6 +2616,36 @@ private:
    * It is a fatal error to fail validation.
    */
   void Validate (void);
+  /** \brief Build the grid and alias tables of a valid CDF. */
+  void BuildTables (void);
+  /**
+   * \brief Check the uniform random value against the extrema.
+   *
+   * \param [in,out] value The uniform random value, replaced by the
+   *                  extremal value if the extrema apply.
+   * \returns \c true if \p value is the extremal result.
+   */
+  bool Extremum (double & value) const;
+  /**
+   * \brief Get the value of the distribution for a uniform random value,
+   * in the current mode.
+   * \param [in] r The uniform random value, antithetic if configured.
+   * \returns The value.
+   */
+  double Sample (double r);
+  /**
+   * \brief Find the first CDF point above a uniform random value, as
+   * std::upper_bound would, starting from the grid table.
+   * \param [in] r The uniform random value, between the extrema.
+   * \returns The index of the point.
+   */
+  std::size_t FindUpper (double r) const;
+  /**
+   * \brief Sample the CDF with the alias table.
+   * \param [in] r The uniform random value.
+   * \return The value of the selected CDF point.
+   */
+  double DoSampleAlias (double r) const;
    /**
    * \brief Do the initial rng draw and check against the extrema.
    *
@@ -2627,6 +2693,20 @@ private:
    * otherwise treat CDF as normal histogram.
    */
   bool m_interpolate;
+  /** If \c true GetValue samples the CDF with the alias table. */
+  bool m_alias;
+  /**
+   * The index of the first CDF point above each cell of a uniform grid
+   * of [0,1], with one cell per point.
+   */
+  std::vector<uint32_t> m_grid;
+  /**
+   * The alias table: the probability to keep each column of the table,
+   * rather than take its alias.
+   */
+  std::vector<double> m_aliasKeep;
+  /** The alias table: the alias of each column of the table. */
+  std::vector<uint32_t> m_aliasIndex;
 
 };  // class EmpiricalRandomVariable
 
@@ -90,6 +90,7 @@ RealtimeSimulatorImpl::RealtimeSimulatorImpl ()
   m_currentTs = 0;
   m_currentContext = Simulator::NO_CONTEXT;
   m_unscheduledEvents = 0;
+  m_cancelledEvents = 0;
   m_eventCount = 0;
 
   m_main = SystemThread::Self ();
@@ -332,6 +333,10 @@ RealtimeSimulatorImpl::ProcessOneEvent (void)
     next = m_events->RemoveNext ();
     m_unscheduledEvents--;
     m_eventCount++;
+    if (next.impl->IsCancelled ())
+      {
+        m_cancelledEvents--;
+      }
 
     //
     // We cannot make any assumption that "next" is the same event we originally waited
@@ -751,10 +756,19 @@ RealtimeSimulatorImpl::Remove (const EventId &id)
 void
 RealtimeSimulatorImpl::Cancel (const EventId &id)
 {
-  if (IsExpired (id) == false)
+  if (IsExpired (id))
+    {
+      return;
+    }
+  if (id.GetUid () == 2 || m_events->IsRemoveFast ())
     {
-      id.PeekEventImpl ()->Cancel ();
+      // leave no dead event in the lists
+      Remove (id);
+      return;
     }
+  CriticalSection cs (m_mutex);
+  id.PeekEventImpl ()->Cancel ();
+  m_cancelledEvents++;
 }
 
 bool
@@ -825,6 +839,29 @@ RealtimeSimulatorImpl::GetEventCount (void) const
   return m_eventCount;
 }
 
+uint32_t
+RealtimeSimulatorImpl::GetLiveEventCount (void) const
+{
+  CriticalSection cs (m_mutex);
+  return m_unscheduledEvents - m_cancelledEvents;
+}
+
+uint32_t
+RealtimeSimulatorImpl::GetCancelledEventCount (void) const
+{
+  CriticalSection cs (m_mutex);
+  return m_cancelledEvents;
+}
+
+void
+RealtimeSimulatorImpl::InvokeWithContext (uint32_t context, const Callback<void> &callback)
+{
+  uint32_t previous = m_currentContext;
+  m_currentContext = context;
+  callback ();
+  m_currentContext = previous;
+}
+
 void
 RealtimeSimulatorImpl::SetSynchronizationMode (enum SynchronizationMode mode)
 {
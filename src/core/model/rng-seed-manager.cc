@@ -23,6 +23,7 @@
 #include "uinteger.h"
 #include "config.h"
 #include "log.h"
+#include "simulation-context.h"
 
 /**
  * \file
@@ -36,10 +37,38 @@ NS_LOG_COMPONENT_DEFINE ("RngSeedManager");
 
 /**
  * \relates RngSeedManager
- * The next random number generator stream number to use
- * for automatic assignment.
+ * The random number generator state of a SimulationContext.
  */
-static uint64_t g_nextStreamIndex = 0;
+struct RngState
+{
+  RngState ()
+    : seed (0),
+      hasRun (false),
+      run (0),
+      nextStreamIndex (0)
+  {}
+  uint32_t seed;             //!< Seed set in the context, or 0.
+  bool hasRun;               //!< Whether a run was set in the context.
+  uint64_t run;              //!< Run set in the context.
+  /**
+   * The next random number generator stream number to use
+   * for automatic assignment.
+   */
+  uint64_t nextStreamIndex;
+};
+
+/**
+ * \relates RngSeedManager
+ * \return The random number generator state of the current
+ * SimulationContext.  Without a context, the seed and the run are
+ * only kept in the RngSeed and RngRun global values.
+ */
+static RngState &
+GetRngState (void)
+{
+  static ContextLocal<RngState> state;
+  return state.Get ();
+}
 /**
  * \relates RngSeedManager
  * \anchor GlobalValueRngSeed
@@ -73,6 +102,11 @@ static ns3::GlobalValue g_rngRun ("RngRun",
 uint32_t RngSeedManager::GetSeed (void)
 {
   NS_LOG_FUNCTION_NOARGS ();
+  const RngState &state = GetRngState ();
+  if (state.seed != 0)
+    {
+      return state.seed;
+    }
   UintegerValue seedValue;
   g_rngSeed.GetValue (seedValue);
   return static_cast<uint32_t> (seedValue.Get ());
@@ -81,18 +115,35 @@ void
 RngSeedManager::SetSeed (uint32_t seed)
 {
   NS_LOG_FUNCTION (seed);
+  if (SimulationContext::GetCurrent () != 0)
+    {
+      GetRngState ().seed = seed;
+      return;
+    }
   Config::SetGlobal ("RngSeed", UintegerValue (seed));
 }
 
 void RngSeedManager::SetRun (uint64_t run)
 {
   NS_LOG_FUNCTION (run);
+  if (SimulationContext::GetCurrent () != 0)
+    {
+      RngState &state = GetRngState ();
+      state.hasRun = true;
+      state.run = run;
+      return;
+    }
   Config::SetGlobal ("RngRun", UintegerValue (run));
 }
 
 uint64_t RngSeedManager::GetRun ()
 {
   NS_LOG_FUNCTION_NOARGS ();
+  const RngState &state = GetRngState ();
+  if (state.hasRun)
+    {
+      return state.run;
+    }
   UintegerValue value;
   g_rngRun.GetValue (value);
   uint64_t run = value.Get ();
@@ -102,8 +153,9 @@ uint64_t RngSeedManager::GetRun ()
 uint64_t RngSeedManager::GetNextStreamIndex (void)
 {
   NS_LOG_FUNCTION_NOARGS ();
-  uint64_t next = g_nextStreamIndex;
-  g_nextStreamIndex++;
+  RngState &state = GetRngState ();
+  uint64_t next = state.nextStreamIndex;
+  state.nextStreamIndex++;
   return next;
 }
 
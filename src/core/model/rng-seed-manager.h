@@ -35,6 +35,10 @@ namespace ns3 {
  *
  * Manage the seed number and run number of the underlying
  * random number generator, and automatic assignment of stream numbers.
+ *
+ * In a SimulationContext, the seed and the run set are those of the
+ * context, which default to the RngSeed and RngRun global values, and the
+ * stream numbers are assigned from 0.
  */
 class RngSeedManager
 {
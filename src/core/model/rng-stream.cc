@@ -26,6 +26,12 @@
 #include "fatal-error.h"
 #include "log.h"
 
+#if defined (__GNUC__) && (defined (__x86_64__) || defined (__i386__))
+/** Build the AVX2 lockstep RandU01, selected at run time. */
+#define RNG_STREAM_AVX2 1
+#include <immintrin.h>
+#endif
+
 /**
  * \file
  * \ingroup rngimpl
@@ -323,48 +329,252 @@ void PowerOfTwoMatrix (int n, Matrix a1p, Matrix a2p)
     }
 }
 
-} // namespace MRG32k3a
-
-// *NS_CHECK_STYLE_ON*
-
-
-namespace ns3 {
-
-using namespace MRG32k3a;
-
-double RngStream::RandU01 ()
+/**
+ * Advance a state by one step.
+ *
+ * \param [in,out] s The state vector.
+ * \returns The next random number.
+ */
+inline double Step (double s[6])
 {
   int32_t k;
-  double p1, p2, u;
+  double p1, p2;
 
   /* Component 1 */
-  p1 = a12 * m_currentState[1] - a13n * m_currentState[0];
+  p1 = a12 * s[1] - a13n * s[0];
   k = static_cast<int32_t> (p1 / m1);
   p1 -= k * m1;
   if (p1 < 0.0)
     {
       p1 += m1;
     }
-  m_currentState[0] = m_currentState[1];
-  m_currentState[1] = m_currentState[2];
-  m_currentState[2] = p1;
+  s[0] = s[1];
+  s[1] = s[2];
+  s[2] = p1;
 
   /* Component 2 */
-  p2 = a21 * m_currentState[5] - a23n * m_currentState[3];
+  p2 = a21 * s[5] - a23n * s[3];
   k = static_cast<int32_t> (p2 / m2);
   p2 -= k * m2;
   if (p2 < 0.0)
     {
       p2 += m2;
     }
-  m_currentState[3] = m_currentState[4];
-  m_currentState[4] = m_currentState[5];
-  m_currentState[5] = p2;
+  s[3] = s[4];
+  s[4] = s[5];
+  s[5] = p2;
 
   /* Combination */
-  u = ((p1 > p2) ? (p1 - p2) * norm : (p1 - p2 + m1) * norm);
+  return ((p1 > p2) ? (p1 - p2) * norm : (p1 - p2 + m1) * norm);
+}
+
+/** The number of streams advanced together by the lockstep RandU01. */
+const int LANES = 4;
+
+/**
+ * Advance the states of LANES streams together, without SIMD instructions.
+ *
+ * \param [in,out] state The state vectors, component by component.
+ * \param [out] values The numbers of each stream.
+ * \param [in] n The number of numbers per stream.
+ */
+void Lockstep (double state[6][LANES], double *values[LANES], std::size_t n)
+{
+  for (int l = 0; l < LANES; ++l)
+    {
+      double s[6] = { state[0][l], state[1][l], state[2][l],
+                      state[3][l], state[4][l], state[5][l] };
+      for (std::size_t j = 0; j < n; ++j)
+        {
+          values[l][j] = Step (s);
+        }
+      for (int c = 0; c < 6; ++c)
+        {
+          state[c][l] = s[c];
+        }
+    }
+}
+
+#ifdef RNG_STREAM_AVX2
+/**
+ * Advance the states of LANES streams together, one stream per lane of
+ * the AVX2 registers. Each operation rounds as its scalar version in
+ * Step: the products fit in 53 bits, and the quotient is truncated
+ * toward zero, so that the numbers are exactly those of Step.
+ *
+ * \param [in,out] state The state vectors, component by component.
+ * \param [out] values The numbers of each stream.
+ * \param [in] n The number of numbers per stream.
+ */
+__attribute__ ((target ("avx2")))
+void LockstepAvx2 (double state[6][LANES], double *values[LANES], std::size_t n)
+{
+  const __m256d vm1 = _mm256_set1_pd (m1);
+  const __m256d vm2 = _mm256_set1_pd (m2);
+  const __m256d va12 = _mm256_set1_pd (a12);
+  const __m256d va13n = _mm256_set1_pd (a13n);
+  const __m256d va21 = _mm256_set1_pd (a21);
+  const __m256d va23n = _mm256_set1_pd (a23n);
+  const __m256d vnorm = _mm256_set1_pd (norm);
+  const __m256d zero = _mm256_setzero_pd ();
+  __m256d s0 = _mm256_loadu_pd (state[0]);
+  __m256d s1 = _mm256_loadu_pd (state[1]);
+  __m256d s2 = _mm256_loadu_pd (state[2]);
+  __m256d s3 = _mm256_loadu_pd (state[3]);
+  __m256d s4 = _mm256_loadu_pd (state[4]);
+  __m256d s5 = _mm256_loadu_pd (state[5]);
+  double u[LANES];
+  for (std::size_t j = 0; j < n; ++j)
+    {
+      /* Component 1 */
+      __m256d p1 = _mm256_sub_pd (_mm256_mul_pd (va12, s1), _mm256_mul_pd (va13n, s0));
+      __m256d k = _mm256_round_pd (_mm256_div_pd (p1, vm1), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+      p1 = _mm256_sub_pd (p1, _mm256_mul_pd (k, vm1));
+      p1 = _mm256_add_pd (p1, _mm256_and_pd (_mm256_cmp_pd (p1, zero, _CMP_LT_OQ), vm1));
+      s0 = s1;
+      s1 = s2;
+      s2 = p1;
+
+      /* Component 2 */
+      __m256d p2 = _mm256_sub_pd (_mm256_mul_pd (va21, s5), _mm256_mul_pd (va23n, s3));
+      k = _mm256_round_pd (_mm256_div_pd (p2, vm2), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+      p2 = _mm256_sub_pd (p2, _mm256_mul_pd (k, vm2));
+      p2 = _mm256_add_pd (p2, _mm256_and_pd (_mm256_cmp_pd (p2, zero, _CMP_LT_OQ), vm2));
+      s3 = s4;
+      s4 = s5;
+      s5 = p2;
+
+      /* Combination */
+      __m256d d = _mm256_sub_pd (p1, p2);
+      d = _mm256_add_pd (d, _mm256_andnot_pd (_mm256_cmp_pd (p1, p2, _CMP_GT_OQ), vm1));
+      _mm256_storeu_pd (u, _mm256_mul_pd (d, vnorm));
+      for (int l = 0; l < LANES; ++l)
+        {
+          values[l][j] = u[l];
+        }
+    }
+  _mm256_storeu_pd (state[0], s0);
+  _mm256_storeu_pd (state[1], s1);
+  _mm256_storeu_pd (state[2], s2);
+  _mm256_storeu_pd (state[3], s3);
+  _mm256_storeu_pd (state[4], s4);
+  _mm256_storeu_pd (state[5], s5);
+}
+
+/** \returns \c true if the processor supports AVX2. */
+bool HasAvx2 (void)
+{
+  __builtin_cpu_init ();
+  return __builtin_cpu_supports ("avx2");
+}
+#endif /* RNG_STREAM_AVX2 */
+
+/**
+ * \returns The flag telling whether the lockstep RandU01 uses the AVX2
+ *          instructions, initially set if the processor supports them.
+ */
+bool & SimdFlag (void)
+{
+#ifdef RNG_STREAM_AVX2
+  static bool simd = HasAvx2 ();
+#else
+  static bool simd = false;
+#endif
+  return simd;
+}
+
+} // namespace MRG32k3a
 
-  return u;
+// *NS_CHECK_STYLE_ON*
+
+
+namespace ns3 {
+
+using namespace MRG32k3a;
+
+double RngStream::RandU01 ()
+{
+  return Step (m_currentState);
+}
+
+void
+RngStream::RandU01 (double *values, std::size_t n)
+{
+  // a local copy of the state stays in registers
+  double s[6];
+  for (int i = 0; i < 6; ++i)
+    {
+      s[i] = m_currentState[i];
+    }
+  for (std::size_t j = 0; j < n; ++j)
+    {
+      values[j] = Step (s);
+    }
+  for (int i = 0; i < 6; ++i)
+    {
+      m_currentState[i] = s[i];
+    }
+}
+
+void
+RngStream::RandU01 (RngStream * const streams[], std::size_t nStreams,
+                    double *values, std::size_t n)
+{
+  std::size_t i = 0;
+  for (; i + LANES <= nStreams; i += LANES)
+    {
+      double state[6][LANES];
+      double *laneValues[LANES];
+      for (int l = 0; l < LANES; ++l)
+        {
+          for (int c = 0; c < 6; ++c)
+            {
+              state[c][l] = streams[i + l]->m_currentState[c];
+            }
+          laneValues[l] = values + (i + l) * n;
+        }
+#ifdef RNG_STREAM_AVX2
+      if (SimdFlag ())
+        {
+          LockstepAvx2 (state, laneValues, n);
+        }
+      else
+#endif
+        {
+          Lockstep (state, laneValues, n);
+        }
+      for (int l = 0; l < LANES; ++l)
+        {
+          for (int c = 0; c < 6; ++c)
+            {
+              streams[i + l]->m_currentState[c] = state[c][l];
+            }
+        }
+    }
+  for (; i < nStreams; ++i)
+    {
+      streams[i]->RandU01 (values + i * n, n);
+    }
+}
+
+void
+RngStream::EnableSimd (void)
+{
+#ifdef RNG_STREAM_AVX2
+  SimdFlag () = HasAvx2 ();
+#endif
+}
+
+void
+RngStream::DisableSimd (void)
+{
+  SimdFlag () = false;
+}
+
+bool
+RngStream::IsSimdEnabled (void)
+{
+  return SimdFlag ();
 }
 
 RngStream::RngStream (uint32_t seedNumber, uint64_t stream, uint64_t substream)
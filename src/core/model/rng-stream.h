@@ -21,6 +21,7 @@
 #define RNGSTREAM_H
 #include <string>
 #include <stdint.h>
+#include <cstddef>
 
 /**
  * \file
@@ -45,6 +46,13 @@ namespace ns3 {
  * holds a static instance of this class.  The details of this
  * class are explained in:
  * http://www.iro.umontreal.ca/~lecuyer/myftp/papers/streams00.pdf
+ *
+ * Besides RandU01 (void), the numbers can be drawn by blocks, from one
+ * stream, or from several streams advanced in lockstep. The lockstep
+ * version computes four streams at once with AVX2 instructions when the
+ * processor supports them. Both return exactly the numbers which the
+ * same number of calls to RandU01 (void) would return, stream by
+ * stream, so that a simulation does not depend on how it draws them.
  */
 class RngStream
 {
@@ -70,6 +78,39 @@ public:
    * \returns The next random.
    */
   double RandU01 (void);
+  /**
+   * Generate the next \pname{n} random numbers of this stream, the
+   * numbers which \pname{n} calls to RandU01 (void) would return.
+   *
+   * \param [out] values The numbers.
+   * \param [in] n The number of numbers.
+   */
+  void RandU01 (double *values, std::size_t n);
+  /**
+   * Generate the next \pname{n} random numbers of several streams,
+   * advanced in lockstep.
+   *
+   * \param [in] streams The streams.
+   * \param [in] nStreams The number of streams.
+   * \param [out] values The numbers: <tt>values[i * n + j]</tt> is the
+   *             number which the <em>j</em>-th call to RandU01 (void) on
+   *             <tt>streams[i]</tt> would return.
+   * \param [in] n The number of numbers per stream.
+   */
+  static void RandU01 (RngStream * const streams[], std::size_t nStreams,
+                       double *values, std::size_t n);
+
+  /**
+   * Use the AVX2 instructions for the lockstep RandU01, if the processor
+   * supports them. This is the default.
+   */
+  static void EnableSimd (void);
+  /** Use the portable code only for the lockstep RandU01. */
+  static void DisableSimd (void);
+  /**
+   * \returns \c true if the lockstep RandU01 uses the AVX2 instructions.
+   */
+  static bool IsSimdEnabled (void);
 
 private:
   /**
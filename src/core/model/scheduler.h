@@ -61,15 +61,19 @@ class EventImpl;
  *
  * The most important Scheduler functions for time performance are (usually)
  * Scheduler::Insert (for new events) and Scheduler::RemoveNext (for pulling
- * off the next event to execute).  Simulator::Cancel is usually
- * implemented by simply setting a bit on the Event, but leaving it in the
- * Scheduler; the Simulator just skips those events as they are encountered.
+ * off the next event to execute).  With the schedulers whose Remove takes
+ * linear time, Simulator::Cancel is implemented by simply setting a bit on
+ * the Event, but leaving it in the Scheduler; the Simulator just skips
+ * those events as they are encountered.
  *
  * For models which need a large event list the Scheduler overhead
  * and per-event memory cost could also be important.  Some models
- * rely heavily on Scheduler::Cancel, however, and these might benefit
- * from using Scheduler::Remove instead, to reduce the size of the event
- * list, at the time cost of actually removing events from the list.
+ * rely heavily on Scheduler::Cancel, e.g. to restart timers on every
+ * packet, and the cancelled events would then fill the event list.
+ * The schedulers for which Scheduler::IsRemoveFast returns true
+ * (HeapScheduler, LadderQueueScheduler and MapScheduler) find an event
+ * from its handle, or its key, without a linear search: the Simulator
+ * then removes the cancelled events from the event list right away.
  *
  * A summary of the main characteristics
  * of each SchedulerImpl is provided below.  See the individual
@@ -110,6 +114,14 @@ class EventImpl;
  *      <td class="markdownTableBodyLeft"> 0 </td>
  * </tr>
  * <tr class="markdownTableBody">
+ *      <td class="markdownTableBodyLeft"> LadderQueueScheduler </td>
+ *      <td class="markdownTableBodyLeft"> Rungs of `std::vector` buckets </td>
+ *      <td class="markdownTableBodyLeft"> Constant </td>
+ *      <td class="markdownTableBodyLeft"> Constant </td>
+ *      <td class="markdownTableBodyLeft"> Buckets </td>
+ *      <td class="markdownTableBodyLeft"> 0 </td>
+ * </tr>
+ * <tr class="markdownTableBody">
  *      <td class="markdownTableBodyLeft"> ListScheduler </td>
  *      <td class="markdownTableBodyLeft"> `std::list` </td>
  *      <td class="markdownTableBodyLeft"> Linear </td>
@@ -224,6 +236,15 @@ public:
    * \param [in] ev The event to remove
    */
   virtual void Remove (const Event &ev) = 0;
+  /**
+   * Check if Remove() is fast enough to be called for each cancelled
+   * event, instead of leaving the cancelled events in the event list.
+   *
+   * The default implementation returns \c false.
+   *
+   * \returns \c true if Remove() takes at most logarithmic time.
+   */
+  virtual bool IsRemoveFast (void) const;
 };
 
 /**
@@ -0,0 +1,97 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Amiraslan Haghrah
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "simulation-context.h"
+#include "simulator.h"
+#include "log.h"
+
+#include <atomic>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::SimulationContext implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("SimulationContext");
+
+thread_local SimulationContext *SimulationContext::m_current = 0;
+
+SimulationContext::SimulationContext ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+SimulationContext::~SimulationContext ()
+{
+  NS_LOG_FUNCTION (this);
+  SimulationContext *previous = m_current;
+  m_current = this;
+  Simulator::Destroy ();
+  // destroying a value may use the other variables of the context
+  while (!m_order.empty ())
+    {
+      uint32_t id = m_order.back ();
+      m_order.pop_back ();
+      Slot slot = m_slots[id];
+      m_slots[id].value = 0;
+      slot.deleter (slot.value);
+    }
+  m_current = previous;
+}
+
+uint32_t
+SimulationContext::AllocateSlot (void)
+{
+  static std::atomic<uint32_t> next (0);
+  return next++;
+}
+
+void
+SimulationContext::SetSlot (uint32_t id, void *value, Deleter deleter)
+{
+  // no logging: the log time printer may create the simulator slot
+  if (id >= m_slots.size ())
+    {
+      Slot empty = { 0, 0 };
+      m_slots.resize (id + 1, empty);
+    }
+  NS_ASSERT (m_slots[id].value == 0);
+  m_slots[id].value = value;
+  m_slots[id].deleter = deleter;
+  m_order.push_back (id);
+}
+
+SimulationContext::Scope::Scope (Ptr<SimulationContext> context)
+  : m_context (context),
+    m_previous (SimulationContext::m_current)
+{
+  NS_LOG_FUNCTION (this << context);
+  SimulationContext::m_current = PeekPointer (m_context);
+}
+
+SimulationContext::Scope::~Scope ()
+{
+  NS_LOG_FUNCTION (this);
+  SimulationContext::m_current = m_previous;
+}
+
+} // namespace ns3
@@ -36,6 +36,8 @@ namespace ns3 {
  * type will be automatically deleted upon a call
  * to Simulator::Destroy.
  *
+ * Each SimulationContext has its own instance.
+ *
  * For a singleton with a lifetime bounded by the process,
  * not the simulation run, see Singleton.
  */
@@ -99,6 +101,7 @@ private:
  ********************************************************************/
 
 #include "simulator.h"
+#include "simulation-context.h"
 
 namespace ns3 {
 
@@ -114,7 +117,8 @@ template <typename T>
 T **
 SimulationSingleton<T>::GetObject (void)
 {
-  static T *pobject = 0;
+  static ContextLocal<T *> object;
+  T *&pobject = object.Get ();
   if (pobject == 0)
     {
       pobject = new T ();
@@ -19,6 +19,7 @@
 
 #include "simulator-impl.h"
 #include "log.h"
+#include "make-event.h"
 
 /**
  * \file
@@ -42,4 +43,34 @@ SimulatorImpl::GetTypeId (void)
   return tid;
 }
 
+/**
+ * \ingroup simulator
+ * Invoke a callback.
+ * \param [in] callback The callback.
+ */
+static void
+InvokeCallback (Callback<void> callback)
+{
+  callback ();
+}
+
+void
+SimulatorImpl::InvokeWithContext (uint32_t context, const Callback<void> &callback)
+{
+  NS_LOG_FUNCTION (this << context);
+  ScheduleWithContext (context, Time (0), MakeEvent (&InvokeCallback, callback));
+}
+
+uint32_t
+SimulatorImpl::GetLiveEventCount (void) const
+{
+  return 0;
+}
+
+uint32_t
+SimulatorImpl::GetCancelledEventCount (void) const
+{
+  return 0;
+}
+
 } // namespace ns3
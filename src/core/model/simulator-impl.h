@@ -21,6 +21,7 @@
 #ifndef SIMULATOR_IMPL_H
 #define SIMULATOR_IMPL_H
 
+#include "callback.h"
 #include "event-impl.h"
 #include "event-id.h"
 #include "nstime.h"
@@ -101,6 +102,34 @@ public:
   virtual uint32_t GetContext (void) const = 0;
   /** \copydoc Simulator::GetEventCount */
   virtual uint64_t GetEventCount (void) const = 0;
+  /**
+   * Invoke a callback now, from the simulation thread, as if it were
+   * an event of another context: GetContext() returns \pname{context}
+   * during the call, and the events scheduled by the callback inherit it.
+   *
+   * This lets one event run the work of several contexts, as
+   * PeriodicEventGroup does. The default implementation, for the
+   * implementations which cannot switch the current context, schedules
+   * the callback with ScheduleWithContext() and a zero delay instead.
+   *
+   * \param [in] context The context of the call.
+   * \param [in] callback The callback to invoke.
+   */
+  virtual void InvokeWithContext (uint32_t context, const Callback<void> &callback);
+  /**
+   * \copydoc Simulator::GetLiveEventCount
+   *
+   * The default implementation, for the implementations which do not
+   * count the events, returns 0.
+   */
+  virtual uint32_t GetLiveEventCount (void) const;
+  /**
+   * \copydoc Simulator::GetCancelledEventCount
+   *
+   * The default implementation, for the implementations which do not
+   * count the events, returns 0.
+   */
+  virtual uint32_t GetCancelledEventCount (void) const;
 
 };
 
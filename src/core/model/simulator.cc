@@ -20,6 +20,7 @@
 #include "ns3/core-config.h"
 #include "simulator.h"
 #include "simulator-impl.h"
+#include "simulation-context.h"
 #include "scheduler.h"
 #include "map-scheduler.h"
 #include "event-impl.h"
@@ -80,13 +81,13 @@ static GlobalValue g_schedTypeImpl = GlobalValue ("SchedulerType",
 
 /**
  * \ingroup simulator
- * \brief Get the static SimulatorImpl instance.
+ * \brief Get the SimulatorImpl instance of the current SimulationContext.
  * \return The SimulatorImpl instance pointer.
  */
 static SimulatorImpl ** PeekImpl (void)
 {
-  static SimulatorImpl *impl = 0;
-  return &impl;
+  static ContextLocal<SimulatorImpl *> impl;
+  return &impl.Get ();
 }
 
 /**
@@ -146,9 +147,14 @@ Simulator::Destroy (void)
    * this, and restart a simulation after this call to Destroy, (which is
    * legal), Simulator::GetImpl will trigger again an infinite recursion until
    * the stack explodes.
+   * The printers are shared by all the simulation contexts, which may still
+   * be running, so they are left alone when a context is destroyed.
    */
-  LogSetTimePrinter (0);
-  LogSetNodePrinter (0);
+  if (SimulationContext::GetCurrent () == 0)
+    {
+      LogSetTimePrinter (0);
+      LogSetNodePrinter (0);
+    }
   (*pimpl)->Destroy ();
   (*pimpl)->Unref ();
   *pimpl = 0;
@@ -308,6 +314,18 @@ Simulator::GetEventCount (void)
   return GetImpl ()->GetEventCount ();
 }
 
+uint32_t
+Simulator::GetLiveEventCount (void)
+{
+  return GetImpl ()->GetLiveEventCount ();
+}
+
+uint32_t
+Simulator::GetCancelledEventCount (void)
+{
+  return GetImpl ()->GetCancelledEventCount ();
+}
+
 uint32_t
 Simulator::GetSystemId (void)
 {
@@ -204,6 +204,22 @@ public:
    * \returns The total number of events executed.
    */
   static uint64_t GetEventCount (void);
+  /**
+   * Get the number of events waiting to run.
+   * \returns The number of events scheduled and neither run, nor
+   *          cancelled nor removed, not counting the destroy events.
+   */
+  static uint32_t GetLiveEventCount (void);
+  /**
+   * Get the number of cancelled events which are still in the event list.
+   *
+   * Cancelled events are removed from the event list at once when the
+   * scheduler supports it (see Scheduler::IsRemoveFast); otherwise, they
+   * stay in the event list until their time, and use memory.
+   *
+   * \returns The number of cancelled events left in the event list.
+   */
+  static uint32_t GetCancelledEventCount (void);
 
 
   /**
@@ -0,0 +1,516 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Amiraslan Haghrah
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#ifndef SIZE_CLASS_ALLOCATOR_H
+#define SIZE_CLASS_ALLOCATOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup ptr
+ * ns3::SizeClassAllocator declaration and template implementation.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup ptr
+ *
+ * \brief Per-thread caches of variable-size memory blocks, binned by
+ * size class, with a global depot shared by the threads.
+ *
+ * A class which allocates variable-size storage at a high rate, such
+ * as the data of Buffer and PacketMetadata, obtains its blocks with
+ * Allocate, which rounds the size up to a size class (a power of two
+ * from MIN_CLASS_SIZE to MAX_CLASS_SIZE) and returns the capacity of
+ * the block, and releases them with Deallocate and this capacity.
+ * Larger blocks are allocated by the system.
+ *
+ * Each thread keeps, for each size class, two magazines of at most
+ * MAGAZINE_SIZE free blocks, used without lock.  When both are full,
+ * a full magazine is given to the depot; when both are empty, a
+ * magazine is taken from the depot.  The depot is locked only for
+ * these exchanges, which let the blocks released by a thread be
+ * reused by another one, for instance between a thread which
+ * receives packets and the thread which consumes them.  The
+ * magazines of a thread go to the depot when it exits.
+ *
+ * The statistics of each thread tell how often the magazines, the
+ * depot and the system are used, to tune the constants.
+ *
+ * \tparam T \explicit The class of the owner of the blocks, which
+ *           has its own caches and depot.
+ */
+template <typename T>
+class SizeClassAllocator
+{
+public:
+  /** Number of size classes. */
+  static const uint32_t N_CLASSES = 10;
+  /** The size of the smallest class. */
+  static const uint32_t MIN_CLASS_SIZE = 64;
+  /** The size of the largest class. */
+  static const uint32_t MAX_CLASS_SIZE = MIN_CLASS_SIZE << (N_CLASSES - 1);
+  /** Maximum number of blocks in a magazine. */
+  static const uint32_t MAGAZINE_SIZE = 32;
+  /** Maximum number of magazines of each class in the depot. */
+  static const uint32_t MAX_DEPOT_MAGAZINES = 64;
+
+  /** The allocation statistics of a thread. */
+  struct Statistics
+  {
+    Statistics ();
+
+    uint64_t nAllocations;       //!< Allocations while enabled.
+    uint64_t nCacheHits;         //!< Allocations of a free block of the thread.
+    uint64_t nDepotGets;         //!< Magazines taken from the depot.
+    uint64_t nDepotPuts;         //!< Magazines given to the depot.
+    uint64_t nSystemAllocations; //!< Allocations by the system.
+    uint64_t nSystemFrees;       //!< Releases to the system.
+  };
+
+  /**
+   * Allocate a block.
+   * \param [in] size The minimum size of the block.
+   * \param [out] capacity The size of the block.
+   * \return The block memory.
+   */
+  static void * Allocate (std::size_t size, std::size_t *capacity);
+  /**
+   * Release a block.
+   * \param [in] p The block memory.
+   * \param [in] capacity The size of the block, given by Allocate.
+   */
+  static void Deallocate (void *p, std::size_t capacity);
+  /**
+   * \param [in] size The minimum size of a block.
+   * \returns The size of the block which Allocate would return.
+   */
+  static std::size_t GetCapacity (std::size_t size);
+  /**
+   * Allocate the blocks from the system from now on, e.g., to compare
+   * the performance or to check the memory accesses with valgrind.
+   */
+  static void Disable (void);
+  /** Allocate the blocks from the caches from now on (the default). */
+  static void Enable (void);
+  /** \returns \c true if the blocks are allocated from the caches. */
+  static bool IsEnabled (void);
+  /** \returns The allocation statistics of the calling thread. */
+  static Statistics GetStatistics (void);
+  /** \returns The number of magazines in the depot. */
+  static uint32_t GetNDepotMagazines (void);
+
+private:
+  /** A set of free blocks of a size class. */
+  struct Magazine
+  {
+    Magazine ();
+
+    uint32_t n;                   //!< The number of blocks.
+    void *blocks[MAGAZINE_SIZE];  //!< The blocks.
+  };
+
+  /** The magazines of a thread. */
+  struct Cache
+  {
+    Cache ();
+    /** Give the magazines to the depot. */
+    ~Cache ();
+
+    Magazine *loaded[N_CLASSES];    //!< The magazines used first.
+    Magazine *previous[N_CLASSES];  //!< The other magazines.
+    Statistics statistics;          //!< The statistics of the thread.
+  };
+
+  /** The magazines shared by the threads. */
+  struct Depot
+  {
+    /** Release the blocks to the system. */
+    ~Depot ();
+
+    std::mutex mutex;                       //!< Lock of the depot.
+    std::vector<Magazine *> full[N_CLASSES];   //!< The magazines with blocks.
+    std::vector<Magazine *> empty[N_CLASSES];  //!< The empty magazines.
+  };
+
+  /**
+   * \param [in] size A block size.
+   * \returns The index of the smallest size class which holds it,
+   *          or N_CLASSES if it is too large.
+   */
+  static uint32_t GetClass (std::size_t size);
+  /**
+   * \return The cache of the calling thread, or 0 if it was already
+   *         destroyed, at thread exit.
+   */
+  static Cache * GetCache (void);
+  /** \return The depot, or 0 if it was already destroyed. */
+  static Depot * GetDepot (void);
+  /**
+   * Replace the empty loaded magazine of a class with one of the depot.
+   * \param [in] cache The cache of the thread.
+   * \param [in] c The size class.
+   */
+  static void Refill (Cache *cache, uint32_t c);
+  /**
+   * Give the full previous magazine of a class to the depot, and load
+   * an empty one.
+   * \param [in] cache The cache of the thread.
+   * \param [in] c The size class.
+   */
+  static void Flush (Cache *cache, uint32_t c);
+  /**
+   * Release the blocks of a magazine to the system.
+   * \param [in] magazine The magazine.
+   * \returns The number of blocks released.
+   */
+  static uint32_t Release (Magazine *magazine);
+
+  /** Flag \c true if the blocks are allocated from the caches. */
+  static std::atomic<bool> m_enabled;
+  /** Flag set when the depot is destroyed. */
+  static std::atomic<bool> m_depotDestroyed;
+  /** The cache of each thread, trivially destructible. */
+  static thread_local Cache *m_cache;
+  /** Flag set when the cache of the thread is destroyed. */
+  static thread_local bool m_destroyed;
+};
+
+} // namespace ns3
+
+
+/********************************************************************
+ *  Implementation of the templates declared above.
+ ********************************************************************/
+
+namespace ns3 {
+
+template <typename T>
+std::atomic<bool> SizeClassAllocator<T>::m_enabled (true);
+template <typename T>
+std::atomic<bool> SizeClassAllocator<T>::m_depotDestroyed (false);
+template <typename T>
+thread_local typename SizeClassAllocator<T>::Cache *SizeClassAllocator<T>::m_cache = 0;
+template <typename T>
+thread_local bool SizeClassAllocator<T>::m_destroyed = false;
+
+template <typename T>
+SizeClassAllocator<T>::Statistics::Statistics ()
+  : nAllocations (0),
+    nCacheHits (0),
+    nDepotGets (0),
+    nDepotPuts (0),
+    nSystemAllocations (0),
+    nSystemFrees (0)
+{}
+
+template <typename T>
+SizeClassAllocator<T>::Magazine::Magazine ()
+  : n (0)
+{}
+
+template <typename T>
+SizeClassAllocator<T>::Cache::Cache ()
+{
+  for (uint32_t c = 0; c < N_CLASSES; ++c)
+    {
+      loaded[c] = new Magazine ();
+      previous[c] = new Magazine ();
+    }
+}
+
+template <typename T>
+SizeClassAllocator<T>::Cache::~Cache ()
+{
+  Depot *depot = GetDepot ();
+  for (uint32_t c = 0; c < N_CLASSES; ++c)
+    {
+      Magazine *magazines[2] = { loaded[c], previous[c] };
+      for (uint32_t i = 0; i < 2; ++i)
+        {
+          if (depot != 0 && magazines[i]->n > 0)
+            {
+              std::lock_guard<std::mutex> lock (depot->mutex);
+              if (depot->full[c].size () < MAX_DEPOT_MAGAZINES)
+                {
+                  depot->full[c].push_back (magazines[i]);
+                  continue;
+                }
+            }
+          Release (magazines[i]);
+          delete magazines[i];
+        }
+    }
+  m_cache = 0;
+  m_destroyed = true;
+}
+
+template <typename T>
+SizeClassAllocator<T>::Depot::~Depot ()
+{
+  for (uint32_t c = 0; c < N_CLASSES; ++c)
+    {
+      for (std::size_t i = 0; i < full[c].size (); ++i)
+        {
+          Release (full[c][i]);
+          delete full[c][i];
+        }
+      for (std::size_t i = 0; i < empty[c].size (); ++i)
+        {
+          delete empty[c][i];
+        }
+    }
+  m_depotDestroyed = true;
+}
+
+template <typename T>
+uint32_t
+SizeClassAllocator<T>::GetClass (std::size_t size)
+{
+  uint32_t c = 0;
+  std::size_t classSize = MIN_CLASS_SIZE;
+  while (classSize < size && c < N_CLASSES)
+    {
+      classSize <<= 1;
+      ++c;
+    }
+  return c;
+}
+
+template <typename T>
+typename SizeClassAllocator<T>::Cache *
+SizeClassAllocator<T>::GetCache (void)
+{
+  if (m_cache == 0 && !m_destroyed)
+    {
+      static thread_local Cache cache;
+      m_cache = &cache;
+    }
+  return m_cache;
+}
+
+template <typename T>
+typename SizeClassAllocator<T>::Depot *
+SizeClassAllocator<T>::GetDepot (void)
+{
+  static Depot depot;
+  return m_depotDestroyed ? 0 : &depot;
+}
+
+template <typename T>
+void
+SizeClassAllocator<T>::Refill (Cache *cache, uint32_t c)
+{
+  Depot *depot = GetDepot ();
+  if (depot == 0)
+    {
+      return;
+    }
+  std::lock_guard<std::mutex> lock (depot->mutex);
+  if (depot->full[c].empty ())
+    {
+      return;
+    }
+  depot->empty[c].push_back (cache->loaded[c]);
+  cache->loaded[c] = depot->full[c].back ();
+  depot->full[c].pop_back ();
+  cache->statistics.nDepotGets++;
+}
+
+template <typename T>
+void
+SizeClassAllocator<T>::Flush (Cache *cache, uint32_t c)
+{
+  Depot *depot = GetDepot ();
+  if (depot != 0)
+    {
+      std::lock_guard<std::mutex> lock (depot->mutex);
+      if (depot->full[c].size () < MAX_DEPOT_MAGAZINES)
+        {
+          depot->full[c].push_back (cache->previous[c]);
+          cache->previous[c] = cache->loaded[c];
+          if (depot->empty[c].empty ())
+            {
+              cache->loaded[c] = new Magazine ();
+            }
+          else
+            {
+              cache->loaded[c] = depot->empty[c].back ();
+              depot->empty[c].pop_back ();
+            }
+          cache->statistics.nDepotPuts++;
+          return;
+        }
+    }
+  // The depot is full: release the blocks of the previous magazine.
+  cache->statistics.nSystemFrees += Release (cache->previous[c]);
+  std::swap (cache->loaded[c], cache->previous[c]);
+}
+
+template <typename T>
+uint32_t
+SizeClassAllocator<T>::Release (Magazine *magazine)
+{
+  uint32_t n = magazine->n;
+  while (magazine->n > 0)
+    {
+      ::operator delete (magazine->blocks[--magazine->n]);
+    }
+  return n;
+}
+
+template <typename T>
+void *
+SizeClassAllocator<T>::Allocate (std::size_t size, std::size_t *capacity)
+{
+  uint32_t c = GetClass (size);
+  if (c == N_CLASSES || !m_enabled.load (std::memory_order_relaxed))
+    {
+      *capacity = size;
+      return ::operator new (size);
+    }
+  *capacity = static_cast<std::size_t> (MIN_CLASS_SIZE) << c;
+  Cache *cache = GetCache ();
+  if (cache == 0)
+    {
+      return ::operator new (*capacity);
+    }
+  cache->statistics.nAllocations++;
+  if (cache->loaded[c]->n == 0)
+    {
+      if (cache->previous[c]->n > 0)
+        {
+          std::swap (cache->loaded[c], cache->previous[c]);
+        }
+      else
+        {
+          Refill (cache, c);
+        }
+    }
+  Magazine *loaded = cache->loaded[c];
+  if (loaded->n > 0)
+    {
+      cache->statistics.nCacheHits++;
+      return loaded->blocks[--loaded->n];
+    }
+  cache->statistics.nSystemAllocations++;
+  return ::operator new (*capacity);
+}
+
+template <typename T>
+void
+SizeClassAllocator<T>::Deallocate (void *p, std::size_t capacity)
+{
+  uint32_t c = GetClass (capacity);
+  Cache *cache = 0;
+  if (c < N_CLASSES
+      && capacity == static_cast<std::size_t> (MIN_CLASS_SIZE) << c
+      && m_enabled.load (std::memory_order_relaxed))
+    {
+      cache = GetCache ();
+    }
+  if (cache == 0)
+    {
+      ::operator delete (p);
+      return;
+    }
+  if (cache->loaded[c]->n == MAGAZINE_SIZE)
+    {
+      if (cache->previous[c]->n == 0)
+        {
+          std::swap (cache->loaded[c], cache->previous[c]);
+        }
+      else
+        {
+          Flush (cache, c);
+        }
+    }
+  Magazine *loaded = cache->loaded[c];
+  loaded->blocks[loaded->n++] = p;
+}
+
+template <typename T>
+std::size_t
+SizeClassAllocator<T>::GetCapacity (std::size_t size)
+{
+  uint32_t c = GetClass (size);
+  if (c == N_CLASSES || !m_enabled.load (std::memory_order_relaxed))
+    {
+      return size;
+    }
+  return static_cast<std::size_t> (MIN_CLASS_SIZE) << c;
+}
+
+template <typename T>
+void
+SizeClassAllocator<T>::Disable (void)
+{
+  m_enabled = false;
+}
+
+template <typename T>
+void
+SizeClassAllocator<T>::Enable (void)
+{
+  m_enabled = true;
+}
+
+template <typename T>
+bool
+SizeClassAllocator<T>::IsEnabled (void)
+{
+  return m_enabled.load (std::memory_order_relaxed);
+}
+
+template <typename T>
+typename SizeClassAllocator<T>::Statistics
+SizeClassAllocator<T>::GetStatistics (void)
+{
+  Cache *cache = GetCache ();
+  return cache != 0 ? cache->statistics : Statistics ();
+}
+
+template <typename T>
+uint32_t
+SizeClassAllocator<T>::GetNDepotMagazines (void)
+{
+  Depot *depot = GetDepot ();
+  if (depot == 0)
+    {
+      return 0;
+    }
+  std::lock_guard<std::mutex> lock (depot->mutex);
+  uint32_t n = 0;
+  for (uint32_t c = 0; c < N_CLASSES; ++c)
+    {
+      n += depot->full[c].size ();
+    }
+  return n;
+}
+
+} // namespace ns3
+
+#endif /* SIZE_CLASS_ALLOCATOR_H */
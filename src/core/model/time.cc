@@ -68,6 +68,7 @@ bool Time::StaticInit ()
 
   if (firstTime)
     {
+#ifndef NS3_TIME_RESOLUTION
       if (!g_markingTimes)
         {
           static MarkedTimes markingTimes;
@@ -77,6 +78,7 @@ bool Time::StaticInit ()
         {
           NS_LOG_ERROR ("firstTime but g_markingTimes != 0");
         }
+#endif /* NS3_TIME_RESOLUTION */
 
       // Schedule the cleanup.
       // We'd really like:
@@ -171,7 +173,11 @@ Time::SetDefaultNsResolution (void)
 {
   NS_LOG_FUNCTION_NOARGS ();
   struct Resolution resolution;
+#ifdef NS3_TIME_RESOLUTION
+  SetResolution (NS3_TIME_RESOLUTION, &resolution, false);
+#else
   SetResolution (Time::NS, &resolution, false);
+#endif
   return resolution;
 }
 
@@ -180,7 +186,13 @@ void
 Time::SetResolution (enum Unit resolution)
 {
   NS_LOG_FUNCTION (resolution);
+#ifdef NS3_TIME_RESOLUTION
+  NS_ABORT_MSG_IF (resolution != NS3_TIME_RESOLUTION,
+                   "The Time resolution is fixed at configuration, "
+                   "with --time-resolution");
+#else
   SetResolution (resolution, PeekResolution ());
+#endif
 }
 
 
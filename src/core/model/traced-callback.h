@@ -21,7 +21,7 @@
 #ifndef TRACED_CALLBACK_H
 #define TRACED_CALLBACK_H
 
-#include <list>
+#include <vector>
 #include "callback.h"
 
 /**
@@ -44,7 +44,9 @@ namespace ns3 {
  *
  * This is a functor: the chain of Callbacks is invoked by
  * calling the \c operator() form with the appropriate
- * number of arguments.
+ * number of arguments.  The chain is a contiguous array, and
+ * invoking an empty chain returns at once; when the arguments of
+ * a trace are costly to build, check IsEmpty first.
  *
  * \tparam Ts \explicit Types of the functor arguments.
  */
@@ -89,6 +91,11 @@ public:
    * \param [in] args The arguments to the functor
    */
   void operator() (Ts... args) const;
+  /**
+   * Checks if the chain of Callbacks is empty.
+   * \return \c true if no Callback is connected.
+   */
+  bool IsEmpty (void) const;
 
   /**
    *  TracedCallback signature for POD.
@@ -107,7 +114,7 @@ private:
    *
    * \tparam Ts \deduced Types of the functor arguments.
    */
-  typedef std::list<Callback<void,Ts...> > CallbackList;
+  typedef std::vector<Callback<void,Ts...> > CallbackList;
   /** The chain of Callbacks. */
   CallbackList m_callbackList;
 };
@@ -181,12 +188,22 @@ template<typename... Ts>
 void
 TracedCallback<Ts...>::operator() (Ts... args) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  if (m_callbackList.empty ())
+    {
+      return;
+    }
+  // By index: a Callback may connect another one to the chain.
+  for (std::size_t i = 0; i < m_callbackList.size (); i++)
     {
-      (*i)(args...);
+      m_callbackList[i](args...);
     }
 }
+template<typename... Ts>
+bool
+TracedCallback<Ts...>::IsEmpty (void) const
+{
+  return m_callbackList.empty ();
+}
 
 } // namespace ns3
 
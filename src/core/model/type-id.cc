@@ -21,9 +21,12 @@
 #include "hash.h"
 #include "type-id.h"
 #include "singleton.h"
+#include "system-mutex.h"
 #include "trace-source-accessor.h"
 
-#include <map>
+#include <atomic>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 #include <sstream>
 #include <iomanip>
@@ -50,8 +53,19 @@ NS_LOG_COMPONENT_DEFINE ("TypeId");
  * \ingroup object
  * \brief TypeId information manager
  *
- * Information records are stored in a vector.  Name and hash lookup
- * are performed by maps to the vector index.
+ * Information records are stored in blocks which are never moved or
+ * freed, so that a record can be read while other types are registered.
+ * Name and hash lookups probe an open addressing table of the type ids,
+ * placed by the hash of their name.  The table grows by replacing it
+ * with a larger copy; the previous tables are kept until the manager
+ * is destroyed.  Lookups read the table without locking; type id
+ * allocations are serialized by a mutex.  Lookups may thus run
+ * concurrently from several threads, e.g. those of SimulationContexts,
+ * and types first used by one of those threads may be registered then.
+ *
+ * Each record also holds a hash table of its own Attributes, by name,
+ * filled as they are added.  A lookup probes the tables of the type and
+ * of its parents.
  *
  * \internal
  * <b>Hash Chaining</b>
@@ -78,6 +92,10 @@ NS_LOG_COMPONENT_DEFINE ("TypeId");
 class IidManager : public Singleton<IidManager>
 {
 public:
+  /** Constructor. */
+  IidManager ();
+  /** Destructor. */
+  ~IidManager ();
   /**
    * Create a new unique type id.
    * \param [in] name The name of this type id.
@@ -229,6 +247,23 @@ public:
    * \returns The information associated to attribute whose index is \pname{i}.
    */
   struct TypeId::AttributeInformation GetAttribute (uint16_t uid, std::size_t i) const;
+  /**
+   * Get a reference to the Attribute information by index.
+   * \param [in] uid The id.
+   * \param [in] i Index into attribute array
+   * \returns The information associated to attribute whose index is \pname{i}.
+   */
+  const struct TypeId::AttributeInformation & PeekAttribute (uint16_t uid, std::size_t i) const;
+  /**
+   * Find where an Attribute of a type id, or of its parents, is defined.
+   * \param [in] uid The id.
+   * \param [in] name The Attribute name.
+   * \param [out] owner The id which defines the Attribute.
+   * \param [out] index The index of the Attribute in \pname{owner}.
+   * \returns \c true if the Attribute was found.
+   */
+  bool LookupAttribute (uint16_t uid, const std::string &name,
+                        uint16_t *owner, std::size_t *index) const;
   /**
    * Record a new TraceSource.
    * \param [in] uid The id.
@@ -292,6 +327,22 @@ private:
    * \returns The hashed value of \pname{name}.
    */
   static TypeId::hash_t Hasher (const std::string name);
+  /**
+   * Find a type id in the uid table.
+   * \param [in] hash The type id hash value, or the hash of \pname{name}.
+   * \param [in] name The type id name, or 0 to match \pname{hash} exactly.
+   * \returns The type id, or 0 if not found.
+   */
+  uint16_t FindUid (TypeId::hash_t hash, const std::string *name) const;
+  /**
+   * Add a type id to the uid table, growing it if needed.
+   * The caller holds m_mutex.
+   * \param [in] uid The type id.
+   */
+  void InsertUid (uint16_t uid);
+
+  /** Type of the by-name index of the Attributes of a type id. */
+  typedef std::unordered_map<std::string, std::size_t> attributeindex_t;
 
   /** The information record about a single type id. */
   struct IidInformation
@@ -320,9 +371,9 @@ private:
     TypeId::SupportLevel supportLevel;
     /** Support message. */
     std::string supportMsg;
+    /** The by-name index of the Attributes, into attributes. */
+    attributeindex_t attributeIndex;
   };
-  /** Iterator type. */
-  typedef std::vector<struct IidInformation>::const_iterator Iterator;
 
   /**
    * Retrieve the information record for a type.
@@ -331,19 +382,32 @@ private:
    */
   struct IidManager::IidInformation * LookupInformation (uint16_t uid) const;
 
-  /** The container of all type id records. */
-  std::vector<struct IidInformation> m_information;
-
-  /** Type of the by-name index. */
-  typedef std::map<std::string, uint16_t> namemap_t;
-  /** The by-name index. */
-  namemap_t m_namemap;
-
-  /** Type of the by-hash index. */
-  typedef std::map<TypeId::hash_t, uint16_t> hashmap_t;
-  /** The by-hash index. */
-  hashmap_t m_hashmap;
+  /** The open addressing table of the type ids. */
+  struct UidTable
+  {
+    /**
+     * Constructor.
+     * \param [in] size The number of slots, a power of two.
+     */
+    UidTable (uint32_t size);
+    /** Destructor. */
+    ~UidTable ();
+    /** The number of slots, minus one. */
+    uint32_t mask;
+    /** The slots: a type id, or 0 if empty. */
+    std::atomic<uint16_t> *slots;
+  };
 
+  /** The blocks of type id records. */
+  std::atomic<struct IidInformation *> m_blocks[0x10000 / 0x100];
+  /** The number of type ids. */
+  std::atomic<uint16_t> m_n;
+  /** The current uid table. */
+  std::atomic<struct UidTable *> m_table;
+  /** The uid tables, the current one last. */
+  std::vector<struct UidTable *> m_tables;
+  /** Serialize the type id allocations. */
+  SystemMutex m_mutex;
 
   /** IidManager constants. */
   enum
@@ -354,16 +418,64 @@ private:
      * To handle the first collision, we reserve the high bit as a
      * chain flag.
      */
-    HashChainFlag = 0x80000000
+    HashChainFlag = 0x80000000,
+    /** The number of records in a block. */
+    BlockSize = 0x100,
+    /** The initial number of slots of the uid table. */
+    TableSize = 0x400
   };
 };
 
 
+IidManager::UidTable::UidTable (uint32_t size)
+  : mask (size - 1),
+    slots (new std::atomic<uint16_t>[size])
+{
+  NS_ASSERT ((size & mask) == 0);
+  for (uint32_t i = 0; i < size; ++i)
+    {
+      slots[i].store (0, std::memory_order_relaxed);
+    }
+}
+
+IidManager::UidTable::~UidTable ()
+{
+  delete [] slots;
+}
+
+IidManager::IidManager ()
+  : m_n (0)
+{
+  for (std::size_t i = 0; i < sizeof (m_blocks) / sizeof (m_blocks[0]); ++i)
+    {
+      m_blocks[i].store (0, std::memory_order_relaxed);
+    }
+  m_tables.push_back (new struct UidTable (TableSize));
+  m_table.store (m_tables.back (), std::memory_order_release);
+}
+
+IidManager::~IidManager ()
+{
+  for (std::size_t i = 0; i < sizeof (m_blocks) / sizeof (m_blocks[0]); ++i)
+    {
+      delete [] m_blocks[i].load ();
+      m_blocks[i].store (0);
+    }
+  m_n.store (0);
+  for (std::vector<struct UidTable *>::iterator i = m_tables.begin (); i != m_tables.end (); ++i)
+    {
+      delete *i;
+    }
+  m_tables.clear ();
+  m_table.store (0);
+}
+
 //static
 TypeId::hash_t
 IidManager::Hasher (const std::string name)
 {
-  static ns3::Hasher hasher ( Create<Hash::Function::Murmur3> () );
+  // the hasher keeps state between calls: one per thread
+  static thread_local ns3::Hasher hasher ( Create<Hash::Function::Murmur3> () );
   return hasher.clear ().GetHash32 (name);
 }
 
@@ -384,12 +496,13 @@ uint16_t
 IidManager::AllocateUid (std::string name)
 {
   NS_LOG_FUNCTION (IID << name);
+  CriticalSection cs (m_mutex);
   // Type names are definitive: equal names are equal types
-  NS_ASSERT_MSG (m_namemap.count (name) == 0,
+  NS_ASSERT_MSG (GetUid (name) == 0,
                  "Trying to allocate twice the same uid: " << name);
 
   TypeId::hash_t hash = Hasher (name) & (~HashChainFlag);
-  if (m_hashmap.count (hash) == 1)
+  if (GetUid (hash) != 0)
     {
       NS_LOG_ERROR ("Hash chaining TypeId for '" << name << "'.  "
                                                  << "This is not a bug, but is extremely unlikely.  "
@@ -406,7 +519,7 @@ IidManager::AllocateUid (std::string name)
       //  Oh, by the way, I owe you a beer, since I bet Mathieu that
       //  this would never happen..  -- Peter Barnes, LLNL
 
-      NS_ASSERT_MSG (m_hashmap.count (hash | HashChainFlag) == 0,
+      NS_ASSERT_MSG (GetUid (hash | HashChainFlag) == 0,
                      "Triplicate hash detected while chaining TypeId for '"
                      << name
                      << "'. Please contact the ns3 developers for assistance.");
@@ -426,15 +539,21 @@ IidManager::AllocateUid (std::string name)
       else
         { // chain old type
           NS_LOG_LOGIC (IIDL << "Old TypeId '" << hinfo->name << "' getting chained.");
-          uint16_t oldUid = GetUid (hinfo->hash);
-          m_hashmap.erase (m_hashmap.find (hinfo->hash));
+          // the slots are placed by the unchained hash: the old type stays
           hinfo->hash = hash | HashChainFlag;
-          m_hashmap.insert (std::make_pair (hinfo->hash, oldUid));
           // leave new hash unchained
         }
     }
 
-  struct IidInformation information;
+  std::size_t index = m_n.load (std::memory_order_relaxed);
+  NS_ASSERT (index + 1 <= 0xffff);
+  uint16_t uid = static_cast<uint16_t> (index + 1);
+  std::atomic<struct IidInformation *> &block = m_blocks[index / BlockSize];
+  if (block.load (std::memory_order_relaxed) == 0)
+    {
+      block.store (new struct IidInformation[BlockSize], std::memory_order_release);
+    }
+  struct IidInformation &information = block.load (std::memory_order_relaxed)[index % BlockSize];
   information.name = name;
   information.hash = hash;
   information.parent = 0;
@@ -443,32 +562,93 @@ IidManager::AllocateUid (std::string name)
   information.hasConstructor = false;
   information.mustHideFromDocumentation = false;
   information.supportLevel = TypeId::SUPPORTED;
-  m_information.push_back (information);
-  std::size_t tuid = m_information.size ();
-  NS_ASSERT (tuid <= 0xffff);
-  uint16_t uid = static_cast<uint16_t> (tuid);
-
-  // Add to both maps:
-  m_namemap.insert (std::make_pair (name, uid));
-  m_hashmap.insert (std::make_pair (hash, uid));
+  m_n.store (uid, std::memory_order_release);
+
+  InsertUid (uid);
   NS_LOG_LOGIC (IIDL << uid);
   return uid;
 }
 
+uint16_t
+IidManager::FindUid (TypeId::hash_t hash, const std::string *name) const
+{
+  const struct UidTable *table = m_table.load (std::memory_order_acquire);
+  TypeId::hash_t base = hash & (~HashChainFlag);
+  for (uint32_t i = base & table->mask; ; i = (i + 1) & table->mask)
+    {
+      uint16_t uid = table->slots[i].load (std::memory_order_acquire);
+      if (uid == 0)
+        {
+          return 0;
+        }
+      const struct IidInformation *information = LookupInformation (uid);
+      if (name == 0)
+        {
+          if (information->hash == hash)
+            {
+              return uid;
+            }
+        }
+      else if ((information->hash & (~HashChainFlag)) == base
+               && information->name == *name)
+        {
+          return uid;
+        }
+    }
+}
+
+void
+IidManager::InsertUid (uint16_t uid)
+{
+  NS_LOG_FUNCTION (IID << uid);
+  struct UidTable *table = m_table.load (std::memory_order_relaxed);
+  if (2 * static_cast<uint32_t> (uid) > table->mask + 1)
+    {
+      // keep the table at most half full: copy the type ids in a larger one
+      struct UidTable *larger = new struct UidTable (2 * (table->mask + 1));
+      for (uint32_t i = 0; i <= table->mask; ++i)
+        {
+          uint16_t other = table->slots[i].load (std::memory_order_relaxed);
+          if (other != 0)
+            {
+              uint32_t j = LookupInformation (other)->hash & (~HashChainFlag) & larger->mask;
+              while (larger->slots[j].load (std::memory_order_relaxed) != 0)
+                {
+                  j = (j + 1) & larger->mask;
+                }
+              larger->slots[j].store (other, std::memory_order_relaxed);
+            }
+        }
+      // the previous tables may still be read by lookups
+      m_tables.push_back (larger);
+      m_table.store (larger, std::memory_order_release);
+      table = larger;
+    }
+  uint32_t i = LookupInformation (uid)->hash & (~HashChainFlag) & table->mask;
+  while (table->slots[i].load (std::memory_order_relaxed) != 0)
+    {
+      i = (i + 1) & table->mask;
+    }
+  table->slots[i].store (uid, std::memory_order_release);
+}
+
 struct IidManager::IidInformation *
 IidManager::LookupInformation (uint16_t uid) const
 {
   NS_LOG_FUNCTION (IID << uid);
-  NS_ASSERT (uid <= m_information.size () && uid != 0);
-  NS_LOG_LOGIC (IIDL << m_information[uid - 1].name);
-  return const_cast<struct IidInformation *> (&m_information[uid - 1]);
+  NS_ASSERT (uid <= m_n.load (std::memory_order_acquire) && uid != 0);
+  std::size_t index = uid - 1;
+  struct IidInformation *information =
+    &m_blocks[index / BlockSize].load (std::memory_order_acquire)[index % BlockSize];
+  NS_LOG_LOGIC (IIDL << information->name);
+  return information;
 }
 
 void
 IidManager::SetParent (uint16_t uid, uint16_t parent)
 {
   NS_LOG_FUNCTION (IID << uid << parent);
-  NS_ASSERT (parent <= m_information.size ());
+  NS_ASSERT (parent <= m_n.load ());
   struct IidInformation *information = LookupInformation (uid);
   information->parent = parent;
 }
@@ -511,12 +691,7 @@ uint16_t
 IidManager::GetUid (std::string name) const
 {
   NS_LOG_FUNCTION (IID << name);
-  uint16_t uid = 0;
-  namemap_t::const_iterator it = m_namemap.find (name);
-  if (it != m_namemap.end ())
-    {
-      uid = it->second;
-    }
+  uint16_t uid = FindUid (Hasher (name), &name);
   NS_LOG_LOGIC (IIDL << uid);
   return uid;
 }
@@ -524,12 +699,7 @@ uint16_t
 IidManager::GetUid (TypeId::hash_t hash) const
 {
   NS_LOG_FUNCTION (IID << hash);
-  hashmap_t::const_iterator it = m_hashmap.find (hash);
-  uint16_t uid = 0;
-  if (it != m_hashmap.end ())
-    {
-      uid = it->second;
-    }
+  uint16_t uid = FindUid (hash, 0);
   NS_LOG_LOGIC (IIDL << uid);
   return uid;
 }
@@ -602,8 +772,9 @@ IidManager::HasConstructor (uint16_t uid) const
 uint16_t
 IidManager::GetRegisteredN (void) const
 {
-  NS_LOG_FUNCTION (IID << m_information.size ());
-  return static_cast<uint16_t> (m_information.size ());
+  uint16_t n = m_n.load (std::memory_order_acquire);
+  NS_LOG_FUNCTION (IID << n);
+  return n;
 }
 uint16_t
 IidManager::GetRegistered (uint16_t i) const
@@ -617,30 +788,11 @@ IidManager::HasAttribute (uint16_t uid,
                           std::string name)
 {
   NS_LOG_FUNCTION (IID << uid << name);
-  struct IidInformation *information  = LookupInformation (uid);
-  while (true)
-    {
-      for (std::vector<struct TypeId::AttributeInformation>::const_iterator i = information->attributes.begin ();
-           i != information->attributes.end (); ++i)
-        {
-          if (i->name == name)
-            {
-              NS_LOG_LOGIC (IIDL << true);
-              return true;
-            }
-        }
-      struct IidInformation *parent = LookupInformation (information->parent);
-      if (parent == information)
-        {
-          // top of inheritance tree
-          NS_LOG_LOGIC (IIDL << false);
-          return false;
-        }
-      // check parent
-      information = parent;
-    }
-  NS_LOG_LOGIC (IIDL << false);
-  return false;
+  uint16_t owner;
+  std::size_t index;
+  bool found = LookupAttribute (uid, name, &owner, &index);
+  NS_LOG_LOGIC (IIDL << found);
+  return found;
 }
 
 void
@@ -670,9 +822,10 @@ IidManager::AddAttribute (uint16_t uid,
                       "\" already registered on tid=\"" <<
                       information->name << "\"");
     }
+  information->attributeIndex.insert (std::make_pair (name, information->attributes.size ()));
   struct TypeId::AttributeInformation info;
-  info.name = name;
-  info.help = help;
+  info.name = std::move (name);
+  info.help = std::move (help);
   info.flags = flags;
   info.initialValue = initialValue;
   info.originalInitialValue = initialValue;
@@ -680,7 +833,7 @@ IidManager::AddAttribute (uint16_t uid,
   info.checker = checker;
   info.supportLevel = supportLevel;
   info.supportMsg = supportMsg;
-  information->attributes.push_back (info);
+  information->attributes.push_back (std::move (info));
   NS_LOG_LOGIC (IIDL << information->attributes.size () - 1);
 }
 void
@@ -714,6 +867,40 @@ IidManager::GetAttribute (uint16_t uid, std::size_t i) const
   NS_LOG_LOGIC (IIDL << information->name);
   return information->attributes[i];
 }
+const struct TypeId::AttributeInformation &
+IidManager::PeekAttribute (uint16_t uid, std::size_t i) const
+{
+  NS_LOG_FUNCTION (IID << uid << i);
+  struct IidInformation *information = LookupInformation (uid);
+  NS_ASSERT (i < information->attributes.size ());
+  return information->attributes[i];
+}
+
+bool
+IidManager::LookupAttribute (uint16_t uid, const std::string &name,
+                             uint16_t *owner, std::size_t *index) const
+{
+  NS_LOG_FUNCTION (IID << uid << name);
+  while (true)
+    {
+      struct IidInformation *information = LookupInformation (uid);
+      attributeindex_t::const_iterator i = information->attributeIndex.find (name);
+      if (i != information->attributeIndex.end ())
+        {
+          *owner = uid;
+          *index = i->second;
+          NS_LOG_LOGIC (IIDL << *owner << " " << *index);
+          return true;
+        }
+      if (information->parent == uid || information->parent == 0)
+        {
+          // top of inheritance tree
+          NS_LOG_LOGIC (IIDL << false);
+          return false;
+        }
+      uid = information->parent;
+    }
+}
 
 bool
 IidManager::HasTraceSource (uint16_t uid,
@@ -883,40 +1070,39 @@ bool
 TypeId::LookupAttributeByName (std::string name, struct TypeId::AttributeInformation *info) const
 {
   NS_LOG_FUNCTION (this << name << info);
-  TypeId tid;
-  TypeId nextTid = *this;
-  do
+  TypeId owner;
+  std::size_t index;
+  if (!LookupAttributeIndexByName (name, &owner, &index))
     {
-      tid = nextTid;
-      for (std::size_t i = 0; i < tid.GetAttributeN (); i++)
-        {
-          struct TypeId::AttributeInformation tmp = tid.GetAttribute (i);
-          if (tmp.name == name)
-            {
-              if (tmp.supportLevel == TypeId::SUPPORTED)
-                {
-                  *info = tmp;
-                  return true;
-                }
-              else if (tmp.supportLevel == TypeId::DEPRECATED)
-                {
-                  std::cerr << "Attribute '" << name << "' is deprecated: "
-                            << tmp.supportMsg << std::endl;
-                  *info = tmp;
-                  return true;
-                }
-              else if (tmp.supportLevel == TypeId::OBSOLETE)
-                {
-                  NS_FATAL_ERROR ("Attribute '" << name <<
-                                  "' is obsolete, with no fallback: " <<
-                                  tmp.supportMsg);
-                }
-            }
-        }
-      nextTid = tid.GetParent ();
+      return false;
     }
-  while (nextTid != tid);
-  return false;
+  const struct TypeId::AttributeInformation &tmp = owner.PeekAttribute (index);
+  if (tmp.supportLevel == TypeId::DEPRECATED)
+    {
+      std::cerr << "Attribute '" << name << "' is deprecated: "
+                << tmp.supportMsg << std::endl;
+    }
+  else if (tmp.supportLevel == TypeId::OBSOLETE)
+    {
+      NS_FATAL_ERROR ("Attribute '" << name <<
+                      "' is obsolete, with no fallback: " <<
+                      tmp.supportMsg);
+    }
+  *info = tmp;
+  return true;
+}
+
+bool
+TypeId::LookupAttributeIndexByName (const std::string &name, TypeId *owner, std::size_t *index) const
+{
+  NS_LOG_FUNCTION (this << name << owner << index);
+  uint16_t uid;
+  if (!IidManager::Get ()->LookupAttribute (m_tid, name, &uid, index))
+    {
+      return false;
+    }
+  *owner = TypeId (uid);
+  return true;
 }
 
 TypeId
@@ -1086,12 +1272,17 @@ TypeId::GetAttribute (std::size_t i) const
   NS_LOG_FUNCTION (this << i);
   return IidManager::Get ()->GetAttribute (m_tid, i);
 }
+const struct TypeId::AttributeInformation &
+TypeId::PeekAttribute (std::size_t i) const
+{
+  NS_LOG_FUNCTION (this << i);
+  return IidManager::Get ()->PeekAttribute (m_tid, i);
+}
 std::string
 TypeId::GetAttributeFullName (std::size_t i) const
 {
   NS_LOG_FUNCTION (this << i);
-  struct TypeId::AttributeInformation info = GetAttribute (i);
-  return GetName () + "::" + info.name;
+  return GetName () + "::" + PeekAttribute (i).name;
 }
 
 std::size_t
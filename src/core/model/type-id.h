@@ -258,6 +258,17 @@ public:
    * \returns The information associated to attribute whose index is \pname{i}.
    */
   struct TypeId::AttributeInformation GetAttribute (std::size_t i) const;
+  /**
+   * Get a reference to the Attribute information by index.
+   *
+   * Unlike GetAttribute, this does not copy the information.  The
+   * reference is invalidated by the next AddAttribute on this TypeId.
+   *
+   * \param [in] i Index into attribute array
+   * 
+eturns The information associated to attribute whose index is \pname{i}.
+   */
+  const struct TypeId::AttributeInformation & PeekAttribute (std::size_t i) const;
   /**
    * Get the Attribute name by index.
    *
@@ -472,6 +483,22 @@ public:
    * \returns \c true if the requested attribute could be found.
    */
   bool LookupAttributeByName (std::string name, struct AttributeInformation *info) const;
+  /**
+   * Find where an Attribute is defined, by name.
+   *
+   * Each TypeId indexes its own Attributes by name in a hash table;
+   * the lookup probes the tables of this TypeId and of its parents.
+   * Unlike LookupAttributeByName, this does not check the support
+   * level of the Attribute.
+   *
+   * \param [in]  name The name of the requested attribute
+   * \param [out] owner The TypeId, this one or a parent, which
+   *              defines the attribute.
+   * \param [out] index The index of the attribute in \pname{owner}.
+   * 
+eturns \c true if the requested attribute could be found.
+   */
+  bool LookupAttributeIndexByName (const std::string &name, TypeId *owner, std::size_t *index) const;
   /**
    * Find a TraceSource by name.
    *
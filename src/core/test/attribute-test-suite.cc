@@ -34,6 +34,7 @@
 #include "ns3/pointer.h"
 #include "ns3/object-factory.h"
 #include "ns3/nstime.h"
+#include "ns3/attribute-handle.h"
 
 using namespace ns3;
 
@@ -1467,6 +1468,73 @@ CallbackValueTestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (m_gotCbValue, 2, "Callback Attribute set to null callback unexpectedly fired");
 }
 
+// ===========================================================================
+// Test the typed AttributeHandle.
+// ===========================================================================
+class AttributeHandleTestCase : public TestCase
+{
+public:
+  AttributeHandleTestCase (std::string description);
+  virtual ~AttributeHandleTestCase ()
+  {}
+
+private:
+  virtual void DoRun (void);
+};
+
+AttributeHandleTestCase::AttributeHandleTestCase (std::string description)
+  : TestCase (description)
+{}
+
+void
+AttributeHandleTestCase::DoRun (void)
+{
+  Ptr<AttributeObjectTest> p = CreateObject<AttributeObjectTest> ();
+  NS_TEST_ASSERT_MSG_NE (p, 0, "Unable to CreateObject");
+
+  //
+  // A member variable, with bounds checked by the checker.
+  //
+  AttributeHandle<IntegerValue> bounded (AttributeObjectTest::GetTypeId (), "TestInt16WithBounds");
+  NS_TEST_ASSERT_MSG_EQ (bounded.IsValid (), true, "Handle not resolved");
+  NS_TEST_ASSERT_MSG_EQ (bounded.Get (p), -2, "Handle does not read the initial value");
+  bounded.Set (p, 7);
+  NS_TEST_ASSERT_MSG_EQ (bounded.Get (p), 7, "Handle does not read the value set");
+  IntegerValue integer;
+  p->GetAttribute ("TestInt16WithBounds", integer);
+  NS_TEST_ASSERT_MSG_EQ (integer.Get (), 7, "Handle does not set the attribute");
+  bool ok = bounded.SetFailSafe (PeekPointer (p), 11);
+  NS_TEST_ASSERT_MSG_EQ (ok, false, "Handle sets a value out of bounds");
+  NS_TEST_ASSERT_MSG_EQ (bounded.Get (p), 7, "Value out of bounds changed the attribute");
+
+  //
+  // Setter and getter methods.
+  //
+  AttributeHandle<IntegerValue> setGet (AttributeObjectTest::GetTypeId (), "TestInt16SetGet");
+  setGet.Set (p, -9);
+  NS_TEST_ASSERT_MSG_EQ (setGet.Get (p), -9, "Handle does not go through the setter and getter");
+
+  AttributeHandle<EnumValue> enumeration (AttributeObjectTest::GetTypeId (), "TestEnum");
+  enumeration.Set (p, AttributeObjectTest::TEST_C);
+  NS_TEST_ASSERT_MSG_EQ (enumeration.Get (p), AttributeObjectTest::TEST_C, "Enum not set");
+  ok = enumeration.SetFailSafe (PeekPointer (p), 5);
+  NS_TEST_ASSERT_MSG_EQ (ok, false, "Handle sets an unknown enum value");
+
+  AttributeHandle<TimeValue> time (AttributeObjectTest::GetTypeId (), "TestTimeWithBounds");
+  time.Set (p, Seconds (3));
+  NS_TEST_ASSERT_MSG_EQ (time.Get (p), Seconds (3), "Time not set");
+
+  //
+  // Missing attributes, and attributes of another value type.
+  //
+  AttributeHandle<IntegerValue> missing =
+    AttributeHandle<IntegerValue>::LookupFailSafe (AttributeObjectTest::GetTypeId (), "NoSuchAttribute");
+  NS_TEST_ASSERT_MSG_EQ (missing.IsValid (), false, "Handle resolved to a missing attribute");
+  AttributeHandle<DoubleValue> wrongType =
+    AttributeHandle<DoubleValue>::LookupFailSafe (AttributeObjectTest::GetTypeId (), "TestInt16");
+  NS_TEST_ASSERT_MSG_EQ (wrongType.IsValid (), false, "Handle resolved to an attribute of another type");
+}
+
 // ===========================================================================
 // The Test Suite that glues all of the Test Cases together.
 // ===========================================================================
@@ -1490,6 +1558,7 @@ AttributesTestSuite::AttributesTestSuite ()
   AddTestCase (new ObjectMapAttributeTestCase ("Check Attributes of type ObjectMapValue"), TestCase::QUICK);
   AddTestCase (new PointerAttributeTestCase ("Check Attributes of type PointerValue"), TestCase::QUICK);
   AddTestCase (new CallbackValueTestCase ("Check Attributes of type CallbackValue"), TestCase::QUICK);
+  AddTestCase (new AttributeHandleTestCase ("Check typed AttributeHandle access"), TestCase::QUICK);
   AddTestCase (new IntegerTraceSourceAttributeTestCase ("Ensure TracedValue<uint8_t> can be set like IntegerValue"), TestCase::QUICK);
   AddTestCase (new IntegerTraceSourceTestCase ("Ensure TracedValue<uint8_t> also works as trace source"), TestCase::QUICK);
   AddTestCase (new TracedCallbackTestCase ("Ensure TracedCallback<double, int, float> works as trace source"), TestCase::QUICK);
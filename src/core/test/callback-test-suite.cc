@@ -739,6 +739,75 @@ MakeCallbackTemplatesTestCase::DoRun (void)
   that.CheckParentalRights ();
 }
 
+// ===========================================================================
+// Test the equality of Callbacks, which compares the types of their
+// implementations and then their targets.
+// ===========================================================================
+class EqualityCallbackTarget
+{
+public:
+  void Target1 (int a)
+  {
+    NS_UNUSED (a);
+  }
+  void Target2 (int a)
+  {
+    NS_UNUSED (a);
+  }
+};
+
+class EqualityCallbackTestCase : public TestCase
+{
+public:
+  EqualityCallbackTestCase ();
+  virtual ~EqualityCallbackTestCase ()
+  {}
+
+private:
+  virtual void DoRun (void);
+};
+
+/* *NS_CHECK_STYLE_OFF* */
+void TestEqualityOne (int) {}
+void TestEqualityTwo (int) {}
+void TestEqualityBound (int, int) {}
+/* *NS_CHECK_STYLE_ON* */
+
+EqualityCallbackTestCase::EqualityCallbackTestCase ()
+  : TestCase ("Check IsEqual()")
+{}
+
+void
+EqualityCallbackTestCase::DoRun (void)
+{
+  EqualityCallbackTarget target;
+  EqualityCallbackTarget other;
+  Callback<void, int> function = MakeCallback (&TestEqualityOne);
+  Callback<void, int> member = MakeCallback (&EqualityCallbackTarget::Target1, &target);
+  Callback<void, int> bound = MakeBoundCallback (&TestEqualityBound, 1);
+
+  NS_TEST_ASSERT_MSG_EQ (function.IsEqual (MakeCallback (&TestEqualityOne)), true,
+                         "Callbacks to the same function differ");
+  NS_TEST_ASSERT_MSG_EQ (function.IsEqual (MakeCallback (&TestEqualityTwo)), false,
+                         "Callbacks to different functions are equal");
+  NS_TEST_ASSERT_MSG_EQ (member.IsEqual (MakeCallback (&EqualityCallbackTarget::Target1, &target)), true,
+                         "Callbacks to the same method differ");
+  NS_TEST_ASSERT_MSG_EQ (member.IsEqual (MakeCallback (&EqualityCallbackTarget::Target2, &target)), false,
+                         "Callbacks to different methods are equal");
+  NS_TEST_ASSERT_MSG_EQ (member.IsEqual (MakeCallback (&EqualityCallbackTarget::Target1, &other)), false,
+                         "Callbacks to different objects are equal");
+  NS_TEST_ASSERT_MSG_EQ (bound.IsEqual (MakeBoundCallback (&TestEqualityBound, 1)), true,
+                         "Callbacks with the same bound argument differ");
+  NS_TEST_ASSERT_MSG_EQ (bound.IsEqual (MakeBoundCallback (&TestEqualityBound, 2)), false,
+                         "Callbacks with different bound arguments are equal");
+  NS_TEST_ASSERT_MSG_EQ (function.IsEqual (member), false,
+                         "Callbacks of different implementations are equal");
+  NS_TEST_ASSERT_MSG_EQ (member.IsEqual (bound), false,
+                         "Callbacks of different implementations are equal");
+  NS_TEST_ASSERT_MSG_EQ (function.IsEqual (Callback<void, int> ()), false,
+                         "Callback equal to a null Callback");
+}
+
 // ===========================================================================
 // The Test Suite that glues all of the Test Cases together.
 // ===========================================================================
@@ -756,6 +825,7 @@ CallbackTestSuite::CallbackTestSuite ()
   AddTestCase (new MakeBoundCallbackTestCase, TestCase::QUICK);
   AddTestCase (new NullifyCallbackTestCase, TestCase::QUICK);
   AddTestCase (new MakeCallbackTemplatesTestCase, TestCase::QUICK);
+  AddTestCase (new EqualityCallbackTestCase, TestCase::QUICK);
 }
 
 static CallbackTestSuite CallbackTestSuite;
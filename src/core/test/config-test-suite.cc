@@ -840,6 +840,107 @@ SearchAttributesOfParentObjectsTestCase::DoRun (void)
 
 }
 
+/**
+ * \ingroup config-tests
+ * Test for the compiled paths, and their incremental application.
+ */
+class PathConfigTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  PathConfigTestCase ();
+  /** Destructor. */
+  virtual ~PathConfigTestCase ()
+  {}
+
+  /**
+   * Trace callback with context path.
+   * \param path The context path.
+   * \param old The old value.
+   * \param newValue The new value.
+   */
+  void TraceWithPath (std::string path, int16_t old, int16_t newValue)
+  {
+    NS_UNUSED (old);
+    NS_UNUSED (newValue);
+    m_paths.push_back (path);
+  }
+
+private:
+  virtual void DoRun (void);
+
+  std::vector<std::string> m_paths; //!< The context paths of the traces.
+};
+
+PathConfigTestCase::PathConfigTestCase ()
+  : TestCase ("Check that a compiled path only visits the new objects when applied again")
+{}
+
+void
+PathConfigTestCase::DoRun (void)
+{
+  IntegerValue iv;
+  Ptr<ConfigTestObject> root = CreateObject<ConfigTestObject> ();
+  Config::RegisterRootNamespaceObject (root);
+
+  std::vector<Ptr<ConfigTestObject> > objects;
+  for (uint32_t i = 0; i < 6; ++i)
+    {
+      objects.push_back (CreateObject<ConfigTestObject> ());
+    }
+  root->AddNodeA (objects[0]);
+  root->AddNodeA (objects[1]);
+
+  Config::Path trace ("/NodesA/*/Source");
+  NS_TEST_ASSERT_MSG_EQ (trace.GetPath (), "/NodesA/*/Source", "Wrong path");
+  trace.Connect (MakeCallback (&PathConfigTestCase::TraceWithPath, this));
+  Config::Path set ("/NodesA/[1-3]|5/A");
+  set.Set (IntegerValue (-1));
+
+  //
+  // Add objects to the container of the root, and apply the paths again:
+  // only the new objects are connected and set.
+  //
+  root->AddNodeA (objects[2]);
+  root->AddNodeA (objects[3]);
+  objects[1]->SetAttribute ("A", IntegerValue (3));
+  trace.Connect (MakeCallback (&PathConfigTestCase::TraceWithPath, this));
+  set.Set (IntegerValue (-2));
+  NS_TEST_ASSERT_MSG_EQ (trace.LookupNewMatches ().GetN (), 0, "Objects matched twice");
+  NS_TEST_ASSERT_MSG_EQ (set.LookupMatches ().GetN (), 3, "Wrong number of matches");
+
+  for (uint32_t i = 0; i < 4; ++i)
+    {
+      objects[i]->SetAttribute ("Source", IntegerValue (i));
+    }
+  NS_TEST_ASSERT_MSG_EQ (m_paths.size (), 4, "Trace sources connected twice");
+  for (uint32_t i = 0; i < m_paths.size (); ++i)
+    {
+      std::ostringstream oss;
+      oss << "/NodesA/" << i << "/Source";
+      NS_TEST_ASSERT_MSG_EQ (m_paths[i], oss.str (), "Trace did not provide expected context");
+    }
+
+  objects[0]->GetAttribute ("A", iv);
+  NS_TEST_ASSERT_MSG_EQ (iv.Get (), 10, "Object Attribute \"A\" unexpectedly set");
+  objects[1]->GetAttribute ("A", iv);
+  NS_TEST_ASSERT_MSG_EQ (iv.Get (), 3, "Object Attribute \"A\" set twice");
+  objects[2]->GetAttribute ("A", iv);
+  NS_TEST_ASSERT_MSG_EQ (iv.Get (), -2, "Object Attribute \"A\" not set as expected");
+  objects[3]->GetAttribute ("A", iv);
+  NS_TEST_ASSERT_MSG_EQ (iv.Get (), -2, "Object Attribute \"A\" not set as expected");
+
+  //
+  // An object reached outside the containers of the root is matched once.
+  //
+  root->SetNodeA (objects[4]);
+  Config::Path pointer ("/NodeA/A");
+  NS_TEST_ASSERT_MSG_EQ (pointer.LookupNewMatches ().GetN (), 1, "Object not matched");
+  NS_TEST_ASSERT_MSG_EQ (pointer.LookupNewMatches ().GetN (), 0, "Object matched twice");
+
+  Config::UnregisterRootNamespaceObject (root);
+}
+
 /**
  * \ingroup config-tests
  * The Test Suite that glues all of the Test Cases together.
@@ -858,6 +959,7 @@ ConfigTestSuite::ConfigTestSuite ()
   AddTestCase (new UnderRootNamespaceConfigTestCase);
   AddTestCase (new ObjectVectorConfigTestCase);
   AddTestCase (new SearchAttributesOfParentObjectsTestCase);
+  AddTestCase (new PathConfigTestCase);
 }
 
 /**
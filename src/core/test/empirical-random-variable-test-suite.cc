@@ -0,0 +1,236 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Amiraslan Haghrah
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/test.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup randomvariable
+ * EmpiricalRandomVariable sampling tables test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup empirical-random-variable-tests EmpiricalRandomVariable test suite
+ */
+
+namespace ns3 {
+
+namespace tests {
+
+
+/**
+ * \ingroup empirical-random-variable-tests
+ * Base class of the EmpiricalRandomVariable test cases: a CDF with
+ * many points, irregularly spaced.
+ */
+class EmpiricalTestCaseBase : public TestCase
+{
+public:
+  /**
+   * Constructor.
+   * \param name the name of the test case
+   */
+  EmpiricalTestCaseBase (std::string name);
+
+protected:
+  /**
+   * Make an empirical random variable with the CDF.
+   * \param interpolate the interpolate mode
+   * \param alias the alias mode
+   * \returns the random variable, with stream 11
+   */
+  Ptr<EmpiricalRandomVariable> Make (bool interpolate, bool alias);
+
+  std::vector<double> m_values;  //!< The values of the CDF points.
+  std::vector<double> m_cdf;     //!< The CDF at the points.
+};
+
+EmpiricalTestCaseBase::EmpiricalTestCaseBase (std::string name)
+  : TestCase (name)
+{
+  // clustered probabilities, and a point of null probability
+  double cdf = 0.05;
+  for (uint32_t i = 0; i < 200; ++i)
+    {
+      m_values.push_back (i * 1.5);
+      m_cdf.push_back (cdf);
+      if (i != 100)
+        {
+          cdf += (i % 10 == 0) ? 0.02 : 0.002;
+        }
+    }
+  m_cdf.back () = 1.0;
+}
+
+Ptr<EmpiricalRandomVariable>
+EmpiricalTestCaseBase::Make (bool interpolate, bool alias)
+{
+  Ptr<EmpiricalRandomVariable> x = CreateObject<EmpiricalRandomVariable> ();
+  x->SetAttribute ("Interpolate", BooleanValue (interpolate));
+  x->SetAttribute ("Alias", BooleanValue (alias));
+  x->SetStream (11);
+  for (std::size_t i = 0; i < m_values.size (); ++i)
+    {
+      x->CDF (m_values[i], m_cdf[i]);
+    }
+  return x;
+}
+
+
+/**
+ * \ingroup empirical-random-variable-tests
+ * Check that the grid table gives the values of a binary search of the
+ * CDF, in both modes, and that GetValues gives those of GetValue.
+ */
+class EmpiricalGridTestCase : public EmpiricalTestCaseBase
+{
+public:
+  /** Constructor. */
+  EmpiricalGridTestCase ();
+  virtual void DoRun (void);
+};
+
+EmpiricalGridTestCase::EmpiricalGridTestCase ()
+  : EmpiricalTestCaseBase ("Grid table search")
+{}
+
+void
+EmpiricalGridTestCase::DoRun (void)
+{
+  const std::size_t n = 20000;
+  for (int interpolate = 0; interpolate < 2; ++interpolate)
+    {
+      Ptr<EmpiricalRandomVariable> x = Make (interpolate, false);
+      Ptr<EmpiricalRandomVariable> y = Make (interpolate, false);
+      // the same stream, so the same uniform numbers
+      Ptr<UniformRandomVariable> u = CreateObject<UniformRandomVariable> ();
+      u->SetStream (11);
+      std::vector<double> values (n);
+      y->GetValues (&values[0], n);
+      for (std::size_t j = 0; j < n; ++j)
+        {
+          double r = u->GetValue ();
+          double expected;
+          std::size_t upper = std::upper_bound (m_cdf.begin (), m_cdf.end (), r) - m_cdf.begin ();
+          if (r <= m_cdf.front ())
+            {
+              expected = m_values.front ();
+            }
+          else if (r >= m_cdf.back ())
+            {
+              expected = m_values.back ();
+            }
+          else if (!interpolate)
+            {
+              expected = m_values[upper];
+            }
+          else
+            {
+              std::size_t lower = upper - 1;
+              expected = m_values[lower] + ((m_values[upper] - m_values[lower])
+                                            / (m_cdf[upper] - m_cdf[lower])) * (r - m_cdf[lower]);
+            }
+          NS_TEST_ASSERT_MSG_EQ (x->GetValue (), expected, "wrong value for " << r);
+          NS_TEST_ASSERT_MSG_EQ (values[j], expected, "wrong bulk value for " << r);
+        }
+    }
+}
+
+
+/**
+ * \ingroup empirical-random-variable-tests
+ * Check the distribution of the values sampled with the alias table.
+ */
+class EmpiricalAliasTestCase : public EmpiricalTestCaseBase
+{
+public:
+  /** Constructor. */
+  EmpiricalAliasTestCase ();
+  virtual void DoRun (void);
+};
+
+EmpiricalAliasTestCase::EmpiricalAliasTestCase ()
+  : EmpiricalTestCaseBase ("Alias table sampling")
+{}
+
+void
+EmpiricalAliasTestCase::DoRun (void)
+{
+  const std::size_t n = 1000000;
+  Ptr<EmpiricalRandomVariable> x = Make (false, true);
+  std::vector<double> values (n);
+  x->GetValues (&values[0], n);
+  std::map<double, uint32_t> counts;
+  for (std::size_t j = 0; j < n; ++j)
+    {
+      counts[values[j]]++;
+    }
+  double prior = 0;
+  for (std::size_t i = 0; i < m_values.size (); ++i)
+    {
+      double p = m_cdf[i] - prior;
+      prior = m_cdf[i];
+      double count = counts[m_values[i]];
+      counts.erase (m_values[i]);
+      // within 5 standard deviations of the binomial count
+      double tolerance = 5 * std::sqrt (n * p * (1 - p)) + 1;
+      NS_TEST_ASSERT_MSG_EQ_TOL (count, n * p, tolerance, "wrong frequency of " << m_values[i]);
+    }
+  NS_TEST_ASSERT_MSG_EQ (counts.size (), 0, "value not in the CDF");
+}
+
+
+/**
+ * \ingroup empirical-random-variable-tests
+ * EmpiricalRandomVariable test suite.
+ */
+class EmpiricalRandomVariableTestSuite : public TestSuite
+{
+public:
+  /** Constructor. */
+  EmpiricalRandomVariableTestSuite ();
+};
+
+EmpiricalRandomVariableTestSuite::EmpiricalRandomVariableTestSuite ()
+  : TestSuite ("empirical-random-variable")
+{
+  AddTestCase (new EmpiricalGridTestCase ());
+  AddTestCase (new EmpiricalAliasTestCase ());
+}
+
+/**
+ * \ingroup empirical-random-variable-tests
+ * EmpiricalRandomVariableTestSuite instance variable.
+ */
+static EmpiricalRandomVariableTestSuite g_empiricalRandomVariableTestSuite;
+
+
+}    // namespace tests
+
+}  // namespace ns3
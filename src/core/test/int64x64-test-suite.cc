@@ -18,6 +18,7 @@
  */
 
 #include "ns3/int64x64.h"
+#include "ns3/nstime.h"
 #include "ns3/test.h"
 #include "ns3/valgrind.h"  // Bug 1882
 
@@ -1173,6 +1174,98 @@ Int64x64DoubleTestCase::DoRun (void)
 }
 
 
+/**
+ * Check the exact results of the multiplications and divisions which
+ * take the fast paths of the int128 implementation: integer or pure
+ * fraction operands, and the quotients of Times.
+ */
+class Int64x64FastPathTestCase : public TestCase
+{
+public:
+  Int64x64FastPathTestCase ();
+  virtual void DoRun (void);
+
+  void Check (const int64x64_t value, const int64_t hi, const uint64_t lo,
+              const std::string & msg);
+};
+
+Int64x64FastPathTestCase::Int64x64FastPathTestCase ()
+  : TestCase ("Exact results of the int128 fast paths")
+{}
+void
+Int64x64FastPathTestCase::Check (const int64x64_t value,
+                                 const int64_t hi, const uint64_t lo,
+                                 const std::string & msg)
+{
+  bool pass = (value.GetHigh () == hi) && (value.GetLow () == lo);
+
+  std::cout << GetParent ()->GetName () << " Fast path: "
+            << (pass ? "pass " : "FAIL ")
+            << Printer (value);
+  if (!pass)
+    {
+      std::cout << ", expected " << Printer (hi, lo);
+    }
+  std::cout << ": " << msg << std::endl;
+
+  NS_TEST_EXPECT_MSG_EQ (value.GetHigh (), hi, msg << ": high word");
+  NS_TEST_EXPECT_MSG_EQ (value.GetLow (), lo, msg << ": low word");
+}
+
+void
+Int64x64FastPathTestCase::DoRun (void)
+{
+  std::cout << std::endl;
+  std::cout << GetParent ()->GetName () << " Fast path: " << GetName ()
+            << std::endl;
+
+  if (int64x64_t::implementation != int64x64_t::int128_impl)
+    {
+      std::cout << GetParent ()->GetName () << " Fast path: "
+                << "skip, not the int128 implementation" << std::endl;
+      return;
+    }
+
+  const int64x64_t one  (1, 0);
+  const int64x64_t two  (2, 0);
+  const int64x64_t thre (3, 0);
+  const int64x64_t frac (0, 0xc000000000000000ULL);  // 0.75
+  const int64x64_t half (0, 0x8000000000000000ULL);  // 0.5
+  const int64x64_t third (0, 0x5555555555555555ULL);
+
+  // Integer divisor
+  Check ( one / thre,     0, 0x5555555555555555ULL, "1 / 3");
+  Check ( two / thre,     0, 0xaaaaaaaaaaaaaaaaULL, "2 / 3");
+  Check ( int64x64_t (7) / two, 3, 0x8000000000000000ULL, "7 / 2");
+  Check (-one / thre,    -1, 0xaaaaaaaaaaaaaaabULL, "-1 / 3");
+  Check ( one / (-thre), -1, 0xaaaaaaaaaaaaaaabULL, "1 / -3");
+  // Fractional dividend
+  Check ( frac / thre,    0, 0x4000000000000000ULL, "0.75 / 3");
+  Check ( third / frac,   0, 0x71c71c71c71c71c6ULL, "1/3 / 0.75");
+  // Fractional divisor
+  Check ( one / frac,     1, 0x5555555555555555ULL, "1 / 0.75");
+  Check ( thre / half,    6, 0, "3 / 0.5");
+  // General division
+  Check ( (thre + half) / (one + frac), 2, 0, "3.5 / 1.75");
+
+  // Integer operand
+  Check ( thre * third,   0, 0xffffffffffffffffULL, "3 * 1/3");
+  Check ( third * (-thre), -1, 1, "1/3 * -3");
+  Check ( int64x64_t (1000000) * int64x64_t (1000000), 1000000000000LL, 0,
+          "1e6 * 1e6");
+  // Fractional operands
+  Check ( half * frac,    0, 0x6000000000000000ULL, "0.5 * 0.75");
+  Check ( third * third,  0, 0x1c71c71c71c71c71ULL, "1/3 * 1/3");
+  // General multiplication
+  Check ( (two + half) * (one + half), 3, 0xc000000000000000ULL, "2.5 * 1.5");
+
+  // Quotient of Times, in the current unit
+  Check ( Seconds (1) / MilliSeconds (3), 333, 0x5555555555555555ULL,
+          "1s / 3ms");
+  Check ( MilliSeconds (3) / MicroSeconds (4), 750, 0, "3ms / 4us");
+}
+
+
 class Int64x64ImplTestCase : public TestCase
 {
 public:
@@ -1233,6 +1326,7 @@ public:
     AddTestCase (new Int64x64Bug1786TestCase (), TestCase::QUICK);
     AddTestCase (new Int64x64InvertTestCase (), TestCase::QUICK);
     AddTestCase (new Int64x64DoubleTestCase (), TestCase::QUICK);
+    AddTestCase (new Int64x64FastPathTestCase (), TestCase::QUICK);
   }
 }  g_int64x64TestSuite;
 
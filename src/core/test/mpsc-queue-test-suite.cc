@@ -0,0 +1,221 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Amiraslan Haghrah
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/core-config.h"
+#include "ns3/test.h"
+#include "ns3/mpsc-queue.h"
+#ifdef HAVE_PTHREAD_H
+#include "ns3/system-thread.h"
+
+#include <thread>  // yield
+#endif
+
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup thread
+ * MpscQueue test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup mpsc-queue-tests MpscQueue test suite
+ */
+
+namespace ns3 {
+
+namespace tests {
+
+
+/**
+ * \ingroup mpsc-queue-tests
+ * Check the order and the bounds of a queue used by one thread.
+ */
+class MpscQueueFifoTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  MpscQueueFifoTestCase ();
+  virtual void DoRun (void);
+};
+
+MpscQueueFifoTestCase::MpscQueueFifoTestCase ()
+  : TestCase ("Order and capacity of the queue")
+{}
+
+void
+MpscQueueFifoTestCase::DoRun (void)
+{
+  MpscQueue<uint32_t> queue (4);
+  uint32_t item = 0;
+  NS_TEST_ASSERT_MSG_EQ (queue.GetCapacity (), 4, "wrong capacity");
+  NS_TEST_ASSERT_MSG_EQ (queue.IsEmpty (), true, "new queue not empty");
+  NS_TEST_ASSERT_MSG_EQ (queue.Pop (item), false, "item popped from an empty queue");
+
+  // several laps of the ring
+  uint32_t next = 0;
+  for (uint32_t lap = 0; lap < 3; ++lap)
+    {
+      for (uint32_t i = 0; i < 4; ++i)
+        {
+          NS_TEST_ASSERT_MSG_EQ (queue.Push (lap * 4 + i), true, "item not pushed");
+        }
+      NS_TEST_ASSERT_MSG_EQ (queue.Push (100), false, "item pushed in a full queue");
+      NS_TEST_ASSERT_MSG_EQ (queue.IsEmpty (), false, "full queue empty");
+      // free one cell, which can be used again
+      NS_TEST_ASSERT_MSG_EQ (queue.Pop (item), true, "item not popped");
+      NS_TEST_ASSERT_MSG_EQ (item, next, "wrong order");
+      ++next;
+      NS_TEST_ASSERT_MSG_EQ (queue.Push (200 + lap), true, "freed cell not used");
+      while (queue.Pop (item))
+        {
+          if (item >= 200)
+            {
+              NS_TEST_ASSERT_MSG_EQ (item, 200 + lap, "wrong order");
+              next = (lap + 1) * 4;
+            }
+          else
+            {
+              NS_TEST_ASSERT_MSG_EQ (item, next, "wrong order");
+              ++next;
+            }
+        }
+      NS_TEST_ASSERT_MSG_EQ (queue.IsEmpty (), true, "drained queue not empty");
+    }
+}
+
+
+#ifdef HAVE_PTHREAD_H
+/**
+ * \ingroup mpsc-queue-tests
+ * Check that the items of concurrent producers are all popped, in order.
+ */
+class MpscQueueProducersTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  MpscQueueProducersTestCase ();
+  virtual void DoRun (void);
+
+private:
+  /** Item pushed by a producer. */
+  struct Item
+  {
+    uint32_t producer;   //!< the producer
+    uint32_t sequence;   //!< the number of items pushed before by the producer
+  };
+
+  /**
+   * Push the items of a producer, retrying when the queue is full.
+   * \param test the test case
+   * \param producer the producer
+   */
+  static void Produce (MpscQueueProducersTestCase *test, uint32_t producer);
+
+  MpscQueue<Item> m_queue;        //!< the queue
+  static const uint32_t N_PRODUCERS = 4;  //!< number of producers
+  static const uint32_t N_ITEMS = 20000;  //!< items pushed by each producer
+};
+
+const uint32_t MpscQueueProducersTestCase::N_PRODUCERS;
+const uint32_t MpscQueueProducersTestCase::N_ITEMS;
+
+MpscQueueProducersTestCase::MpscQueueProducersTestCase ()
+  : TestCase ("Concurrent producers"),
+    m_queue (64)
+{}
+
+void
+MpscQueueProducersTestCase::Produce (MpscQueueProducersTestCase *test, uint32_t producer)
+{
+  for (uint32_t i = 0; i < N_ITEMS; ++i)
+    {
+      Item item = { producer, i };
+      while (!test->m_queue.Push (item))
+        {
+          std::this_thread::yield ();
+        }
+    }
+}
+
+void
+MpscQueueProducersTestCase::DoRun (void)
+{
+  std::vector<Ptr<SystemThread> > threads;
+  for (uint32_t i = 0; i < N_PRODUCERS; ++i)
+    {
+      threads.push_back (Create<SystemThread> (MakeBoundCallback (&Produce, this, i)));
+      threads.back ()->Start ();
+    }
+  std::vector<uint32_t> next (N_PRODUCERS, 0);
+  uint32_t count = 0;
+  Item item;
+  while (count < N_PRODUCERS * N_ITEMS)
+    {
+      if (!m_queue.Pop (item))
+        {
+          std::this_thread::yield ();
+          continue;
+        }
+      NS_TEST_ASSERT_MSG_LT (item.producer, N_PRODUCERS, "unknown producer");
+      NS_TEST_ASSERT_MSG_EQ (item.sequence, next[item.producer], "item lost or out of order");
+      ++next[item.producer];
+      ++count;
+    }
+  for (uint32_t i = 0; i < N_PRODUCERS; ++i)
+    {
+      threads[i]->Join ();
+    }
+  NS_TEST_ASSERT_MSG_EQ (m_queue.IsEmpty (), true, "items left in the queue");
+}
+#endif /* HAVE_PTHREAD_H */
+
+
+/**
+ * \ingroup mpsc-queue-tests
+ * MpscQueue test suite.
+ */
+class MpscQueueTestSuite : public TestSuite
+{
+public:
+  /** Constructor. */
+  MpscQueueTestSuite ();
+};
+
+MpscQueueTestSuite::MpscQueueTestSuite ()
+  : TestSuite ("mpsc-queue")
+{
+  AddTestCase (new MpscQueueFifoTestCase ());
+#ifdef HAVE_PTHREAD_H
+  AddTestCase (new MpscQueueProducersTestCase ());
+#endif
+}
+
+/**
+ * \ingroup mpsc-queue-tests
+ * MpscQueueTestSuite instance variable.
+ */
+static MpscQueueTestSuite g_mpscQueueTestSuite;
+
+
+}    // namespace tests
+
+}  // namespace ns3
@@ -0,0 +1,255 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Amiraslan Haghrah
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/test.h"
+#include "ns3/parameter-sweep.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+
+#include <sstream>
+#include <unistd.h>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * ParameterSweep test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup parameter-sweep-tests ParameterSweep test suite
+ */
+
+namespace ns3 {
+
+namespace tests {
+
+
+/**
+ * \ingroup parameter-sweep-tests
+ * \param table a table written by ParameterSweep::Run
+ * \return the cells of the table, line by line
+ */
+static std::vector<std::vector<std::string> >
+ParseTable (std::string table)
+{
+  std::vector<std::vector<std::string> > cells;
+  std::istringstream lines (table);
+  std::string line;
+  while (std::getline (lines, line))
+    {
+      std::vector<std::string> row;
+      std::string::size_type start = 0;
+      std::string::size_type comma;
+      while ((comma = line.find (',', start)) != std::string::npos)
+        {
+          row.push_back (line.substr (start, comma - start));
+          start = comma + 1;
+        }
+      row.push_back (line.substr (start));
+      cells.push_back (row);
+    }
+  return cells;
+}
+
+
+/**
+ * \ingroup parameter-sweep-tests
+ * Check the grid, the seeds and the results of a sweep.
+ */
+class ParameterSweepGridTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  ParameterSweepGridTestCase ();
+  virtual void DoRun (void);
+
+private:
+  /**
+   * Run one replica: schedule an event at the "delay" parameter.
+   * \param replica the replica
+   */
+  static void RunReplica (ParameterSweep::Replica &replica);
+  /**
+   * Event of a replica.
+   * \param replica the replica
+   */
+  static void Fire (ParameterSweep::Replica *replica);
+};
+
+ParameterSweepGridTestCase::ParameterSweepGridTestCase ()
+  : TestCase ("Grid order, seeds and results")
+{}
+
+void
+ParameterSweepGridTestCase::Fire (ParameterSweep::Replica *replica)
+{
+  replica->Report ("fired", Simulator::Now ().GetSeconds ());
+}
+
+void
+ParameterSweepGridTestCase::RunReplica (ParameterSweep::Replica &replica)
+{
+  Simulator::Schedule (Seconds (replica.GetDouble ("delay")), &Fire, &replica);
+  Simulator::Run ();
+  Ptr<UniformRandomVariable> x = CreateObject<UniformRandomVariable> ();
+  x->SetStream (0);
+  replica.Report ("draw", x->GetValue ());
+  replica.Report ("rngSeed", RngSeedManager::GetSeed ());
+  replica.Report ("rngRun", RngSeedManager::GetRun ());
+}
+
+void
+ParameterSweepGridTestCase::DoRun (void)
+{
+  ParameterSweep sweep;
+  sweep.SetSeeds ("3, 5");
+  sweep.AddParameter ("delay", "1,2,4");
+  sweep.AddParameter ("mode", "a,b");
+  sweep.SetReplicas (2);
+  sweep.SetWorkers (3);
+  NS_TEST_ASSERT_MSG_EQ (sweep.GetNReplicas (), 24, "wrong grid size");
+
+  std::ostringstream oss;
+  uint32_t failed = sweep.Run (MakeCallback (&ParameterSweepGridTestCase::RunReplica), oss);
+  NS_TEST_ASSERT_MSG_EQ (failed, 0, "replicas failed");
+
+  std::vector<std::vector<std::string> > table = ParseTable (oss.str ());
+  NS_TEST_ASSERT_MSG_EQ (table.size (), 25, "wrong number of lines");
+  NS_TEST_ASSERT_MSG_EQ (oss.str ().substr (0, oss.str ().find ('\n')),
+                         "replica,seed,run,status,delay,mode,fired,draw,rngSeed,rngRun",
+                         "wrong header");
+
+  const char *delays[] = { "1", "2", "4" };
+  const char *modes[] = { "a", "b" };
+  for (uint32_t i = 0; i < 24; ++i)
+    {
+      const std::vector<std::string> &row = table[i + 1];
+      NS_TEST_ASSERT_MSG_EQ (row.size (), 10, "wrong number of cells");
+      std::string seed = (i < 12) ? "3" : "5";
+      std::string run = (i % 2 == 0) ? "1" : "2";
+      std::string delay = delays[(i / 4) % 3];
+      std::ostringstream index;
+      index << i;
+      NS_TEST_ASSERT_MSG_EQ (row[0], index.str (), "wrong replica index");
+      NS_TEST_ASSERT_MSG_EQ (row[1], seed, "wrong seed");
+      NS_TEST_ASSERT_MSG_EQ (row[2], run, "wrong run");
+      NS_TEST_ASSERT_MSG_EQ (row[3], "ok", "wrong status");
+      NS_TEST_ASSERT_MSG_EQ (row[4], delay, "wrong first parameter");
+      NS_TEST_ASSERT_MSG_EQ (row[5], modes[(i / 2) % 2], "wrong second parameter");
+      NS_TEST_ASSERT_MSG_EQ (row[6], delay, "wrong result");
+      NS_TEST_ASSERT_MSG_EQ (row[8], seed, "seed not set in the replica");
+      NS_TEST_ASSERT_MSG_EQ (row[9], run, "run not set in the replica");
+      // the random streams only depend on the seed and the run
+      NS_TEST_ASSERT_MSG_EQ (row[7], table[1 + (i / 12) * 12 + i % 2][7], "wrong random stream");
+    }
+  NS_TEST_ASSERT_MSG_NE (table[1][7], table[2][7], "same stream in two runs");
+  NS_TEST_ASSERT_MSG_NE (table[1][7], table[13][7], "same stream with two seeds");
+
+  // nothing ran in this process
+  NS_TEST_ASSERT_MSG_EQ (Simulator::Now (), Seconds (0), "simulation ran in the caller");
+}
+
+
+/**
+ * \ingroup parameter-sweep-tests
+ * Check that a failing replica does not stop the sweep.
+ */
+class ParameterSweepFailureTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  ParameterSweepFailureTestCase ();
+  virtual void DoRun (void);
+
+private:
+  /**
+   * Run one replica, which exits early when the "fail" parameter is set.
+   * \param replica the replica
+   */
+  static void RunReplica (ParameterSweep::Replica &replica);
+};
+
+ParameterSweepFailureTestCase::ParameterSweepFailureTestCase ()
+  : TestCase ("Failed replicas")
+{}
+
+void
+ParameterSweepFailureTestCase::RunReplica (ParameterSweep::Replica &replica)
+{
+  replica.Report ("started", "yes");
+  if (replica.GetInteger ("fail"))
+    {
+      _exit (2);
+    }
+  replica.Report ("completed", "yes");
+}
+
+void
+ParameterSweepFailureTestCase::DoRun (void)
+{
+  ParameterSweep sweep;
+  sweep.AddParameter ("fail", "0,1,0");
+  sweep.SetWorkers (1);
+
+  std::ostringstream oss;
+  uint32_t failed = sweep.Run (MakeCallback (&ParameterSweepFailureTestCase::RunReplica), oss);
+  NS_TEST_ASSERT_MSG_EQ (failed, 1, "wrong number of failed replicas");
+
+  std::vector<std::vector<std::string> > table = ParseTable (oss.str ());
+  NS_TEST_ASSERT_MSG_EQ (table.size (), 4, "wrong number of lines");
+  NS_TEST_ASSERT_MSG_EQ (table[0][6], "completed", "wrong result column");
+  NS_TEST_ASSERT_MSG_EQ (table[1][3], "ok", "wrong status");
+  NS_TEST_ASSERT_MSG_EQ (table[2][3], "failed", "wrong status of the failed replica");
+  NS_TEST_ASSERT_MSG_EQ (table[2][5], "", "result of the failed replica");
+  NS_TEST_ASSERT_MSG_EQ (table[2][6], "", "result of the failed replica");
+  NS_TEST_ASSERT_MSG_EQ (table[3][3], "ok", "sweep stopped by the failed replica");
+  NS_TEST_ASSERT_MSG_EQ (table[3][6], "yes", "wrong result");
+}
+
+
+/**
+ * \ingroup parameter-sweep-tests
+ * ParameterSweep test suite.
+ */
+class ParameterSweepTestSuite : public TestSuite
+{
+public:
+  /** Constructor. */
+  ParameterSweepTestSuite ();
+};
+
+ParameterSweepTestSuite::ParameterSweepTestSuite ()
+  : TestSuite ("parameter-sweep")
+{
+  AddTestCase (new ParameterSweepGridTestCase ());
+  AddTestCase (new ParameterSweepFailureTestCase ());
+}
+
+/**
+ * \ingroup parameter-sweep-tests
+ * ParameterSweepTestSuite instance variable.
+ */
+static ParameterSweepTestSuite g_parameterSweepTestSuite;
+
+
+}    // namespace tests
+
+}  // namespace ns3
@@ -0,0 +1,258 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Amiraslan Haghrah
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/test.h"
+#include "ns3/periodic-event-group.h"
+#include "ns3/simulator.h"
+
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup events
+ * PeriodicEventGroup test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup periodic-event-group-tests PeriodicEventGroup test suite
+ */
+
+namespace ns3 {
+
+namespace tests {
+
+
+/**
+ * \ingroup periodic-event-group-tests
+ * Check the times and contexts of the invocations of the callbacks.
+ */
+class PeriodicEventGroupInvokeTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  PeriodicEventGroupInvokeTestCase ();
+  virtual void DoRun (void);
+
+private:
+  /** The invocations of a callback. */
+  struct Record
+  {
+    uint32_t context;          //!< the expected context
+    std::vector<Time> times;   //!< the times of the invocations
+    bool wrongContext;         //!< set if invoked with another context
+    uint32_t inherited;        //!< the context of the events scheduled by the callback
+  };
+
+  /**
+   * Record an invocation, and schedule an event which records its context.
+   * \param record the record of the callback
+   */
+  static void Invoke (Record *record);
+  /**
+   * Record the context of an event.
+   * \param record the record of the callback which scheduled the event
+   */
+  static void Inherit (Record *record);
+};
+
+PeriodicEventGroupInvokeTestCase::PeriodicEventGroupInvokeTestCase ()
+  : TestCase ("Times and contexts of the invocations")
+{}
+
+void
+PeriodicEventGroupInvokeTestCase::Invoke (Record *record)
+{
+  record->times.push_back (Simulator::Now ());
+  if (Simulator::GetContext () != record->context)
+    {
+      record->wrongContext = true;
+    }
+  Simulator::Schedule (MicroSeconds (1), &Inherit, record);
+}
+
+void
+PeriodicEventGroupInvokeTestCase::Inherit (Record *record)
+{
+  record->inherited = Simulator::GetContext ();
+}
+
+void
+PeriodicEventGroupInvokeTestCase::DoRun (void)
+{
+  const uint32_t n = 4;
+  Record records[n];
+  PeriodicEventId ids[n];
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      records[i].context = 10 + i;
+      records[i].wrongContext = false;
+      records[i].inherited = 0;
+    }
+  // 0 and 1 share a group; 2 joins it, but later; 3 has another phase
+  ids[0] = PeriodicEventGroup::Schedule (MilliSeconds (1), MilliSeconds (1), 10,
+                                         MakeBoundCallback (&Invoke, &records[0]));
+  ids[1] = PeriodicEventGroup::Schedule (MilliSeconds (1), MilliSeconds (1), 11,
+                                         MakeBoundCallback (&Invoke, &records[1]));
+  ids[2] = PeriodicEventGroup::Schedule (MilliSeconds (3), MilliSeconds (1), 12,
+                                         MakeBoundCallback (&Invoke, &records[2]));
+  ids[3] = PeriodicEventGroup::Schedule (MicroSeconds (1500), MilliSeconds (1), 13,
+                                         MakeBoundCallback (&Invoke, &records[3]));
+  NS_TEST_ASSERT_MSG_EQ (ids[1].IsRunning (), true, "callback not scheduled");
+
+  Simulator::Schedule (MicroSeconds (4100), &PeriodicEventId::Cancel, &ids[0]);
+  Simulator::Stop (MicroSeconds (5200));
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (ids[0].IsRunning (), false, "callback not cancelled");
+  NS_TEST_ASSERT_MSG_EQ (records[0].times.size (), 4, "wrong number of invocations");
+  NS_TEST_ASSERT_MSG_EQ (records[1].times.size (), 5, "wrong number of invocations");
+  NS_TEST_ASSERT_MSG_EQ (records[2].times.size (), 3, "callback invoked before its start");
+  NS_TEST_ASSERT_MSG_EQ (records[3].times.size (), 4, "wrong number of invocations");
+  for (uint32_t k = 0; k < records[1].times.size (); ++k)
+    {
+      NS_TEST_ASSERT_MSG_EQ (records[1].times[k], MilliSeconds (k + 1), "wrong time");
+    }
+  NS_TEST_ASSERT_MSG_EQ (records[2].times[0], MilliSeconds (3), "wrong first time");
+  NS_TEST_ASSERT_MSG_EQ (records[3].times[0], MicroSeconds (1500), "wrong phase");
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (records[i].wrongContext, false, "wrong context");
+      NS_TEST_ASSERT_MSG_EQ (records[i].inherited, records[i].context, "context not inherited");
+    }
+
+  // with all the callbacks cancelled, the groups schedule no more events,
+  // and Run returns
+  ids[0].Cancel ();
+  PeriodicEventGroup::Cancel (std::vector<PeriodicEventId> (ids + 1, ids + n));
+  Simulator::Run ();
+  NS_TEST_ASSERT_MSG_EQ (records[1].times.size (), 5, "callback invoked after its cancellation");
+  Simulator::Destroy ();
+}
+
+
+/**
+ * \ingroup periodic-event-group-tests
+ * Check the batch scheduling and cancelling of callbacks.
+ */
+class PeriodicEventGroupBatchTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  PeriodicEventGroupBatchTestCase ();
+  virtual void DoRun (void);
+
+private:
+  /**
+   * Count an invocation.
+   * \param count the count of invocations
+   */
+  static void Count (uint32_t *count);
+  /**
+   * Cancel callbacks from a callback.
+   * \param ids the callbacks to cancel
+   */
+  static void CancelAll (std::vector<PeriodicEventId> *ids);
+};
+
+PeriodicEventGroupBatchTestCase::PeriodicEventGroupBatchTestCase ()
+  : TestCase ("Batch scheduling and cancelling")
+{}
+
+void
+PeriodicEventGroupBatchTestCase::Count (uint32_t *count)
+{
+  ++*count;
+}
+
+void
+PeriodicEventGroupBatchTestCase::CancelAll (std::vector<PeriodicEventId> *ids)
+{
+  PeriodicEventGroup::Cancel (*ids);
+}
+
+void
+PeriodicEventGroupBatchTestCase::DoRun (void)
+{
+  const uint32_t n = 1000;
+  std::vector<uint32_t> counts (n, 0);
+  std::vector<PeriodicEventGroup::Member> members (n);
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      members[i].context = i;
+      members[i].callback = MakeBoundCallback (&Count, &counts[i]);
+    }
+  std::vector<PeriodicEventId> ids = PeriodicEventGroup::Schedule (Seconds (0), Seconds (1), members);
+  NS_TEST_ASSERT_MSG_EQ (ids.size (), n, "wrong number of identifiers");
+
+  // a callback joining the group later cancels the batch at its first
+  // invocation, the third of the group
+  std::vector<PeriodicEventId> cancelled (ids.begin (), ids.end ());
+  PeriodicEventId canceller = PeriodicEventGroup::Schedule (Seconds (2), Seconds (1), 0,
+                                                            MakeBoundCallback (&CancelAll, &cancelled));
+  // cancel every other callback before the start
+  std::vector<PeriodicEventId> odd;
+  for (uint32_t i = 1; i < n; i += 2)
+    {
+      odd.push_back (ids[i]);
+    }
+  PeriodicEventGroup::Cancel (odd);
+  Simulator::Stop (Seconds (10));
+  Simulator::Run ();
+
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (ids[i].IsRunning (), false, "callback not cancelled");
+      NS_TEST_ASSERT_MSG_EQ (counts[i], (i % 2) ? 0 : 3, "wrong number of invocations");
+    }
+  NS_TEST_ASSERT_MSG_EQ (canceller.IsRunning (), true, "wrong callback cancelled");
+  canceller.Cancel ();
+  Simulator::Destroy ();
+}
+
+
+/**
+ * \ingroup periodic-event-group-tests
+ * PeriodicEventGroup test suite.
+ */
+class PeriodicEventGroupTestSuite : public TestSuite
+{
+public:
+  /** Constructor. */
+  PeriodicEventGroupTestSuite ();
+};
+
+PeriodicEventGroupTestSuite::PeriodicEventGroupTestSuite ()
+  : TestSuite ("periodic-event-group")
+{
+  AddTestCase (new PeriodicEventGroupInvokeTestCase ());
+  AddTestCase (new PeriodicEventGroupBatchTestCase ());
+}
+
+/**
+ * \ingroup periodic-event-group-tests
+ * PeriodicEventGroupTestSuite instance variable.
+ */
+static PeriodicEventGroupTestSuite g_periodicEventGroupTestSuite;
+
+
+}    // namespace tests
+
+}  // namespace ns3
@@ -20,6 +20,9 @@
 
 #include "ns3/test.h"
 #include "ns3/ptr.h"
+#include "ns3/pool-allocator.h"
+
+#include <utility>
 
 /**
  * \file
@@ -324,6 +327,177 @@ PtrTestCase::DoRun (void)
   }
 }
 
+
+/**
+ * \ingroup ptr-tests
+ * Object which counts the calls to Ref and Unref.
+ */
+class RefCounter : public PtrTestBase
+{
+public:
+  /** Count and increment the reference count. */
+  void Ref (void) const;
+  /** Count and decrement the reference count. */
+  void Unref (void) const;
+
+  static uint32_t m_nRefOps;  //!< The number of Ref and Unref calls.
+};
+
+uint32_t RefCounter::m_nRefOps = 0;
+
+void
+RefCounter::Ref (void) const
+{
+  m_nRefOps++;
+  PtrTestBase::Ref ();
+}
+void
+RefCounter::Unref (void) const
+{
+  m_nRefOps++;
+  PtrTestBase::Unref ();
+}
+
+
+/**
+ * \ingroup ptr-tests
+ * Check that moving a Ptr, or viewing it with a PtrView, does not touch
+ * the reference count.
+ */
+class PtrMoveTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  PtrMoveTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Inspect an object through a view.
+   * \param [in] view The view.
+   * \returns The object pointer.
+   */
+  static const RefCounter * Inspect (PtrView<const RefCounter> view);
+};
+
+PtrMoveTestCase::PtrMoveTestCase ()
+  : TestCase ("Ptr<> move and PtrView<>")
+{}
+
+const RefCounter *
+PtrMoveTestCase::Inspect (PtrView<const RefCounter> view)
+{
+  return &*view;
+}
+
+void
+PtrMoveTestCase::DoRun (void)
+{
+  Ptr<RefCounter> p1 = Create<RefCounter> ();
+  RefCounter *raw = PeekPointer (p1);
+  RefCounter::m_nRefOps = 0;
+
+  Ptr<RefCounter> p2 = std::move (p1);
+  NS_TEST_EXPECT_MSG_EQ (PeekPointer (p1), 0, "moved-from Ptr not empty");
+  NS_TEST_EXPECT_MSG_EQ (PeekPointer (p2), raw, "wrong moved Ptr");
+  Ptr<const RefCounter> p3 = std::move (p2);
+  NS_TEST_EXPECT_MSG_EQ (PeekPointer (p2), 0, "moved-from Ptr not empty");
+  Ptr<const PtrTestBase> p4;
+  p4 = std::move (p3);
+  NS_TEST_EXPECT_MSG_EQ (PeekPointer (p3), 0, "moved-from Ptr not empty");
+  NS_TEST_EXPECT_MSG_EQ (PeekPointer (p4), raw, "wrong move-assigned Ptr");
+  NS_TEST_EXPECT_MSG_EQ (RefCounter::m_nRefOps, 0, "the moves touched the reference count");
+
+  Ptr<RefCounter> p5 = Create<RefCounter> ();
+  NS_TEST_EXPECT_MSG_EQ (Inspect (p5), PeekPointer (p5), "wrong view");
+  NS_TEST_EXPECT_MSG_EQ (Inspect (raw), raw, "wrong view of a raw pointer");
+  NS_TEST_EXPECT_MSG_EQ (RefCounter::m_nRefOps, 0, "the views touched the reference count");
+
+  // a view converted to a Ptr takes a reference
+  PtrView<RefCounter> view (p5);
+  Ptr<RefCounter> p6 = view;
+  NS_TEST_EXPECT_MSG_EQ (RefCounter::m_nRefOps, 1, "the Ptr did not take a reference");
+  // move assignment releases the object held before
+  p6 = Ptr<RefCounter> ();
+  p5 = std::move (p6);
+  NS_TEST_EXPECT_MSG_EQ (PeekPointer (p5), 0, "wrong move-assigned Ptr");
+  NS_TEST_EXPECT_MSG_EQ (RefCounter::m_nRefOps, 3, "the objects were not released");
+}
+
+
+/**
+ * \ingroup ptr-tests
+ * Pooled object.
+ */
+class Pooled
+{
+public:
+  /**
+   * Allocate from the pool.
+   * \param [in] size The size of the object.
+   * \returns The object memory.
+   */
+  static void * operator new (std::size_t size)
+  {
+    return PoolAllocator<Pooled>::Allocate (size);
+  }
+  /**
+   * Release to the pool.
+   * \param [in] p The object memory.
+   * \param [in] size The size of the object.
+   */
+  static void operator delete (void *p, std::size_t size)
+  {
+    PoolAllocator<Pooled>::Deallocate (p, size);
+  }
+
+  double m_value[4];  //!< Some data.
+};
+
+
+/**
+ * \ingroup ptr-tests
+ * Check that PoolAllocator reuses the released objects.
+ */
+class PoolAllocatorTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  PoolAllocatorTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+PoolAllocatorTestCase::PoolAllocatorTestCase ()
+  : TestCase ("PoolAllocator<>")
+{}
+
+void
+PoolAllocatorTestCase::DoRun (void)
+{
+  uint64_t allocations = PoolAllocator<Pooled>::GetNAllocations ();
+  uint64_t reuses = PoolAllocator<Pooled>::GetNReuses ();
+  Pooled *a = new Pooled;
+  Pooled *b = new Pooled;
+  delete a;
+  Pooled *c = new Pooled;
+  NS_TEST_EXPECT_MSG_EQ (c, a, "the released object was not reused");
+  NS_TEST_EXPECT_MSG_EQ (PoolAllocator<Pooled>::GetNAllocations () - allocations, 3, "wrong allocation count");
+  NS_TEST_EXPECT_MSG_EQ (PoolAllocator<Pooled>::GetNReuses () - reuses, 1, "wrong reuse count");
+  delete b;
+  delete c;
+
+  // the objects released when the pool is disabled go to the system
+  PoolAllocator<Pooled>::Disable ();
+  Pooled *d = new Pooled;
+  delete d;
+  PoolAllocator<Pooled>::Enable ();
+  NS_TEST_EXPECT_MSG_EQ (PoolAllocator<Pooled>::GetNAllocations () - allocations, 3,
+                         "allocation counted while disabled");
+}
+
+
 /**
  * \ingroup ptr-tests
  * Test suite for pointer
@@ -336,6 +510,8 @@ public:
     : TestSuite ("ptr")
   {
     AddTestCase (new PtrTestCase ());
+    AddTestCase (new PtrMoveTestCase ());
+    AddTestCase (new PoolAllocatorTestCase ());
   }
 };
 
@@ -0,0 +1,231 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Amiraslan Haghrah
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/test.h"
+#include "ns3/rng-stream.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/integer.h"
+
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup rngimpl
+ * RngStream block generation test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup rng-stream-tests RngStream block generation test suite
+ */
+
+namespace ns3 {
+
+namespace tests {
+
+
+/**
+ * \ingroup rng-stream-tests
+ * Check that the block and lockstep RandU01 return the numbers of
+ * RandU01 (void).
+ */
+class RngStreamBlockTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  RngStreamBlockTestCase ();
+  virtual void DoRun (void);
+
+private:
+  /**
+   * Check the lockstep RandU01 against RandU01 (void).
+   * \param simd use the AVX2 instructions, if supported
+   */
+  void CheckLockstep (bool simd);
+};
+
+RngStreamBlockTestCase::RngStreamBlockTestCase ()
+  : TestCase ("Block and lockstep generation")
+{}
+
+void
+RngStreamBlockTestCase::CheckLockstep (bool simd)
+{
+  // two groups of four lanes, and three streams left
+  const std::size_t nStreams = 11;
+  const std::size_t n = 1000;
+  std::vector<RngStream *> streams;
+  std::vector<RngStream *> references;
+  for (std::size_t i = 0; i < nStreams; ++i)
+    {
+      streams.push_back (new RngStream (12345, i, 3));
+      references.push_back (new RngStream (12345, i, 3));
+    }
+  if (simd)
+    {
+      RngStream::EnableSimd ();
+    }
+  else
+    {
+      RngStream::DisableSimd ();
+    }
+  std::vector<double> values (nStreams * n);
+  // in two blocks, to check that the states are saved
+  for (std::size_t block = 0; block < 2; ++block)
+    {
+      RngStream::RandU01 (&streams[0], nStreams, &values[0], n);
+      for (std::size_t i = 0; i < nStreams; ++i)
+        {
+          for (std::size_t j = 0; j < n; ++j)
+            {
+              NS_TEST_ASSERT_MSG_EQ (values[i * n + j], references[i]->RandU01 (),
+                                     "lockstep number differs, stream " << i << " block " << block);
+            }
+        }
+    }
+  for (std::size_t i = 0; i < nStreams; ++i)
+    {
+      delete streams[i];
+      delete references[i];
+    }
+}
+
+void
+RngStreamBlockTestCase::DoRun (void)
+{
+  const std::size_t n = 10007;
+  RngStream stream (1, 2, 3);
+  RngStream reference (1, 2, 3);
+  std::vector<double> values (n);
+  stream.RandU01 (&values[0], n);
+  for (std::size_t j = 0; j < n; ++j)
+    {
+      NS_TEST_ASSERT_MSG_EQ (values[j], reference.RandU01 (), "block number differs");
+    }
+  NS_TEST_ASSERT_MSG_EQ (stream.RandU01 (), reference.RandU01 (), "state not saved");
+
+  bool simd = RngStream::IsSimdEnabled ();
+  CheckLockstep (false);
+  CheckLockstep (true);
+  if (!simd)
+    {
+      RngStream::DisableSimd ();
+    }
+}
+
+
+/**
+ * \ingroup rng-stream-tests
+ * Check that RandomVariableStream::GetValues returns the values of
+ * GetValue.
+ */
+class RngStreamGetValuesTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  RngStreamGetValuesTestCase ();
+  virtual void DoRun (void);
+
+private:
+  /**
+   * Compare GetValues and GetValue on two variables with the same stream.
+   * \param block the variable drawn by blocks
+   * \param reference the variable drawn one by one
+   * \param name the name of the distribution
+   */
+  void Check (Ptr<RandomVariableStream> block, Ptr<RandomVariableStream> reference,
+              std::string name);
+};
+
+RngStreamGetValuesTestCase::RngStreamGetValuesTestCase ()
+  : TestCase ("RandomVariableStream::GetValues")
+{}
+
+void
+RngStreamGetValuesTestCase::Check (Ptr<RandomVariableStream> block,
+                                   Ptr<RandomVariableStream> reference,
+                                   std::string name)
+{
+  const std::size_t n = 1000;
+  block->SetStream (7);
+  reference->SetStream (7);
+  std::vector<double> values (n);
+  block->GetValues (&values[0], n);
+  for (std::size_t j = 0; j < n; ++j)
+    {
+      NS_TEST_ASSERT_MSG_EQ (values[j], reference->GetValue (), name << " value " << j << " differs");
+    }
+  NS_TEST_ASSERT_MSG_EQ (block->GetValue (), reference->GetValue (), name << " stream not in step");
+}
+
+void
+RngStreamGetValuesTestCase::DoRun (void)
+{
+  Ptr<UniformRandomVariable> uniform[2];
+  Ptr<ExponentialRandomVariable> exponential[2];
+  Ptr<NormalRandomVariable> normal[2];
+  for (int i = 0; i < 2; ++i)
+    {
+      uniform[i] = CreateObject<UniformRandomVariable> ();
+      uniform[i]->SetAttribute ("Min", DoubleValue (-3));
+      uniform[i]->SetAttribute ("Max", DoubleValue (5));
+      uniform[i]->SetAttribute ("Antithetic", BooleanValue (true));
+      // a bound close to the mean, so that many values are rejected
+      exponential[i] = CreateObject<ExponentialRandomVariable> ();
+      exponential[i]->SetAttribute ("Mean", DoubleValue (2));
+      exponential[i]->SetAttribute ("Bound", DoubleValue (1));
+      normal[i] = CreateObject<NormalRandomVariable> ();
+    }
+  Check (uniform[0], uniform[1], "uniform");
+  Check (exponential[0], exponential[1], "exponential");
+  Check (normal[0], normal[1], "normal");
+}
+
+
+/**
+ * \ingroup rng-stream-tests
+ * RngStream block generation test suite.
+ */
+class RngStreamTestSuite : public TestSuite
+{
+public:
+  /** Constructor. */
+  RngStreamTestSuite ();
+};
+
+RngStreamTestSuite::RngStreamTestSuite ()
+  : TestSuite ("rng-stream")
+{
+  AddTestCase (new RngStreamBlockTestCase ());
+  AddTestCase (new RngStreamGetValuesTestCase ());
+}
+
+/**
+ * \ingroup rng-stream-tests
+ * RngStreamTestSuite instance variable.
+ */
+static RngStreamTestSuite g_rngStreamTestSuite;
+
+
+}    // namespace tests
+
+}  // namespace ns3
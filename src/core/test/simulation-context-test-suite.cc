@@ -0,0 +1,318 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Amiraslan Haghrah
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/core-config.h"
+#include "ns3/test.h"
+#include "ns3/simulation-context.h"
+#include "ns3/simulation-singleton.h"
+#include "ns3/simulator.h"
+#include "ns3/names.h"
+#include "ns3/config.h"
+#include "ns3/object.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/random-variable-stream.h"
+#ifdef HAVE_PTHREAD_H
+#include "ns3/system-thread.h"
+#endif
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup simulator
+ * SimulationContext test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup simulation-context-tests SimulationContext test suite
+ */
+
+namespace ns3 {
+
+namespace tests {
+
+
+/**
+ * \ingroup simulation-context-tests
+ * Check that interleaved contexts do not see each other.
+ */
+class SimulationContextIsolationTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  SimulationContextIsolationTestCase ();
+  virtual void DoRun (void);
+
+private:
+  /**
+   * Record the time of an event.
+   * \param time where to record the time
+   */
+  static void Record (Time *time);
+  /**
+   * Record a destroy event.
+   * \param destroyed set to true
+   */
+  static void Destroyed (bool *destroyed);
+};
+
+SimulationContextIsolationTestCase::SimulationContextIsolationTestCase ()
+  : TestCase ("Isolation of the simulations of two contexts")
+{}
+
+void
+SimulationContextIsolationTestCase::Record (Time *time)
+{
+  *time = Simulator::Now ();
+}
+
+void
+SimulationContextIsolationTestCase::Destroyed (bool *destroyed)
+{
+  *destroyed = true;
+}
+
+void
+SimulationContextIsolationTestCase::DoRun (void)
+{
+  Ptr<SimulationContext> a = Create<SimulationContext> ();
+  Ptr<SimulationContext> b = Create<SimulationContext> ();
+  Ptr<Object> object = CreateObject<Object> ();
+  Time timeA;
+  Time timeB;
+  bool destroyedA = false;
+  uint32_t seed = RngSeedManager::GetSeed ();
+
+  NS_TEST_ASSERT_MSG_EQ (SimulationContext::GetCurrent (), 0, "context bound by default");
+  {
+    SimulationContext::Scope scope (a);
+    NS_TEST_ASSERT_MSG_EQ (SimulationContext::GetCurrent (), PeekPointer (a), "context not bound");
+    Simulator::Schedule (Seconds (2), &Record, &timeA);
+    Simulator::ScheduleDestroy (&Destroyed, &destroyedA);
+    Names::Add ("shared-name", object);
+    Config::RegisterRootNamespaceObject (object);
+    RngSeedManager::SetSeed (seed + 1);
+    RngSeedManager::SetRun (7);
+    NS_TEST_ASSERT_MSG_EQ (RngSeedManager::GetNextStreamIndex (), 0, "stream index not per context");
+    NS_TEST_ASSERT_MSG_EQ (RngSeedManager::GetNextStreamIndex (), 1, "stream index not incremented");
+  }
+  {
+    SimulationContext::Scope scope (b);
+    NS_TEST_ASSERT_MSG_EQ (Simulator::GetEventCount (), 0, "events of another context");
+    NS_TEST_ASSERT_MSG_EQ (Names::Find<Object> ("shared-name"), 0, "name of another context");
+    NS_TEST_ASSERT_MSG_EQ (Config::GetRootNamespaceObjectN (), 0, "root of another context");
+    NS_TEST_ASSERT_MSG_EQ (RngSeedManager::GetSeed (), seed, "seed of another context");
+    NS_TEST_ASSERT_MSG_EQ (RngSeedManager::GetNextStreamIndex (), 0, "stream index of another context");
+    // the same name can be given to another object
+    Names::Add ("shared-name", CreateObject<Object> ());
+    Simulator::Schedule (Seconds (3), &Record, &timeB);
+    Simulator::Run ();
+    NS_TEST_ASSERT_MSG_EQ (Simulator::Now (), Seconds (3), "wrong time");
+  }
+  NS_TEST_ASSERT_MSG_EQ (timeA, Seconds (0), "event of a context run by another");
+  NS_TEST_ASSERT_MSG_EQ (timeB, Seconds (3), "event not run");
+
+  // the process-wide state is untouched
+  NS_TEST_ASSERT_MSG_EQ (Simulator::Now (), Seconds (0), "process-wide time changed");
+  NS_TEST_ASSERT_MSG_EQ (Names::Find<Object> ("shared-name"), 0, "process-wide name added");
+  NS_TEST_ASSERT_MSG_EQ (RngSeedManager::GetSeed (), seed, "process-wide seed changed");
+
+  {
+    SimulationContext::Scope scope (a);
+    NS_TEST_ASSERT_MSG_EQ (Names::Find<Object> ("shared-name"), object, "name lost");
+    NS_TEST_ASSERT_MSG_EQ (RngSeedManager::GetSeed (), seed + 1, "seed lost");
+    NS_TEST_ASSERT_MSG_EQ (RngSeedManager::GetRun (), 7, "run lost");
+    Simulator::Run ();
+    NS_TEST_ASSERT_MSG_EQ (Simulator::Now (), Seconds (2), "wrong time");
+    Config::UnregisterRootNamespaceObject (object);
+  }
+  NS_TEST_ASSERT_MSG_EQ (timeA, Seconds (2), "event not run");
+
+  // releasing the last reference destroys the simulation of the context
+  NS_TEST_ASSERT_MSG_EQ (destroyedA, false, "simulation destroyed early");
+  a = 0;
+  NS_TEST_ASSERT_MSG_EQ (destroyedA, true, "simulation not destroyed with the context");
+  Simulator::Destroy ();
+}
+
+
+/**
+ * \ingroup simulation-context-tests
+ * Check that SimulationSingleton has one instance per context.
+ */
+class SimulationContextSingletonTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  SimulationContextSingletonTestCase ();
+  virtual void DoRun (void);
+};
+
+SimulationContextSingletonTestCase::SimulationContextSingletonTestCase ()
+  : TestCase ("SimulationSingleton instances of the contexts")
+{}
+
+void
+SimulationContextSingletonTestCase::DoRun (void)
+{
+  uint32_t *global = SimulationSingleton<uint32_t>::Get ();
+  *global = 1;
+  Ptr<SimulationContext> context = Create<SimulationContext> ();
+  {
+    SimulationContext::Scope scope (context);
+    uint32_t *local = SimulationSingleton<uint32_t>::Get ();
+    NS_TEST_ASSERT_MSG_NE (local, global, "singleton shared by the contexts");
+    NS_TEST_ASSERT_MSG_EQ (*local, 0, "singleton not default constructed");
+    *local = 2;
+    NS_TEST_ASSERT_MSG_EQ (SimulationSingleton<uint32_t>::Get (), local, "singleton not kept");
+  }
+  NS_TEST_ASSERT_MSG_EQ (SimulationSingleton<uint32_t>::Get (), global, "wrong singleton");
+  NS_TEST_ASSERT_MSG_EQ (*global, 1, "singleton of the process modified");
+  context = 0;
+  Simulator::Destroy ();
+}
+
+
+#ifdef HAVE_PTHREAD_H
+/**
+ * \ingroup simulation-context-tests
+ * Check that the simulations of concurrent threads are independent.
+ */
+class SimulationContextThreadsTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  SimulationContextThreadsTestCase ();
+  virtual void DoRun (void);
+
+private:
+  /** Result of a simulation. */
+  struct Result
+  {
+    uint64_t run;        //!< the run number of the simulation
+    uint32_t events;     //!< the number of events run
+    double sum;          //!< sum of the random values drawn
+    Time end;            //!< the end of the simulation
+  };
+
+  /**
+   * Draw a random value and schedule the next event.
+   * \param x the random variable
+   * \param result the result of the simulation
+   */
+  static void Step (Ptr<UniformRandomVariable> x, Result *result);
+  /**
+   * Run a simulation in a new context.
+   * \param result the result of the simulation
+   */
+  static void Simulate (Result *result);
+};
+
+SimulationContextThreadsTestCase::SimulationContextThreadsTestCase ()
+  : TestCase ("Concurrent simulations on threads")
+{}
+
+void
+SimulationContextThreadsTestCase::Step (Ptr<UniformRandomVariable> x, Result *result)
+{
+  result->sum += x->GetValue ();
+  ++result->events;
+  if (result->events < 10000)
+    {
+      Simulator::Schedule (MicroSeconds (x->GetInteger (1, 100)), &Step, x, result);
+    }
+}
+
+void
+SimulationContextThreadsTestCase::Simulate (Result *result)
+{
+  SimulationContext::Scope scope (Create<SimulationContext> ());
+  RngSeedManager::SetRun (result->run);
+  result->events = 0;
+  result->sum = 0;
+  Ptr<UniformRandomVariable> x = CreateObject<UniformRandomVariable> ();
+  Simulator::ScheduleNow (&Step, x, result);
+  Simulator::Run ();
+  result->end = Simulator::Now ();
+}
+
+void
+SimulationContextThreadsTestCase::DoRun (void)
+{
+  const uint32_t n = 4;
+  Result reference[n];
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      reference[i].run = 1 + i % 2;
+      Simulate (&reference[i]);
+    }
+  NS_TEST_ASSERT_MSG_EQ (reference[0].end, reference[2].end, "same run, different results");
+  NS_TEST_ASSERT_MSG_NE (reference[0].end, reference[1].end, "different runs, same results");
+
+  Result results[n];
+  std::vector<Ptr<SystemThread> > threads;
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      results[i].run = reference[i].run;
+      threads.push_back (Create<SystemThread> (MakeBoundCallback (&Simulate, &results[i])));
+      threads.back ()->Start ();
+    }
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      threads[i]->Join ();
+      NS_TEST_ASSERT_MSG_EQ (results[i].events, reference[i].events, "wrong number of events");
+      NS_TEST_ASSERT_MSG_EQ (results[i].sum, reference[i].sum, "wrong random values");
+      NS_TEST_ASSERT_MSG_EQ (results[i].end, reference[i].end, "wrong end of simulation");
+    }
+  NS_TEST_ASSERT_MSG_EQ (Simulator::Now (), Seconds (0), "process-wide simulation ran");
+}
+#endif /* HAVE_PTHREAD_H */
+
+
+/**
+ * \ingroup simulation-context-tests
+ * SimulationContext test suite.
+ */
+class SimulationContextTestSuite : public TestSuite
+{
+public:
+  /** Constructor. */
+  SimulationContextTestSuite ();
+};
+
+SimulationContextTestSuite::SimulationContextTestSuite ()
+  : TestSuite ("simulation-context")
+{
+  AddTestCase (new SimulationContextIsolationTestCase ());
+  AddTestCase (new SimulationContextSingletonTestCase ());
+#ifdef HAVE_PTHREAD_H
+  AddTestCase (new SimulationContextThreadsTestCase ());
+#endif
+}
+
+/**
+ * \ingroup simulation-context-tests
+ * SimulationContextTestSuite instance variable.
+ */
+static SimulationContextTestSuite g_simulationContextTestSuite;
+
+
+}    // namespace tests
+
+}  // namespace ns3
@@ -24,6 +24,10 @@
 #include "ns3/map-scheduler.h"
 #include "ns3/calendar-scheduler.h"
 #include "ns3/priority-queue-scheduler.h"
+#include "ns3/ladder-queue-scheduler.h"
+
+#include <vector>
+#include <unordered_map>
 
 using namespace ns3;
 
@@ -465,6 +469,240 @@ SimulatorTemplateTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+class SimulatorEventPoolTestCase : public TestCase
+{
+public:
+  SimulatorEventPoolTestCase ();
+
+private:
+  virtual void DoRun (void);
+  void Count (uint32_t n);
+  static void Small (void) {}
+  static void Large (uint64_t, uint64_t, uint64_t, uint64_t, uint64_t) {}
+
+  uint32_t m_count;
+};
+
+SimulatorEventPoolTestCase::SimulatorEventPoolTestCase ()
+  : TestCase ("Check the reuse of the events by the event pool")
+{}
+
+void
+SimulatorEventPoolTestCase::Count (uint32_t n)
+{
+  ++m_count;
+  if (n > 1)
+    {
+      Simulator::Schedule (MicroSeconds (1), &SimulatorEventPoolTestCase::Count, this, n - 1);
+      Simulator::Schedule (MicroSeconds (1), &SimulatorEventPoolTestCase::Count, this, 0);
+    }
+}
+
+void
+SimulatorEventPoolTestCase::DoRun (void)
+{
+  // a freed event is reused by the next event of its size class
+  Ptr<EventImpl> small = Ptr<EventImpl> (MakeEvent (&Small), false);
+  EventImpl *freed = PeekPointer (small);
+  small = 0;
+  Ptr<EventImpl> large = Ptr<EventImpl> (MakeEvent (&Large, 0, 0, 0, 0, 0), false);
+  NS_TEST_EXPECT_MSG_NE (PeekPointer (large), freed, "Event reused by another size class");
+  small = Ptr<EventImpl> (MakeEvent (&Small), false);
+  NS_TEST_EXPECT_MSG_EQ (PeekPointer (small), freed, "Event not reused");
+  large = 0;
+  small = 0;
+
+  m_count = 0;
+  Simulator::Schedule (Seconds (0), &SimulatorEventPoolTestCase::Count, this, 1000);
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (m_count, 1999, "Wrong number of events run with the pool");
+
+  // events allocated from the pool can be released with malloc, and back
+  small = Ptr<EventImpl> (MakeEvent (&Small), false);
+  EventImpl::DisablePool ();
+  m_count = 0;
+  Simulator::Schedule (Seconds (0), &SimulatorEventPoolTestCase::Count, this, 1000);
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (m_count, 1999, "Wrong number of events run without the pool");
+  small = 0;
+  EventImpl::EnablePool ();
+  Simulator::Destroy ();
+}
+
+class SchedulerConsistencyTestCase : public TestCase
+{
+public:
+  SchedulerConsistencyTestCase (ObjectFactory schedulerFactory);
+
+private:
+  virtual void DoRun (void);
+  uint32_t Random (uint32_t n);
+  static void Nothing (void) {}
+  void Add (Scheduler::Event ev);
+  void Forget (Scheduler::Event ev);
+
+  ObjectFactory m_schedulerFactory;
+  uint64_t m_random;
+  std::vector<Scheduler::Event> m_pending;
+  std::unordered_map<uint32_t, std::size_t> m_index;
+};
+
+SchedulerConsistencyTestCase::SchedulerConsistencyTestCase (ObjectFactory schedulerFactory)
+  : TestCase ("Check the order of skewed events against ns3::MapScheduler with " + schedulerFactory.GetTypeId ().GetName ()),
+    m_schedulerFactory (schedulerFactory),
+    m_random (1)
+{}
+
+uint32_t
+SchedulerConsistencyTestCase::Random (uint32_t n)
+{
+  // a fixed sequence, independent of the simulator random streams
+  m_random = m_random * 6364136223846793005ULL + 1442695040888963407ULL;
+  return (m_random >> 33) % n;
+}
+
+void
+SchedulerConsistencyTestCase::Add (Scheduler::Event ev)
+{
+  m_index[ev.key.m_uid] = m_pending.size ();
+  m_pending.push_back (ev);
+}
+
+void
+SchedulerConsistencyTestCase::Forget (Scheduler::Event ev)
+{
+  std::size_t i = m_index[ev.key.m_uid];
+  m_index.erase (ev.key.m_uid);
+  if (i != m_pending.size () - 1)
+    {
+      m_pending[i] = m_pending.back ();
+      m_index[m_pending[i].key.m_uid] = i;
+    }
+  m_pending.pop_back ();
+  ev.impl->Unref ();
+}
+
+void
+SchedulerConsistencyTestCase::DoRun (void)
+{
+  Ptr<Scheduler> scheduler = m_schedulerFactory.Create<Scheduler> ();
+  Ptr<Scheduler> reference = CreateObject<MapScheduler> ();
+  uint64_t now = 0;
+  uint32_t uid = 4;
+  for (uint32_t i = 0; i < 100000; ++i)
+    {
+      uint32_t action = Random (10);
+      if (action < 5 || m_pending.empty ())
+        {
+          // mostly at the next TTI, some soon, a few far timers
+          uint64_t delay;
+          uint32_t kind = Random (20);
+          if (kind < 12)
+            {
+              delay = 1000000;
+            }
+          else if (kind < 19)
+            {
+              delay = Random (100000);
+            }
+          else
+            {
+              delay = 1000000000ULL + Random (1000000) * 1000ULL;
+            }
+          Scheduler::Event ev;
+          ev.impl = MakeEvent (&SchedulerConsistencyTestCase::Nothing);
+          ev.key.m_ts = now + delay;
+          ev.key.m_uid = uid++;
+          ev.key.m_context = 0;
+          scheduler->Insert (ev);
+          reference->Insert (ev);
+          Add (ev);
+        }
+      else if (action < 7)
+        {
+          Scheduler::Event ev = m_pending[Random (m_pending.size ())];
+          scheduler->Remove (ev);
+          reference->Remove (ev);
+          Forget (ev);
+        }
+      else
+        {
+          Scheduler::Event next = reference->RemoveNext ();
+          NS_TEST_ASSERT_MSG_EQ (scheduler->PeekNext ().key.m_uid, next.key.m_uid, "Wrong next event");
+          Scheduler::Event removed = scheduler->RemoveNext ();
+          NS_TEST_ASSERT_MSG_EQ (removed.key.m_uid, next.key.m_uid, "Wrong event removed");
+          now = next.key.m_ts;
+          Forget (next);
+        }
+      NS_TEST_ASSERT_MSG_EQ (scheduler->IsEmpty (), reference->IsEmpty (), "Wrong emptiness");
+    }
+  while (!reference->IsEmpty ())
+    {
+      Scheduler::Event next = reference->RemoveNext ();
+      Scheduler::Event removed = scheduler->RemoveNext ();
+      NS_TEST_ASSERT_MSG_EQ (removed.key.m_uid, next.key.m_uid, "Wrong event removed");
+      Forget (next);
+    }
+  NS_TEST_ASSERT_MSG_EQ (scheduler->IsEmpty (), true, "Events left");
+}
+
+class SimulatorCancelTestCase : public TestCase
+{
+public:
+  SimulatorCancelTestCase (ObjectFactory schedulerFactory);
+
+private:
+  virtual void DoRun (void);
+  void Count (void);
+
+  ObjectFactory m_schedulerFactory;
+  uint32_t m_count;
+};
+
+SimulatorCancelTestCase::SimulatorCancelTestCase (ObjectFactory schedulerFactory)
+  : TestCase ("Check the count of the live and cancelled events with " + schedulerFactory.GetTypeId ().GetName ()),
+    m_schedulerFactory (schedulerFactory),
+    m_count (0)
+{}
+
+void
+SimulatorCancelTestCase::Count (void)
+{
+  ++m_count;
+}
+
+void
+SimulatorCancelTestCase::DoRun (void)
+{
+  Simulator::SetScheduler (m_schedulerFactory);
+  bool fast = m_schedulerFactory.Create<Scheduler> ()->IsRemoveFast ();
+  std::vector<EventId> ids;
+  for (uint32_t i = 0; i < 100; ++i)
+    {
+      ids.push_back (Simulator::Schedule (MicroSeconds (i % 7), &SimulatorCancelTestCase::Count, this));
+    }
+  // a timer restarted on every packet
+  EventId timer;
+  for (uint32_t i = 0; i < 1000; ++i)
+    {
+      timer.Cancel ();
+      timer = Simulator::Schedule (MilliSeconds (200), &SimulatorCancelTestCase::Count, this);
+    }
+  for (uint32_t i = 0; i < 100; i += 2)
+    {
+      ids[i].Cancel ();
+      NS_TEST_ASSERT_MSG_EQ (ids[i].IsExpired (), true, "Cancelled event not expired");
+    }
+  NS_TEST_ASSERT_MSG_EQ (Simulator::GetLiveEventCount (), 51, "Wrong number of live events");
+  NS_TEST_ASSERT_MSG_EQ (Simulator::GetCancelledEventCount (), fast ? 0 : 1049,
+                         "Wrong number of cancelled events");
+  Simulator::Run ();
+  NS_TEST_ASSERT_MSG_EQ (m_count, 51, "Wrong number of events run");
+  NS_TEST_ASSERT_MSG_EQ (Simulator::GetLiveEventCount (), 0, "Live events left");
+  NS_TEST_ASSERT_MSG_EQ (Simulator::GetCancelledEventCount (), 0, "Cancelled events left");
+  Simulator::Destroy ();
+}
+
 class SimulatorTestSuite : public TestSuite
 {
 public:
@@ -475,13 +713,21 @@ public:
     factory.SetTypeId (ListScheduler::GetTypeId ());
 
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    AddTestCase (new SimulatorCancelTestCase (factory), TestCase::QUICK);
     factory.SetTypeId (MapScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
     factory.SetTypeId (HeapScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    AddTestCase (new SchedulerConsistencyTestCase (factory), TestCase::QUICK);
+    AddTestCase (new SimulatorCancelTestCase (factory), TestCase::QUICK);
     factory.SetTypeId (CalendarScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
     factory.SetTypeId (PriorityQueueScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (LadderQueueScheduler::GetTypeId ());
+    AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    AddTestCase (new SchedulerConsistencyTestCase (factory), TestCase::QUICK);
+    AddTestCase (new SimulatorCancelTestCase (factory), TestCase::QUICK);
+    AddTestCase (new SimulatorEventPoolTestCase (), TestCase::QUICK);
   }
 } g_simulatorTestSuite;
@@ -0,0 +1,218 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Amiraslan Haghrah
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/core-config.h"
+#include "ns3/test.h"
+#include "ns3/size-class-allocator.h"
+#ifdef HAVE_PTHREAD_H
+#include "ns3/system-thread.h"
+#endif
+
+#include <cstring>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup ptr
+ * SizeClassAllocator test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup size-class-allocator-tests SizeClassAllocator test suite
+ */
+
+namespace ns3 {
+
+namespace tests {
+
+
+/**
+ * \ingroup size-class-allocator-tests
+ * Check the size classes, and the reuse of the blocks by one thread
+ * through its magazines and the depot.
+ */
+class SizeClassAllocatorReuseTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  SizeClassAllocatorReuseTestCase ();
+  virtual void DoRun (void);
+};
+
+SizeClassAllocatorReuseTestCase::SizeClassAllocatorReuseTestCase ()
+  : TestCase ("Size classes and reuse")
+{}
+
+void
+SizeClassAllocatorReuseTestCase::DoRun (void)
+{
+  typedef SizeClassAllocator<SizeClassAllocatorReuseTestCase> Allocator;
+
+  NS_TEST_ASSERT_MSG_EQ (Allocator::GetCapacity (1), 64, "wrong smallest class");
+  NS_TEST_ASSERT_MSG_EQ (Allocator::GetCapacity (64), 64, "wrong class");
+  NS_TEST_ASSERT_MSG_EQ (Allocator::GetCapacity (65), 128, "wrong class");
+  NS_TEST_ASSERT_MSG_EQ (Allocator::GetCapacity (1500), 2048, "wrong class");
+  NS_TEST_ASSERT_MSG_EQ (Allocator::GetCapacity (Allocator::MAX_CLASS_SIZE),
+                         Allocator::MAX_CLASS_SIZE, "wrong largest class");
+  NS_TEST_ASSERT_MSG_EQ (Allocator::GetCapacity (Allocator::MAX_CLASS_SIZE + 1),
+                         Allocator::MAX_CLASS_SIZE + 1, "large blocks have their own size");
+
+  // More blocks than the two magazines hold: some go to the depot.
+  const uint32_t n = 4 * Allocator::MAGAZINE_SIZE;
+  std::vector<void *> blocks;
+  std::size_t capacity;
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      blocks.push_back (Allocator::Allocate (1000, &capacity));
+      NS_TEST_ASSERT_MSG_EQ (capacity, 1024, "wrong capacity");
+      std::memset (blocks.back (), 0xff, capacity);
+    }
+  Allocator::Statistics statistics = Allocator::GetStatistics ();
+  NS_TEST_ASSERT_MSG_EQ (statistics.nAllocations, n, "wrong number of allocations");
+  NS_TEST_ASSERT_MSG_EQ (statistics.nSystemAllocations, n, "blocks reused before any release");
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      Allocator::Deallocate (blocks[i], capacity);
+    }
+  statistics = Allocator::GetStatistics ();
+  NS_TEST_ASSERT_MSG_EQ (statistics.nDepotPuts, 2, "wrong number of magazines given to the depot");
+  NS_TEST_ASSERT_MSG_EQ (Allocator::GetNDepotMagazines (), 2, "wrong number of magazines in the depot");
+
+  // A smaller size of the same class reuses the blocks, then the depot ones.
+  std::vector<void *> reused;
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      reused.push_back (Allocator::Allocate (600, &capacity));
+      NS_TEST_ASSERT_MSG_EQ (capacity, 1024, "wrong capacity");
+    }
+  statistics = Allocator::GetStatistics ();
+  NS_TEST_ASSERT_MSG_EQ (statistics.nCacheHits, n, "blocks not reused");
+  NS_TEST_ASSERT_MSG_EQ (statistics.nDepotGets, 2, "wrong number of magazines taken from the depot");
+  NS_TEST_ASSERT_MSG_EQ (Allocator::GetNDepotMagazines (), 0, "magazines left in the depot");
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      Allocator::Deallocate (reused[i], capacity);
+    }
+
+  // Disabled, the blocks are allocated by the system.
+  Allocator::Disable ();
+  void *p = Allocator::Allocate (1000, &capacity);
+  NS_TEST_ASSERT_MSG_EQ (capacity, 1000, "disabled allocator rounded the size");
+  Allocator::Deallocate (p, capacity);
+  NS_TEST_ASSERT_MSG_EQ (Allocator::GetStatistics ().nAllocations, 2 * n, "disabled allocation counted");
+  Allocator::Enable ();
+}
+
+
+#ifdef HAVE_PTHREAD_H
+/**
+ * \ingroup size-class-allocator-tests
+ * Check that the blocks released by a thread are reused by another
+ * one, once the first thread exits.
+ */
+class SizeClassAllocatorThreadsTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  SizeClassAllocatorThreadsTestCase ();
+  virtual void DoRun (void);
+
+private:
+  /** The allocator of this test. */
+  typedef SizeClassAllocator<SizeClassAllocatorThreadsTestCase> Allocator;
+  /** Allocate and release blocks. */
+  static void Churn (void);
+};
+
+SizeClassAllocatorThreadsTestCase::SizeClassAllocatorThreadsTestCase ()
+  : TestCase ("Reuse across threads")
+{}
+
+void
+SizeClassAllocatorThreadsTestCase::Churn (void)
+{
+  std::vector<void *> blocks;
+  std::size_t capacity;
+  for (uint32_t i = 0; i < Allocator::MAGAZINE_SIZE; ++i)
+    {
+      blocks.push_back (Allocator::Allocate (200, &capacity));
+    }
+  for (uint32_t i = 0; i < blocks.size (); ++i)
+    {
+      Allocator::Deallocate (blocks[i], capacity);
+    }
+}
+
+void
+SizeClassAllocatorThreadsTestCase::DoRun (void)
+{
+  Ptr<SystemThread> thread = Create<SystemThread> (MakeCallback (&Churn));
+  thread->Start ();
+  thread->Join ();
+  NS_TEST_ASSERT_MSG_EQ (Allocator::GetNDepotMagazines (), 1, "the thread magazines did not go to the depot");
+
+  std::vector<void *> blocks;
+  std::size_t capacity;
+  for (uint32_t i = 0; i < Allocator::MAGAZINE_SIZE; ++i)
+    {
+      blocks.push_back (Allocator::Allocate (200, &capacity));
+    }
+  Allocator::Statistics statistics = Allocator::GetStatistics ();
+  NS_TEST_ASSERT_MSG_EQ (statistics.nDepotGets, 1, "the depot was not used");
+  NS_TEST_ASSERT_MSG_EQ (statistics.nCacheHits, Allocator::MAGAZINE_SIZE, "blocks not reused");
+  for (uint32_t i = 0; i < blocks.size (); ++i)
+    {
+      Allocator::Deallocate (blocks[i], capacity);
+    }
+}
+#endif /* HAVE_PTHREAD_H */
+
+
+/**
+ * \ingroup size-class-allocator-tests
+ * SizeClassAllocator test suite.
+ */
+class SizeClassAllocatorTestSuite : public TestSuite
+{
+public:
+  /** Constructor. */
+  SizeClassAllocatorTestSuite ();
+};
+
+SizeClassAllocatorTestSuite::SizeClassAllocatorTestSuite ()
+  : TestSuite ("size-class-allocator")
+{
+  AddTestCase (new SizeClassAllocatorReuseTestCase ());
+#ifdef HAVE_PTHREAD_H
+  AddTestCase (new SizeClassAllocatorThreadsTestCase ());
+#endif
+}
+
+/**
+ * \ingroup size-class-allocator-tests
+ * SizeClassAllocatorTestSuite instance variable.
+ */
+static SizeClassAllocatorTestSuite g_sizeClassAllocatorTestSuite;
+
+
+}    // namespace tests
+
+}  // namespace ns3
@@ -67,6 +67,7 @@ BasicTracedCallbackTestCase::DoRun (void)
   // these methods do is to set corresponding member variables m_one and m_two.
   //
   TracedCallback<uint8_t, double> trace;
+  NS_TEST_ASSERT_MSG_EQ (trace.IsEmpty (), true, "New trace not empty");
 
   //
   // Connect both callbacks to their respective test methods.  If we hit the
@@ -100,6 +101,7 @@ BasicTracedCallbackTestCase::DoRun (void)
   trace (1, 2);
   NS_TEST_ASSERT_MSG_EQ (m_one, false, "Callback CbOne unexpectedly called");
   NS_TEST_ASSERT_MSG_EQ (m_two, false, "Callback CbTwo unexpectedly called");
+  NS_TEST_ASSERT_MSG_EQ (trace.IsEmpty (), true, "Trace not empty after the disconnections");
 
   //
   // If we connect them back up, then both callbacks should be called.
@@ -113,6 +115,67 @@ BasicTracedCallbackTestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (m_two, true, "Callback CbTwo not called");
 }
 
+class GrowTracedCallbackTestCase : public TestCase
+{
+public:
+  GrowTracedCallbackTestCase ();
+  virtual ~GrowTracedCallbackTestCase ()
+  {}
+
+private:
+  virtual void DoRun (void);
+
+  void CbGrow (uint32_t a);
+  void CbCount (uint32_t a);
+
+  TracedCallback<uint32_t> m_trace;
+  uint32_t m_count;
+};
+
+GrowTracedCallbackTestCase::GrowTracedCallbackTestCase ()
+  : TestCase ("Check a TracedCallback which connects Callbacks while it is invoked")
+{}
+
+void
+GrowTracedCallbackTestCase::CbGrow (uint32_t a)
+{
+  // Enough Callbacks to move the chain to a larger array.
+  for (uint32_t i = 0; i < a; ++i)
+    {
+      m_trace.ConnectWithoutContext (MakeCallback (&GrowTracedCallbackTestCase::CbCount, this));
+    }
+}
+
+void
+GrowTracedCallbackTestCase::CbCount (uint32_t a)
+{
+  NS_UNUSED (a);
+  m_count++;
+}
+
+void
+GrowTracedCallbackTestCase::DoRun (void)
+{
+  m_count = 0;
+  m_trace.ConnectWithoutContext (MakeCallback (&GrowTracedCallbackTestCase::CbGrow, this));
+  NS_TEST_ASSERT_MSG_EQ (m_trace.IsEmpty (), false, "Trace empty after a connection");
+
+  //
+  // The Callbacks connected by CbGrow are called by the same invocation,
+  // at the end of the chain.
+  //
+  m_trace (20);
+  NS_TEST_ASSERT_MSG_EQ (m_count, 20, "Callbacks connected during the invocation not called");
+
+  m_trace.DisconnectWithoutContext (MakeCallback (&GrowTracedCallbackTestCase::CbGrow, this));
+  m_count = 0;
+  m_trace (20);
+  NS_TEST_ASSERT_MSG_EQ (m_count, 20, "Wrong number of Callbacks called");
+
+  m_trace.DisconnectWithoutContext (MakeCallback (&GrowTracedCallbackTestCase::CbCount, this));
+  NS_TEST_ASSERT_MSG_EQ (m_trace.IsEmpty (), true, "Trace not empty after the disconnections");
+}
+
 class TracedCallbackTestSuite : public TestSuite
 {
 public:
@@ -123,6 +186,7 @@ TracedCallbackTestSuite::TracedCallbackTestSuite ()
   : TestSuite ("traced-callback", UNIT)
 {
   AddTestCase (new BasicTracedCallbackTestCase, TestCase::QUICK);
+  AddTestCase (new GrowTracedCallbackTestCase, TestCase::QUICK);
 }
 
 static TracedCallbackTestSuite tracedCallbackTestSuite;
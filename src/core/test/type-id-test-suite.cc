@@ -30,6 +30,14 @@
 #include "ns3/test.h"
 #include "ns3/log.h"
 #include "ns3/unused.h"
+#include "ns3/core-config.h"
+
+#ifdef HAVE_PTHREAD_H
+#include "ns3/system-thread.h"
+#include <atomic>
+#include <sstream>
+#include <vector>
+#endif
 
 using namespace std;
 
@@ -334,6 +342,111 @@ DeprecatedAttributeTestCase::DoRun (void)
 }
 
 
+#ifdef HAVE_PTHREAD_H
+
+//----------------------------
+//
+// Lookups from several threads, while types are registered
+
+class ConcurrentLookupTestCase : public TestCase
+{
+public:
+  ConcurrentLookupTestCase ();
+  virtual ~ConcurrentLookupTestCase ();
+
+private:
+  virtual void DoRun (void);
+  void Lookup (void);
+
+  enum
+  {
+    THREADS = 4,
+    NEW_TYPES = 3000
+  };
+
+  std::vector<std::string> m_names;
+  std::vector<uint16_t> m_uids;
+  std::atomic<bool> m_done;
+  std::atomic<uint32_t> m_errors;
+};
+
+ConcurrentLookupTestCase::ConcurrentLookupTestCase ()
+  : TestCase ("Check lookups from threads while registering types")
+{}
+
+ConcurrentLookupTestCase::~ConcurrentLookupTestCase ()
+{}
+
+void
+ConcurrentLookupTestCase::Lookup (void)
+{
+  do
+    {
+      for (std::size_t i = 0; i < m_names.size (); ++i)
+        {
+          TypeId tid;
+          if (!TypeId::LookupByNameFailSafe (m_names[i], &tid)
+              || tid.GetUid () != m_uids[i])
+            {
+              ++m_errors;
+            }
+        }
+    }
+  while (!m_done.load ());
+}
+
+void
+ConcurrentLookupTestCase::DoRun (void)
+{
+  cout << suite << endl;
+  cout << suite << GetName () << endl;
+
+  uint16_t nids = TypeId::GetRegisteredN ();
+  for (uint16_t i = 0; i < nids; ++i)
+    {
+      TypeId tid = TypeId::GetRegistered (i);
+      m_names.push_back (tid.GetName ());
+      m_uids.push_back (tid.GetUid ());
+    }
+  m_done = false;
+  m_errors = 0;
+
+  std::vector<Ptr<SystemThread> > threads;
+  for (uint32_t i = 0; i < THREADS; ++i)
+    {
+      threads.push_back (Create<SystemThread> (MakeCallback (&ConcurrentLookupTestCase::Lookup, this)));
+      threads.back ()->Start ();
+    }
+  // enough new types to grow the table of the registry
+  std::vector<uint16_t> uids;
+  for (uint32_t i = 0; i < NEW_TYPES; ++i)
+    {
+      std::ostringstream name;
+      name << "ns3::ConcurrentLookupTestCase::Type" << i;
+      uids.push_back (TypeId (name.str ().c_str ()).GetUid ());
+    }
+  m_done = true;
+  for (uint32_t i = 0; i < THREADS; ++i)
+    {
+      threads[i]->Join ();
+    }
+  NS_TEST_ASSERT_MSG_EQ (m_errors.load (), 0, "Lookup failed while registering types");
+
+  for (uint32_t i = 0; i < NEW_TYPES; ++i)
+    {
+      std::ostringstream name;
+      name << "ns3::ConcurrentLookupTestCase::Type" << i;
+      TypeId tid = TypeId::LookupByName (name.str ());
+      NS_TEST_ASSERT_MSG_EQ (tid.GetUid (), uids[i], "LookupByName returned a different TypeId for "
+                             << name.str ());
+      NS_TEST_ASSERT_MSG_EQ (TypeId::LookupByHash (tid.GetHash ()).GetUid (), uids[i],
+                             "LookupByHash returned a different TypeId for " << name.str ());
+    }
+}
+
+#endif /* HAVE_PTHREAD_H */
+
+
 //----------------------------
 //
 // Performance test
@@ -447,6 +560,9 @@ TypeIdTestSuite::TypeIdTestSuite ()
   AddTestCase (new UniqueTypeIdTestCase, QUICK);
   AddTestCase (new CollisionTestCase, QUICK);
   AddTestCase (new DeprecatedAttributeTestCase, QUICK);
+#ifdef HAVE_PTHREAD_H
+  AddTestCase (new ConcurrentLookupTestCase, QUICK);
+#endif
 }
 
 static TypeIdTestSuite g_TypeIdTestSuite;
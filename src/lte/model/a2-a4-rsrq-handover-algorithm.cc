@@ -135,6 +135,7 @@ void
 A2A4RsrqHandoverAlgorithm::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
+  m_neighbourCellMeasures.Clear ();
   delete m_handoverManagementSapProvider;
 }
 
@@ -184,27 +185,28 @@ A2A4RsrqHandoverAlgorithm::EvaluateHandover (uint16_t rnti,
 {
   NS_LOG_FUNCTION (this << rnti << (uint16_t) servingCellRsrq);
 
-  MeasurementTable_t::iterator it1;
-  it1 = m_neighbourCellMeasures.find (rnti);
+  const HandoverMeasurementHistory::NeighbourCellMap &neighbourCells =
+    m_neighbourCellMeasures.GetNeighbourCells (rnti);
 
-  if (it1 == m_neighbourCellMeasures.end ())
+  if (neighbourCells.empty ())
     {
       NS_LOG_WARN ("Skipping handover evaluation for RNTI " << rnti << " because neighbour cells information is not found");
     }
   else
     {
       // Find the best neighbour cell (eNB)
-      NS_LOG_LOGIC ("Number of neighbour cells = " << it1->second.size ());
+      NS_LOG_LOGIC ("Number of neighbour cells = " << neighbourCells.size ());
       uint16_t bestNeighbourCellId = 0;
       uint8_t bestNeighbourRsrq = 0;
-      MeasurementRow_t::iterator it2;
-      for (it2 = it1->second.begin (); it2 != it1->second.end (); ++it2)
+      HandoverMeasurementHistory::NeighbourCellMap::const_iterator it;
+      for (it = neighbourCells.begin (); it != neighbourCells.end (); ++it)
         {
-          if ((it2->second->m_rsrq > bestNeighbourRsrq)
-              && IsValidNeighbour (it2->first))
+          uint8_t rsrq = it->second.measurements.GetLast ();
+          if ((rsrq > bestNeighbourRsrq)
+              && IsValidNeighbour (it->first))
             {
-              bestNeighbourCellId = it2->first;
-              bestNeighbourRsrq = it2->second->m_rsrq;
+              bestNeighbourCellId = it->first;
+              bestNeighbourRsrq = rsrq;
             }
         }
 
@@ -225,7 +227,7 @@ A2A4RsrqHandoverAlgorithm::EvaluateHandover (uint16_t rnti,
             }
         }
 
-    } // end of else of if (it1 == m_neighbourCellMeasures.end ())
+    } // end of else of if (neighbourCells.empty ())
 
 } // end of EvaluateMeasurementReport
 
@@ -251,42 +253,17 @@ A2A4RsrqHandoverAlgorithm::UpdateNeighbourMeasurements (uint16_t rnti,
                                                         uint8_t rsrq)
 {
   NS_LOG_FUNCTION (this << rnti << cellId << (uint16_t) rsrq);
-  MeasurementTable_t::iterator it1;
-  it1 = m_neighbourCellMeasures.find (rnti);
+  m_neighbourCellMeasures.AddNeighbourCellMeasurement (rnti, cellId, rsrq);
 
-  if (it1 == m_neighbourCellMeasures.end ())
-    {
-      // insert a new UE entry
-      MeasurementRow_t row;
-      std::pair<MeasurementTable_t::iterator, bool> ret;
-      ret = m_neighbourCellMeasures.insert (std::pair<uint16_t, MeasurementRow_t> (rnti, row));
-      NS_ASSERT (ret.second);
-      it1 = ret.first;
-    }
+} // end of UpdateNeighbourMeasurements
 
-  NS_ASSERT (it1 != m_neighbourCellMeasures.end ());
-  Ptr<UeMeasure> neighbourCellMeasures;
-  std::map<uint16_t, Ptr<UeMeasure> >::iterator it2;
-  it2 = it1->second.find (cellId);
 
-  if (it2 != it1->second.end ())
-    {
-      neighbourCellMeasures = it2->second;
-      neighbourCellMeasures->m_cellId = cellId;
-      neighbourCellMeasures->m_rsrp = 0;
-      neighbourCellMeasures->m_rsrq = rsrq;
-    }
-  else
-    {
-      // insert a new cell entry
-      neighbourCellMeasures = Create<UeMeasure> ();
-      neighbourCellMeasures->m_cellId = cellId;
-      neighbourCellMeasures->m_rsrp = 0;
-      neighbourCellMeasures->m_rsrq = rsrq;
-      it1->second[cellId] = neighbourCellMeasures;
-    }
-
-} // end of UpdateNeighbourMeasurements
+void
+A2A4RsrqHandoverAlgorithm::DoRemoveUe (uint16_t rnti)
+{
+  NS_LOG_FUNCTION (this << rnti);
+  m_neighbourCellMeasures.RemoveUe (rnti);
+}
 
 
 } // end of namespace ns3
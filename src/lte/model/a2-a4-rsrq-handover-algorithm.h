@@ -31,9 +31,7 @@
 #include <ns3/lte-handover-algorithm.h>
 #include <ns3/lte-handover-management-sap.h>
 #include <ns3/lte-rrc-sap.h>
-#include <ns3/simple-ref-count.h>
-#include <ns3/ptr.h>
-#include <map>
+#include <ns3/handover-measurement-history.h>
 
 namespace ns3 {
 
@@ -105,6 +103,7 @@ protected:
 
   // inherited from LteHandoverAlgorithm as a Handover Management SAP implementation
   void DoReportUeMeas (uint16_t rnti, LteRrcSap::MeasResults measResults);
+  void DoRemoveUe (uint16_t rnti);
 
 private:
   /**
@@ -126,9 +125,7 @@ private:
 
   /**
    * Called when Event A4 is reported, then update the measurements table.
-   * If the RNTI and/or cell ID is not found in the table, a corresponding
-   * entry will be created. Only the latest measurements are stored in the
-   * table.
+   * Only the latest measurements are stored in the table.
    *
    * \param rnti The RNTI of the UE who reported the event.
    * \param cellId The cell ID of the measured cell.
@@ -142,32 +139,8 @@ private:
   /// The expected measurement identity for A4 measurements.
   uint8_t m_a4MeasId;
 
-  /**
-   * Measurements reported by a UE for a cell ID. The values are quantized
-   * according 3GPP TS 36.133 section 9.1.4 and 9.1.7.
-   */
-  class UeMeasure : public SimpleRefCount<UeMeasure>
-  {
-  public:
-    uint16_t m_cellId;  ///< Cell ID.
-    uint8_t m_rsrp;     ///< RSRP in quantized format. \todo Can be removed?
-    uint8_t m_rsrq;     ///< RSRQ in quantized format.
-  };
-
-  /**
-   * Measurements reported by a UE for several cells. The structure is a map
-   * indexed by the cell ID.
-   */
-  typedef std::map<uint16_t, Ptr<UeMeasure> > MeasurementRow_t;
-
-  /**
-   * Measurements reported by several UEs. The structure is a map indexed by
-   * the RNTI of the UE.
-   */
-  typedef std::map<uint16_t, MeasurementRow_t> MeasurementTable_t;
-
-  /// Table of measurement reports from all UEs.
-  MeasurementTable_t m_neighbourCellMeasures;
+  /// Latest neighbour cell measurements reported by each UE.
+  HandoverMeasurementHistory m_neighbourCellMeasures;
 
   /**
    * The `ServingCellThreshold` attribute. If the RSRQ of the serving cell is
@@ -0,0 +1,285 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Amiraslan Haghrah
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Amiraslan Haghrah <amiraslanhaghrah@gmail.com>
+ */
+
+#include "fuzzy-decision-surface.h"
+#include <ns3/log.h>
+#include <ns3/assert.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <unistd.h>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("FuzzyDecisionSurface");
+
+/// Magic string at the beginning of a decision surface file
+static const char * const SURFACE_FILE_MAGIC = "ns3-fuzzy-decision-surface";
+/// Version of the decision surface file format
+static const uint32_t SURFACE_FILE_VERSION = 1;
+
+
+///////////////////////////////////////////
+// FuzzyDecisionSurface
+///////////////////////////////////////////
+
+
+FuzzyDecisionSurface::FuzzyDecisionSurface ()
+  : m_xMin (0.0),
+    m_xStep (1.0),
+    m_nx (0),
+    m_yMin (0.0),
+    m_yStep (1.0),
+    m_ny (0)
+{
+}
+
+FuzzyDecisionSurface::FuzzyDecisionSurface (double xMin, double xMax, uint32_t nx,
+                                            double yMin, double yMax, uint32_t ny)
+  : m_xMin (xMin),
+    m_xStep ((xMax - xMin) / (nx - 1)),
+    m_nx (nx),
+    m_yMin (yMin),
+    m_yStep ((yMax - yMin) / (ny - 1)),
+    m_ny (ny)
+{
+  NS_ASSERT_MSG (nx >= 2 && ny >= 2, "a surface needs at least 2x2 grid points");
+  NS_ASSERT (xMax > xMin && yMax > yMin);
+}
+
+void
+FuzzyDecisionSurface::Build (Callback<double, double, double> f)
+{
+  NS_LOG_FUNCTION (this);
+  m_values.resize (m_nx * m_ny);
+  for (uint32_t i = 0; i < m_nx; ++i)
+    {
+      double x = m_xMin + i * m_xStep;
+      for (uint32_t j = 0; j < m_ny; ++j)
+        {
+          m_values[i * m_ny + j] = f (x, m_yMin + j * m_yStep);
+        }
+    }
+}
+
+double
+FuzzyDecisionSurface::Lookup (double x, double y) const
+{
+  NS_ASSERT_MSG (!m_values.empty (), "surface not built");
+
+  // fractional grid coordinates, clamped to the grid
+  double u = std::min (std::max ((x - m_xMin) / m_xStep, 0.0), m_nx - 1.0);
+  double v = std::min (std::max ((y - m_yMin) / m_yStep, 0.0), m_ny - 1.0);
+  uint32_t i = std::min<uint32_t> (u, m_nx - 2);
+  uint32_t j = std::min<uint32_t> (v, m_ny - 2);
+  u -= i;
+  v -= j;
+
+  const float *p = &m_values[i * m_ny + j];
+  double lo = p[0] + v * (p[1] - p[0]);
+  double hi = p[m_ny] + v * (p[m_ny + 1] - p[m_ny]);
+  return lo + u * (hi - lo);
+}
+
+void
+FuzzyDecisionSurface::Save (std::ostream &os) const
+{
+  NS_LOG_FUNCTION (this);
+  os << std::setprecision (17)
+     << m_xMin << " " << m_xStep << " " << m_nx << " "
+     << m_yMin << " " << m_yStep << " " << m_ny << "\n"
+     << std::setprecision (9);
+  for (uint32_t i = 0; i < m_nx; ++i)
+    {
+      for (uint32_t j = 0; j < m_ny; ++j)
+        {
+          os << m_values[i * m_ny + j] << ((j + 1 < m_ny) ? " " : "\n");
+        }
+    }
+}
+
+bool
+FuzzyDecisionSurface::Load (std::istream &is)
+{
+  NS_LOG_FUNCTION (this);
+  double xMin, xStep, yMin, yStep;
+  uint32_t nx, ny;
+  if (!(is >> xMin >> xStep >> nx >> yMin >> yStep >> ny))
+    {
+      return false;
+    }
+  // the grid is read back with 17 significant digits
+  if (nx != m_nx || ny != m_ny
+      || std::fabs (xMin - m_xMin) > 1e-9 || std::fabs (xStep - m_xStep) > 1e-9
+      || std::fabs (yMin - m_yMin) > 1e-9 || std::fabs (yStep - m_yStep) > 1e-9)
+    {
+      NS_LOG_WARN ("grid definition does not match");
+      return false;
+    }
+  std::vector<float> values (m_nx * m_ny);
+  for (std::vector<float>::iterator it = values.begin (); it != values.end (); ++it)
+    {
+      if (!(is >> *it))
+        {
+          return false;
+        }
+    }
+  m_values.swap (values);
+  return true;
+}
+
+
+///////////////////////////////////////////
+// TabulatedFuzzyHandoverController
+///////////////////////////////////////////
+
+
+TabulatedFuzzyHandoverController::TabulatedFuzzyHandoverController (Ptr<const FuzzyHandoverController> controller)
+  : m_controller (controller),
+    m_servingCellRlq (0.0, 34.0, 137, -8.0, 8.0, 129),
+    m_neighbourCellRlq (0.0, 34.0, 137, -8.0, 8.0, 129),
+    m_handoverTrigger (0.0, 1.0, 101, 0.0, 1.0, 101)
+{
+  NS_LOG_FUNCTION (this << controller->GetName ());
+}
+
+void
+TabulatedFuzzyHandoverController::Build ()
+{
+  NS_LOG_FUNCTION (this);
+  const FuzzyHandoverController *c = PeekPointer (m_controller);
+  m_servingCellRlq.Build (MakeCallback (&FuzzyHandoverController::EvaluateServingCellRlq, c));
+  m_neighbourCellRlq.Build (MakeCallback (&FuzzyHandoverController::EvaluateNeighbourCellRlq, c));
+  m_handoverTrigger.Build (MakeCallback (&FuzzyHandoverController::EvaluateHandoverTrigger, c));
+}
+
+bool
+TabulatedFuzzyHandoverController::Save (std::string filename) const
+{
+  NS_LOG_FUNCTION (this << filename);
+
+  // concurrent runs may share the file: write a private copy, then rename it
+  // over the target, which readers see either complete or not at all
+  std::ostringstream tmp;
+  tmp << filename << ".tmp." << getpid ();
+  std::ofstream os (tmp.str ().c_str ());
+  if (!os.is_open ())
+    {
+      NS_LOG_WARN ("cannot open " << tmp.str ());
+      return false;
+    }
+  os << SURFACE_FILE_MAGIC << " " << SURFACE_FILE_VERSION << " "
+     << m_controller->GetName () << "\n";
+  m_servingCellRlq.Save (os);
+  m_neighbourCellRlq.Save (os);
+  m_handoverTrigger.Save (os);
+  os.close ();
+  if (os.fail () || std::rename (tmp.str ().c_str (), filename.c_str ()) != 0)
+    {
+      NS_LOG_WARN ("cannot write " << filename);
+      std::remove (tmp.str ().c_str ());
+      return false;
+    }
+  return true;
+}
+
+bool
+TabulatedFuzzyHandoverController::Load (std::string filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  std::ifstream is (filename.c_str ());
+  if (!is.is_open ())
+    {
+      return false;
+    }
+  std::string magic;
+  uint32_t version;
+  std::string name;
+  if (!(is >> magic >> version >> name)
+      || magic != SURFACE_FILE_MAGIC || version != SURFACE_FILE_VERSION)
+    {
+      NS_LOG_WARN (filename << " is not a decision surface file");
+      return false;
+    }
+  if (name != m_controller->GetName ())
+    {
+      NS_LOG_WARN (filename << " tabulates controller " << name
+                            << ", not " << m_controller->GetName ());
+      return false;
+    }
+  return m_servingCellRlq.Load (is)
+         && m_neighbourCellRlq.Load (is)
+         && m_handoverTrigger.Load (is);
+}
+
+Ptr<TabulatedFuzzyHandoverController>
+TabulatedFuzzyHandoverController::Tabulate (Ptr<const FuzzyHandoverController> controller,
+                                            std::string filename)
+{
+  NS_LOG_FUNCTION (controller->GetName () << filename);
+  Ptr<TabulatedFuzzyHandoverController> tabulated = Create<TabulatedFuzzyHandoverController> (controller);
+  if (!filename.empty () && tabulated->Load (filename))
+    {
+      NS_LOG_INFO ("loaded " << controller->GetName () << " decision surfaces from " << filename);
+      return tabulated;
+    }
+  tabulated->Build ();
+  if (!filename.empty ())
+    {
+      tabulated->Save (filename);
+    }
+  return tabulated;
+}
+
+std::string
+TabulatedFuzzyHandoverController::GetName () const
+{
+  return m_controller->GetName ();
+}
+
+double
+TabulatedFuzzyHandoverController::EvaluateServingCellRlq (double rsrq, double deltaRsrq) const
+{
+  return m_servingCellRlq.Lookup (rsrq, deltaRsrq);
+}
+
+double
+TabulatedFuzzyHandoverController::EvaluateNeighbourCellRlq (double rsrq, double deltaRsrq) const
+{
+  return m_neighbourCellRlq.Lookup (rsrq, deltaRsrq);
+}
+
+double
+TabulatedFuzzyHandoverController::EvaluateHandoverTrigger (double servingCellRlq, double neighbourCellRlq) const
+{
+  return m_handoverTrigger.Lookup (servingCellRlq, neighbourCellRlq);
+}
+
+bool
+TabulatedFuzzyHandoverController::IsHandoverTriggered (double handoverTrigger) const
+{
+  return m_controller->IsHandoverTriggered (handoverTrigger);
+}
+
+} // namespace ns3
@@ -0,0 +1,421 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Amiraslan Haghrah
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Amiraslan Haghrah <amiraslanhaghrah@gmail.com>
+ */
+
+#include "fuzzy-handover-controller.h"
+#include <ns3/log.h>
+#include <ns3/assert.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("FuzzyHandoverController");
+
+
+///////////////////////////////////////////
+// FuzzyHandoverController
+///////////////////////////////////////////
+
+
+const uint32_t FuzzyHandoverController::PREDICTION_WINDOW;
+
+FuzzyHandoverController::~FuzzyHandoverController ()
+{
+}
+
+uint16_t
+FuzzyHandoverController::EvaluateHandover (const MeasurementRingBuffer &servingCellRsrq,
+                                           const HandoverMeasurementHistory::NeighbourCellMap &neighbourCellRsrq) const
+{
+  NS_ASSERT (!servingCellRsrq.IsEmpty ());
+
+  double rsrqPred = PredictServingCellRsrq (servingCellRsrq);
+  double servingCellRlq = EvaluateServingCellRlq (rsrqPred, rsrqPred - servingCellRsrq.GetLast ());
+  NS_LOG_LOGIC ("serving cell RSRQ " << servingCellRsrq.GetLast ()
+                << " predicted " << rsrqPred << " RLQ " << servingCellRlq);
+
+  uint16_t bestNeighbourCellId = 0;
+  double bestNeighbourCellRlq = 0.0;
+  for (HandoverMeasurementHistory::NeighbourCellMap::const_iterator it = neighbourCellRsrq.begin ();
+       it != neighbourCellRsrq.end (); ++it)
+    {
+      const MeasurementRingBuffer &series = it->second.measurements;
+      if (series.IsEmpty ())
+        {
+          continue;
+        }
+      rsrqPred = PredictNeighbourCellRsrq (series);
+      double neighbourCellRlq = EvaluateNeighbourCellRlq (rsrqPred, rsrqPred - series.GetLast ());
+      NS_LOG_LOGIC ("neighbour cellId " << it->first << " RSRQ " << series.GetLast ()
+                    << " predicted " << rsrqPred << " RLQ " << neighbourCellRlq);
+      if (bestNeighbourCellRlq <= neighbourCellRlq)
+        {
+          bestNeighbourCellId = it->first;
+          bestNeighbourCellRlq = neighbourCellRlq;
+        }
+    }
+
+  if (bestNeighbourCellId > 0)
+    {
+      double handoverTrigger = EvaluateHandoverTrigger (servingCellRlq, bestNeighbourCellRlq);
+      NS_LOG_LOGIC ("handover trigger " << handoverTrigger);
+      if (IsHandoverTriggered (handoverTrigger))
+        {
+          return bestNeighbourCellId;
+        }
+    }
+  return 0;
+}
+
+double
+FuzzyHandoverController::PredictServingCellRsrq (const MeasurementRingBuffer &series)
+{
+  NS_ASSERT (!series.IsEmpty ());
+  if (series.GetSize () < 2)
+    {
+      return series.Get (0) + 1.0;
+    }
+  return Extrapolate (series);
+}
+
+double
+FuzzyHandoverController::PredictNeighbourCellRsrq (const MeasurementRingBuffer &series)
+{
+  NS_ASSERT (!series.IsEmpty ());
+  if (series.GetSize () < 2)
+    {
+      return series.Get (0);
+    }
+  return Extrapolate (series);
+}
+
+double
+FuzzyHandoverController::Extrapolate (const MeasurementRingBuffer &series)
+{
+  NS_ASSERT (series.GetSize () >= 2);
+  const uint32_t n = std::min<uint32_t> (series.GetSize (), PREDICTION_WINDOW);
+  const uint32_t order = (n < 4) ? 2 : 3; // number of coefficients
+  const uint32_t first = series.GetSize () - n;
+
+  // normal equations of the least squares fit over t = 0 .. n-1
+  double a[3][4] = {{0}};
+  for (uint32_t k = 0; k < n; ++k)
+    {
+      double t = k;
+      double y = series.Get (first + k);
+      double powers[5] = {1.0, t, t * t, t * t * t, t * t * t * t};
+      for (uint32_t i = 0; i < order; ++i)
+        {
+          for (uint32_t j = 0; j < order; ++j)
+            {
+              a[i][j] += powers[i + j];
+            }
+          a[i][order] += powers[i] * y;
+        }
+    }
+
+  // Gaussian elimination with partial pivoting
+  for (uint32_t c = 0; c < order; ++c)
+    {
+      uint32_t pivot = c;
+      for (uint32_t r = c + 1; r < order; ++r)
+        {
+          if (std::fabs (a[r][c]) > std::fabs (a[pivot][c]))
+            {
+              pivot = r;
+            }
+        }
+      for (uint32_t j = 0; j <= order; ++j)
+        {
+          std::swap (a[c][j], a[pivot][j]);
+        }
+      for (uint32_t r = c + 1; r < order; ++r)
+        {
+          double f = a[r][c] / a[c][c];
+          for (uint32_t j = c; j <= order; ++j)
+            {
+              a[r][j] -= f * a[c][j];
+            }
+        }
+    }
+  double coeff[3] = {0};
+  for (int32_t i = order - 1; i >= 0; --i)
+    {
+      double s = a[i][order];
+      for (uint32_t j = i + 1; j < order; ++j)
+        {
+          s -= a[i][j] * coeff[j];
+        }
+      coeff[i] = s / a[i][i];
+    }
+
+  double t = n;
+  double prediction = 0.0;
+  for (int32_t i = order - 1; i >= 0; --i)
+    {
+      prediction = prediction * t + coeff[i];
+    }
+  return prediction;
+}
+
+std::vector<double>
+FuzzyHandoverController::Linspace (double lo, double hi, uint32_t n)
+{
+  std::vector<double> v;
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      v.push_back (lo + (hi - lo) * i / (n - 1));
+    }
+  return v;
+}
+
+
+///////////////////////////////////////////
+// Type1FuzzyHandoverController
+///////////////////////////////////////////
+
+
+Type1FuzzyHandoverController::Type1FuzzyHandoverController ()
+{
+  NS_LOG_FUNCTION (this);
+  typedef GaussianMembershipFunction Mf;
+  std::vector<double> rsrqDomain = Linspace (0.0, 34.0, 35);
+  std::vector<double> deltaRsrqDomain = Linspace (-4.0, 4.0, 9);
+  std::vector<double> rlqDomain = Linspace (0.0, 1.0, 101);
+  std::vector<double> htDomain = Linspace (0.0, 1.0, 101);
+
+  // serving cell radio link quality estimator
+  uint32_t rsrq = m_servingCellRlq.AddInput (rsrqDomain);
+  uint32_t sPoor = m_servingCellRlq.AddInputTerm (rsrq, Mf (Mf::LEFT_FLAT, 20.0, 1.5));
+  uint32_t sFair = m_servingCellRlq.AddInputTerm (rsrq, Mf (Mf::SYMMETRIC, 23.0, 1.5));
+  uint32_t sGood = m_servingCellRlq.AddInputTerm (rsrq, Mf (Mf::SYMMETRIC, 27.0, 1.5));
+  uint32_t sExcellent = m_servingCellRlq.AddInputTerm (rsrq, Mf (Mf::RIGHT_FLAT, 31.0, 1.5));
+  uint32_t deltaRsrq = m_servingCellRlq.AddInput (deltaRsrqDomain);
+  uint32_t sDec = m_servingCellRlq.AddInputTerm (deltaRsrq, Mf (Mf::LEFT_FLAT, -4.0, 2.0));
+  uint32_t sInc = m_servingCellRlq.AddInputTerm (deltaRsrq, Mf (Mf::RIGHT_FLAT, 4.0, 1.5));
+  m_servingCellRlq.SetOutput (rlqDomain);
+  uint32_t low = m_servingCellRlq.AddOutputTerm (Mf (Mf::LEFT_FLAT, 0.0, 0.2));
+  uint32_t average = m_servingCellRlq.AddOutputTerm (Mf (Mf::SYMMETRIC, 0.5, 0.1));
+  uint32_t high = m_servingCellRlq.AddOutputTerm (Mf (Mf::RIGHT_FLAT, 1.0, 0.2));
+  m_servingCellRlq.AddRule ({sPoor, sDec}, low);
+  m_servingCellRlq.AddRule ({sPoor, sInc}, low);
+  m_servingCellRlq.AddRule ({sFair, sDec}, low);
+  m_servingCellRlq.AddRule ({sFair, sInc}, average);
+  m_servingCellRlq.AddRule ({sGood, sDec}, average);
+  m_servingCellRlq.AddRule ({sGood, sInc}, high);
+  m_servingCellRlq.AddRule ({sExcellent, sDec}, high);
+  m_servingCellRlq.AddRule ({sExcellent, sInc}, high);
+
+  // neighbour cell radio link quality estimator
+  rsrq = m_neighbourCellRlq.AddInput (rsrqDomain);
+  uint32_t nPoor = m_neighbourCellRlq.AddInputTerm (rsrq, Mf (Mf::LEFT_FLAT, 17.0, 1.0));
+  uint32_t nFair = m_neighbourCellRlq.AddInputTerm (rsrq, Mf (Mf::SYMMETRIC, 20.0, 1.0));
+  uint32_t nGood = m_neighbourCellRlq.AddInputTerm (rsrq, Mf (Mf::SYMMETRIC, 23.0, 1.0));
+  uint32_t nExcellent = m_neighbourCellRlq.AddInputTerm (rsrq, Mf (Mf::RIGHT_FLAT, 26.0, 1.0));
+  deltaRsrq = m_neighbourCellRlq.AddInput (deltaRsrqDomain);
+  uint32_t nDec = m_neighbourCellRlq.AddInputTerm (deltaRsrq, Mf (Mf::LEFT_FLAT, -4.0, 2.0));
+  uint32_t nInc = m_neighbourCellRlq.AddInputTerm (deltaRsrq, Mf (Mf::RIGHT_FLAT, 4.0, 2.0));
+  m_neighbourCellRlq.SetOutput (rlqDomain);
+  low = m_neighbourCellRlq.AddOutputTerm (Mf (Mf::LEFT_FLAT, 0.0, 0.2));
+  average = m_neighbourCellRlq.AddOutputTerm (Mf (Mf::SYMMETRIC, 0.5, 0.1));
+  high = m_neighbourCellRlq.AddOutputTerm (Mf (Mf::RIGHT_FLAT, 1.0, 0.2));
+  m_neighbourCellRlq.AddRule ({nPoor, nDec}, low);
+  m_neighbourCellRlq.AddRule ({nPoor, nInc}, low);
+  m_neighbourCellRlq.AddRule ({nFair, nDec}, low);
+  m_neighbourCellRlq.AddRule ({nFair, nInc}, average);
+  m_neighbourCellRlq.AddRule ({nGood, nDec}, average);
+  m_neighbourCellRlq.AddRule ({nGood, nInc}, high);
+  m_neighbourCellRlq.AddRule ({nExcellent, nDec}, high);
+  m_neighbourCellRlq.AddRule ({nExcellent, nInc}, high);
+
+  // handover trigger evaluator
+  uint32_t sRlq = m_handoverTrigger.AddInput (rlqDomain);
+  uint32_t sLow = m_handoverTrigger.AddInputTerm (sRlq, Mf (Mf::LEFT_FLAT, 0.0, 0.2));
+  uint32_t sAverage = m_handoverTrigger.AddInputTerm (sRlq, Mf (Mf::SYMMETRIC, 0.5, 0.1));
+  uint32_t sHigh = m_handoverTrigger.AddInputTerm (sRlq, Mf (Mf::RIGHT_FLAT, 1.0, 0.2));
+  uint32_t nRlq = m_handoverTrigger.AddInput (rlqDomain);
+  uint32_t nLow = m_handoverTrigger.AddInputTerm (nRlq, Mf (Mf::LEFT_FLAT, 0.0, 0.2));
+  uint32_t nAverage = m_handoverTrigger.AddInputTerm (nRlq, Mf (Mf::SYMMETRIC, 0.5, 0.1));
+  uint32_t nHigh = m_handoverTrigger.AddInputTerm (nRlq, Mf (Mf::RIGHT_FLAT, 1.0, 0.2));
+  m_handoverTrigger.SetOutput (htDomain);
+  uint32_t no = m_handoverTrigger.AddOutputTerm (Mf (Mf::LEFT_FLAT, 0.0, 0.2));
+  uint32_t middle = m_handoverTrigger.AddOutputTerm (Mf (Mf::SYMMETRIC, 0.5, 0.1));
+  uint32_t yes = m_handoverTrigger.AddOutputTerm (Mf (Mf::RIGHT_FLAT, 1.0, 0.2));
+  m_handoverTrigger.AddRule ({sLow, nLow}, middle);
+  m_handoverTrigger.AddRule ({sAverage, nLow}, no);
+  m_handoverTrigger.AddRule ({sHigh, nLow}, no);
+  m_handoverTrigger.AddRule ({sLow, nAverage}, yes);
+  m_handoverTrigger.AddRule ({sAverage, nAverage}, middle);
+  m_handoverTrigger.AddRule ({sHigh, nAverage}, no);
+  m_handoverTrigger.AddRule ({sLow, nHigh}, yes);
+  m_handoverTrigger.AddRule ({sAverage, nHigh}, middle);
+  m_handoverTrigger.AddRule ({sHigh, nHigh}, no);
+}
+
+std::string
+Type1FuzzyHandoverController::GetName () const
+{
+  return "Type1";
+}
+
+double
+Type1FuzzyHandoverController::EvaluateServingCellRlq (double rsrq, double deltaRsrq) const
+{
+  return m_servingCellRlq.Evaluate ({rsrq, deltaRsrq});
+}
+
+double
+Type1FuzzyHandoverController::EvaluateNeighbourCellRlq (double rsrq, double deltaRsrq) const
+{
+  return m_neighbourCellRlq.Evaluate ({rsrq, deltaRsrq});
+}
+
+double
+Type1FuzzyHandoverController::EvaluateHandoverTrigger (double servingCellRlq, double neighbourCellRlq) const
+{
+  return m_handoverTrigger.Evaluate ({servingCellRlq, neighbourCellRlq});
+}
+
+bool
+Type1FuzzyHandoverController::IsHandoverTriggered (double handoverTrigger) const
+{
+  return handoverTrigger > 0.75;
+}
+
+
+///////////////////////////////////////////
+// Type2FuzzyHandoverController
+///////////////////////////////////////////
+
+
+Type2FuzzyHandoverController::Type2FuzzyHandoverController (It2MamdaniFis::TNorm tNorm)
+  : m_tNorm (tNorm),
+    m_servingCellRlq (tNorm),
+    m_neighbourCellRlq (tNorm),
+    m_handoverTrigger (tNorm)
+{
+  NS_LOG_FUNCTION (this << tNorm);
+  typedef It2GaussianMembershipFunction Mf;
+  const GaussianMembershipFunction::Shape LEFT_FLAT = GaussianMembershipFunction::LEFT_FLAT;
+  const GaussianMembershipFunction::Shape SYMMETRIC = GaussianMembershipFunction::SYMMETRIC;
+  const GaussianMembershipFunction::Shape RIGHT_FLAT = GaussianMembershipFunction::RIGHT_FLAT;
+  std::vector<double> rlqDomain = Linspace (0.0, 1.0, 101);
+  std::vector<double> htDomain = Linspace (0.0, 1.0, 101);
+
+  // serving cell radio link quality estimator
+  uint32_t rsrq = m_servingCellRlq.AddInput ();
+  uint32_t sPoor = m_servingCellRlq.AddInputTerm (rsrq, Mf (LEFT_FLAT, 20.0, 1.5, 0.5));
+  uint32_t sFair = m_servingCellRlq.AddInputTerm (rsrq, Mf (SYMMETRIC, 23.0, 1.5, 0.5));
+  uint32_t sGood = m_servingCellRlq.AddInputTerm (rsrq, Mf (SYMMETRIC, 27.0, 1.5, 0.5));
+  uint32_t sExcellent = m_servingCellRlq.AddInputTerm (rsrq, Mf (RIGHT_FLAT, 31.0, 1.5, 0.5));
+  uint32_t deltaRsrq = m_servingCellRlq.AddInput ();
+  uint32_t sDec = m_servingCellRlq.AddInputTerm (deltaRsrq, Mf (LEFT_FLAT, -4.0, 2.0, 0.25));
+  uint32_t sInc = m_servingCellRlq.AddInputTerm (deltaRsrq, Mf (RIGHT_FLAT, 4.0, 1.5, 0.25));
+  m_servingCellRlq.SetOutput (rlqDomain);
+  uint32_t low = m_servingCellRlq.AddOutputTerm (Mf (LEFT_FLAT, 0.0, 0.2, 0.1));
+  uint32_t average = m_servingCellRlq.AddOutputTerm (Mf (SYMMETRIC, 0.5, 0.1, 0.04));
+  uint32_t high = m_servingCellRlq.AddOutputTerm (Mf (RIGHT_FLAT, 1.0, 0.2, 0.1));
+  m_servingCellRlq.AddRule ({sPoor, sDec}, low);
+  m_servingCellRlq.AddRule ({sPoor, sInc}, low);
+  m_servingCellRlq.AddRule ({sFair, sDec}, low);
+  m_servingCellRlq.AddRule ({sFair, sInc}, average);
+  m_servingCellRlq.AddRule ({sGood, sDec}, average);
+  m_servingCellRlq.AddRule ({sGood, sInc}, high);
+  m_servingCellRlq.AddRule ({sExcellent, sDec}, high);
+  m_servingCellRlq.AddRule ({sExcellent, sInc}, high);
+
+  // neighbour cell radio link quality estimator
+  rsrq = m_neighbourCellRlq.AddInput ();
+  uint32_t nPoor = m_neighbourCellRlq.AddInputTerm (rsrq, Mf (LEFT_FLAT, 17.0, 1.0, 0.5));
+  uint32_t nFair = m_neighbourCellRlq.AddInputTerm (rsrq, Mf (SYMMETRIC, 20.0, 1.0, 0.5));
+  uint32_t nGood = m_neighbourCellRlq.AddInputTerm (rsrq, Mf (SYMMETRIC, 23.0, 1.0, 0.5));
+  uint32_t nExcellent = m_neighbourCellRlq.AddInputTerm (rsrq, Mf (RIGHT_FLAT, 26.0, 1.0, 0.5));
+  deltaRsrq = m_neighbourCellRlq.AddInput ();
+  uint32_t nDec = m_neighbourCellRlq.AddInputTerm (deltaRsrq, Mf (LEFT_FLAT, -4.0, 2.0, 0.25));
+  uint32_t nInc = m_neighbourCellRlq.AddInputTerm (deltaRsrq, Mf (RIGHT_FLAT, 4.0, 2.0, 0.25));
+  m_neighbourCellRlq.SetOutput (rlqDomain);
+  low = m_neighbourCellRlq.AddOutputTerm (Mf (LEFT_FLAT, 0.0, 0.2, 0.1));
+  average = m_neighbourCellRlq.AddOutputTerm (Mf (SYMMETRIC, 0.5, 0.1, 0.04));
+  high = m_neighbourCellRlq.AddOutputTerm (Mf (RIGHT_FLAT, 1.0, 0.2, 0.1));
+  m_neighbourCellRlq.AddRule ({nPoor, nDec}, low);
+  m_neighbourCellRlq.AddRule ({nPoor, nInc}, low);
+  m_neighbourCellRlq.AddRule ({nFair, nDec}, low);
+  m_neighbourCellRlq.AddRule ({nFair, nInc}, average);
+  m_neighbourCellRlq.AddRule ({nGood, nDec}, average);
+  m_neighbourCellRlq.AddRule ({nGood, nInc}, high);
+  m_neighbourCellRlq.AddRule ({nExcellent, nDec}, high);
+  m_neighbourCellRlq.AddRule ({nExcellent, nInc}, high);
+
+  // handover trigger evaluator
+  uint32_t sRlq = m_handoverTrigger.AddInput ();
+  uint32_t sLow = m_handoverTrigger.AddInputTerm (sRlq, Mf (LEFT_FLAT, 0.0, 0.2, 0.1));
+  uint32_t sAverage = m_handoverTrigger.AddInputTerm (sRlq, Mf (SYMMETRIC, 0.5, 0.1, 0.04));
+  uint32_t sHigh = m_handoverTrigger.AddInputTerm (sRlq, Mf (RIGHT_FLAT, 1.0, 0.2, 0.1));
+  uint32_t nRlq = m_handoverTrigger.AddInput ();
+  uint32_t nLow = m_handoverTrigger.AddInputTerm (nRlq, Mf (LEFT_FLAT, 0.0, 0.2, 0.1));
+  uint32_t nAverage = m_handoverTrigger.AddInputTerm (nRlq, Mf (SYMMETRIC, 0.5, 0.1, 0.04));
+  uint32_t nHigh = m_handoverTrigger.AddInputTerm (nRlq, Mf (RIGHT_FLAT, 1.0, 0.2, 0.1));
+  m_handoverTrigger.SetOutput (htDomain);
+  uint32_t no = m_handoverTrigger.AddOutputTerm (Mf (LEFT_FLAT, 0.0, 0.2, 0.1));
+  uint32_t middle = m_handoverTrigger.AddOutputTerm (Mf (SYMMETRIC, 0.5, 0.1, 0.04));
+  uint32_t yes = m_handoverTrigger.AddOutputTerm (Mf (RIGHT_FLAT, 1.0, 0.2, 0.1));
+  m_handoverTrigger.AddRule ({sLow, nLow}, middle);
+  m_handoverTrigger.AddRule ({sAverage, nLow}, no);
+  m_handoverTrigger.AddRule ({sHigh, nLow}, no);
+  m_handoverTrigger.AddRule ({sLow, nAverage}, yes);
+  m_handoverTrigger.AddRule ({sAverage, nAverage}, middle);
+  m_handoverTrigger.AddRule ({sHigh, nAverage}, no);
+  m_handoverTrigger.AddRule ({sLow, nHigh}, yes);
+  m_handoverTrigger.AddRule ({sAverage, nHigh}, middle);
+  m_handoverTrigger.AddRule ({sHigh, nHigh}, no);
+}
+
+std::string
+Type2FuzzyHandoverController::GetName () const
+{
+  return (m_tNorm == It2MamdaniFis::MIN_T_NORM) ? "Type2/Min" : "Type2/Product";
+}
+
+double
+Type2FuzzyHandoverController::EvaluateServingCellRlq (double rsrq, double deltaRsrq) const
+{
+  return m_servingCellRlq.Evaluate ({rsrq, deltaRsrq});
+}
+
+double
+Type2FuzzyHandoverController::EvaluateNeighbourCellRlq (double rsrq, double deltaRsrq) const
+{
+  return m_neighbourCellRlq.Evaluate ({rsrq, deltaRsrq});
+}
+
+double
+Type2FuzzyHandoverController::EvaluateHandoverTrigger (double servingCellRlq, double neighbourCellRlq) const
+{
+  return m_handoverTrigger.Evaluate ({servingCellRlq, neighbourCellRlq});
+}
+
+bool
+Type2FuzzyHandoverController::IsHandoverTriggered (double handoverTrigger) const
+{
+  return handoverTrigger >= 0.75;
+}
+
+} // namespace ns3
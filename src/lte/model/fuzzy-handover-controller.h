@@ -0,0 +1,180 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Amiraslan Haghrah
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Amiraslan Haghrah <amiraslanhaghrah@gmail.com>
+ */
+
+#ifndef FUZZY_HANDOVER_CONTROLLER_H
+#define FUZZY_HANDOVER_CONTROLLER_H
+
+#include <ns3/simple-ref-count.h>
+#include <ns3/fuzzy-inference-system.h>
+#include <ns3/handover-measurement-history.h>
+
+#include <stdint.h>
+#include <string>
+
+namespace ns3 {
+
+/**
+ * \ingroup lte
+ * \brief Fuzzy handover decision logic shared by the fuzzy handover
+ *        algorithms.
+ *
+ * The decision is made in two stages. First, the radio link quality (RLQ) of
+ * the serving cell and of each neighbour cell is estimated from the RSRQ
+ * predicted for the next report and from its variation with respect to the
+ * last reported RSRQ. Second, a handover trigger (HT) is inferred from the
+ * serving cell RLQ and the best neighbour cell RLQ; the handover is triggered
+ * when the HT is above a threshold.
+ *
+ * The RSRQ prediction extrapolates, by one report, the least squares
+ * polynomial fit (degree 1 up to 3 samples, degree 2 from 4 samples) of the
+ * last reported RSRQ values, as done with Chebyshev series in the original
+ * Python controllers.
+ *
+ * Subclasses provide the three fuzzy inference systems.
+ */
+class FuzzyHandoverController : public SimpleRefCount<FuzzyHandoverController>
+{
+public:
+  /// Number of reports used for the RSRQ prediction
+  static const uint32_t PREDICTION_WINDOW = 6;
+
+  virtual ~FuzzyHandoverController ();
+
+  /**
+   * \return a name identifying the rule base and its settings
+   */
+  virtual std::string GetName () const = 0;
+  /**
+   * \param rsrq the predicted serving cell RSRQ, in quantized range [0..34]
+   * \param deltaRsrq the predicted variation of the serving cell RSRQ
+   * \return the serving cell RLQ, in [0, 1]
+   */
+  virtual double EvaluateServingCellRlq (double rsrq, double deltaRsrq) const = 0;
+  /**
+   * \param rsrq the predicted neighbour cell RSRQ, in quantized range [0..34]
+   * \param deltaRsrq the predicted variation of the neighbour cell RSRQ
+   * \return the neighbour cell RLQ, in [0, 1]
+   */
+  virtual double EvaluateNeighbourCellRlq (double rsrq, double deltaRsrq) const = 0;
+  /**
+   * \param servingCellRlq the serving cell RLQ
+   * \param neighbourCellRlq the neighbour cell RLQ
+   * \return the handover trigger, in [0, 1]
+   */
+  virtual double EvaluateHandoverTrigger (double servingCellRlq, double neighbourCellRlq) const = 0;
+  /**
+   * \param handoverTrigger the handover trigger
+   * \return true if the handover trigger value calls for a handover
+   */
+  virtual bool IsHandoverTriggered (double handoverTrigger) const = 0;
+
+  /**
+   * \brief Make a handover decision.
+   * \param servingCellRsrq the last RSRQ reports of the serving cell
+   * \param neighbourCellRsrq the last RSRQ reports of each neighbour cell
+   * \return the cell ID of the handover target, or zero if no handover is
+   *         needed
+   */
+  uint16_t EvaluateHandover (const MeasurementRingBuffer &servingCellRsrq,
+                             const HandoverMeasurementHistory::NeighbourCellMap &neighbourCellRsrq) const;
+
+  /**
+   * \param series the last serving cell RSRQ reports
+   * \return the predicted RSRQ of the next report
+   */
+  static double PredictServingCellRsrq (const MeasurementRingBuffer &series);
+  /**
+   * \param series the last neighbour cell RSRQ reports
+   * \return the predicted RSRQ of the next report
+   */
+  static double PredictNeighbourCellRsrq (const MeasurementRingBuffer &series);
+
+protected:
+  /**
+   * \param series the last RSRQ reports, at least 2 of them
+   * \return the one-step extrapolation of the least squares polynomial fit
+   *         of the last PREDICTION_WINDOW reports
+   */
+  static double Extrapolate (const MeasurementRingBuffer &series);
+
+  /**
+   * \param lo first value
+   * \param hi last value
+   * \param n number of values
+   * \return n evenly spaced values from lo to hi
+   */
+  static std::vector<double> Linspace (double lo, double hi, uint32_t n);
+};
+
+
+/**
+ * \ingroup lte
+ * \brief Type 1 fuzzy handover controller (scikit-fuzzy rule base).
+ */
+class Type1FuzzyHandoverController : public FuzzyHandoverController
+{
+public:
+  Type1FuzzyHandoverController ();
+
+  // inherited from FuzzyHandoverController
+  virtual std::string GetName () const;
+  virtual double EvaluateServingCellRlq (double rsrq, double deltaRsrq) const;
+  virtual double EvaluateNeighbourCellRlq (double rsrq, double deltaRsrq) const;
+  virtual double EvaluateHandoverTrigger (double servingCellRlq, double neighbourCellRlq) const;
+  virtual bool IsHandoverTriggered (double handoverTrigger) const;
+
+private:
+  Type1MamdaniFis m_servingCellRlq;   ///< serving cell RLQ estimator
+  Type1MamdaniFis m_neighbourCellRlq; ///< neighbour cell RLQ estimator
+  Type1MamdaniFis m_handoverTrigger;  ///< handover trigger evaluator
+};
+
+
+/**
+ * \ingroup lte
+ * \brief Interval type 2 fuzzy handover controller (pyit2fls rule base).
+ */
+class Type2FuzzyHandoverController : public FuzzyHandoverController
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param tNorm the t-norm used by the three inference systems
+   */
+  Type2FuzzyHandoverController (It2MamdaniFis::TNorm tNorm = It2MamdaniFis::MIN_T_NORM);
+
+  // inherited from FuzzyHandoverController
+  virtual std::string GetName () const;
+  virtual double EvaluateServingCellRlq (double rsrq, double deltaRsrq) const;
+  virtual double EvaluateNeighbourCellRlq (double rsrq, double deltaRsrq) const;
+  virtual double EvaluateHandoverTrigger (double servingCellRlq, double neighbourCellRlq) const;
+  virtual bool IsHandoverTriggered (double handoverTrigger) const;
+
+private:
+  It2MamdaniFis::TNorm m_tNorm;     ///< t-norm of the inference systems
+  It2MamdaniFis m_servingCellRlq;   ///< serving cell RLQ estimator
+  It2MamdaniFis m_neighbourCellRlq; ///< neighbour cell RLQ estimator
+  It2MamdaniFis m_handoverTrigger;  ///< handover trigger evaluator
+};
+
+} // namespace ns3
+
+#endif /* FUZZY_HANDOVER_CONTROLLER_H */
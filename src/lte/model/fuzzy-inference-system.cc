@@ -0,0 +1,466 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Amiraslan Haghrah
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Amiraslan Haghrah <amiraslanhaghrah@gmail.com>
+ */
+
+#include "fuzzy-inference-system.h"
+#include <ns3/log.h>
+#include <ns3/assert.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("FuzzyInferenceSystem");
+
+
+///////////////////////////////////////////
+// Membership functions
+///////////////////////////////////////////
+
+
+GaussianMembershipFunction::GaussianMembershipFunction (Shape shape, double mean,
+                                                        double std, double height)
+  : m_shape (shape),
+    m_mean (mean),
+    m_std (std),
+    m_height (height)
+{
+  NS_ASSERT_MSG (std > 0, "standard deviation must be positive");
+}
+
+double
+GaussianMembershipFunction::Evaluate (double x) const
+{
+  if ((m_shape == LEFT_FLAT && x < m_mean)
+      || (m_shape == RIGHT_FLAT && x > m_mean))
+    {
+      return m_height;
+    }
+  double d = x - m_mean;
+  return m_height * std::exp (-(d * d) / (2.0 * m_std * m_std));
+}
+
+
+It2GaussianMembershipFunction::It2GaussianMembershipFunction (GaussianMembershipFunction::Shape shape,
+                                                              double mean, double std, double spread,
+                                                              double height)
+  : m_upper (shape, mean, std + spread / 2.0, height),
+    m_lower (shape, mean, std - spread / 2.0, height)
+{
+}
+
+double
+It2GaussianMembershipFunction::EvaluateUpper (double x) const
+{
+  return m_upper.Evaluate (x);
+}
+
+double
+It2GaussianMembershipFunction::EvaluateLower (double x) const
+{
+  return m_lower.Evaluate (x);
+}
+
+
+///////////////////////////////////////////
+// Type1MamdaniFis
+///////////////////////////////////////////
+
+
+Type1MamdaniFis::Type1MamdaniFis ()
+{
+}
+
+uint32_t
+Type1MamdaniFis::AddInput (const std::vector<double> &universe)
+{
+  NS_ASSERT (universe.size () > 1);
+  Variable v;
+  v.universe = universe;
+  m_inputs.push_back (v);
+  return m_inputs.size () - 1;
+}
+
+uint32_t
+Type1MamdaniFis::AddInputTerm (uint32_t input, const GaussianMembershipFunction &mf)
+{
+  NS_ASSERT (input < m_inputs.size ());
+  Variable &v = m_inputs.at (input);
+  std::vector<double> sampled;
+  for (std::vector<double>::const_iterator it = v.universe.begin (); it != v.universe.end (); ++it)
+    {
+      sampled.push_back (mf.Evaluate (*it));
+    }
+  v.terms.push_back (sampled);
+  return v.terms.size () - 1;
+}
+
+void
+Type1MamdaniFis::SetOutput (const std::vector<double> &universe)
+{
+  NS_ASSERT (universe.size () > 1);
+  m_output.universe = universe;
+  m_output.terms.clear ();
+}
+
+uint32_t
+Type1MamdaniFis::AddOutputTerm (const GaussianMembershipFunction &mf)
+{
+  std::vector<double> sampled;
+  for (std::vector<double>::const_iterator it = m_output.universe.begin (); it != m_output.universe.end (); ++it)
+    {
+      sampled.push_back (mf.Evaluate (*it));
+    }
+  m_output.terms.push_back (sampled);
+  return m_output.terms.size () - 1;
+}
+
+void
+Type1MamdaniFis::AddRule (const std::vector<uint32_t> &antecedents, uint32_t consequent)
+{
+  NS_ASSERT (antecedents.size () == m_inputs.size ());
+  NS_ASSERT (consequent < m_output.terms.size ());
+  for (uint32_t i = 0; i < antecedents.size (); ++i)
+    {
+      NS_ASSERT (antecedents.at (i) < m_inputs.at (i).terms.size ());
+    }
+  Rule r;
+  r.antecedents = antecedents;
+  r.consequent = consequent;
+  m_rules.push_back (r);
+}
+
+double
+Type1MamdaniFis::Interpolate (const std::vector<double> &universe,
+                              const std::vector<double> &mf, double x)
+{
+  if (x <= universe.front ())
+    {
+      return mf.front ();
+    }
+  if (x >= universe.back ())
+    {
+      return mf.back ();
+    }
+  std::vector<double>::const_iterator it = std::upper_bound (universe.begin (), universe.end (), x);
+  uint32_t i = it - universe.begin ();
+  double x1 = universe.at (i - 1);
+  double x2 = universe.at (i);
+  return mf.at (i - 1) + (x - x1) * (mf.at (i) - mf.at (i - 1)) / (x2 - x1);
+}
+
+double
+Type1MamdaniFis::Centroid (const std::vector<double> &x, const std::vector<double> &mf)
+{
+  NS_ASSERT (x.size () == mf.size ());
+  double sumMomentArea = 0.0;
+  double sumArea = 0.0;
+  for (uint32_t i = 1; i < x.size (); ++i)
+    {
+      double x1 = x.at (i - 1);
+      double x2 = x.at (i);
+      double y1 = mf.at (i - 1);
+      double y2 = mf.at (i);
+      if ((y1 == 0.0 && y2 == 0.0) || x1 == x2)
+        {
+          continue;
+        }
+      double moment;
+      double area;
+      if (y1 == y2)
+        {
+          // rectangle
+          moment = 0.5 * (x1 + x2);
+          area = (x2 - x1) * y1;
+        }
+      else if (y1 == 0.0)
+        {
+          // triangle, height y2
+          moment = 2.0 / 3.0 * (x2 - x1) + x1;
+          area = 0.5 * (x2 - x1) * y2;
+        }
+      else if (y2 == 0.0)
+        {
+          // triangle, height y1
+          moment = 1.0 / 3.0 * (x2 - x1) + x1;
+          area = 0.5 * (x2 - x1) * y1;
+        }
+      else
+        {
+          // trapezoid
+          moment = (2.0 / 3.0 * (x2 - x1) * (y2 + 0.5 * y1)) / (y1 + y2) + x1;
+          area = 0.5 * (x2 - x1) * (y1 + y2);
+        }
+      sumMomentArea += moment * area;
+      sumArea += area;
+    }
+  return sumMomentArea / std::max (sumArea, std::numeric_limits<double>::epsilon ());
+}
+
+double
+Type1MamdaniFis::Evaluate (const std::vector<double> &inputs) const
+{
+  NS_ASSERT (inputs.size () == m_inputs.size ());
+
+  // cut level of each output term: max over the rules using the term of the
+  // min over the rule antecedents
+  std::vector<double> cuts (m_output.terms.size (), -1.0);
+  for (std::vector<Rule>::const_iterator rule = m_rules.begin (); rule != m_rules.end (); ++rule)
+    {
+      double activation = 1.0;
+      for (uint32_t i = 0; i < m_inputs.size (); ++i)
+        {
+          const Variable &v = m_inputs.at (i);
+          double x = std::min (std::max (inputs.at (i), v.universe.front ()), v.universe.back ());
+          activation = std::min (activation,
+                                 Interpolate (v.universe, v.terms.at (rule->antecedents.at (i)), x));
+        }
+      cuts.at (rule->consequent) = std::max (cuts.at (rule->consequent), activation);
+    }
+
+  // refine the output universe with the points where each term crosses its
+  // cut level, so that the clipped sets are represented exactly
+  const std::vector<double> &universe = m_output.universe;
+  std::vector<double> points (universe);
+  for (uint32_t t = 0; t < m_output.terms.size (); ++t)
+    {
+      double cut = cuts.at (t);
+      if (cut <= 0.0)
+        {
+          continue;
+        }
+      const std::vector<double> &mf = m_output.terms.at (t);
+      for (uint32_t i = 0; i + 1 < universe.size (); ++i)
+        {
+          if ((mf.at (i) >= cut) != (mf.at (i + 1) >= cut))
+            {
+              points.push_back (universe.at (i) + (cut - mf.at (i))
+                                * (universe.at (i + 1) - universe.at (i))
+                                / (mf.at (i + 1) - mf.at (i)));
+            }
+        }
+    }
+  std::sort (points.begin (), points.end ());
+  points.erase (std::unique (points.begin (), points.end ()), points.end ());
+
+  std::vector<double> output (points.size (), 0.0);
+  for (uint32_t t = 0; t < m_output.terms.size (); ++t)
+    {
+      double cut = cuts.at (t);
+      if (cut < 0.0)
+        {
+          continue; // term not used by any rule
+        }
+      const std::vector<double> &mf = m_output.terms.at (t);
+      for (uint32_t j = 0; j < points.size (); ++j)
+        {
+          output.at (j) = std::max (output.at (j), std::min (cut, Interpolate (universe, mf, points.at (j))));
+        }
+    }
+
+  return Centroid (points, output);
+}
+
+
+///////////////////////////////////////////
+// It2MamdaniFis
+///////////////////////////////////////////
+
+
+It2MamdaniFis::It2MamdaniFis (TNorm tNorm)
+  : m_tNorm (tNorm)
+{
+}
+
+uint32_t
+It2MamdaniFis::AddInput ()
+{
+  m_inputs.push_back (std::vector<It2GaussianMembershipFunction> ());
+  return m_inputs.size () - 1;
+}
+
+uint32_t
+It2MamdaniFis::AddInputTerm (uint32_t input, const It2GaussianMembershipFunction &mf)
+{
+  NS_ASSERT (input < m_inputs.size ());
+  m_inputs.at (input).push_back (mf);
+  return m_inputs.at (input).size () - 1;
+}
+
+void
+It2MamdaniFis::SetOutput (const std::vector<double> &universe)
+{
+  NS_ASSERT (universe.size () > 1);
+  m_outputUniverse = universe;
+  m_outputCentroids.clear ();
+}
+
+uint32_t
+It2MamdaniFis::AddOutputTerm (const It2GaussianMembershipFunction &mf)
+{
+  NS_ASSERT_MSG (!m_outputUniverse.empty (), "output universe not set");
+  std::vector<double> lower;
+  std::vector<double> upper;
+  for (std::vector<double>::const_iterator it = m_outputUniverse.begin (); it != m_outputUniverse.end (); ++it)
+    {
+      lower.push_back (mf.EvaluateLower (*it));
+      upper.push_back (mf.EvaluateUpper (*it));
+    }
+  m_outputCentroids.push_back (KarnikMendel (m_outputUniverse, lower, upper));
+  NS_LOG_LOGIC ("output term " << m_outputCentroids.size () - 1
+                << " centroid [" << m_outputCentroids.back ().first
+                << ", " << m_outputCentroids.back ().second << "]");
+  return m_outputCentroids.size () - 1;
+}
+
+void
+It2MamdaniFis::AddRule (const std::vector<uint32_t> &antecedents, uint32_t consequent)
+{
+  NS_ASSERT (antecedents.size () == m_inputs.size ());
+  NS_ASSERT (consequent < m_outputCentroids.size ());
+  for (uint32_t i = 0; i < antecedents.size (); ++i)
+    {
+      NS_ASSERT (antecedents.at (i) < m_inputs.at (i).size ());
+    }
+  Rule r;
+  r.antecedents = antecedents;
+  r.consequent = consequent;
+  m_rules.push_back (r);
+}
+
+double
+It2MamdaniFis::ApplyTNorm (double a, double b) const
+{
+  return (m_tNorm == MIN_T_NORM) ? std::min (a, b) : a * b;
+}
+
+std::pair<double, double>
+It2MamdaniFis::EvaluateInterval (const std::vector<double> &inputs) const
+{
+  NS_ASSERT (inputs.size () == m_inputs.size ());
+
+  std::vector<double> firingLower;
+  std::vector<double> firingUpper;
+  std::vector<double> centroidLeft;
+  std::vector<double> centroidRight;
+  for (std::vector<Rule>::const_iterator rule = m_rules.begin (); rule != m_rules.end (); ++rule)
+    {
+      double lower = 1.0;
+      double upper = 1.0;
+      for (uint32_t i = 0; i < m_inputs.size (); ++i)
+        {
+          const It2GaussianMembershipFunction &mf = m_inputs.at (i).at (rule->antecedents.at (i));
+          lower = ApplyTNorm (lower, mf.EvaluateLower (inputs.at (i)));
+          upper = ApplyTNorm (upper, mf.EvaluateUpper (inputs.at (i)));
+        }
+      firingLower.push_back (lower);
+      firingUpper.push_back (upper);
+      centroidLeft.push_back (m_outputCentroids.at (rule->consequent).first);
+      centroidRight.push_back (m_outputCentroids.at (rule->consequent).second);
+    }
+
+  double yl = KarnikMendel (centroidLeft, firingLower, firingUpper).first;
+  double yr = KarnikMendel (centroidRight, firingLower, firingUpper).second;
+  return std::make_pair (yl, yr);
+}
+
+double
+It2MamdaniFis::Evaluate (const std::vector<double> &inputs) const
+{
+  std::pair<double, double> tr = EvaluateInterval (inputs);
+  return (tr.first + tr.second) / 2.0;
+}
+
+std::pair<double, double>
+It2MamdaniFis::KarnikMendel (const std::vector<double> &x,
+                             const std::vector<double> &lower,
+                             const std::vector<double> &upper)
+{
+  NS_ASSERT (x.size () == lower.size () && x.size () == upper.size ());
+  const uint32_t n = x.size ();
+
+  std::vector<std::pair<double, uint32_t> > order;
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      order.push_back (std::make_pair (x.at (i), i));
+    }
+  std::sort (order.begin (), order.end ());
+
+  // weights of the points before (prefix) and from (suffix) each switch
+  // point, summed separately so that no weight is ever subtracted
+  std::vector<double> prefixLower (n + 1, 0.0);
+  std::vector<double> prefixLowerMoment (n + 1, 0.0);
+  std::vector<double> prefixUpper (n + 1, 0.0);
+  std::vector<double> prefixUpperMoment (n + 1, 0.0);
+  for (uint32_t k = 0; k < n; ++k)
+    {
+      uint32_t i = order.at (k).second;
+      prefixLower.at (k + 1) = prefixLower.at (k) + lower.at (i);
+      prefixLowerMoment.at (k + 1) = prefixLowerMoment.at (k) + lower.at (i) * x.at (i);
+      prefixUpper.at (k + 1) = prefixUpper.at (k) + upper.at (i);
+      prefixUpperMoment.at (k + 1) = prefixUpperMoment.at (k) + upper.at (i) * x.at (i);
+    }
+  std::vector<double> suffixLower (n + 1, 0.0);
+  std::vector<double> suffixLowerMoment (n + 1, 0.0);
+  std::vector<double> suffixUpper (n + 1, 0.0);
+  std::vector<double> suffixUpperMoment (n + 1, 0.0);
+  for (uint32_t k = n; k > 0; --k)
+    {
+      uint32_t i = order.at (k - 1).second;
+      suffixLower.at (k - 1) = suffixLower.at (k) + lower.at (i);
+      suffixLowerMoment.at (k - 1) = suffixLowerMoment.at (k) + lower.at (i) * x.at (i);
+      suffixUpper.at (k - 1) = suffixUpper.at (k) + upper.at (i);
+      suffixUpperMoment.at (k - 1) = suffixUpperMoment.at (k) + upper.at (i) * x.at (i);
+    }
+
+  if (prefixUpper.at (n) <= 0)
+    {
+      NS_LOG_WARN ("all weights are zero, type reduction undefined");
+      return std::make_pair (0.0, 0.0);
+    }
+
+  // the left end point uses the upper weights for the k smallest points and
+  // the lower weights for the others; the right end point the opposite
+  double yl = std::numeric_limits<double>::infinity ();
+  double yr = -std::numeric_limits<double>::infinity ();
+  for (uint32_t k = 0; k <= n; ++k)
+    {
+      double leftWeight = prefixUpper.at (k) + suffixLower.at (k);
+      if (leftWeight > 0)
+        {
+          yl = std::min (yl, (prefixUpperMoment.at (k) + suffixLowerMoment.at (k)) / leftWeight);
+        }
+      double rightWeight = prefixLower.at (k) + suffixUpper.at (k);
+      if (rightWeight > 0)
+        {
+          yr = std::max (yr, (prefixLowerMoment.at (k) + suffixUpperMoment.at (k)) / rightWeight);
+        }
+    }
+
+  // coincident points may leave yl a rounding error above yr
+  if (yl > yr)
+    {
+      yl = yr = (yl + yr) / 2.0;
+    }
+  return std::make_pair (yl, yr);
+}
+
+} // namespace ns3
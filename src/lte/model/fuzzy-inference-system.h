@@ -0,0 +1,328 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Amiraslan Haghrah
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Amiraslan Haghrah <amiraslanhaghrah@gmail.com>
+ */
+
+#ifndef FUZZY_INFERENCE_SYSTEM_H
+#define FUZZY_INFERENCE_SYSTEM_H
+
+#include <stdint.h>
+#include <vector>
+#include <utility>
+
+namespace ns3 {
+
+/**
+ * \ingroup lte
+ * \brief Gaussian membership function, optionally saturated on one side.
+ *
+ * The shapes follow the naming of the pyit2fls / scikit-fuzzy functions the
+ * rule bases were originally written with: a `LEFT_FLAT` function is equal to
+ * its height below the mean (pyit2fls "R" sets, e.g., POOR), a `RIGHT_FLAT`
+ * function is equal to its height above the mean (pyit2fls "L" sets, e.g.,
+ * EXCELLENT).
+ */
+class GaussianMembershipFunction
+{
+public:
+  /// Shape of the function around its mean
+  enum Shape
+  {
+    SYMMETRIC,
+    LEFT_FLAT,
+    RIGHT_FLAT
+  };
+
+  /**
+   * Constructor
+   *
+   * \param shape the shape of the function
+   * \param mean the mean (centre) of the Gaussian
+   * \param std the standard deviation of the Gaussian
+   * \param height the maximum membership degree
+   */
+  GaussianMembershipFunction (Shape shape, double mean, double std, double height = 1.0);
+
+  /**
+   * \param x the crisp value
+   * \return the membership degree of x
+   */
+  double Evaluate (double x) const;
+
+private:
+  Shape m_shape;   ///< shape of the function
+  double m_mean;   ///< mean
+  double m_std;    ///< standard deviation
+  double m_height; ///< maximum membership degree
+};
+
+
+/**
+ * \ingroup lte
+ * \brief Interval type-2 Gaussian fuzzy set with uncertain standard deviation.
+ *
+ * Equivalent of pyit2fls IT2FS_Gaussian_UncertStd (and its R_ / L_ variants):
+ * the upper membership function is a Gaussian with standard deviation
+ * `std + spread / 2`, the lower one a Gaussian with `std - spread / 2`.
+ */
+class It2GaussianMembershipFunction
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param shape the shape of the upper and lower functions
+   * \param mean the mean (centre) of the Gaussians
+   * \param std the centre of the uncertain standard deviation
+   * \param spread the width of the standard deviation uncertainty interval
+   * \param height the maximum membership degree
+   */
+  It2GaussianMembershipFunction (GaussianMembershipFunction::Shape shape,
+                                 double mean, double std, double spread,
+                                 double height = 1.0);
+
+  /**
+   * \param x the crisp value
+   * \return the upper membership degree of x
+   */
+  double EvaluateUpper (double x) const;
+  /**
+   * \param x the crisp value
+   * \return the lower membership degree of x
+   */
+  double EvaluateLower (double x) const;
+
+private:
+  GaussianMembershipFunction m_upper; ///< upper membership function
+  GaussianMembershipFunction m_lower; ///< lower membership function
+};
+
+
+/**
+ * \ingroup lte
+ * \brief Type-1 Mamdani fuzzy inference system.
+ *
+ * Reproduces the scikit-fuzzy control system used by the type 1 fuzzy
+ * handover algorithm: membership functions are sampled over a discrete
+ * universe per variable, crisp inputs are clipped to the universe bounds and
+ * fuzzified by linear interpolation, rules use the min t-norm, the
+ * activations of rules sharing a consequent term are aggregated with max,
+ * and the clipped output sets are defuzzified by centroid over the output
+ * universe refined with the points where each term crosses its cut level.
+ *
+ * Inputs are identified by the order in which they are added; every rule
+ * names one term per input, in the same order.
+ */
+class Type1MamdaniFis
+{
+public:
+  Type1MamdaniFis ();
+
+  /**
+   * \brief Add an input variable.
+   * \param universe the sorted discrete universe of the variable
+   * \return the index of the input
+   */
+  uint32_t AddInput (const std::vector<double> &universe);
+  /**
+   * \brief Add a linguistic term to an input variable.
+   * \param input the index of the input
+   * \param mf the membership function of the term
+   * \return the index of the term within the input
+   */
+  uint32_t AddInputTerm (uint32_t input, const GaussianMembershipFunction &mf);
+  /**
+   * \brief Set the output variable.
+   * \param universe the sorted discrete universe of the variable
+   */
+  void SetOutput (const std::vector<double> &universe);
+  /**
+   * \brief Add a linguistic term to the output variable.
+   * \param mf the membership function of the term
+   * \return the index of the term
+   */
+  uint32_t AddOutputTerm (const GaussianMembershipFunction &mf);
+  /**
+   * \brief Add a rule.
+   * \param antecedents the term index of each input, in input order
+   * \param consequent the output term index
+   */
+  void AddRule (const std::vector<uint32_t> &antecedents, uint32_t consequent);
+
+  /**
+   * \param inputs the crisp value of each input, in input order
+   * \return the crisp output
+   */
+  double Evaluate (const std::vector<double> &inputs) const;
+
+  /**
+   * \brief Centroid of a piecewise linear membership function.
+   * \param x the sorted sample points
+   * \param mf the membership degree at each sample point
+   * \return the abscissa of the centroid of the area under mf
+   */
+  static double Centroid (const std::vector<double> &x, const std::vector<double> &mf);
+
+private:
+  /**
+   * \brief Linear interpolation of a sampled membership function.
+   * \param universe the sample points
+   * \param mf the membership degree at each sample point
+   * \param x the point to evaluate
+   * \return the interpolated membership degree
+   */
+  static double Interpolate (const std::vector<double> &universe,
+                             const std::vector<double> &mf, double x);
+
+  /// A fuzzy variable over a discrete universe
+  struct Variable
+  {
+    std::vector<double> universe;          ///< discrete universe
+    std::vector<std::vector<double> > terms; ///< sampled membership functions
+  };
+
+  /// A rule of the system
+  struct Rule
+  {
+    std::vector<uint32_t> antecedents; ///< term index per input
+    uint32_t consequent;               ///< output term index
+  };
+
+  std::vector<Variable> m_inputs; ///< input variables
+  Variable m_output;              ///< output variable
+  std::vector<Rule> m_rules;      ///< rule base
+};
+
+
+/**
+ * \ingroup lte
+ * \brief Interval type-2 Mamdani fuzzy inference system.
+ *
+ * Reproduces the pyit2fls Mamdani system (method "CoSet") used by the type 2
+ * fuzzy handover algorithm: each rule fires an interval obtained by applying
+ * the t-norm to the lower and to the upper membership degrees of its
+ * antecedents; the centroid interval of each consequent set is computed once
+ * by Karnik-Mendel type reduction over the discrete output universe; the
+ * output interval is the Karnik-Mendel centre of sets of the consequent
+ * centroids weighted by the firing intervals, and the crisp output is its
+ * midpoint.
+ */
+class It2MamdaniFis
+{
+public:
+  /// The t-norm used to combine antecedents
+  enum TNorm
+  {
+    MIN_T_NORM,
+    PRODUCT_T_NORM
+  };
+
+  /**
+   * Constructor
+   *
+   * \param tNorm the t-norm used to combine antecedents
+   */
+  It2MamdaniFis (TNorm tNorm = MIN_T_NORM);
+
+  /**
+   * \brief Add an input variable.
+   * \return the index of the input
+   */
+  uint32_t AddInput ();
+  /**
+   * \brief Add a linguistic term to an input variable.
+   * \param input the index of the input
+   * \param mf the membership function of the term
+   * \return the index of the term within the input
+   */
+  uint32_t AddInputTerm (uint32_t input, const It2GaussianMembershipFunction &mf);
+  /**
+   * \brief Set the output variable.
+   * \param universe the sorted discrete universe used for type reduction
+   */
+  void SetOutput (const std::vector<double> &universe);
+  /**
+   * \brief Add a linguistic term to the output variable.
+   *
+   * The centroid interval of the term is computed here, so SetOutput must be
+   * called before.
+   *
+   * \param mf the membership function of the term
+   * \return the index of the term
+   */
+  uint32_t AddOutputTerm (const It2GaussianMembershipFunction &mf);
+  /**
+   * \brief Add a rule.
+   * \param antecedents the term index of each input, in input order
+   * \param consequent the output term index
+   */
+  void AddRule (const std::vector<uint32_t> &antecedents, uint32_t consequent);
+
+  /**
+   * \param inputs the crisp value of each input, in input order
+   * \return the type-reduced output interval
+   */
+  std::pair<double, double> EvaluateInterval (const std::vector<double> &inputs) const;
+  /**
+   * \param inputs the crisp value of each input, in input order
+   * \return the crisp output, i.e., the midpoint of the type-reduced interval
+   */
+  double Evaluate (const std::vector<double> &inputs) const;
+
+  /**
+   * \brief Karnik-Mendel type reduction.
+   *
+   * Computes the interval [yl, yr] of weighted averages of the points x when
+   * each weight varies independently within [lower, upper]. The switch
+   * points found by the iterative KM procedure are located here exactly by
+   * scanning every candidate with prefix sums.
+   *
+   * \param x the points
+   * \param lower the lower weight of each point
+   * \param upper the upper weight of each point
+   * \return the interval [yl, yr]; (0, 0) if every weight is zero
+   */
+  static std::pair<double, double> KarnikMendel (const std::vector<double> &x,
+                                                 const std::vector<double> &lower,
+                                                 const std::vector<double> &upper);
+
+private:
+  /**
+   * \param a first operand
+   * \param b second operand
+   * \return the t-norm of a and b
+   */
+  double ApplyTNorm (double a, double b) const;
+
+  /// A rule of the system
+  struct Rule
+  {
+    std::vector<uint32_t> antecedents; ///< term index per input
+    uint32_t consequent;               ///< output term index
+  };
+
+  TNorm m_tNorm; ///< t-norm used to combine antecedents
+  std::vector<std::vector<It2GaussianMembershipFunction> > m_inputs; ///< terms of each input
+  std::vector<double> m_outputUniverse; ///< discrete output universe
+  std::vector<std::pair<double, double> > m_outputCentroids; ///< centroid interval of each output term
+  std::vector<Rule> m_rules; ///< rule base
+};
+
+} // namespace ns3
+
+#endif /* FUZZY_INFERENCE_SYSTEM_H */
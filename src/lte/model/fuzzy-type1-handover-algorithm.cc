@@ -26,15 +26,11 @@
  */
 
 #include "fuzzy-type1-handover-algorithm.h"
+#include "fuzzy-decision-surface.h"
 #include <ns3/log.h>
 #include <ns3/uinteger.h>
-
-// #include <ns3/random-variable-stream.h>
-#include "ns3/core-module.h"
-
-
-#include <iomanip>
-#include <numeric>
+#include <ns3/boolean.h>
+#include <ns3/string.h>
 
 namespace ns3 {
 
@@ -53,6 +49,8 @@ Type1FuzzyHandoverAlgorithm::Type1FuzzyHandoverAlgorithm ()
     m_a4MeasId (0),
     m_servingCellThreshold (30),
     m_neighbourCellOffset (1),
+    m_useLookupTable (false),
+    m_measurementHistory (FuzzyHandoverController::PREDICTION_WINDOW),
     m_handoverManagementSapUser (0)
 {
   NS_LOG_FUNCTION (this);
@@ -62,10 +60,6 @@ Type1FuzzyHandoverAlgorithm::Type1FuzzyHandoverAlgorithm ()
 
 Type1FuzzyHandoverAlgorithm::~Type1FuzzyHandoverAlgorithm ()
 {
-  // Clean up
-  Py_DECREF(pName);
-  Py_Finalize();
-  
   NS_LOG_FUNCTION (this);
 }
 
@@ -92,6 +86,27 @@ Type1FuzzyHandoverAlgorithm::GetTypeId ()
                    UintegerValue (1),
                    MakeUintegerAccessor (&Type1FuzzyHandoverAlgorithm::m_neighbourCellOffset),
                    MakeUintegerChecker<uint8_t> ())
+    .AddAttribute ("NeighbourCellTimeout",
+                   "Neighbour cells which have not been reported by Event A4 "
+                   "within this time are not considered for handover.",
+                   TimeValue (MilliSeconds (240)),
+                   MakeTimeAccessor (&Type1FuzzyHandoverAlgorithm::m_neighbourCellTimeout),
+                   MakeTimeChecker ())
+    .AddAttribute ("UseLookupTable",
+                   "If true, the fuzzy inference systems are evaluated once "
+                   "over a grid of their inputs at initialization, and each "
+                   "decision is interpolated from these tables.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&Type1FuzzyHandoverAlgorithm::m_useLookupTable),
+                   MakeBooleanChecker ())
+    .AddAttribute ("LookupTableFile",
+                   "File from which the lookup tables are loaded if it holds "
+                   "them, and to which they are saved otherwise. Only used "
+                   "if UseLookupTable is true. An empty string disables "
+                   "loading and saving.",
+                   StringValue (""),
+                   MakeStringAccessor (&Type1FuzzyHandoverAlgorithm::m_lookupTableFile),
+                   MakeStringChecker ())
   ;
   return tid;
 }
@@ -138,21 +153,11 @@ Type1FuzzyHandoverAlgorithm::DoInitialize ()
   reportConfigA4.reportInterval = LteRrcSap::ReportConfigEutra::MS120;
   m_a4MeasId = m_handoverManagementSapUser->AddUeMeasReportConfigForHandover (reportConfigA4);
 
-  setenv("PYTHONPATH", "/mnt/data/Ph.D./ns-3/ns-3-dev/src/lte/model/fuzzy/", 1);
-
-  Py_Initialize();
-
-  pName = PyUnicode_FromString("type1fuzzy");
-  pModule = PyImport_Import(pName);
-  pDict = PyModule_GetDict(pModule);
-
-  // Build the name of a callable class 
-  pClass = PyDict_GetItemString(pDict, "FuzzyHandover");
-
-  // Create an instance of the class
-  if (PyCallable_Check(pClass)) {
-      pInstance = PyObject_CallObject(pClass, NULL);
-  }
+  m_controller = Create<Type1FuzzyHandoverController> ();
+  if (m_useLookupTable)
+    {
+      m_controller = TabulatedFuzzyHandoverController::Tabulate (m_controller, m_lookupTableFile);
+    }
 
   LteHandoverAlgorithm::DoInitialize ();
 }
@@ -162,10 +167,8 @@ void
 Type1FuzzyHandoverAlgorithm::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
-  // Clean up
-  Py_DECREF(pName);
-  Py_Finalize();
-
+  m_controller = 0;
+  m_measurementHistory.Clear ();
   delete m_handoverManagementSapProvider;
 }
 
@@ -178,28 +181,30 @@ Type1FuzzyHandoverAlgorithm::DoReportUeMeas  (uint16_t rnti,
 
   if (measResults.measId == m_a2MeasId)
     {
-      uint16_t bestNeighbourCellId = _PyLong_AsInt ( PyObject_CallMethod ( pInstance, "EvaluateHandover", "(diii)", 
-                                                                          Simulator::Now ().GetSeconds(), 
-                                                                          rnti, 
-                                                                          measResults.rsrpResult, 
-                                                                          measResults.rsrqResult )); 
+      const MeasurementRingBuffer &servingCellRsrq =
+        m_measurementHistory.AddServingCellMeasurement (rnti, measResults.rsrqResult);
+
+      PurgeNeighbourCells (rnti);
+      uint16_t bestNeighbourCellId =
+        m_controller->EvaluateHandover (servingCellRsrq,
+                                        m_measurementHistory.GetNeighbourCells (rnti));
 
       // Trigger Handover, if needed
       if (bestNeighbourCellId > 0)
         {
           NS_LOG_LOGIC ("Best neighbour cellId " << bestNeighbourCellId);
 
-          NS_LOG_LOGIC ("Trigger Handover to cellId " << bestNeighbourCellId);;
+          NS_LOG_LOGIC ("Trigger Handover to cellId " << bestNeighbourCellId);
 
           // Inform eNodeB RRC about handover
-          m_handoverManagementSapUser->TriggerHandover (rnti, bestNeighbourCellId);            
+          m_handoverManagementSapUser->TriggerHandover (rnti, bestNeighbourCellId);
         }
     }
   else if (measResults.measId == m_a4MeasId)
     {
       if (measResults.haveMeasResultNeighCells
           && !measResults.measResultListEutra.empty ())
-        {          
+        {
           for (std::list <LteRrcSap::MeasResultEutra>::iterator it = measResults.measResultListEutra.begin ();
                it != measResults.measResultListEutra.end ();
                ++it)
@@ -209,13 +214,9 @@ Type1FuzzyHandoverAlgorithm::DoReportUeMeas  (uint16_t rnti,
               NS_ASSERT_MSG (it->haveRsrqResult == true,
                              "RSRQ measurement is missing from cellId " << it->physCellId);
 
-              PyObject_CallMethod ( pInstance, "UpdateNeighbourMeasurements", "(diiii)", 
-                                    Simulator::Now ().GetSeconds(), 
-                                    rnti, 
-                                    it->physCellId, 
-                                    it->rsrpResult, 
-                                    it->rsrqResult);         
-            }          
+              m_measurementHistory.AddNeighbourCellMeasurement (rnti, it->physCellId,
+                                                                it->rsrqResult);
+            }
         }
       else
         {
@@ -229,4 +230,39 @@ Type1FuzzyHandoverAlgorithm::DoReportUeMeas  (uint16_t rnti,
 
 } // end of DoReportUeMeas
 
+
+void
+Type1FuzzyHandoverAlgorithm::DoRemoveUe (uint16_t rnti)
+{
+  NS_LOG_FUNCTION (this << rnti);
+  m_measurementHistory.RemoveUe (rnti);
+}
+
+
+void
+Type1FuzzyHandoverAlgorithm::PurgeNeighbourCells (uint16_t rnti)
+{
+  NS_LOG_FUNCTION (this << rnti);
+
+  m_measurementHistory.PurgeNeighbourCells (rnti, m_neighbourCellTimeout);
+
+  // a neighbour cell last reported with the lowest RSRQ is not a candidate
+  std::vector<uint16_t> lost;
+  const HandoverMeasurementHistory::NeighbourCellMap &neighbourCells =
+    m_measurementHistory.GetNeighbourCells (rnti);
+  for (HandoverMeasurementHistory::NeighbourCellMap::const_iterator it = neighbourCells.begin ();
+       it != neighbourCells.end (); ++it)
+    {
+      if (it->second.measurements.GetLast () == 0)
+        {
+          lost.push_back (it->first);
+        }
+    }
+  for (std::vector<uint16_t>::const_iterator it = lost.begin (); it != lost.end (); ++it)
+    {
+      NS_LOG_LOGIC ("discarding neighbour cellId " << *it);
+      m_measurementHistory.RemoveNeighbourCell (rnti, *it);
+    }
+}
+
 } // end of namespace ns3
@@ -31,43 +31,30 @@
 #include <ns3/lte-handover-algorithm.h>
 #include <ns3/lte-handover-management-sap.h>
 #include <ns3/lte-rrc-sap.h>
-#include <ns3/simple-ref-count.h>
+#include <ns3/fuzzy-handover-controller.h>
+#include <ns3/handover-measurement-history.h>
+#include <ns3/nstime.h>
 #include <ns3/ptr.h>
-#include <map>
-
-#include <queue>
-#include <deque>
-
-#ifdef _DEBUG
-    #undef _DEBUG
-    #include <python.h>
-    #define _DEBUG
-#else
-    #include <Python.h>    
-#endif
+#include <string>
 
 namespace ns3 {
 
 
 /**
  * \brief Handover algorithm implementation based on RSRQ measurements, Event
- *        A2 and Event A4.
- *
- * Handover decision made by this algorithm is primarily based on Event A2
- * measurements (serving cell's RSRQ becomes worse than threshold). When the
- * event is triggered, the first condition of handover is fulfilled.
+ *        A2, Event A4 and type 1 fuzzy inference systems (see Type1FuzzyHandoverController).
  *
  * Event A4 measurements (neighbour cell's RSRQ becomes better than threshold)
- * are used to detect neighbouring cells and their respective RSRQ. When a
- * neighbouring cell's RSRQ is higher than the serving cell's RSRQ by a certain
- * offset, then the second condition of handover is fulfilled.
- *
- * When the first and second conditions above are fulfilled, the algorithm
- * informs the eNodeB RRC to trigger a handover.
+ * are used to detect neighbouring cells and to keep the history of their
+ * RSRQ. Every Event A2 measurement (serving cell's RSRQ becomes worse than
+ * threshold) is added to the history of the serving cell RSRQ and triggers a
+ * handover decision: the radio link quality of the serving cell and of every
+ * neighbour cell reported within `NeighbourCellTimeout` is estimated from
+ * its predicted RSRQ, and the best neighbour cell is selected as target if
+ * the inferred handover trigger is high enough.
  *
  * The threshold for Event A2 can be configured in the `ServingCellThreshold`
- * attribute. The offset used in the second condition can also be configured by
- * setting the `NeighbourCellOffset` attribute.
+ * attribute.
  *
  * The following code snippet is an example of using and configuring the
  * handover algorithm in a simulation program:
@@ -77,11 +64,9 @@ namespace ns3 {
  *     NodeContainer enbNodes;
  *     // configure the nodes here...
  *
- *     lteHelper->SetHandoverAlgorithmType ("ns3::A2A4RsrqHandoverAlgorithm");
+ *     lteHelper->SetHandoverAlgorithmType ("ns3::Type1FuzzyHandoverAlgorithm");
  *     lteHelper->SetHandoverAlgorithmAttribute ("ServingCellThreshold",
- *                                               UintegerValue (30));
- *     lteHelper->SetHandoverAlgorithmAttribute ("NeighbourCellOffset",
- *                                               UintegerValue (1));
+ *                                               UintegerValue (34));
  *     NetDeviceContainer enbLteDevs = lteHelper->InstallEnbDevice (enbNodes);
  *
  * \note Setting the handover algorithm type and attributes after the call to
@@ -116,6 +101,7 @@ protected:
 
   // inherited from LteHandoverAlgorithm as a Handover Management SAP implementation
   void DoReportUeMeas (uint16_t rnti, LteRrcSap::MeasResults measResults);
+  void DoRemoveUe (uint16_t rnti);
 
 private:
   /// The expected measurement identity for A2 measurements.
@@ -123,8 +109,6 @@ private:
   /// The expected measurement identity for A4 measurements.
   uint8_t m_a4MeasId;
 
-  // todo
-  PyObject* pName, * pModule, * pDict, * pClass, * pInstance;
 
   /**
    * The `ServingCellThreshold` attribute. If the RSRQ of the serving cell is
@@ -141,15 +125,47 @@ private:
    */
   uint8_t m_neighbourCellOffset;
 
+  /**
+   * The `NeighbourCellTimeout` attribute. Neighbour cells which have not been
+   * reported by Event A4 within this time are not considered for handover
+   * and their RSRQ history is discarded.
+   */
+  Time m_neighbourCellTimeout;
+
+  /**
+   * The `UseLookupTable` attribute. Whether the decisions are interpolated
+   * from tables of the fuzzy inference systems.
+   */
+  bool m_useLookupTable;
+
+  /**
+   * The `LookupTableFile` attribute. File holding the lookup tables shared
+   * between runs.
+   */
+  std::string m_lookupTableFile;
+
+  /// The fuzzy handover decision logic.
+  Ptr<FuzzyHandoverController> m_controller;
+
+  /**
+   * \brief Discard the neighbour cells which are not valid handover targets
+   *        anymore.
+   * \param rnti the UE whose neighbour cells are checked
+   */
+  void PurgeNeighbourCells (uint16_t rnti);
+
+  /// Last RSRQ reports of the serving and neighbour cells of each UE.
+  HandoverMeasurementHistory m_measurementHistory;
+
   /// Interface to the eNodeB RRC instance.
   LteHandoverManagementSapUser* m_handoverManagementSapUser;
   /// Receive API calls from the eNodeB RRC instance.
   LteHandoverManagementSapProvider* m_handoverManagementSapProvider;
 
-}; // end of class A2A4RsrqHandoverAlgorithm
+}; // end of class Type1FuzzyHandoverAlgorithm
 
 
 } // end of namespace ns3
 
 
-#endif /* A2_A4_RSRQ_HANDOVER_ALGORITHM_H */
+#endif /* TYPE_1_FUZZY_HANDOVER_ALGORITHM_H */
@@ -0,0 +1,279 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Amiraslan Haghrah
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Amiraslan Haghrah <amiraslanhaghrah@gmail.com>
+ */
+
+#include "handover-measurement-history.h"
+#include <ns3/log.h>
+#include <ns3/assert.h>
+#include <ns3/simulator.h>
+
+#include <algorithm>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("HandoverMeasurementHistory");
+
+
+///////////////////////////////////////////
+// MeasurementRingBuffer
+///////////////////////////////////////////
+
+
+MeasurementRingBuffer::MeasurementRingBuffer (uint32_t capacity)
+  : m_values (capacity),
+    m_first (0),
+    m_size (0)
+{
+  NS_ASSERT_MSG (capacity > 0, "a measurement history needs a capacity");
+}
+
+void
+MeasurementRingBuffer::Push (double value)
+{
+  uint32_t capacity = m_values.size ();
+  if (m_size < capacity)
+    {
+      m_values[(m_first + m_size) % capacity] = value;
+      ++m_size;
+    }
+  else
+    {
+      m_values[m_first] = value;
+      m_first = (m_first + 1) % capacity;
+    }
+}
+
+void
+MeasurementRingBuffer::Clear ()
+{
+  m_first = 0;
+  m_size = 0;
+}
+
+uint32_t
+MeasurementRingBuffer::GetCapacity () const
+{
+  return m_values.size ();
+}
+
+uint32_t
+MeasurementRingBuffer::GetSize () const
+{
+  return m_size;
+}
+
+bool
+MeasurementRingBuffer::IsEmpty () const
+{
+  return m_size == 0;
+}
+
+double
+MeasurementRingBuffer::Get (uint32_t i) const
+{
+  NS_ASSERT_MSG (i < m_size, "index " << i << " out of " << m_size << " measurements");
+  return m_values[(m_first + i) % m_values.size ()];
+}
+
+double
+MeasurementRingBuffer::GetLast () const
+{
+  NS_ASSERT_MSG (m_size > 0, "no measurement");
+  return Get (m_size - 1);
+}
+
+double
+MeasurementRingBuffer::GetDelta (uint32_t n) const
+{
+  NS_ASSERT_MSG (m_size > 0, "no measurement");
+  n = std::min (n, m_size - 1);
+  return GetLast () - Get (m_size - 1 - n);
+}
+
+double
+MeasurementRingBuffer::GetTrend (uint32_t n) const
+{
+  n = std::min (n, m_size);
+  if (n < 2)
+    {
+      return 0.0;
+    }
+  // least squares slope over t = 0 .. n-1, centred on the mean time
+  double tMean = (n - 1) / 2.0;
+  double yMean = 0.0;
+  for (uint32_t k = 0; k < n; ++k)
+    {
+      yMean += Get (m_size - n + k);
+    }
+  yMean /= n;
+  double sty = 0.0;
+  double stt = 0.0;
+  for (uint32_t k = 0; k < n; ++k)
+    {
+      double t = k - tMean;
+      sty += t * (Get (m_size - n + k) - yMean);
+      stt += t * t;
+    }
+  return sty / stt;
+}
+
+
+///////////////////////////////////////////
+// HandoverMeasurementHistory
+///////////////////////////////////////////
+
+
+HandoverMeasurementHistory::NeighbourCell::NeighbourCell (uint32_t capacity)
+  : measurements (capacity)
+{
+}
+
+HandoverMeasurementHistory::Ue::Ue (uint32_t capacity)
+  : servingCell (capacity)
+{
+}
+
+HandoverMeasurementHistory::HandoverMeasurementHistory (uint32_t capacity)
+  : m_capacity (capacity),
+    m_noServingCell (capacity)
+{
+  NS_LOG_FUNCTION (this << capacity);
+}
+
+void
+HandoverMeasurementHistory::SetCapacity (uint32_t capacity)
+{
+  NS_LOG_FUNCTION (this << capacity);
+  m_capacity = capacity;
+  m_ues.clear ();
+  m_noServingCell = MeasurementRingBuffer (capacity);
+}
+
+uint32_t
+HandoverMeasurementHistory::GetCapacity () const
+{
+  return m_capacity;
+}
+
+HandoverMeasurementHistory::Ue &
+HandoverMeasurementHistory::GetUe (uint16_t rnti)
+{
+  std::map<uint16_t, Ue>::iterator it = m_ues.find (rnti);
+  if (it == m_ues.end ())
+    {
+      NS_LOG_LOGIC ("new UE " << rnti);
+      it = m_ues.insert (std::make_pair (rnti, Ue (m_capacity))).first;
+    }
+  return it->second;
+}
+
+const MeasurementRingBuffer &
+HandoverMeasurementHistory::AddServingCellMeasurement (uint16_t rnti, double value)
+{
+  NS_LOG_FUNCTION (this << rnti << value);
+  Ue &ue = GetUe (rnti);
+  ue.servingCell.Push (value);
+  return ue.servingCell;
+}
+
+void
+HandoverMeasurementHistory::AddNeighbourCellMeasurement (uint16_t rnti, uint16_t cellId, double value)
+{
+  NS_LOG_FUNCTION (this << rnti << cellId << value);
+  NeighbourCellMap &neighbourCells = GetUe (rnti).neighbourCells;
+  NeighbourCellMap::iterator it = neighbourCells.find (cellId);
+  if (it == neighbourCells.end ())
+    {
+      it = neighbourCells.insert (std::make_pair (cellId, NeighbourCell (m_capacity))).first;
+    }
+  it->second.measurements.Push (value);
+  it->second.lastReport = Simulator::Now ();
+}
+
+const MeasurementRingBuffer &
+HandoverMeasurementHistory::GetServingCell (uint16_t rnti) const
+{
+  std::map<uint16_t, Ue>::const_iterator it = m_ues.find (rnti);
+  return (it == m_ues.end ()) ? m_noServingCell : it->second.servingCell;
+}
+
+const HandoverMeasurementHistory::NeighbourCellMap &
+HandoverMeasurementHistory::GetNeighbourCells (uint16_t rnti) const
+{
+  std::map<uint16_t, Ue>::const_iterator it = m_ues.find (rnti);
+  return (it == m_ues.end ()) ? m_noNeighbourCells : it->second.neighbourCells;
+}
+
+void
+HandoverMeasurementHistory::RemoveNeighbourCell (uint16_t rnti, uint16_t cellId)
+{
+  NS_LOG_FUNCTION (this << rnti << cellId);
+  std::map<uint16_t, Ue>::iterator it = m_ues.find (rnti);
+  if (it != m_ues.end ())
+    {
+      it->second.neighbourCells.erase (cellId);
+    }
+}
+
+void
+HandoverMeasurementHistory::PurgeNeighbourCells (uint16_t rnti, Time timeout)
+{
+  NS_LOG_FUNCTION (this << rnti << timeout);
+  std::map<uint16_t, Ue>::iterator ue = m_ues.find (rnti);
+  if (ue == m_ues.end ())
+    {
+      return;
+    }
+  NeighbourCellMap &neighbourCells = ue->second.neighbourCells;
+  NeighbourCellMap::iterator it = neighbourCells.begin ();
+  while (it != neighbourCells.end ())
+    {
+      if (Simulator::Now () - it->second.lastReport > timeout)
+        {
+          NS_LOG_LOGIC ("discarding neighbour cellId " << it->first);
+          neighbourCells.erase (it++);
+        }
+      else
+        {
+          ++it;
+        }
+    }
+}
+
+void
+HandoverMeasurementHistory::RemoveUe (uint16_t rnti)
+{
+  NS_LOG_FUNCTION (this << rnti);
+  m_ues.erase (rnti);
+}
+
+void
+HandoverMeasurementHistory::Clear ()
+{
+  NS_LOG_FUNCTION (this);
+  m_ues.clear ();
+}
+
+uint32_t
+HandoverMeasurementHistory::GetNUes () const
+{
+  return m_ues.size ();
+}
+
+} // namespace ns3
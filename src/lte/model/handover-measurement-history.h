@@ -0,0 +1,219 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Amiraslan Haghrah
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Amiraslan Haghrah <amiraslanhaghrah@gmail.com>
+ */
+
+#ifndef HANDOVER_MEASUREMENT_HISTORY_H
+#define HANDOVER_MEASUREMENT_HISTORY_H
+
+#include <ns3/nstime.h>
+
+#include <stdint.h>
+#include <map>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup lte
+ * \brief Fixed-capacity history of the measurements of one cell.
+ *
+ * Once the buffer is full, each new measurement overwrites the oldest one,
+ * so the memory used does not grow with the number of reports.
+ */
+class MeasurementRingBuffer
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param capacity the maximum number of measurements kept, at least 1
+   */
+  MeasurementRingBuffer (uint32_t capacity = 1);
+
+  /**
+   * \brief Append a measurement, discarding the oldest one if the buffer is
+   *        full.
+   * \param value the measurement
+   */
+  void Push (double value);
+
+  /// Discard all the measurements.
+  void Clear ();
+
+  /// \return the maximum number of measurements kept
+  uint32_t GetCapacity () const;
+  /// \return the number of measurements kept
+  uint32_t GetSize () const;
+  /// \return true if no measurement is kept
+  bool IsEmpty () const;
+
+  /**
+   * \param i the index of the measurement, 0 being the oldest one kept
+   * \return the measurement
+   */
+  double Get (uint32_t i) const;
+  /// \return the most recent measurement
+  double GetLast () const;
+
+  /**
+   * \param n the number of samples between the two measurements compared
+   * \return the most recent measurement minus the one n samples before it,
+   *         or the oldest one kept if there are fewer samples, or zero if
+   *         there is only one measurement
+   */
+  double GetDelta (uint32_t n) const;
+  /**
+   * \param n the number of most recent measurements considered
+   * \return the slope, per sample, of the least squares line fitted to the
+   *         last n measurements (all of them if there are fewer), or zero if
+   *         there are fewer than 2 measurements
+   */
+  double GetTrend (uint32_t n) const;
+
+private:
+  std::vector<double> m_values; ///< storage
+  uint32_t m_first;             ///< index in m_values of the oldest measurement
+  uint32_t m_size;              ///< number of measurements kept
+};
+
+
+/**
+ * \ingroup lte
+ * \brief Measurement history of the UEs of a cell, for handover algorithms.
+ *
+ * For each UE (RNTI), the history keeps the last measurements of the serving
+ * cell and of every reported neighbour cell in ring buffers of the same
+ * capacity, along with the time of the last report of each neighbour cell.
+ *
+ * Entries are added as measurement reports arrive. The handover algorithm
+ * removes the whole history of a UE when the UE leaves the cell (see
+ * LteHandoverManagementSapProvider::RemoveUe), and may discard neighbour
+ * cells which are no longer reported.
+ */
+class HandoverMeasurementHistory
+{
+public:
+  /// History of a neighbour cell
+  struct NeighbourCell
+  {
+    /**
+     * Constructor
+     *
+     * \param capacity the maximum number of measurements kept
+     */
+    NeighbourCell (uint32_t capacity);
+
+    MeasurementRingBuffer measurements; ///< the last measurements
+    Time lastReport; ///< time of the last measurement
+  };
+  /// Histories of the neighbour cells of a UE, indexed by cell ID
+  typedef std::map<uint16_t, NeighbourCell> NeighbourCellMap;
+
+  /**
+   * Constructor
+   *
+   * \param capacity the maximum number of measurements kept per cell
+   */
+  HandoverMeasurementHistory (uint32_t capacity = 1);
+
+  /**
+   * \brief Change the capacity of the ring buffers, discarding the history.
+   * \param capacity the maximum number of measurements kept per cell
+   */
+  void SetCapacity (uint32_t capacity);
+  /// \return the maximum number of measurements kept per cell
+  uint32_t GetCapacity () const;
+
+  /**
+   * \param rnti the UE
+   * \param value the measurement of the serving cell
+   * \return the serving cell history of the UE
+   */
+  const MeasurementRingBuffer & AddServingCellMeasurement (uint16_t rnti, double value);
+  /**
+   * \param rnti the UE
+   * \param cellId the neighbour cell
+   * \param value the measurement of the neighbour cell
+   */
+  void AddNeighbourCellMeasurement (uint16_t rnti, uint16_t cellId, double value);
+
+  /**
+   * \param rnti the UE
+   * \return the serving cell history of the UE, empty if unknown
+   */
+  const MeasurementRingBuffer & GetServingCell (uint16_t rnti) const;
+  /**
+   * \param rnti the UE
+   * \return the neighbour cell histories of the UE, empty if unknown
+   */
+  const NeighbourCellMap & GetNeighbourCells (uint16_t rnti) const;
+
+  /**
+   * \param rnti the UE
+   * \param cellId the neighbour cell to forget
+   */
+  void RemoveNeighbourCell (uint16_t rnti, uint16_t cellId);
+  /**
+   * \brief Forget the neighbour cells not reported for a while.
+   * \param rnti the UE
+   * \param timeout the neighbour cells whose last report is older than this
+   *        are removed
+   */
+  void PurgeNeighbourCells (uint16_t rnti, Time timeout);
+
+  /**
+   * \brief Forget a UE which left the cell.
+   * \param rnti the UE
+   */
+  void RemoveUe (uint16_t rnti);
+  /// Forget all UEs.
+  void Clear ();
+  /// \return the number of UEs with a history
+  uint32_t GetNUes () const;
+
+private:
+  /// History of a UE
+  struct Ue
+  {
+    /**
+     * Constructor
+     *
+     * \param capacity the maximum number of measurements kept per cell
+     */
+    Ue (uint32_t capacity);
+
+    MeasurementRingBuffer servingCell; ///< serving cell history
+    NeighbourCellMap neighbourCells;   ///< neighbour cell histories
+  };
+
+  /**
+   * \param rnti the UE
+   * \return the history of the UE, created if needed
+   */
+  Ue & GetUe (uint16_t rnti);
+
+  uint32_t m_capacity;            ///< capacity of the ring buffers
+  std::map<uint16_t, Ue> m_ues;   ///< histories, indexed by RNTI
+  MeasurementRingBuffer m_noServingCell; ///< returned for unknown UEs
+  NeighbourCellMap m_noNeighbourCells;   ///< returned for unknown UEs
+};
+
+} // namespace ns3
+
+#endif /* HANDOVER_MEASUREMENT_HISTORY_H */
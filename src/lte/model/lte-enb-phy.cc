@@ -254,6 +254,7 @@ void
 LteEnbPhy::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
+  m_endSubFrameEvent.Cancel ();
   m_ueAttached.clear ();
   m_srsUeOffset.clear ();
   delete m_enbPhySapProvider;
@@ -767,10 +768,14 @@ LteEnbPhy::StartSubFrame (void)
   // trigger the MAC
   m_enbPhySapUser->SubframeIndication (m_nrFrames, m_nrSubFrames);
 
-  Simulator::Schedule (Seconds (GetTti ()),
-                       &LteEnbPhy::EndSubFrame,
-                       this);
-
+  if (!m_endSubFrameEvent.IsRunning ())
+    {
+      // one scheduler event per TTI ends the subframes of all the eNBs
+      m_endSubFrameEvent = PeriodicEventGroup::Schedule (Seconds (GetTti ()),
+                                                         Seconds (GetTti ()),
+                                                         Simulator::GetContext (),
+                                                         MakeCallback (&LteEnbPhy::EndSubFrame, this));
+    }
 }
 
 void
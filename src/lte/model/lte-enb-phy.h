@@ -28,6 +28,7 @@
 #include <ns3/lte-enb-cphy-sap.h>
 #include <ns3/lte-phy.h>
 #include <ns3/lte-harq-phy.h>
+#include <ns3/periodic-event-group.h>
 
 #include <map>
 #include <set>
@@ -462,6 +463,11 @@ private:
    * The number resets to the beginning again after 10 subframes.
    */
   uint32_t m_nrSubFrames;
+  /**
+   * Ends the subframes every TTI, in a PeriodicEventGroup shared with the
+   * other eNBs and the UEs.
+   */
+  PeriodicEventId m_endSubFrameEvent;
 
   uint16_t m_srsPeriodicity; ///< SRS periodicity
   Time m_srsStartTime; ///< SRS start time
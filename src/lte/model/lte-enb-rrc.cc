@@ -2843,6 +2843,10 @@ LteEnbRrc::RemoveUe (uint16_t rnti)
       m_s1SapProvider->UeContextRelease (rnti);
     }
   m_ccmRrcSapProvider-> RemoveUe (rnti);
+  if (m_handoverManagementSapProvider != 0)
+    {
+      m_handoverManagementSapProvider->RemoveUe (rnti);
+    }
   // need to do this after UeManager has been deleted
   if (srsCi != 0)
     {
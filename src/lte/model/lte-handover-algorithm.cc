@@ -56,5 +56,12 @@ LteHandoverAlgorithm::DoDispose ()
 }
 
 
+void
+LteHandoverAlgorithm::DoRemoveUe (uint16_t rnti)
+{
+  NS_LOG_FUNCTION (this << rnti);
+}
+
+
 
 } // end of namespace ns3
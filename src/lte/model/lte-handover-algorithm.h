@@ -105,6 +105,15 @@ protected:
    */
   virtual void DoReportUeMeas (uint16_t rnti, LteRrcSap::MeasResults measResults) = 0;
 
+  /**
+   * \brief Implementation of LteHandoverManagementSapProvider::RemoveUe.
+   * \param rnti Radio Network Temporary Identity, an integer identifying the UE
+   *
+   * The default implementation does nothing; algorithms keeping per-UE state
+   * override it to discard that state.
+   */
+  virtual void DoRemoveUe (uint16_t rnti);
+
 }; // end of class LteHandoverAlgorithm
 
 
@@ -54,6 +54,17 @@ public:
   virtual void ReportUeMeas (uint16_t rnti,
                              LteRrcSap::MeasResults measResults) = 0;
 
+  /**
+   * \brief Inform the handover algorithm that a UE left the cell.
+   * \param rnti Radio Network Temporary Identity, an integer identifying the UE
+   *
+   * Called by the eNodeB RRC entity when the UE context is removed, either
+   * because the UE moved to another cell or because its connection was
+   * released. Any state kept for this UE may be discarded, since the RNTI may
+   * later be given to another UE.
+   */
+  virtual void RemoveUe (uint16_t rnti) = 0;
+
 }; // end of class LteHandoverManagementSapProvider
 
 
@@ -124,6 +135,7 @@ public:
 
   // inherited from LteHandoverManagemenrSapProvider
   virtual void ReportUeMeas (uint16_t rnti, LteRrcSap::MeasResults measResults);
+  virtual void RemoveUe (uint16_t rnti);
 
 private:
   MemberLteHandoverManagementSapProvider ();
@@ -147,6 +159,14 @@ MemberLteHandoverManagementSapProvider<C>::ReportUeMeas (uint16_t rnti, LteRrcSa
 }
 
 
+template <class C>
+void
+MemberLteHandoverManagementSapProvider<C>::RemoveUe (uint16_t rnti)
+{
+  m_owner->DoRemoveUe (rnti);
+}
+
+
 
 /**
  * \brief Template for the implementation of the LteHandoverManagementSapUser
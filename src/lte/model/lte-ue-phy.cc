@@ -167,6 +167,8 @@ LteUePhy::LteUePhy (Ptr<LteSpectrumPhy> dlPhy, Ptr<LteSpectrumPhy> ulPhy)
     m_ueMeasurementsFilterPeriod (MilliSeconds (200)),
     m_ueMeasurementsFilterLast (MilliSeconds (0)),
     m_rsrpSinrSampleCounter (0),
+    m_nextFrameNo (1),
+    m_nextSubframeNo (1),
     m_imsi (0)
 {
   m_amc = CreateObject <LteAmc> ();
@@ -192,6 +194,7 @@ void
 LteUePhy::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
+  m_subframeEvent.Cancel ();
   delete m_uePhySapProvider;
   delete m_ueCphySapProvider;
   LtePhy::DoDispose ();
@@ -1331,7 +1334,22 @@ LteUePhy::SubframeIndication (uint32_t frameNo, uint32_t subframeNo)
     }
 
   // schedule next subframe indication
-  Simulator::Schedule (Seconds (GetTti ()), &LteUePhy::SubframeIndication, this, frameNo, subframeNo);
+  m_nextFrameNo = frameNo;
+  m_nextSubframeNo = subframeNo;
+  if (!m_subframeEvent.IsRunning ())
+    {
+      // one scheduler event per TTI triggers the subframes of all the UEs
+      m_subframeEvent = PeriodicEventGroup::Schedule (Seconds (GetTti ()),
+                                                      Seconds (GetTti ()),
+                                                      Simulator::GetContext (),
+                                                      MakeCallback (&LteUePhy::NextSubframeIndication, this));
+    }
+}
+
+void
+LteUePhy::NextSubframeIndication (void)
+{
+  SubframeIndication (m_nextFrameNo, m_nextSubframeNo);
 }
 
 
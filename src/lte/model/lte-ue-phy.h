@@ -37,6 +37,7 @@
 #include <ns3/lte-amc.h>
 #include <set>
 #include <ns3/lte-ue-power-control.h>
+#include <ns3/periodic-event-group.h>
 
 
 namespace ns3 {
@@ -271,6 +272,10 @@ public:
    * \param subframeNo subframe number
    */
   void SubframeIndication (uint32_t frameNo, uint32_t subframeNo);
+  /**
+   * \brief Trigger the next subframe, every TTI
+   */
+  void NextSubframeIndication (void);
 
 
   /**
@@ -790,6 +795,13 @@ private:
   TracedCallback<uint16_t, uint16_t, double, double, bool, uint8_t> m_reportUeMeasurements;
 
   EventId m_sendSrsEvent; ///< send SRS event
+  /**
+   * Triggers the subframes every TTI, in a PeriodicEventGroup shared with
+   * the other UEs and the eNBs.
+   */
+  PeriodicEventId m_subframeEvent;
+  uint32_t m_nextFrameNo; ///< frame number of the next subframe indication
+  uint32_t m_nextSubframeNo; ///< subframe number of the next subframe indication
 
   /**
    * The `UlPhyTransmission` trace source. Contains trace information regarding
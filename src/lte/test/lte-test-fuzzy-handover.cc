@@ -0,0 +1,416 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Amiraslan Haghrah
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Amiraslan Haghrah <amiraslanhaghrah@gmail.com>
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/ptr.h"
+
+#include "ns3/fuzzy-inference-system.h"
+#include "ns3/fuzzy-handover-controller.h"
+#include "ns3/fuzzy-decision-surface.h"
+
+#include <cmath>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestFuzzyHandover");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test the membership functions and the type reduction /
+ * defuzzification primitives of the fuzzy inference systems.
+ */
+class LteFuzzyInferenceTestCase : public TestCase
+{
+public:
+  LteFuzzyInferenceTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LteFuzzyInferenceTestCase::LteFuzzyInferenceTestCase ()
+  : TestCase ("Fuzzy inference primitives")
+{
+}
+
+void
+LteFuzzyInferenceTestCase::DoRun (void)
+{
+  GaussianMembershipFunction sym (GaussianMembershipFunction::SYMMETRIC, 23.0, 1.5);
+  NS_TEST_ASSERT_MSG_EQ_TOL (sym.Evaluate (23.0), 1.0, 1e-12, "wrong value at the mean");
+  NS_TEST_ASSERT_MSG_EQ_TOL (sym.Evaluate (24.5), std::exp (-0.5), 1e-12, "wrong value at one std");
+  NS_TEST_ASSERT_MSG_EQ_TOL (sym.Evaluate (21.5), std::exp (-0.5), 1e-12, "wrong value at one std");
+
+  GaussianMembershipFunction left (GaussianMembershipFunction::LEFT_FLAT, 20.0, 1.5);
+  NS_TEST_ASSERT_MSG_EQ_TOL (left.Evaluate (0.0), 1.0, 1e-12, "LEFT_FLAT not flat below the mean");
+  NS_TEST_ASSERT_MSG_EQ_TOL (left.Evaluate (21.5), std::exp (-0.5), 1e-12, "wrong LEFT_FLAT slope");
+
+  GaussianMembershipFunction right (GaussianMembershipFunction::RIGHT_FLAT, 31.0, 1.5);
+  NS_TEST_ASSERT_MSG_EQ_TOL (right.Evaluate (34.0), 1.0, 1e-12, "RIGHT_FLAT not flat above the mean");
+  NS_TEST_ASSERT_MSG_EQ_TOL (right.Evaluate (29.5), std::exp (-0.5), 1e-12, "wrong RIGHT_FLAT slope");
+
+  It2GaussianMembershipFunction it2 (GaussianMembershipFunction::SYMMETRIC, 0.5, 0.1, 0.04);
+  for (double x = 0.0; x <= 1.0; x += 0.05)
+    {
+      NS_TEST_ASSERT_MSG_GT_OR_EQ (it2.EvaluateUpper (x), it2.EvaluateLower (x),
+                                   "upper membership below lower membership at " << x);
+    }
+  NS_TEST_ASSERT_MSG_EQ_TOL (it2.EvaluateUpper (0.62), std::exp (-0.5), 1e-12, "wrong upper std");
+  NS_TEST_ASSERT_MSG_EQ_TOL (it2.EvaluateLower (0.58), std::exp (-0.5), 1e-12, "wrong lower std");
+
+  // without uncertainty the type reduction is the weighted average
+  std::vector<double> x;
+  std::vector<double> w;
+  x.push_back (0.0);
+  x.push_back (1.0);
+  x.push_back (3.0);
+  w.push_back (1.0);
+  w.push_back (2.0);
+  w.push_back (1.0);
+  std::pair<double, double> tr = It2MamdaniFis::KarnikMendel (x, w, w);
+  NS_TEST_ASSERT_MSG_EQ_TOL (tr.first, 1.25, 1e-12, "wrong weighted average");
+  NS_TEST_ASSERT_MSG_EQ_TOL (tr.second, 1.25, 1e-12, "wrong weighted average");
+
+  // two points with weights in [0, 1]: the interval spans the two points
+  std::vector<double> p;
+  std::vector<double> lo;
+  std::vector<double> hi;
+  p.push_back (2.0);
+  p.push_back (1.0);
+  lo.push_back (0.0);
+  lo.push_back (0.0);
+  hi.push_back (1.0);
+  hi.push_back (1.0);
+  tr = It2MamdaniFis::KarnikMendel (p, lo, hi);
+  NS_TEST_ASSERT_MSG_EQ_TOL (tr.first, 1.0, 1e-12, "wrong left end point");
+  NS_TEST_ASSERT_MSG_EQ_TOL (tr.second, 2.0, 1e-12, "wrong right end point");
+
+  // coincident points, whatever the weights
+  std::vector<double> c (3, 0.1);
+  lo.clear ();
+  hi.clear ();
+  lo.push_back (0.3);
+  lo.push_back (0.7);
+  lo.push_back (1e-9);
+  hi.push_back (0.9);
+  hi.push_back (1.0);
+  hi.push_back (0.1);
+  tr = It2MamdaniFis::KarnikMendel (c, lo, hi);
+  NS_TEST_ASSERT_MSG_EQ_TOL (tr.first, 0.1, 1e-12, "wrong left end point");
+  NS_TEST_ASSERT_MSG_EQ_TOL (tr.second, 0.1, 1e-12, "wrong right end point");
+
+  // the centroid of a symmetric set is symmetric around its mean
+  It2MamdaniFis fis;
+  std::vector<double> universe;
+  for (uint32_t i = 0; i <= 100; ++i)
+    {
+      universe.push_back (i / 100.0);
+    }
+  fis.SetOutput (universe);
+  uint32_t in = fis.AddInput ();
+  uint32_t term = fis.AddInputTerm (in, it2);
+  uint32_t out = fis.AddOutputTerm (it2);
+  fis.AddRule (std::vector<uint32_t> (1, term), out);
+  tr = fis.EvaluateInterval (std::vector<double> (1, 0.5));
+  NS_TEST_ASSERT_MSG_LT (tr.first, 0.5, "degenerate centroid interval");
+  NS_TEST_ASSERT_MSG_EQ_TOL (tr.first + tr.second, 1.0, 1e-9, "centroid interval not symmetric");
+  NS_TEST_ASSERT_MSG_EQ_TOL (fis.Evaluate (std::vector<double> (1, 0.3)), 0.5, 1e-9, "wrong crisp output");
+
+  // centroid of piecewise linear membership functions
+  std::vector<double> cx;
+  std::vector<double> cy;
+  cx.push_back (0.0);
+  cx.push_back (1.0);
+  cx.push_back (2.0);
+  cy.push_back (1.0);
+  cy.push_back (1.0);
+  cy.push_back (1.0);
+  NS_TEST_ASSERT_MSG_EQ_TOL (Type1MamdaniFis::Centroid (cx, cy), 1.0, 1e-12, "wrong rectangle centroid");
+  cy.at (0) = 0.0;
+  cy.at (1) = 0.5;
+  NS_TEST_ASSERT_MSG_EQ_TOL (Type1MamdaniFis::Centroid (cx, cy), 4.0 / 3.0, 1e-12, "wrong triangle centroid");
+}
+
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test the RSRQ prediction of the fuzzy handover controllers.
+ */
+class LteFuzzyHandoverPredictionTestCase : public TestCase
+{
+public:
+  LteFuzzyHandoverPredictionTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LteFuzzyHandoverPredictionTestCase::LteFuzzyHandoverPredictionTestCase ()
+  : TestCase ("Fuzzy handover RSRQ prediction")
+{
+}
+
+void
+LteFuzzyHandoverPredictionTestCase::DoRun (void)
+{
+  MeasurementRingBuffer series (8);
+  series.Push (20.0);
+  NS_TEST_ASSERT_MSG_EQ_TOL (FuzzyHandoverController::PredictServingCellRsrq (series), 21.0, 1e-9,
+                             "wrong serving cell prediction from a single report");
+  NS_TEST_ASSERT_MSG_EQ_TOL (FuzzyHandoverController::PredictNeighbourCellRsrq (series), 20.0, 1e-9,
+                             "wrong neighbour cell prediction from a single report");
+
+  // linear trend, degree 1 fit
+  series.Push (18.0);
+  series.Push (16.0);
+  NS_TEST_ASSERT_MSG_EQ_TOL (FuzzyHandoverController::PredictServingCellRsrq (series), 14.0, 1e-9,
+                             "wrong linear extrapolation");
+
+  // quadratic trend, degree 2 fit over the last six reports only
+  series.Clear ();
+  series.Push (0.0);
+  for (uint32_t t = 0; t < 6; ++t)
+    {
+      series.Push (30.0 - 0.5 * t * t);
+    }
+  NS_TEST_ASSERT_MSG_EQ_TOL (FuzzyHandoverController::PredictNeighbourCellRsrq (series), 30.0 - 0.5 * 36, 1e-6,
+                             "wrong quadratic extrapolation");
+}
+
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test the decisions of a fuzzy handover controller.
+ */
+class LteFuzzyHandoverDecisionTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param name reference name
+   * \param controller the controller under test
+   */
+  LteFuzzyHandoverDecisionTestCase (std::string name, Ptr<FuzzyHandoverController> controller);
+
+private:
+  virtual void DoRun (void);
+
+  Ptr<FuzzyHandoverController> m_controller; ///< the controller under test
+};
+
+LteFuzzyHandoverDecisionTestCase::LteFuzzyHandoverDecisionTestCase (std::string name,
+                                                                    Ptr<FuzzyHandoverController> controller)
+  : TestCase (name),
+    m_controller (controller)
+{
+}
+
+void
+LteFuzzyHandoverDecisionTestCase::DoRun (void)
+{
+  // radio link quality follows the RSRQ
+  double poor = m_controller->EvaluateServingCellRlq (10.0, -2.0);
+  double excellent = m_controller->EvaluateServingCellRlq (34.0, 2.0);
+  NS_TEST_ASSERT_MSG_LT (poor, 0.25, "poor serving cell with high RLQ");
+  NS_TEST_ASSERT_MSG_GT (excellent, 0.75, "excellent serving cell with low RLQ");
+  double previous = 0.0;
+  for (uint32_t rsrq = 0; rsrq <= 34; ++rsrq)
+    {
+      double rlq = m_controller->EvaluateNeighbourCellRlq (rsrq, 0.0);
+      NS_TEST_ASSERT_MSG_GT_OR_EQ (rlq, previous - 1e-9, "neighbour cell RLQ not monotonic at RSRQ " << rsrq);
+      NS_TEST_ASSERT_MSG_GT_OR_EQ (rlq, 0.0, "RLQ out of range");
+      NS_TEST_ASSERT_MSG_LT_OR_EQ (rlq, 1.0, "RLQ out of range");
+      previous = rlq;
+    }
+
+  // handover trigger
+  NS_TEST_ASSERT_MSG_EQ (m_controller->IsHandoverTriggered (m_controller->EvaluateHandoverTrigger (0.1, 0.9)),
+                         true, "no handover from a bad to a good cell");
+  NS_TEST_ASSERT_MSG_EQ (m_controller->IsHandoverTriggered (m_controller->EvaluateHandoverTrigger (0.9, 0.9)),
+                         false, "handover from a good cell");
+  NS_TEST_ASSERT_MSG_EQ (m_controller->IsHandoverTriggered (m_controller->EvaluateHandoverTrigger (0.9, 0.1)),
+                         false, "handover from a good to a bad cell");
+
+  // complete decision
+  HandoverMeasurementHistory history (FuzzyHandoverController::PREDICTION_WINDOW);
+  history.AddServingCellMeasurement (1, 20.0);
+  history.AddServingCellMeasurement (1, 17.0);
+  const MeasurementRingBuffer &serving = history.AddServingCellMeasurement (1, 14.0);
+  history.AddNeighbourCellMeasurement (1, 2, 16.0);
+  history.AddNeighbourCellMeasurement (1, 2, 16.0);
+  history.AddNeighbourCellMeasurement (1, 3, 25.0);
+  history.AddNeighbourCellMeasurement (1, 3, 27.0);
+  const HandoverMeasurementHistory::NeighbourCellMap &neighbours = history.GetNeighbourCells (1);
+  NS_TEST_ASSERT_MSG_EQ (m_controller->EvaluateHandover (serving, neighbours), 3,
+                         "best neighbour cell not selected");
+
+  MeasurementRingBuffer excellentServing (FuzzyHandoverController::PREDICTION_WINDOW);
+  excellentServing.Push (33.0);
+  excellentServing.Push (34.0);
+  NS_TEST_ASSERT_MSG_EQ (m_controller->EvaluateHandover (excellentServing, neighbours), 0,
+                         "handover from an excellent serving cell");
+  NS_TEST_ASSERT_MSG_EQ (m_controller->EvaluateHandover (excellentServing, history.GetNeighbourCells (2)), 0,
+                         "handover without neighbour cells");
+}
+
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test the tabulated decision surfaces of a fuzzy handover
+ * controller against the controller itself.
+ */
+class LteFuzzyDecisionSurfaceTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param name reference name
+   * \param controller the controller to tabulate
+   * \param other another controller, whose tables must be rejected
+   */
+  LteFuzzyDecisionSurfaceTestCase (std::string name, Ptr<FuzzyHandoverController> controller,
+                                   Ptr<FuzzyHandoverController> other);
+
+private:
+  virtual void DoRun (void);
+
+  Ptr<FuzzyHandoverController> m_controller; ///< the controller to tabulate
+  Ptr<FuzzyHandoverController> m_other;      ///< another controller
+};
+
+LteFuzzyDecisionSurfaceTestCase::LteFuzzyDecisionSurfaceTestCase (std::string name,
+                                                                  Ptr<FuzzyHandoverController> controller,
+                                                                  Ptr<FuzzyHandoverController> other)
+  : TestCase (name),
+    m_controller (controller),
+    m_other (other)
+{
+}
+
+void
+LteFuzzyDecisionSurfaceTestCase::DoRun (void)
+{
+  std::string filename = CreateTempDirFilename ("fuzzy-decision-surface.txt");
+  Ptr<TabulatedFuzzyHandoverController> tabulated =
+    TabulatedFuzzyHandoverController::Tabulate (m_controller, filename);
+  NS_TEST_ASSERT_MSG_EQ (tabulated->GetName (), m_controller->GetName (), "wrong name");
+
+  // exact on the grid points, close elsewhere
+  for (double rsrq = 0.0; rsrq <= 34.0; rsrq += 1.0)
+    {
+      for (double delta = -4.0; delta <= 4.0; delta += 0.5)
+        {
+          NS_TEST_ASSERT_MSG_EQ_TOL (tabulated->EvaluateServingCellRlq (rsrq, delta),
+                                     m_controller->EvaluateServingCellRlq (rsrq, delta), 1e-6,
+                                     "serving cell RLQ at grid point " << rsrq << ", " << delta);
+          NS_TEST_ASSERT_MSG_EQ_TOL (tabulated->EvaluateNeighbourCellRlq (rsrq + 0.1, delta + 0.06),
+                                     m_controller->EvaluateNeighbourCellRlq (rsrq + 0.1, delta + 0.06), 0.02,
+                                     "neighbour cell RLQ at " << rsrq + 0.1 << ", " << delta + 0.06);
+        }
+    }
+  for (double s = 0.0; s <= 1.0; s += 0.1)
+    {
+      for (double n = 0.0; n <= 1.0; n += 0.1)
+        {
+          NS_TEST_ASSERT_MSG_EQ_TOL (tabulated->EvaluateHandoverTrigger (s + 0.003, n + 0.007),
+                                     m_controller->EvaluateHandoverTrigger (s + 0.003, n + 0.007), 0.02,
+                                     "handover trigger at " << s << ", " << n);
+        }
+    }
+
+  // the saved tables are reused
+  Ptr<TabulatedFuzzyHandoverController> loaded = Create<TabulatedFuzzyHandoverController> (m_controller);
+  NS_TEST_ASSERT_MSG_EQ (loaded->Load (filename), true, "tables not saved");
+  NS_TEST_ASSERT_MSG_EQ (loaded->EvaluateServingCellRlq (17.3, -1.2),
+                         tabulated->EvaluateServingCellRlq (17.3, -1.2), "tables not restored");
+  NS_TEST_ASSERT_MSG_EQ (loaded->EvaluateHandoverTrigger (0.42, 0.77),
+                         tabulated->EvaluateHandoverTrigger (0.42, 0.77), "tables not restored");
+  Ptr<TabulatedFuzzyHandoverController> other = Create<TabulatedFuzzyHandoverController> (m_other);
+  NS_TEST_ASSERT_MSG_EQ (other->Load (filename), false, "tables of another controller accepted");
+  NS_TEST_ASSERT_MSG_EQ (loaded->Load (CreateTempDirFilename ("missing.txt")), false,
+                         "missing file accepted");
+
+  // same decision as the controller
+  HandoverMeasurementHistory history (FuzzyHandoverController::PREDICTION_WINDOW);
+  history.AddServingCellMeasurement (1, 20.0);
+  history.AddServingCellMeasurement (1, 17.0);
+  const MeasurementRingBuffer &serving = history.AddServingCellMeasurement (1, 14.0);
+  history.AddNeighbourCellMeasurement (1, 2, 16.0);
+  history.AddNeighbourCellMeasurement (1, 2, 16.0);
+  history.AddNeighbourCellMeasurement (1, 3, 25.0);
+  history.AddNeighbourCellMeasurement (1, 3, 27.0);
+  const HandoverMeasurementHistory::NeighbourCellMap &neighbours = history.GetNeighbourCells (1);
+  NS_TEST_ASSERT_MSG_EQ (loaded->EvaluateHandover (serving, neighbours),
+                         m_controller->EvaluateHandover (serving, neighbours),
+                         "different decision with the tables");
+}
+
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test suite for the native fuzzy inference systems used by the
+ * fuzzy handover algorithms.
+ */
+class LteFuzzyHandoverTestSuite : public TestSuite
+{
+public:
+  LteFuzzyHandoverTestSuite ();
+};
+
+static LteFuzzyHandoverTestSuite g_lteFuzzyHandoverTestSuite;
+
+LteFuzzyHandoverTestSuite::LteFuzzyHandoverTestSuite ()
+  : TestSuite ("lte-fuzzy-handover", UNIT)
+{
+  NS_LOG_FUNCTION (this);
+
+  AddTestCase (new LteFuzzyInferenceTestCase (), TestCase::QUICK);
+  AddTestCase (new LteFuzzyHandoverPredictionTestCase (), TestCase::QUICK);
+  AddTestCase (new LteFuzzyHandoverDecisionTestCase ("Type 1 fuzzy handover decision",
+                                                     Create<Type1FuzzyHandoverController> ()),
+               TestCase::QUICK);
+  AddTestCase (new LteFuzzyHandoverDecisionTestCase ("Type 2 fuzzy handover decision",
+                                                     Create<Type2FuzzyHandoverController> ()),
+               TestCase::QUICK);
+  AddTestCase (new LteFuzzyHandoverDecisionTestCase ("Type 2 fuzzy handover decision, product t-norm",
+                                                     Create<Type2FuzzyHandoverController> (It2MamdaniFis::PRODUCT_T_NORM)),
+               TestCase::QUICK);
+  AddTestCase (new LteFuzzyDecisionSurfaceTestCase ("Type 1 fuzzy decision surfaces",
+                                                    Create<Type1FuzzyHandoverController> (),
+                                                    Create<Type2FuzzyHandoverController> ()),
+               TestCase::QUICK);
+  AddTestCase (new LteFuzzyDecisionSurfaceTestCase ("Type 2 fuzzy decision surfaces",
+                                                    Create<Type2FuzzyHandoverController> (),
+                                                    Create<Type2FuzzyHandoverController> (It2MamdaniFis::PRODUCT_T_NORM)),
+               TestCase::QUICK);
+}
@@ -0,0 +1,173 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Amiraslan Haghrah
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Amiraslan Haghrah <amiraslanhaghrah@gmail.com>
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include "ns3/handover-measurement-history.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestHandoverMeasurementHistory");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test the fixed-capacity measurement ring buffer.
+ */
+class LteMeasurementRingBufferTestCase : public TestCase
+{
+public:
+  LteMeasurementRingBufferTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LteMeasurementRingBufferTestCase::LteMeasurementRingBufferTestCase ()
+  : TestCase ("Measurement ring buffer")
+{
+}
+
+void
+LteMeasurementRingBufferTestCase::DoRun (void)
+{
+  MeasurementRingBuffer buffer (4);
+  NS_TEST_ASSERT_MSG_EQ (buffer.IsEmpty (), true, "new buffer not empty");
+  NS_TEST_ASSERT_MSG_EQ (buffer.GetCapacity (), 4, "wrong capacity");
+
+  buffer.Push (10.0);
+  NS_TEST_ASSERT_MSG_EQ (buffer.GetDelta (3), 0.0, "delta of a single measurement");
+  NS_TEST_ASSERT_MSG_EQ (buffer.GetTrend (3), 0.0, "trend of a single measurement");
+
+  for (uint32_t i = 1; i < 10; ++i)
+    {
+      buffer.Push (10.0 + 2.0 * i);
+    }
+  // 10 measurements pushed, the last 4 are kept: 22, 24, 26, 28
+  NS_TEST_ASSERT_MSG_EQ (buffer.GetSize (), 4, "capacity exceeded");
+  NS_TEST_ASSERT_MSG_EQ (buffer.Get (0), 22.0, "wrong oldest measurement");
+  NS_TEST_ASSERT_MSG_EQ (buffer.GetLast (), 28.0, "wrong last measurement");
+  NS_TEST_ASSERT_MSG_EQ (buffer.GetDelta (1), 2.0, "wrong delta over 1 sample");
+  NS_TEST_ASSERT_MSG_EQ (buffer.GetDelta (3), 6.0, "wrong delta over 3 samples");
+  NS_TEST_ASSERT_MSG_EQ (buffer.GetDelta (10), 6.0, "delta not limited to the history");
+  NS_TEST_ASSERT_MSG_EQ_TOL (buffer.GetTrend (4), 2.0, 1e-12, "wrong trend");
+
+  buffer.Push (20.0);
+  // 24, 26, 28, 20: slope of the last two is -8, of all four -1
+  NS_TEST_ASSERT_MSG_EQ_TOL (buffer.GetTrend (2), -8.0, 1e-12, "wrong trend over 2 samples");
+  NS_TEST_ASSERT_MSG_EQ_TOL (buffer.GetTrend (100), -1.0, 1e-12, "wrong trend over the history");
+
+  buffer.Clear ();
+  NS_TEST_ASSERT_MSG_EQ (buffer.GetSize (), 0, "buffer not cleared");
+  buffer.Push (5.0);
+  NS_TEST_ASSERT_MSG_EQ (buffer.Get (0), 5.0, "wrong measurement after clear");
+}
+
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test the per-UE measurement history of the handover algorithms.
+ */
+class LteHandoverMeasurementHistoryTestCase : public TestCase
+{
+public:
+  LteHandoverMeasurementHistoryTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LteHandoverMeasurementHistoryTestCase::LteHandoverMeasurementHistoryTestCase ()
+  : TestCase ("Handover measurement history")
+{
+}
+
+void
+LteHandoverMeasurementHistoryTestCase::DoRun (void)
+{
+  HandoverMeasurementHistory history (3);
+  NS_TEST_ASSERT_MSG_EQ (history.GetServingCell (1).IsEmpty (), true, "unknown UE with a history");
+  NS_TEST_ASSERT_MSG_EQ (history.GetNeighbourCells (1).empty (), true, "unknown UE with neighbours");
+
+  for (uint32_t i = 0; i < 100; ++i)
+    {
+      history.AddServingCellMeasurement (1, i);
+      history.AddNeighbourCellMeasurement (1, 7, 2 * i);
+      history.AddNeighbourCellMeasurement (2, 8, 3 * i);
+    }
+  NS_TEST_ASSERT_MSG_EQ (history.GetNUes (), 2, "wrong number of UEs");
+  NS_TEST_ASSERT_MSG_EQ (history.GetServingCell (1).GetSize (), 3, "serving cell history not bounded");
+  NS_TEST_ASSERT_MSG_EQ (history.GetServingCell (1).GetLast (), 99.0, "wrong serving cell measurement");
+  NS_TEST_ASSERT_MSG_EQ (history.GetServingCell (2).IsEmpty (), true, "serving cell measured");
+  NS_TEST_ASSERT_MSG_EQ (history.GetNeighbourCells (1).size (), 1, "wrong number of neighbour cells");
+  const MeasurementRingBuffer &neighbour = history.GetNeighbourCells (1).find (7)->second.measurements;
+  NS_TEST_ASSERT_MSG_EQ (neighbour.GetSize (), 3, "neighbour cell history not bounded");
+  NS_TEST_ASSERT_MSG_EQ (neighbour.GetDelta (1), 2.0, "wrong neighbour cell delta");
+
+  // neighbour cells not reported for a while are purged
+  Simulator::Stop (Seconds (1.0));
+  Simulator::Run ();
+  history.AddNeighbourCellMeasurement (1, 9, 20.0);
+  history.PurgeNeighbourCells (1, MilliSeconds (500));
+  NS_TEST_ASSERT_MSG_EQ (history.GetNeighbourCells (1).size (), 1, "wrong number of neighbour cells");
+  NS_TEST_ASSERT_MSG_EQ (history.GetNeighbourCells (1).begin ()->first, 9, "wrong neighbour cell purged");
+  NS_TEST_ASSERT_MSG_EQ (history.GetNeighbourCells (2).size (), 1, "neighbour cell of another UE purged");
+  history.RemoveNeighbourCell (1, 9);
+  NS_TEST_ASSERT_MSG_EQ (history.GetNeighbourCells (1).empty (), true, "neighbour cell not removed");
+  Simulator::Destroy ();
+
+  // nothing is left of a UE which left the cell
+  history.RemoveUe (1);
+  NS_TEST_ASSERT_MSG_EQ (history.GetNUes (), 1, "UE not removed");
+  NS_TEST_ASSERT_MSG_EQ (history.GetServingCell (1).IsEmpty (), true, "history of a removed UE");
+  history.AddServingCellMeasurement (1, 30.0);
+  NS_TEST_ASSERT_MSG_EQ (history.GetServingCell (1).GetSize (), 1, "history of a removed UE reused");
+  history.Clear ();
+  NS_TEST_ASSERT_MSG_EQ (history.GetNUes (), 0, "history not cleared");
+}
+
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test suite for the measurement history of the handover algorithms.
+ */
+class LteHandoverMeasurementHistoryTestSuite : public TestSuite
+{
+public:
+  LteHandoverMeasurementHistoryTestSuite ();
+};
+
+static LteHandoverMeasurementHistoryTestSuite g_lteHandoverMeasurementHistoryTestSuite;
+
+LteHandoverMeasurementHistoryTestSuite::LteHandoverMeasurementHistoryTestSuite ()
+  : TestSuite ("lte-handover-measurement-history", UNIT)
+{
+  NS_LOG_FUNCTION (this);
+
+  AddTestCase (new LteMeasurementRingBufferTestCase (), TestCase::QUICK);
+  AddTestCase (new LteHandoverMeasurementHistoryTestCase (), TestCase::QUICK);
+}
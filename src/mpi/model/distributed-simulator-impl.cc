@@ -635,4 +635,13 @@ DistributedSimulatorImpl::GetEventCount (void) const
   return m_eventCount;
 }
 
+void
+DistributedSimulatorImpl::InvokeWithContext (uint32_t context, const Callback<void> &callback)
+{
+  uint32_t previous = m_currentContext;
+  m_currentContext = context;
+  callback ();
+  m_currentContext = previous;
+}
+
 } // namespace ns3
@@ -127,6 +127,7 @@ public:
   virtual uint32_t GetSystemId (void) const;
   virtual uint32_t GetContext (void) const;
   virtual uint64_t GetEventCount (void) const;
+  virtual void InvokeWithContext (uint32_t context, const Callback<void> &callback);
 
 private:
   virtual void DoDispose (void);
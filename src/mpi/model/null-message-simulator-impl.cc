@@ -578,6 +578,15 @@ NullMessageSimulatorImpl::GetEventCount (void) const
   return m_eventCount;
 }
 
+void
+NullMessageSimulatorImpl::InvokeWithContext (uint32_t context, const Callback<void> &callback)
+{
+  uint32_t previous = m_currentContext;
+  m_currentContext = context;
+  callback ();
+  m_currentContext = previous;
+}
+
 Time NullMessageSimulatorImpl::CalculateGuaranteeTime (uint32_t nodeSysId)
 {
   Ptr<RemoteChannelBundle> bundle = RemoteChannelBundleManager::Find (nodeSysId);
@@ -400,6 +400,15 @@ void
 Buffer::AddAtEnd (const Buffer &o)
 {
   NS_LOG_FUNCTION (this << &o);
+  if (o.GetSize () == 0)
+    {
+      return;
+    }
+  if (GetSize () == 0)
+    {
+      *this = o;
+      return;
+    }
   if (m_data->m_count == 1 &&
       m_end == m_zeroAreaEnd &&
       m_end == m_data->m_dirtyEnd &&
@@ -426,14 +435,35 @@ Buffer::AddAtEnd (const Buffer &o)
       return;
     }
 
-  *this = CreateFullCopy ();
-  AddAtEnd (o.GetSize ());
-  Buffer::Iterator destStart = End ();
-  destStart.Prev (o.GetSize ());
-  destStart.Write (o.Begin (), o.End ());
+  // A copy, in case o is this buffer.
+  Buffer src = o;
+  if (src.m_zeroAreaEnd - src.m_zeroAreaStart > m_zeroAreaEnd - m_zeroAreaStart)
+    {
+      // Keep the zero area of o, and write ours.
+      Buffer tmp = src;
+      tmp.AddAtStart (GetSize ());
+      WriteTo (tmp.Begin ());
+      *this = tmp;
+    }
+  else
+    {
+      AddAtEnd (src.GetSize ());
+      Buffer::Iterator destStart = End ();
+      destStart.Prev (src.GetSize ());
+      src.WriteTo (destStart);
+    }
   NS_ASSERT (CheckInternalState ());
 }
 
+void
+Buffer::WriteTo (Buffer::Iterator i) const
+{
+  NS_LOG_FUNCTION (this << &i);
+  i.Write (m_data->m_data + m_start, m_zeroAreaStart - m_start);
+  i.WriteU8 (0, m_zeroAreaEnd - m_zeroAreaStart);
+  i.Write (m_data->m_data + m_zeroAreaStart, m_end - m_zeroAreaEnd);
+}
+
 void 
 Buffer::RemoveAtStart (uint32_t start)
 {
@@ -754,14 +784,8 @@ Buffer::CopyData (uint8_t *buffer, uint32_t size) const
       if (size > 0) 
         { 
           tmpsize = std::min (m_zeroAreaEnd - m_zeroAreaStart, size);
-          uint32_t left = tmpsize;
-          while (left > 0)
-            {
-              uint32_t toWrite = std::min (left, g_zeroes.size);
-              memcpy (buffer, g_zeroes.buffer, toWrite);
-              left -= toWrite;
-              buffer += toWrite;
-            }
+          memset (buffer, 0, tmpsize);
+          buffer += tmpsize;
           size -= tmpsize;
           if (size > 0)
             {
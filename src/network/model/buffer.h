@@ -65,10 +65,13 @@ namespace ns3 {
  * contains real data bytes in its BufferData instance but it also
  * contains "virtual zero data" which typically is used to represent
  * application-level payload. No memory is allocated to store the
- * zero bytes of application-level payload unless the user fragments
- * a Buffer: this application-level payload is kept track of with
- * a pair of integers which describe where in the buffer content
- * the "virtual zero area" starts and ends.
+ * zero bytes of application-level payload: this payload is kept
+ * track of with a pair of integers which describe where in the
+ * buffer content the "virtual zero area" starts and ends. Headers
+ * and trailers can be added and removed, and fragments created,
+ * without writing these bytes.  A Buffer has a single zero area,
+ * so the concatenation of two Buffers with zero areas writes the
+ * smaller of the two; only CopyData and PeekData write them all.
  *
  * \verbatim
  * ***: unused bytes
@@ -524,7 +527,8 @@ private:
   /**
    * \param o the buffer to append to the end of this buffer.
    *
-   * Add bytes at the end of the Buffer.
+   * Add bytes at the end of the Buffer.  The larger of the zero
+   * areas of the two buffers stays virtual.
    * Any call to this method invalidates any Iterator
    * pointing to this Buffer.
    */
@@ -697,6 +701,14 @@ private:
    * \brief Transform a "Virtual byte buffer" into a "Real byte buffer"
    */
   void TransformIntoRealBuffer (void) const;
+  /**
+   * \brief Write the bytes of this buffer, zero area included, at
+   * an iterator of another buffer.
+   *
+   * \param i the position of the first byte, outside of the zero
+   *        area of the other buffer.
+   */
+  void WriteTo (Buffer::Iterator i) const;
   /**
    * \brief Checks the internal buffer structures consistency
    *
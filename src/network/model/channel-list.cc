@@ -17,6 +17,7 @@
  */
 
 #include "ns3/simulator.h"
+#include "ns3/simulation-context.h"
 #include "ns3/object-vector.h"
 #include "ns3/config.h"
 #include "ns3/log.h"
@@ -128,7 +129,8 @@ Ptr<ChannelListPriv> *
 ChannelListPriv::DoGet (void)
 {
   NS_LOG_FUNCTION_NOARGS ();
-  static Ptr<ChannelListPriv> ptr = 0;
+  static ContextLocal<Ptr<ChannelListPriv> > list;
+  Ptr<ChannelListPriv> &ptr = list.Get ();
   if (ptr == 0)
     {
       ptr = CreateObject<ChannelListPriv> ();
@@ -20,6 +20,7 @@
  */
 
 #include "ns3/simulator.h"
+#include "ns3/simulation-context.h"
 #include "ns3/object-vector.h"
 #include "ns3/config.h"
 #include "ns3/log.h"
@@ -130,7 +131,8 @@ Ptr<NodeListPriv> *
 NodeListPriv::DoGet (void)
 {
   NS_LOG_FUNCTION_NOARGS ();
-  static Ptr<NodeListPriv> ptr = 0;
+  static ContextLocal<Ptr<NodeListPriv> > list;
+  Ptr<NodeListPriv> &ptr = list.Get ();
   if (ptr == 0)
     {
       ptr = CreateObject<NodeListPriv> ();
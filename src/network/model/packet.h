@@ -284,6 +284,20 @@ public:
    * \param size the size of the input buffer.
    */
   Packet (uint8_t const*buffer, uint32_t size);
+  /**
+   * \brief Allocate a packet from the pool of the calling thread.
+   *
+   * \see PoolAllocator
+   * \param size the size of the packet
+   * \return the packet memory
+   */
+  static void * operator new (std::size_t size);
+  /**
+   * \brief Release a packet to the pool of the calling thread.
+   * \param p the packet memory
+   * \param size the size of the packet
+   */
+  static void operator delete (void *p, std::size_t size);
   /**
    * \brief Create a new packet which contains a fragment of the original
    * packet.
@@ -394,7 +408,7 @@ public:
    *
    * \param packet packet to concatenate
    */
-  void AddAtEnd (Ptr<const Packet> packet);
+  void AddAtEnd (PtrView<const Packet> packet);
   /**
    * \brief Add a zero-filled padding to the packet.
    *
@@ -787,7 +801,10 @@ private:
   /* Please see comments above about nix-vector */
   Ptr<NixVector> m_nixVector; //!< the packet's Nix vector
 
-  static uint32_t m_globalUid; //!< Global counter of packets Uid
+  /**
+   * \returns a new packet Uid, unique in the current SimulationContext
+   */
+  static uint32_t AllocateUid (void);
 };
 
 /**
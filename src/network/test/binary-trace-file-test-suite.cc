@@ -0,0 +1,231 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Amiraslan Haghrah
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/test.h"
+#include "ns3/binary-trace-file.h"
+#include "ns3/simulator.h"
+#include "ns3/traced-callback.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+using namespace ns3;
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Write records of several traces through TracedCallbacks, and read
+ * them back.
+ */
+class BinaryTraceFileRoundTripTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor.
+   * \param async write from a background thread
+   */
+  BinaryTraceFileRoundTripTestCase (bool async);
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Fire the traces.
+   * \param i the index of the event
+   */
+  void Fire (uint32_t i);
+
+  bool m_async;                                             //!< Write from a thread.
+  TracedCallback<uint16_t, double, Time> m_measurement;     //!< A trace without context.
+  TracedCallback<std::string, Ptr<const Packet>, int8_t> m_rx;  //!< A trace with context.
+};
+
+BinaryTraceFileRoundTripTestCase::BinaryTraceFileRoundTripTestCase (bool async)
+  : TestCase (async ? "Round trip, written by a thread" : "Round trip, written synchronously"),
+    m_async (async)
+{}
+
+void
+BinaryTraceFileRoundTripTestCase::Fire (uint32_t i)
+{
+  m_measurement (i, i * 0.5, MilliSeconds (i));
+  std::ostringstream context;
+  context << "/NodeList/" << i % 3;
+  m_rx (context.str (), Create<Packet> (i + 1), -static_cast<int8_t> (i % 100));
+}
+
+void
+BinaryTraceFileRoundTripTestCase::DoRun (void)
+{
+  const uint32_t n = 1000;
+  std::string filename = CreateTempDirFilename (m_async ? "async.btr" : "sync.btr");
+  // a small buffer, so that the writer runs during the simulation
+  Ptr<BinaryTraceFile> file = Create<BinaryTraceFile> (filename, 256, m_async);
+  m_measurement.ConnectWithoutContext (file->MakeSink<uint16_t, double, Time>
+                                         ("measurement", {"rnti", "rsrp", "delay"}));
+  m_rx.ConnectWithoutContext (file->MakeSinkWithContext<Ptr<const Packet>, int8_t>
+                                ("rx", {"packet", "level"}));
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      Simulator::Schedule (MicroSeconds (i), &BinaryTraceFileRoundTripTestCase::Fire, this, i);
+    }
+  Simulator::Run ();
+  Simulator::Destroy ();
+  NS_TEST_ASSERT_MSG_EQ (file->GetNRecords (), 2 * n, "wrong number of records");
+
+  BinaryTraceReader reader (filename);
+  NS_TEST_ASSERT_MSG_EQ (reader.Fail (), false, "file not read");
+  uint32_t counts[2] = { 0, 0 };
+  while (reader.Next ())
+    {
+      uint16_t traceId = reader.GetTraceId ();
+      NS_TEST_ASSERT_MSG_LT (traceId, 2, "wrong trace id");
+      uint32_t i = counts[traceId]++;
+      NS_TEST_ASSERT_MSG_EQ (reader.GetTimeStep (), MicroSeconds (i).GetTimeStep (), "wrong time");
+      if (traceId == 0)
+        {
+          NS_TEST_ASSERT_MSG_EQ (reader.GetTrace ().name, "measurement", "wrong trace name");
+          NS_TEST_ASSERT_MSG_EQ (reader.GetInteger (0), static_cast<int64_t> (i), "wrong integer column");
+          NS_TEST_ASSERT_MSG_EQ (reader.GetDouble (1), i * 0.5, "wrong double column");
+          NS_TEST_ASSERT_MSG_EQ (reader.GetInteger (2), MilliSeconds (i).GetTimeStep (),
+                                 "wrong time column");
+        }
+      else
+        {
+          // context, packet uid and size, level
+          NS_TEST_ASSERT_MSG_EQ (reader.GetTrace ().columns.size (), 4, "wrong columns");
+          NS_TEST_ASSERT_MSG_EQ (reader.GetTrace ().columns[2].name, "packet_size",
+                                 "wrong packet column name");
+          std::ostringstream context;
+          context << "/NodeList/" << i % 3;
+          NS_TEST_ASSERT_MSG_EQ (reader.GetString (0), context.str (), "wrong context");
+          NS_TEST_ASSERT_MSG_EQ (reader.GetInteger (2), static_cast<int64_t> (i + 1), "wrong packet size");
+          NS_TEST_ASSERT_MSG_EQ (reader.GetInteger (3), -static_cast<int64_t> (i % 100),
+                                 "wrong signed column");
+        }
+    }
+  NS_TEST_ASSERT_MSG_EQ (reader.Fail (), false, "file not read");
+  NS_TEST_ASSERT_MSG_EQ (counts[0], n, "missing records");
+  NS_TEST_ASSERT_MSG_EQ (counts[1], n, "missing records");
+  NS_TEST_ASSERT_MSG_EQ (reader.GetContexts ().size (), 3, "contexts not shared");
+  std::remove (filename.c_str ());
+}
+
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Convert a file to CSV and columnar files.
+ */
+class BinaryTraceFileConvertTestCase : public TestCase
+{
+public:
+  BinaryTraceFileConvertTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Invoke a sink.
+   * \param sink the sink
+   * \param value the first argument
+   * \param state the second argument
+   */
+  static void Invoke (Callback<void, uint32_t, bool> sink, uint32_t value, bool state);
+};
+
+BinaryTraceFileConvertTestCase::BinaryTraceFileConvertTestCase ()
+  : TestCase ("Conversion to CSV and columnar files")
+{}
+
+void
+BinaryTraceFileConvertTestCase::Invoke (Callback<void, uint32_t, bool> sink, uint32_t value, bool state)
+{
+  sink (value, state);
+}
+
+void
+BinaryTraceFileConvertTestCase::DoRun (void)
+{
+  std::string filename = CreateTempDirFilename ("convert.btr");
+  std::string prefix = CreateTempDirFilename ("convert");
+  Ptr<BinaryTraceFile> file = Create<BinaryTraceFile> (filename);
+  Callback<void, uint32_t, bool> sink = file->MakeSink<uint32_t, bool> ("state");
+  Simulator::ScheduleNow (&Invoke, sink, 7, true);
+  Simulator::Schedule (Seconds (1.5), &Invoke, sink, 8, false);
+  Simulator::Run ();
+  file->Close ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (BinaryTraceReader::ConvertToCsv (filename, prefix), true,
+                         "CSV conversion failed");
+  std::ifstream csv ((prefix + "-state.csv").c_str ());
+  std::string line;
+  std::getline (csv, line);
+  NS_TEST_ASSERT_MSG_EQ (line, "time,c0,c1", "wrong CSV header");
+  std::getline (csv, line);
+  NS_TEST_ASSERT_MSG_EQ (line, "0,7,1", "wrong CSV line");
+  std::getline (csv, line);
+  NS_TEST_ASSERT_MSG_EQ (line, "1.5,8,0", "wrong CSV line");
+  csv.close ();
+
+  NS_TEST_ASSERT_MSG_EQ (BinaryTraceReader::ConvertToColumns (filename, prefix), true,
+                         "columnar conversion failed");
+  std::ifstream column ((prefix + "-state-c0.bin").c_str (), std::ios::binary);
+  uint32_t values[2] = { 0, 0 };
+  column.read (reinterpret_cast<char *> (values), sizeof (values));
+  NS_TEST_ASSERT_MSG_EQ (static_cast<std::size_t> (column.gcount ()), sizeof (values), "wrong column size");
+  NS_TEST_ASSERT_MSG_EQ (values[0], 7, "wrong column value");
+  NS_TEST_ASSERT_MSG_EQ (values[1], 8, "wrong column value");
+  column.close ();
+
+  const char *suffixes[] = { ".csv", ".schema", "-time.bin", "-c0.bin", "-c1.bin" };
+  for (uint32_t i = 0; i < sizeof (suffixes) / sizeof (suffixes[0]); ++i)
+    {
+      std::remove ((prefix + "-state" + suffixes[i]).c_str ());
+    }
+  std::remove (filename.c_str ());
+}
+
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * BinaryTraceFile test suite.
+ */
+class BinaryTraceFileTestSuite : public TestSuite
+{
+public:
+  BinaryTraceFileTestSuite ();
+};
+
+BinaryTraceFileTestSuite::BinaryTraceFileTestSuite ()
+  : TestSuite ("binary-trace-file", UNIT)
+{
+  AddTestCase (new BinaryTraceFileRoundTripTestCase (true), TestCase::QUICK);
+  AddTestCase (new BinaryTraceFileRoundTripTestCase (false), TestCase::QUICK);
+  AddTestCase (new BinaryTraceFileConvertTestCase, TestCase::QUICK);
+}
+
+static BinaryTraceFileTestSuite g_binaryTraceFileTestSuite; //!< Static variable for test initialization
@@ -23,6 +23,8 @@
 #include "ns3/double.h"
 #include "ns3/test.h"
 
+#include <vector>
+
 using namespace ns3;
 
 /**
@@ -389,6 +391,133 @@ BufferTest::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (val1, val2, "Bad ReadNtohU16()");
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Buffer concatenation tests: the larger zero area stays virtual.
+ */
+class BufferConcatenationTest : public TestCase {
+private:
+  /**
+   * Make a buffer with a zero area between two headers.
+   * \param before The size of the header before the zero area.
+   * \param zeroes The size of the zero area.
+   * \param after The size of the header after the zero area.
+   * \param fill The first byte of the headers.
+   * \returns The buffer.
+   */
+  Buffer Make (uint32_t before, uint32_t zeroes, uint32_t after, uint8_t fill);
+  /**
+   * Make the content of a buffer made by Make.
+   * \copydetails Make
+   */
+  std::vector<uint8_t> Content (uint32_t before, uint32_t zeroes, uint32_t after, uint8_t fill);
+  /**
+   * Check the content of a buffer.
+   * \param b The buffer.
+   * \param expected The expected content.
+   */
+  void Check (Buffer b, std::vector<uint8_t> expected);
+public:
+  virtual void DoRun (void);
+  BufferConcatenationTest ();
+};
+
+BufferConcatenationTest::BufferConcatenationTest ()
+  : TestCase ("Buffer concatenation")
+{}
+
+Buffer
+BufferConcatenationTest::Make (uint32_t before, uint32_t zeroes, uint32_t after, uint8_t fill)
+{
+  Buffer b (zeroes);
+  b.AddAtStart (before);
+  b.AddAtEnd (after);
+  Buffer::Iterator i = b.Begin ();
+  for (uint32_t j = 0; j < before; j++)
+    {
+      i.WriteU8 (fill + j);
+    }
+  i.Next (zeroes);
+  for (uint32_t j = 0; j < after; j++)
+    {
+      i.WriteU8 (fill + before + j);
+    }
+  return b;
+}
+
+std::vector<uint8_t>
+BufferConcatenationTest::Content (uint32_t before, uint32_t zeroes, uint32_t after, uint8_t fill)
+{
+  std::vector<uint8_t> content;
+  for (uint32_t j = 0; j < before; j++)
+    {
+      content.push_back (fill + j);
+    }
+  content.insert (content.end (), zeroes, 0);
+  for (uint32_t j = 0; j < after; j++)
+    {
+      content.push_back (fill + before + j);
+    }
+  return content;
+}
+
+void
+BufferConcatenationTest::Check (Buffer b, std::vector<uint8_t> expected)
+{
+  NS_TEST_ASSERT_MSG_EQ (b.GetSize (), expected.size (), "Bad size");
+  std::vector<uint8_t> got (b.GetSize ());
+  b.CopyData (got.data (), got.size ());
+  NS_TEST_ASSERT_MSG_EQ ((got == expected), true, "Bad content");
+}
+
+void
+BufferConcatenationTest::DoRun (void)
+{
+  std::vector<uint8_t> small = Content (10, 100, 4, 1);
+  std::vector<uint8_t> large = Content (20, 1000, 8, 50);
+  std::vector<uint8_t> expected;
+
+  // The zero area of the second buffer is the larger one.
+  Buffer a = Make (10, 100, 4, 1);
+  a.AddAtEnd (Make (20, 1000, 8, 50));
+  expected = small;
+  expected.insert (expected.end (), large.begin (), large.end ());
+  Check (a, expected);
+  NS_TEST_ASSERT_MSG_LT (a.GetSerializedSize (), 1000, "Zero area not virtual");
+
+  // The zero area of the first buffer is the larger one.
+  a = Make (20, 1000, 8, 50);
+  a.AddAtEnd (Make (10, 100, 4, 1));
+  expected = large;
+  expected.insert (expected.end (), small.begin (), small.end ());
+  Check (a, expected);
+  NS_TEST_ASSERT_MSG_LT (a.GetSerializedSize (), 1000, "Zero area not virtual");
+
+  // The first buffer is shared: it is left untouched.
+  Buffer b = Make (20, 1000, 8, 50);
+  a = b;
+  a.AddAtEnd (Make (10, 100, 4, 1));
+  Check (a, expected);
+  Check (b, large);
+
+  // Concatenation with itself.
+  a = Make (10, 100, 4, 1);
+  a.AddAtEnd (a);
+  expected = small;
+  expected.insert (expected.end (), small.begin (), small.end ());
+  Check (a, expected);
+
+  // Concatenation with an empty buffer.
+  a = Buffer ();
+  a.AddAtEnd (Make (20, 1000, 8, 50));
+  Check (a, large);
+  a.AddAtEnd (Buffer ());
+  Check (a, large);
+  NS_TEST_ASSERT_MSG_LT (a.GetSerializedSize (), 1000, "Zero area not virtual");
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -405,6 +534,7 @@ BufferTestSuite::BufferTestSuite ()
   : TestSuite ("buffer", UNIT)
 {
   AddTestCase (new BufferTest, TestCase::QUICK);
+  AddTestCase (new BufferConcatenationTest, TestCase::QUICK);
 }
 
 static BufferTestSuite g_bufferTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,812 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Amiraslan Haghrah
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "binary-trace-file.h"
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include <iomanip>
+
+/**
+ * \file
+ * \ingroup network
+ * ns3::BinaryTraceFile and ns3::BinaryTraceReader implementations.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("BinaryTraceFile");
+
+const char BinaryTraceFile::MAGIC[8] = { 'N', 'S', '3', 'B', 'T', 'R', 'C', '\0' };
+
+/**
+ * \ingroup network
+ * How long the threads of a BinaryTraceFile wait for a signal before
+ * checking their state again, in ns.
+ */
+static const uint64_t BINARY_TRACE_WAIT = 10000000;
+
+/**
+ * \ingroup network
+ * Copy a value to a buffer.
+ * \param [in] p Where to copy.
+ * \param [in] value The value.
+ * \returns Where to copy the next value.
+ */
+template <typename T>
+static uint8_t *
+Put (uint8_t *p, T value)
+{
+  std::memcpy (p, &value, sizeof (T));
+  return p + sizeof (T);
+}
+
+/**
+ * \ingroup network
+ * Copy a string to a buffer, prefixed by its length.
+ * \param [in] p Where to copy.
+ * \param [in] s The string.
+ * \returns Where to copy the next value.
+ */
+static uint8_t *
+PutString (uint8_t *p, const std::string &s)
+{
+  p = Put<uint16_t> (p, static_cast<uint16_t> (s.size ()));
+  std::memcpy (p, s.data (), s.size ());
+  return p + s.size ();
+}
+
+
+BinaryTraceFile::BinaryTraceFile (const std::string &filename, uint32_t bufferSize, bool async)
+  : m_open (true),
+    m_buffer (bufferSize),
+    m_used (0),
+    m_nTraces (0),
+    m_nRecords (0)
+#ifdef HAVE_PTHREAD_H
+  ,
+    m_pending (bufferSize),
+    m_pendingUsed (0),
+    m_stop (false)
+#endif
+{
+  NS_LOG_FUNCTION (this << filename << bufferSize << async);
+  NS_ABORT_MSG_IF (bufferSize < 64, "BinaryTraceFile: buffer of " << bufferSize << " bytes");
+  m_file.open (filename.c_str (), std::ios::out | std::ios::binary | std::ios::trunc);
+  NS_ABORT_MSG_UNLESS (m_file.good (), "Unable to open file " << filename << " for writing");
+  uint8_t *p = Reserve (sizeof (MAGIC) + 8);
+  std::memcpy (p, MAGIC, sizeof (MAGIC));
+  p = Put<uint32_t> (p + sizeof (MAGIC), VERSION);
+  Put<uint32_t> (p, static_cast<uint32_t> (Time::GetResolution ()));
+#ifdef HAVE_PTHREAD_H
+  if (async)
+    {
+      m_thread = Create<SystemThread> (MakeCallback (&BinaryTraceFile::DoWrite, this));
+      m_thread->Start ();
+    }
+#endif
+  Simulator::ScheduleDestroy (&BinaryTraceFile::Close, Ptr<BinaryTraceFile> (this));
+}
+
+BinaryTraceFile::~BinaryTraceFile ()
+{
+  NS_LOG_FUNCTION (this);
+  Close ();
+}
+
+uint16_t
+BinaryTraceFile::AddTrace (const std::string &name, const std::vector<Column> &columns)
+{
+  NS_LOG_FUNCTION (this << name << columns.size ());
+  NS_ABORT_MSG_IF (m_nTraces == CONTEXT_RECORD, "BinaryTraceFile: too many traces");
+  NS_ABORT_MSG_IF (name.size () > 0xffff || columns.size () > 0xffff,
+                   "BinaryTraceFile: trace " << name << " too large");
+  std::size_t size = 2 + 2 + 2 + name.size () + 2;
+  for (std::vector<Column>::const_iterator i = columns.begin (); i != columns.end (); ++i)
+    {
+      NS_ABORT_MSG_IF (i->name.size () > 0xffff, "BinaryTraceFile: column name too long");
+      size += 1 + 2 + i->name.size ();
+    }
+  uint16_t traceId = m_nTraces++;
+  if (!m_open)
+    {
+      return traceId;
+    }
+  uint8_t *p = Reserve (size);
+  p = Put<uint16_t> (p, SCHEMA_RECORD);
+  p = Put<uint16_t> (p, traceId);
+  p = PutString (p, name);
+  p = Put<uint16_t> (p, static_cast<uint16_t> (columns.size ()));
+  for (std::vector<Column>::const_iterator i = columns.begin (); i != columns.end (); ++i)
+    {
+      p = Put<uint8_t> (p, static_cast<uint8_t> (i->type));
+      p = PutString (p, i->name);
+    }
+  return traceId;
+}
+
+uint8_t *
+BinaryTraceFile::BeginRecord (uint16_t traceId, uint32_t size)
+{
+  if (!m_open)
+    {
+      return 0;
+    }
+  uint8_t *p = Reserve (2 + 8 + size);
+  p = Put<uint16_t> (p, traceId);
+  p = Put<int64_t> (p, Simulator::Now ().GetTimeStep ());
+  m_nRecords++;
+  return p;
+}
+
+uint32_t
+BinaryTraceFile::GetContextIndex (const std::string &context)
+{
+  std::unordered_map<std::string, uint32_t>::const_iterator i = m_contexts.find (context);
+  if (i != m_contexts.end ())
+    {
+      return i->second;
+    }
+  NS_ABORT_MSG_IF (context.size () > 0xffff, "BinaryTraceFile: context " << context << " too long");
+  uint32_t index = static_cast<uint32_t> (m_contexts.size ());
+  m_contexts[context] = index;
+  if (m_open)
+    {
+      uint8_t *p = Reserve (2 + 4 + 2 + context.size ());
+      p = Put<uint16_t> (p, CONTEXT_RECORD);
+      p = Put<uint32_t> (p, index);
+      PutString (p, context);
+    }
+  return index;
+}
+
+uint8_t *
+BinaryTraceFile::Reserve (std::size_t size)
+{
+  if (m_used + size > m_buffer.size ())
+    {
+      Submit ();
+      if (size > m_buffer.size ())
+        {
+          m_buffer.resize (size);
+        }
+    }
+  uint8_t *p = &m_buffer[m_used];
+  m_used += size;
+  return p;
+}
+
+void
+BinaryTraceFile::Submit (void)
+{
+  NS_LOG_FUNCTION (this << m_used);
+  if (m_used == 0)
+    {
+      return;
+    }
+#ifdef HAVE_PTHREAD_H
+  if (m_thread != 0)
+    {
+      // the writer gives back the previous buffer once written, and the
+      // simulation goes on filling it while the writer writes this one
+      WaitIdle ();
+      {
+        CriticalSection cs (m_mutex);
+        m_pending.swap (m_buffer);
+        m_pendingUsed = m_used;
+      }
+      m_used = 0;
+      m_ready.SetCondition (true);
+      m_ready.Signal ();
+      return;
+    }
+#endif
+  Write (&m_buffer[0], m_used);
+  m_used = 0;
+}
+
+void
+BinaryTraceFile::Write (const uint8_t *data, std::size_t size)
+{
+  m_file.write (reinterpret_cast<const char *> (data), size);
+}
+
+#ifdef HAVE_PTHREAD_H
+void
+BinaryTraceFile::WaitIdle (void)
+{
+  while (true)
+    {
+      // unset before the check, so that a signal sent after the check is
+      // not missed
+      m_idle.SetCondition (false);
+      {
+        CriticalSection cs (m_mutex);
+        if (m_pendingUsed == 0)
+          {
+            return;
+          }
+      }
+      m_idle.TimedWait (BINARY_TRACE_WAIT);
+    }
+}
+
+void
+BinaryTraceFile::DoWrite (void)
+{
+  NS_LOG_FUNCTION (this);
+  while (true)
+    {
+      m_ready.SetCondition (false);
+      std::size_t used;
+      bool stop;
+      {
+        CriticalSection cs (m_mutex);
+        used = m_pendingUsed;
+        stop = m_stop;
+      }
+      if (used > 0)
+        {
+          // the simulation does not touch the pending buffer until
+          // m_pendingUsed is reset
+          Write (&m_pending[0], used);
+          {
+            CriticalSection cs (m_mutex);
+            m_pendingUsed = 0;
+          }
+          m_idle.SetCondition (true);
+          m_idle.Signal ();
+        }
+      else if (stop)
+        {
+          return;
+        }
+      else
+        {
+          m_ready.TimedWait (BINARY_TRACE_WAIT);
+        }
+    }
+}
+#endif
+
+void
+BinaryTraceFile::Flush (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (!m_open)
+    {
+      return;
+    }
+  Submit ();
+#ifdef HAVE_PTHREAD_H
+  if (m_thread != 0)
+    {
+      WaitIdle ();
+    }
+#endif
+  m_file.flush ();
+}
+
+void
+BinaryTraceFile::Close (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (!m_open)
+    {
+      return;
+    }
+  Submit ();
+#ifdef HAVE_PTHREAD_H
+  if (m_thread != 0)
+    {
+      WaitIdle ();
+      {
+        CriticalSection cs (m_mutex);
+        m_stop = true;
+      }
+      m_ready.SetCondition (true);
+      m_ready.Signal ();
+      m_thread->Join ();
+      m_thread = 0;
+    }
+#endif
+  m_open = false;
+  m_file.close ();
+  NS_ABORT_MSG_IF (m_file.fail (), "BinaryTraceFile: write error");
+}
+
+uint64_t
+BinaryTraceFile::GetNRecords (void) const
+{
+  return m_nRecords;
+}
+
+uint32_t
+BinaryTraceFile::GetColumnSize (ColumnType type)
+{
+  switch (type)
+    {
+    case UINT8:
+    case INT8:
+      return 1;
+    case UINT16:
+    case INT16:
+      return 2;
+    case UINT32:
+    case INT32:
+    case FLOAT:
+    case CONTEXT:
+      return 4;
+    case UINT64:
+    case INT64:
+    case DOUBLE:
+    case TIME:
+      return 8;
+    }
+  return 0;
+}
+
+
+/**
+ * \ingroup network
+ * Read a value from a buffer.
+ * \param [in] p The buffer.
+ * \returns The value.
+ */
+template <typename T>
+static T
+Get (const uint8_t *p)
+{
+  T value;
+  std::memcpy (&value, p, sizeof (T));
+  return value;
+}
+
+BinaryTraceReader::BinaryTraceReader (const std::string &filename)
+  : m_fail (false),
+    m_secondsPerStep (0),
+    m_traceId (0),
+    m_timeStep (0)
+{
+  NS_LOG_FUNCTION (this << filename);
+  m_file.open (filename.c_str (), std::ios::in | std::ios::binary);
+  char magic[sizeof (BinaryTraceFile::MAGIC)];
+  uint32_t version;
+  uint32_t unit;
+  if (!Read (magic, sizeof (magic)) || !Read (&version, 4) || !Read (&unit, 4)
+      || std::memcmp (magic, BinaryTraceFile::MAGIC, sizeof (magic)) != 0
+      || version != BinaryTraceFile::VERSION || unit >= Time::LAST)
+    {
+      NS_LOG_WARN ("not a binary trace file, or of another byte order: " << filename);
+      m_fail = true;
+      return;
+    }
+  // the units of Time, from Y to FS
+  static const double seconds[] = { 365 * 86400.0, 86400.0, 3600.0, 60.0, 1.0,
+                                    1e-3, 1e-6, 1e-9, 1e-12, 1e-15 };
+  m_secondsPerStep = seconds[unit];
+}
+
+bool
+BinaryTraceReader::Fail (void) const
+{
+  return m_fail;
+}
+
+bool
+BinaryTraceReader::Read (void *data, std::size_t size)
+{
+  m_file.read (static_cast<char *> (data), size);
+  return static_cast<std::size_t> (m_file.gcount ()) == size;
+}
+
+bool
+BinaryTraceReader::ReadString (std::string &s)
+{
+  uint16_t size;
+  if (!Read (&size, 2))
+    {
+      return false;
+    }
+  s.resize (size);
+  return size == 0 || Read (&s[0], size);
+}
+
+bool
+BinaryTraceReader::ReadSchema (void)
+{
+  uint16_t traceId;
+  uint16_t nColumns;
+  Trace trace;
+  if (!Read (&traceId, 2) || traceId != m_traces.size ()
+      || !ReadString (trace.name) || !Read (&nColumns, 2))
+    {
+      return false;
+    }
+  trace.size = 0;
+  for (uint16_t i = 0; i < nColumns; ++i)
+    {
+      uint8_t type;
+      BinaryTraceFile::Column column;
+      if (!Read (&type, 1) || !ReadString (column.name)
+          || type < BinaryTraceFile::UINT8 || type > BinaryTraceFile::CONTEXT)
+        {
+          return false;
+        }
+      column.type = static_cast<BinaryTraceFile::ColumnType> (type);
+      trace.columns.push_back (column);
+      trace.offsets.push_back (trace.size);
+      trace.size += BinaryTraceFile::GetColumnSize (column.type);
+    }
+  m_traces.push_back (trace);
+  return true;
+}
+
+bool
+BinaryTraceReader::ReadContext (void)
+{
+  uint32_t index;
+  std::string context;
+  if (!Read (&index, 4) || index != m_contexts.size () || !ReadString (context))
+    {
+      return false;
+    }
+  m_contexts.push_back (context);
+  return true;
+}
+
+bool
+BinaryTraceReader::Next (void)
+{
+  if (m_fail)
+    {
+      return false;
+    }
+  while (true)
+    {
+      uint16_t traceId;
+      m_file.read (reinterpret_cast<char *> (&traceId), 2);
+      if (m_file.gcount () == 0)
+        {
+          return false;
+        }
+      bool ok;
+      if (m_file.gcount () != 2)
+        {
+          ok = false;
+        }
+      else if (traceId == BinaryTraceFile::SCHEMA_RECORD)
+        {
+          ok = ReadSchema ();
+        }
+      else if (traceId == BinaryTraceFile::CONTEXT_RECORD)
+        {
+          ok = ReadContext ();
+        }
+      else if (traceId < m_traces.size ())
+        {
+          m_traceId = traceId;
+          m_record.resize (m_traces[traceId].size);
+          if (Read (&m_timeStep, 8)
+              && (m_record.empty () || Read (&m_record[0], m_record.size ())))
+            {
+              return true;
+            }
+          ok = false;
+        }
+      else
+        {
+          ok = false;
+        }
+      if (!ok)
+        {
+          NS_LOG_WARN ("truncated or corrupted binary trace file");
+          m_fail = true;
+          return false;
+        }
+    }
+}
+
+uint16_t
+BinaryTraceReader::GetTraceId (void) const
+{
+  return m_traceId;
+}
+
+const BinaryTraceReader::Trace &
+BinaryTraceReader::GetTrace (void) const
+{
+  return m_traces[m_traceId];
+}
+
+int64_t
+BinaryTraceReader::GetTimeStep (void) const
+{
+  return m_timeStep;
+}
+
+double
+BinaryTraceReader::GetSeconds (void) const
+{
+  return m_timeStep * m_secondsPerStep;
+}
+
+const uint8_t *
+BinaryTraceReader::GetColumnData (uint32_t i) const
+{
+  NS_ASSERT (i < GetTrace ().columns.size ());
+  return &m_record[GetTrace ().offsets[i]];
+}
+
+int64_t
+BinaryTraceReader::GetInteger (uint32_t i) const
+{
+  const uint8_t *p = GetColumnData (i);
+  switch (GetTrace ().columns[i].type)
+    {
+    case BinaryTraceFile::UINT8:
+      return Get<uint8_t> (p);
+    case BinaryTraceFile::INT8:
+      return Get<int8_t> (p);
+    case BinaryTraceFile::UINT16:
+      return Get<uint16_t> (p);
+    case BinaryTraceFile::INT16:
+      return Get<int16_t> (p);
+    case BinaryTraceFile::UINT32:
+    case BinaryTraceFile::CONTEXT:
+      return Get<uint32_t> (p);
+    case BinaryTraceFile::INT32:
+      return Get<int32_t> (p);
+    case BinaryTraceFile::UINT64:
+      return static_cast<int64_t> (Get<uint64_t> (p));
+    case BinaryTraceFile::INT64:
+    case BinaryTraceFile::TIME:
+      return Get<int64_t> (p);
+    case BinaryTraceFile::FLOAT:
+      return static_cast<int64_t> (Get<float> (p));
+    case BinaryTraceFile::DOUBLE:
+      return static_cast<int64_t> (Get<double> (p));
+    }
+  return 0;
+}
+
+double
+BinaryTraceReader::GetDouble (uint32_t i) const
+{
+  const uint8_t *p = GetColumnData (i);
+  switch (GetTrace ().columns[i].type)
+    {
+    case BinaryTraceFile::UINT64:
+      return static_cast<double> (Get<uint64_t> (p));
+    case BinaryTraceFile::FLOAT:
+      return Get<float> (p);
+    case BinaryTraceFile::DOUBLE:
+      return Get<double> (p);
+    case BinaryTraceFile::TIME:
+      return Get<int64_t> (p) * m_secondsPerStep;
+    default:
+      return static_cast<double> (GetInteger (i));
+    }
+}
+
+std::string
+BinaryTraceReader::GetString (uint32_t i) const
+{
+  std::ostringstream oss;
+  switch (GetTrace ().columns[i].type)
+    {
+    case BinaryTraceFile::CONTEXT:
+      {
+        uint32_t index = Get<uint32_t> (GetColumnData (i));
+        if (index < m_contexts.size ())
+          {
+            return m_contexts[index];
+          }
+        oss << index;
+        break;
+      }
+    case BinaryTraceFile::UINT64:
+      oss << Get<uint64_t> (GetColumnData (i));
+      break;
+    case BinaryTraceFile::FLOAT:
+    case BinaryTraceFile::DOUBLE:
+    case BinaryTraceFile::TIME:
+      oss << std::setprecision (15) << GetDouble (i);
+      break;
+    default:
+      oss << GetInteger (i);
+      break;
+    }
+  return oss.str ();
+}
+
+const std::vector<BinaryTraceReader::Trace> &
+BinaryTraceReader::GetTraces (void) const
+{
+  return m_traces;
+}
+
+const std::vector<std::string> &
+BinaryTraceReader::GetContexts (void) const
+{
+  return m_contexts;
+}
+
+std::string
+BinaryTraceReader::GetTypeName (BinaryTraceFile::ColumnType type)
+{
+  switch (type)
+    {
+    case BinaryTraceFile::UINT8:
+      return "uint8";
+    case BinaryTraceFile::INT8:
+      return "int8";
+    case BinaryTraceFile::UINT16:
+      return "uint16";
+    case BinaryTraceFile::INT16:
+      return "int16";
+    case BinaryTraceFile::UINT32:
+      return "uint32";
+    case BinaryTraceFile::INT32:
+      return "int32";
+    case BinaryTraceFile::UINT64:
+      return "uint64";
+    case BinaryTraceFile::INT64:
+      return "int64";
+    case BinaryTraceFile::FLOAT:
+      return "float";
+    case BinaryTraceFile::DOUBLE:
+      return "double";
+    case BinaryTraceFile::TIME:
+      return "time";
+    case BinaryTraceFile::CONTEXT:
+      return "context";
+    }
+  return "unknown";
+}
+
+/**
+ * \ingroup network
+ * \param [in] prefix The prefix of the output files.
+ * \param [in] name The name of a trace or column.
+ * \returns The prefix and the name, with the characters not allowed in
+ *          file names replaced.
+ */
+static std::string
+OutputName (const std::string &prefix, const std::string &name)
+{
+  std::string s = name;
+  for (std::string::iterator i = s.begin (); i != s.end (); ++i)
+    {
+      if (*i == '/' || *i == '\\' || *i == ' ')
+        {
+          *i = '_';
+        }
+    }
+  return prefix + "-" + s;
+}
+
+bool
+BinaryTraceReader::ConvertToCsv (const std::string &filename, const std::string &prefix)
+{
+  NS_LOG_FUNCTION (filename << prefix);
+  BinaryTraceReader reader (filename);
+  std::vector<std::ofstream *> outputs;
+  while (reader.Next ())
+    {
+      const Trace &trace = reader.GetTrace ();
+      uint16_t traceId = reader.GetTraceId ();
+      if (outputs.size () <= traceId)
+        {
+          outputs.resize (traceId + 1, 0);
+        }
+      std::ofstream *os = outputs[traceId];
+      if (os == 0)
+        {
+          os = new std::ofstream (OutputName (prefix, trace.name + ".csv").c_str ());
+          outputs[traceId] = os;
+          *os << "time";
+          for (std::vector<BinaryTraceFile::Column>::const_iterator i = trace.columns.begin ();
+               i != trace.columns.end (); ++i)
+            {
+              *os << "," << i->name;
+            }
+          *os << "\n" << std::setprecision (15);
+        }
+      *os << reader.GetSeconds ();
+      for (uint32_t i = 0; i < trace.columns.size (); ++i)
+        {
+          if (trace.columns[i].type == BinaryTraceFile::CONTEXT)
+            {
+              *os << ",\"" << reader.GetString (i) << "\"";
+            }
+          else
+            {
+              *os << "," << reader.GetString (i);
+            }
+        }
+      *os << "\n";
+    }
+  for (std::vector<std::ofstream *>::iterator i = outputs.begin (); i != outputs.end (); ++i)
+    {
+      delete *i;
+    }
+  return !reader.Fail ();
+}
+
+bool
+BinaryTraceReader::ConvertToColumns (const std::string &filename, const std::string &prefix)
+{
+  NS_LOG_FUNCTION (filename << prefix);
+  BinaryTraceReader reader (filename);
+  // the time column, then one per column, for each trace
+  std::vector<std::vector<std::ofstream *> > outputs;
+  while (reader.Next ())
+    {
+      const Trace &trace = reader.GetTrace ();
+      uint16_t traceId = reader.GetTraceId ();
+      if (outputs.size () <= traceId)
+        {
+          outputs.resize (traceId + 1);
+        }
+      std::vector<std::ofstream *> &columns = outputs[traceId];
+      if (columns.empty ())
+        {
+          std::string base = OutputName (prefix, trace.name);
+          std::ofstream schema ((base + ".schema").c_str ());
+          schema << "# seconds per time step: " << reader.m_secondsPerStep << "\n";
+          schema << "time int64\n";
+          columns.push_back (new std::ofstream ((base + "-time.bin").c_str (), std::ios::binary));
+          for (std::vector<BinaryTraceFile::Column>::const_iterator i = trace.columns.begin ();
+               i != trace.columns.end (); ++i)
+            {
+              schema << i->name << " " << GetTypeName (i->type) << "\n";
+              columns.push_back (new std::ofstream (OutputName (base, i->name + ".bin").c_str (),
+                                                    std::ios::binary));
+            }
+        }
+      columns[0]->write (reinterpret_cast<const char *> (&reader.m_timeStep), 8);
+      for (uint32_t i = 0; i < trace.columns.size (); ++i)
+        {
+          columns[i + 1]->write (reinterpret_cast<const char *> (reader.GetColumnData (i)),
+                                 BinaryTraceFile::GetColumnSize (trace.columns[i].type));
+        }
+    }
+  for (std::vector<std::vector<std::ofstream *> >::iterator i = outputs.begin ();
+       i != outputs.end (); ++i)
+    {
+      for (std::vector<std::ofstream *>::iterator j = i->begin (); j != i->end (); ++j)
+        {
+          delete *j;
+        }
+    }
+  if (!reader.GetContexts ().empty ())
+    {
+      std::ofstream contexts ((prefix + "-contexts.txt").c_str ());
+      for (std::vector<std::string>::const_iterator i = reader.GetContexts ().begin ();
+           i != reader.GetContexts ().end (); ++i)
+        {
+          contexts << *i << "\n";
+        }
+    }
+  return !reader.Fail ();
+}
+
+} // namespace ns3
@@ -203,7 +203,7 @@ PcapFileWrapper::Read (Time &t)
       t = MicroSeconds(tsSec*1000000ULL+tsUsec);
     }
 
-  return Create<Packet> (datbuf,origLen);
+  return Create<Packet> (&datbuf[0], origLen);
 
 }
 
@@ -76,7 +76,7 @@ double SpectrumConverter::GetCoefficient (const BandInfo& from, const BandInfo&
 
 
 Ptr<SpectrumValue>
-SpectrumConverter::Convert (Ptr<const SpectrumValue> fvvf) const
+SpectrumConverter::Convert (PtrView<const SpectrumValue> fvvf) const
 {
   NS_ASSERT ( *(fvvf->GetSpectrumModel ()) == *m_fromSpectrumModel);
 
@@ -63,7 +63,7 @@ public:
    *
    * @return the converted version of the provided ValueVsFreq
    */
-  Ptr<SpectrumValue> Convert (Ptr<const SpectrumValue> vvf) const;
+  Ptr<SpectrumValue> Convert (PtrView<const SpectrumValue> vvf) const;
 
 
 private:
@@ -22,6 +22,7 @@
 #include <ns3/spectrum-value.h>
 #include <ns3/math.h>
 #include <ns3/log.h>
+#include <ns3/pool-allocator.h>
 
 namespace ns3 {
 
@@ -38,6 +39,18 @@ SpectrumValue::SpectrumValue (Ptr<const SpectrumModel> sof)
 
 }
 
+void *
+SpectrumValue::operator new (std::size_t size)
+{
+  return PoolAllocator<SpectrumValue>::Allocate (size);
+}
+
+void
+SpectrumValue::operator delete (void *p, std::size_t size)
+{
+  PoolAllocator<SpectrumValue>::Deallocate (p, size);
+}
+
 double&
 SpectrumValue::operator[] (size_t index)
 {
@@ -80,6 +80,23 @@ public:
 
   SpectrumValue ();
 
+  /**
+   * Allocate a SpectrumValue from the pool of the calling thread.
+   *
+   * @see PoolAllocator
+   * @param size the size of the SpectrumValue
+   * @return the memory of the SpectrumValue
+   */
+  static void * operator new (std::size_t size);
+
+  /**
+   * Release a SpectrumValue to the pool of the calling thread.
+   *
+   * @param p the memory of the SpectrumValue
+   * @param size the size of the SpectrumValue
+   */
+  static void operator delete (void *p, std::size_t size);
+
 
   /**
    * Access value at given frequency index
@@ -230,6 +230,24 @@ VisualSimulatorImpl::GetEventCount (void) const
   return m_simulator->GetEventCount ();
 }
 
+void
+VisualSimulatorImpl::InvokeWithContext (uint32_t context, const Callback<void> &callback)
+{
+  m_simulator->InvokeWithContext (context, callback);
+}
+
+uint32_t
+VisualSimulatorImpl::GetLiveEventCount (void) const
+{
+  return m_simulator->GetLiveEventCount ();
+}
+
+uint32_t
+VisualSimulatorImpl::GetCancelledEventCount (void) const
+{
+  return m_simulator->GetCancelledEventCount ();
+}
+
 void
 VisualSimulatorImpl::RunRealSimulator (void)
 {
@@ -124,6 +124,7 @@ ApWifiMac::DoDispose ()
   m_beaconTxop = 0;
   m_enableBeaconGeneration = false;
   m_beaconEvent.Cancel ();
+  m_beaconPeriodicEvent.Cancel ();
   m_cfpEvent.Cancel ();
   RegularWifiMac::DoDispose ();
 }
@@ -145,6 +146,7 @@ ApWifiMac::SetBeaconGeneration (bool enable)
   if (!enable)
     {
       m_beaconEvent.Cancel ();
+      m_beaconPeriodicEvent.Cancel ();
     }
   else if (enable && !m_enableBeaconGeneration)
     {
@@ -912,7 +914,17 @@ ApWifiMac::SendOneBeacon (void)
 
   //The beacon has it's own special queue, so we load it in there
   m_beaconTxop->Queue (packet, hdr);
-  m_beaconEvent = Simulator::Schedule (GetBeaconInterval (), &ApWifiMac::SendOneBeacon, this);
+  if (!m_beaconPeriodicEvent.IsRunning () || m_beaconPeriod != GetBeaconInterval ())
+    {
+      // one scheduler event per beacon interval sends the beacons of all
+      // the APs with the same beacon phase; a new interval applies from
+      // the next beacon
+      m_beaconPeriodicEvent.Cancel ();
+      m_beaconPeriod = GetBeaconInterval ();
+      m_beaconPeriodicEvent = PeriodicEventGroup::Schedule (m_beaconPeriod, m_beaconPeriod,
+                                                            Simulator::GetContext (),
+                                                            MakeCallback (&ApWifiMac::SendOneBeacon, this));
+    }
 
   //If a STA that does not support Short Slot Time associates,
   //the AP shall use long slot time beginning at the first Beacon
@@ -1563,6 +1575,7 @@ ApWifiMac::DoInitialize (void)
   NS_LOG_FUNCTION (this);
   m_beaconTxop->Initialize ();
   m_beaconEvent.Cancel ();
+  m_beaconPeriodicEvent.Cancel ();
   if (m_enableBeaconGeneration)
     {
       if (m_enableBeaconJitter)
@@ -23,6 +23,7 @@
 #ifndef AP_WIFI_MAC_H
 #define AP_WIFI_MAC_H
 
+#include "ns3/periodic-event-group.h"
 #include "infrastructure-wifi-mac.h"
 
 namespace ns3 {
@@ -288,7 +289,9 @@ private:
 
   Ptr<Txop> m_beaconTxop;                    //!< Dedicated Txop for beacons
   bool m_enableBeaconGeneration;             //!< Flag whether beacons are being generated
-  EventId m_beaconEvent;                     //!< Event to generate one beacon
+  EventId m_beaconEvent;                     //!< Event to generate the first beacon
+  PeriodicEventId m_beaconPeriodicEvent;     //!< Periodic event to generate the next beacons, shared by the APs with the same beacon phase
+  Time m_beaconPeriod;                       //!< Period of m_beaconPeriodicEvent
   EventId m_cfpEvent;                        //!< Event to generate one PCF frame
   Ptr<UniformRandomVariable> m_beaconJitter; //!< UniformRandomVariable used to randomize the time of the first beacon
   bool m_enableBeaconJitter;                 //!< Flag whether the first beacon should be generated at random time
@@ -26,6 +26,9 @@
 #include "ns3/system-wall-clock-ms.h"
 #include "ns3/packet.h"
 #include "ns3/packet-metadata.h"
+#include "ns3/pool-allocator.h"
+#include "ns3/size-class-allocator.h"
+#include "ns3/simulator.h"
 #include <iostream>
 #include <sstream>
 #include <string>
@@ -328,6 +331,72 @@ benchByteTags (uint32_t n)
     }
 }
 
+static void
+Receive (Ptr<Packet> p)
+{
+  BenchHeader<8> udp;
+  p->RemoveHeader (udp);
+}
+
+static void
+benchSchedule (uint32_t n)
+{
+  BenchHeader<8> udp;
+
+  for (uint32_t i = 0; i < n; i++)
+    {
+      Ptr<Packet> p = Create<Packet> (2000);
+      p->AddHeader (udp);
+      Simulator::Schedule (NanoSeconds (i), &Receive, p->Copy ());
+    }
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+/// Number of Ref and Unref calls on the BenchRefCounted objects.
+static uint64_t g_nRefOps = 0;
+
+/// A reference counted object which counts the Ref and Unref calls.
+class BenchRefCounted : public SimpleRefCount<BenchRefCounted>
+{
+public:
+  /** Count and increment the reference count. */
+  void Ref (void) const
+  {
+    g_nRefOps++;
+    SimpleRefCount<BenchRefCounted>::Ref ();
+  }
+  /** Count and decrement the reference count. */
+  void Unref (void) const
+  {
+    g_nRefOps++;
+    SimpleRefCount<BenchRefCounted>::Unref ();
+  }
+};
+
+static void
+Consume (Ptr<BenchRefCounted> object)
+{}
+
+/**
+ * Count the reference count operations of an event which carries a Ptr,
+ * from its scheduling to its execution.
+ */
+static void
+countRefOps (void)
+{
+  const uint32_t n = 1000;
+  Ptr<BenchRefCounted> object = Create<BenchRefCounted> ();
+  g_nRefOps = 0;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      Simulator::Schedule (NanoSeconds (i), &Consume, object);
+    }
+  Simulator::Run ();
+  Simulator::Destroy ();
+  std::cout << double (g_nRefOps) / n << " Ref/Unref calls per event carrying a Ptr" << std::endl;
+}
+
 static uint64_t
 runBenchOneIteration (void (*bench) (uint32_t), uint32_t n)
 {
@@ -357,19 +426,44 @@ runBench (void (*bench) (uint32_t), uint32_t n, uint32_t minIterations, char con
             << std::endl;
 }
 
+/**
+ * Print the statistics of a size class allocator.
+ * \param name the name of the allocated data
+ * \param statistics the statistics of the allocator
+ */
+template <typename T>
+static void
+printAllocatorStatistics (std::string name, const T &statistics)
+{
+  std::cout << statistics.nAllocations << " " << name << " data allocated, "
+            << statistics.nCacheHits << " from the thread cache, "
+            << statistics.nSystemAllocations << " by the system allocator; "
+            << statistics.nDepotGets << "/" << statistics.nDepotPuts
+            << " magazines taken from/given to the depot" << std::endl;
+}
+
 int main (int argc, char *argv[])
 {
   uint32_t n = 0;
   uint32_t minIterations = 1;
   bool enablePrinting = false;
+  bool pool = true;
 
   CommandLine cmd (__FILE__);
   cmd.Usage ("Benchmark Packet class");
   cmd.AddValue ("n", "number of iterations", n);
   cmd.AddValue ("min-iterations", "number of subiterations to minimize iteration time over", minIterations);
   cmd.AddValue ("enable-printing", "enable packet printing", enablePrinting);
+  cmd.AddValue ("pool", "allocate the packets and their data from the per-thread pools", pool);
   cmd.Parse (argc, argv);
 
+  if (!pool)
+    {
+      PoolAllocator<Packet>::Disable ();
+      SizeClassAllocator<Buffer>::Disable ();
+      SizeClassAllocator<PacketMetadata>::Disable ();
+    }
+
   if (n == 0)
     {
       std::cerr << "Error-- number of packets must be specified " <<
@@ -385,6 +479,18 @@ int main (int argc, char *argv[])
   runBench (&benchD, n, minIterations, "Intermixed add/remove headers and tags");
   runBench (&benchFragment, n, minIterations, "Fragmentation and concatenation");
   runBench (&benchByteTags, n, minIterations, "Benchmark byte tags");
+  runBench (&benchSchedule, n, minIterations, "Schedule packet reception");
+
+  countRefOps ();
+  if (pool)
+    {
+      uint64_t allocations = PoolAllocator<Packet>::GetNAllocations ();
+      uint64_t reuses = PoolAllocator<Packet>::GetNReuses ();
+      std::cout << allocations << " packets allocated, "
+                << allocations - reuses << " by the system allocator" << std::endl;
+      printAllocatorStatistics ("buffer", SizeClassAllocator<Buffer>::GetStatistics ());
+      printAllocatorStatistics ("metadata", SizeClassAllocator<PacketMetadata>::GetStatistics ());
+    }
 
   return 0;
 }
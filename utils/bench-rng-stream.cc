@@ -0,0 +1,197 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Amiraslan Haghrah
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+// This program compares the rates of the ways to draw uniform numbers:
+// RngStream::RandU01 one by one, by blocks, and from several streams in
+// lockstep, with and without AVX2, and RandomVariableStream::GetValue
+// against GetValues. The sum of the numbers drawn from each stream is
+// printed too: it is the same for all the ways.
+// Sample usage:  ./waf --run 'bench-rng-stream --n=10000000 --streams=8'
+
+#include "ns3/command-line.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/rng-stream.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/// The streams drawn from.
+static std::vector<RngStream *> g_streams;
+
+/// Reset the streams to their initial states.
+static void
+ResetStreams (void)
+{
+  for (std::size_t i = 0; i < g_streams.size (); ++i)
+    {
+      delete g_streams[i];
+      g_streams[i] = new RngStream (1, i, 0);
+    }
+}
+
+/**
+ * Print a result line.
+ * \param name the way the numbers were drawn
+ * \param n the number of numbers
+ * \param ms the elapsed time
+ * \param sum the sum of the numbers
+ */
+static void
+Report (std::string name, uint64_t n, int64_t ms, double sum)
+{
+  std::cout << std::left << std::setw (32) << name
+            << std::right << std::setw (10) << std::fixed << std::setprecision (1)
+            << (ms > 0 ? n / (ms * 1000.0) : 0.0) << " M/s"
+            << "   sum " << std::setprecision (6) << sum << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 10000000;
+  uint32_t nStreams = 8;
+  uint32_t block = 4096;
+
+  CommandLine cmd (__FILE__);
+  cmd.Usage ("Benchmark the block and lockstep RngStream::RandU01.");
+  cmd.AddValue ("n", "total number of numbers drawn by each way", n);
+  cmd.AddValue ("streams", "number of streams", nStreams);
+  cmd.AddValue ("block", "number of numbers per stream and call", block);
+  cmd.Parse (argc, argv);
+
+  if (nStreams == 0 || block == 0)
+    {
+      std::cerr << "--streams and --block must be positive" << std::endl;
+      return 1;
+    }
+  g_streams.resize (nStreams, 0);
+  uint32_t rounds = n / (nStreams * block);
+  uint64_t total = static_cast<uint64_t> (rounds) * nStreams * block;
+  std::vector<double> values (static_cast<std::size_t> (nStreams) * block);
+  std::cout << "streams " << nStreams << ", block " << block
+            << ", numbers " << total
+            << ", AVX2 " << (RngStream::IsSimdEnabled () ? "available" : "not available")
+            << std::endl;
+
+  SystemWallClockMs time;
+  double sum;
+
+  ResetStreams ();
+  sum = 0;
+  time.Start ();
+  for (uint32_t r = 0; r < rounds; ++r)
+    {
+      for (uint32_t i = 0; i < nStreams; ++i)
+        {
+          for (uint32_t j = 0; j < block; ++j)
+            {
+              sum += g_streams[i]->RandU01 ();
+            }
+        }
+    }
+  Report ("RandU01 ()", total, time.End (), sum);
+
+  ResetStreams ();
+  sum = 0;
+  time.Start ();
+  for (uint32_t r = 0; r < rounds; ++r)
+    {
+      for (uint32_t i = 0; i < nStreams; ++i)
+        {
+          g_streams[i]->RandU01 (&values[0], block);
+          for (uint32_t j = 0; j < block; ++j)
+            {
+              sum += values[j];
+            }
+        }
+    }
+  Report ("RandU01 (values, n)", total, time.End (), sum);
+
+  bool simd = RngStream::IsSimdEnabled ();
+  for (int pass = 0; pass < (simd ? 2 : 1); ++pass)
+    {
+      if (pass == 0)
+        {
+          RngStream::DisableSimd ();
+        }
+      else
+        {
+          RngStream::EnableSimd ();
+        }
+      ResetStreams ();
+      sum = 0;
+      time.Start ();
+      for (uint32_t r = 0; r < rounds; ++r)
+        {
+          RngStream::RandU01 (&g_streams[0], nStreams, &values[0], block);
+          for (std::size_t j = 0; j < values.size (); ++j)
+            {
+              sum += values[j];
+            }
+        }
+      Report (pass == 0 ? "lockstep, portable" : "lockstep, AVX2", total, time.End (), sum);
+    }
+
+  // the variables use their own streams, so only compare their sums
+  // between them
+  for (int pass = 0; pass < 2; ++pass)
+    {
+      std::vector<Ptr<UniformRandomVariable> > variables;
+      for (uint32_t i = 0; i < nStreams; ++i)
+        {
+          variables.push_back (CreateObject<UniformRandomVariable> ());
+          variables.back ()->SetStream (i);
+        }
+      sum = 0;
+      time.Start ();
+      for (uint32_t r = 0; r < rounds; ++r)
+        {
+          for (uint32_t i = 0; i < nStreams; ++i)
+            {
+              if (pass == 0)
+                {
+                  for (uint32_t j = 0; j < block; ++j)
+                    {
+                      sum += variables[i]->GetValue ();
+                    }
+                }
+              else
+                {
+                  variables[i]->GetValues (&values[0], block);
+                  for (uint32_t j = 0; j < block; ++j)
+                    {
+                      sum += values[j];
+                    }
+                }
+            }
+        }
+      Report (pass == 0 ? "UniformRandomVariable::GetValue" : "UniformRandomVariable::GetValues",
+              total, time.End (), sum);
+    }
+
+  for (std::size_t i = 0; i < g_streams.size (); ++i)
+    {
+      delete g_streams[i];
+    }
+  return 0;
+}
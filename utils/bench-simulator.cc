@@ -22,9 +22,19 @@
 #include <iostream>
 #include <fstream>
 #include <vector>
+#include <list>
 #include <string.h>
 
+#include "ns3/core-config.h"
 #include "ns3/core-module.h"
+#include "ns3/mpsc-queue.h"
+#ifdef HAVE_PTHREAD_H
+#include "ns3/system-thread.h"
+#include "ns3/system-mutex.h"
+
+#include <atomic>
+#include <thread>  // yield
+#endif
 
 using namespace ns3;
 
@@ -145,6 +155,222 @@ Bench::Cb (void)
 }
 
 
+#ifdef HAVE_PTHREAD_H
+/**
+ * Benchmark of the events posted to the main thread by other threads.
+ *
+ * Each producer thread posts its share of the events, while the main thread
+ * drains them from:
+ *   - a std::list guarded by a SystemMutex, swapped by the consumer, as
+ *     DefaultSimulatorImpl did before using an MpscQueue,
+ *   - an MpscQueue,
+ *   - Simulator::ScheduleWithContext, drained by Simulator::Run.
+ */
+class ProducerBench
+{
+public:
+  /**
+   * constructor
+   * \param producers the number of producer threads
+   * \param total the total number of events posted
+   */
+  ProducerBench (const uint32_t producers, const uint32_t total)
+    : m_producers (producers),
+      m_perProducer (total / producers),
+      m_total (m_perProducer * producers),
+      m_listEmpty (true),
+      m_queue (4096),
+      m_count (0)
+  {
+  }
+
+  /// Run function
+  void RunBench (void);
+private:
+  /** \return the time to drain the events posted to the mutex list, in s */
+  double RunMutex (void);
+  /** \return the time to drain the events posted to the MpscQueue, in s */
+  double RunQueue (void);
+  /** \return the time to run the events posted to the simulator, in s */
+  double RunSimulator (void);
+  /// post events to the mutex list
+  void ProduceMutex (void);
+  /// post events to the MpscQueue
+  void ProduceQueue (void);
+  /// post events to the simulator
+  void ProduceSimulator (void);
+  /// start the producers posting to the simulator
+  void StartSimulator (void);
+  /// callback function of the events posted to the simulator
+  void Cb (void);
+  /// keep the simulator running until all the events are run
+  void Poll (void);
+  /**
+   * Start the producer threads
+   * \param produce the function of the threads
+   */
+  void Start (void (ProducerBench::*produce)(void));
+  /// Wait for the producer threads
+  void Join (void);
+
+  uint32_t m_producers; ///< number of producer threads
+  uint32_t m_perProducer; ///< events posted by each producer
+  uint32_t m_total; ///< total number of events posted
+  std::vector<Ptr<SystemThread> > m_threads; ///< producer threads
+  std::list<uint32_t> m_list; ///< mutex list
+  SystemMutex m_mutex; ///< mutex of the list
+  std::atomic<bool> m_listEmpty; ///< flag true if the list is empty
+  MpscQueue<uint32_t> m_queue; ///< lock-free queue
+  uint32_t m_count; ///< events run by the simulator
+  Time m_delay; ///< delay of the events posted to the simulator
+};
+
+void
+ProducerBench::RunBench (void)
+{
+  double mutex = RunMutex ();
+  double queue = RunQueue ();
+  double simu = RunSimulator ();
+  LOG (std::setw (g_fwidth) << m_producers <<
+       std::setw (g_fwidth) << (m_total / mutex) <<
+       std::setw (g_fwidth) << (m_total / queue) <<
+       std::setw (g_fwidth) << (m_total / simu));
+}
+
+void
+ProducerBench::Start (void (ProducerBench::*produce)(void))
+{
+  for (uint32_t i = 0; i < m_producers; ++i)
+    {
+      m_threads.push_back (Create<SystemThread> (MakeCallback (produce, this)));
+      m_threads.back ()->Start ();
+    }
+}
+
+void
+ProducerBench::Join (void)
+{
+  for (uint32_t i = 0; i < m_threads.size (); ++i)
+    {
+      m_threads[i]->Join ();
+    }
+  m_threads.clear ();
+}
+
+double
+ProducerBench::RunMutex (void)
+{
+  SystemWallClockMs time;
+  time.Start ();
+  Start (&ProducerBench::ProduceMutex);
+  uint32_t count = 0;
+  while (count < m_total)
+    {
+      if (m_listEmpty.load (std::memory_order_acquire))
+        {
+          continue;
+        }
+      std::list<uint32_t> items;
+      {
+        CriticalSection cs (m_mutex);
+        m_list.swap (items);
+        m_listEmpty.store (true, std::memory_order_release);
+      }
+      count += items.size ();
+    }
+  Join ();
+  return time.End () / 1000.0;
+}
+
+void
+ProducerBench::ProduceMutex (void)
+{
+  for (uint32_t i = 0; i < m_perProducer; ++i)
+    {
+      CriticalSection cs (m_mutex);
+      m_list.push_back (i);
+      m_listEmpty.store (false, std::memory_order_release);
+    }
+}
+
+double
+ProducerBench::RunQueue (void)
+{
+  SystemWallClockMs time;
+  time.Start ();
+  Start (&ProducerBench::ProduceQueue);
+  uint32_t count = 0;
+  uint32_t item;
+  while (count < m_total)
+    {
+      while (m_queue.Pop (item))
+        {
+          ++count;
+        }
+    }
+  Join ();
+  return time.End () / 1000.0;
+}
+
+void
+ProducerBench::ProduceQueue (void)
+{
+  for (uint32_t i = 0; i < m_perProducer; ++i)
+    {
+      while (!m_queue.Push (i))
+        {
+          std::this_thread::yield ();
+        }
+    }
+}
+
+double
+ProducerBench::RunSimulator (void)
+{
+  SystemWallClockMs time;
+  m_count = 0;
+  time.Start ();
+  Simulator::ScheduleNow (&ProducerBench::StartSimulator, this);
+  Simulator::Run ();
+  Join ();
+  return time.End () / 1000.0;
+}
+
+void
+ProducerBench::StartSimulator (void)
+{
+  // the producers start once Simulator::Run stopped marking the times
+  m_delay = NanoSeconds (0);
+  Start (&ProducerBench::ProduceSimulator);
+  Poll ();
+}
+
+void
+ProducerBench::ProduceSimulator (void)
+{
+  for (uint32_t i = 0; i < m_perProducer; ++i)
+    {
+      Simulator::ScheduleWithContext (i, m_delay, &ProducerBench::Cb, this);
+    }
+}
+
+void
+ProducerBench::Cb (void)
+{
+  ++m_count;
+}
+
+void
+ProducerBench::Poll (void)
+{
+  if (m_count < m_total)
+    {
+      Simulator::Schedule (NanoSeconds (1), &ProducerBench::Poll, this);
+    }
+}
+#endif /* HAVE_PTHREAD_H */
+
+
 Ptr<RandomVariableStream>
 GetRandomStream (std::string filename)
 {
@@ -199,6 +425,82 @@ GetRandomStream (std::string filename)
 }
 
 
+/**
+ * Get a random stream mimicking the event mix of a model.
+ *
+ * The presets are:
+ *   - lte: mostly 1 ms TTI events, PHY and control events within the
+ *     first symbols, RLC/PDCP and measurement timers up to 40 ms, and a
+ *     few RRC timers up to 1 s,
+ *   - wifi: SIFS, backoff slots, frame durations, ACK timeouts and
+ *     102.4 ms beacons.
+ *
+ * \param preset the name of the preset
+ * \return a stream of event intervals, in ns
+ */
+Ptr<RandomVariableStream>
+GetPresetStream (std::string preset)
+{
+  Ptr<UniformRandomVariable> u = CreateObject<UniformRandomVariable> ();
+  std::vector<double> nsValues;
+  for (uint32_t i = 0; i < 100000; ++i)
+    {
+      double p = u->GetValue ();
+      double ns;
+      if (preset == "lte")
+        {
+          if (p < 0.6)
+            {
+              ns = 1000000;                             // TTI
+            }
+          else if (p < 0.8)
+            {
+              ns = u->GetValue (1, 214286);             // first 3 symbols
+            }
+          else if (p < 0.95)
+            {
+              ns = u->GetValue (1000000, 40000000);     // RLC, PDCP, measurements
+            }
+          else
+            {
+              ns = u->GetValue (100000000, 1000000000); // RRC timers
+            }
+        }
+      else if (preset == "wifi")
+        {
+          if (p < 0.3)
+            {
+              ns = 16000;                               // SIFS
+            }
+          else if (p < 0.5)
+            {
+              ns = 9000 * u->GetInteger (0, 15);        // backoff slots
+            }
+          else if (p < 0.75)
+            {
+              ns = u->GetValue (50000, 1500000);        // frame durations
+            }
+          else if (p < 0.95)
+            {
+              ns = 75000;                               // ACK timeout
+            }
+          else
+            {
+              ns = 102400000;                           // beacon interval
+            }
+        }
+      else
+        {
+          NS_FATAL_ERROR ("unknown preset " << preset);
+        }
+      nsValues.push_back (ns);
+    }
+  LOGME ("using the " << preset << " event mix");
+  Ptr<DeterministicRandomVariable> drv = CreateObject<DeterministicRandomVariable> ();
+  drv->SetValueArray (&nsValues[0], nsValues.size ());
+  return drv;
+}
+
 
 int main (int argc, char *argv[])
 {
@@ -208,12 +510,16 @@ int main (int argc, char *argv[])
   bool schedList          = false;
   bool schedMap           = true;
   bool schedPriorityQueue = false;
+  bool schedLadder        = false;
 
   uint32_t pop   =  100000;
   uint32_t total = 1000000;
   uint32_t runs  =       1;
   std::string filename = "";
+  std::string preset = "";
   bool calRev = false;
+  uint32_t producers = 0;
+  std::string pool = "on";
 
   CommandLine cmd (__FILE__);
   cmd.Usage ("Benchmark the simulator scheduler.\n"
@@ -223,23 +529,63 @@ int main (int argc, char *argv[])
              "  an ascii file, given by the --file=\"<filename>\" argument,\n"
              "  or standard input, by the argument --file=\"-\"\n"
              "In the case of either --file form, the input is expected\n"
-             "to be ascii, giving the relative event times in ns.");
+             "to be ascii, giving the relative event times in ns.\n"
+             "Alternatively, --preset=lte or --preset=wifi mimics the\n"
+             "event mix of these models.");
   cmd.AddValue ("cal",   "use CalendarSheduler",          schedCal);
   cmd.AddValue ("calrev", "reverse ordering in the CalendarScheduler", calRev);
   cmd.AddValue ("heap",  "use HeapScheduler",             schedHeap);
   cmd.AddValue ("list",  "use ListSheduler",              schedList);
   cmd.AddValue ("map",   "use MapScheduler (default)",    schedMap);
   cmd.AddValue ("pri",   "use PriorityQueue",             schedPriorityQueue);
+  cmd.AddValue ("ladder", "use LadderQueueScheduler",     schedLadder);
   cmd.AddValue ("debug", "enable debugging output",       g_debug);
   cmd.AddValue ("pop",   "event population size (default 1E5)",         pop);
   cmd.AddValue ("total", "total number of events to run (default 1E6)", total);
   cmd.AddValue ("runs",  "number of runs (default 1)",    runs);
   cmd.AddValue ("file",  "file of relative event times",  filename);
+  cmd.AddValue ("preset", "event mix of a model: lte or wifi", preset);
   cmd.AddValue ("prec",  "printed output precision",      g_fwidth);
+  cmd.AddValue ("pool",  "event pool allocator: on (default), off, or both to compare", pool);
+  cmd.AddValue ("producers", "benchmark the events posted by 1 to N threads instead", producers);
   cmd.Parse (argc, argv);
   g_me = cmd.GetName () + ": ";
   g_fwidth += 6;  // 5 extra chars in '2.000002e+07 ': . e+0 _
 
+  if (producers > 0)
+    {
+#ifdef HAVE_PTHREAD_H
+      LOGME (std::setprecision (g_fwidth - 6));
+      LOGME ("total events: " << total);
+      LOG ("");
+      LOG (std::left << std::setw (g_fwidth) << "Threads" <<
+           std::left << std::setw (3 * g_fwidth) << "Rate (ev/s):");
+      LOG (std::left << std::setw (g_fwidth) << "" <<
+           std::left << std::setw (g_fwidth) << "Mutex" <<
+           std::left << std::setw (g_fwidth) << "MpscQueue" <<
+           std::left << std::setw (g_fwidth) << "Simulator");
+      LOG (std::setfill ('-') <<
+           std::right << std::setw (g_fwidth) << " " <<
+           std::right << std::setw (g_fwidth) << " " <<
+           std::right << std::setw (g_fwidth) << " " <<
+           std::right << std::setw (g_fwidth) << " " <<
+           std::setfill (' '));
+      for (uint32_t n = 1; n <= producers; n *= 2)
+        {
+          for (uint32_t i = 0; i < runs; i++)
+            {
+              ProducerBench bench (n, total);
+              bench.RunBench ();
+            }
+        }
+      LOG ("");
+      Simulator::Destroy ();
+#else
+      LOGME ("threads are not supported on this platform");
+#endif
+      return 0;
+    }
+
   ObjectFactory factory ("ns3::MapScheduler");
   if (schedCal)
     {
@@ -258,6 +604,10 @@ int main (int argc, char *argv[])
     {
       factory.SetTypeId ("ns3::PriorityQueueScheduler");
     }
+  if (schedLadder)
+    {
+      factory.SetTypeId ("ns3::LadderQueueScheduler");
+    }
       
   Simulator::SetScheduler (factory);
 
@@ -275,7 +625,14 @@ int main (int argc, char *argv[])
   LOGME ("runs: " << runs);
 
   Bench *bench = new Bench (pop, total);
-  bench->SetRandomStream (GetRandomStream (filename));
+  if (preset != "")
+    {
+      bench->SetRandomStream (GetPresetStream (preset));
+    }
+  else
+    {
+      bench->SetRandomStream (GetRandomStream (filename));
+    }
 
   // table header
   LOG ("");
@@ -300,18 +657,40 @@ int main (int argc, char *argv[])
        std::setfill (' ')
        );
 
-  // prime
-  DEB ("priming");
-  std::cout << std::left << std::setw (g_fwidth) << "(prime)";
-  bench->RunBench ();
-
-  bench->SetPopulation (pop);
-  bench->SetTotal (total);
-  for (uint32_t i = 0; i < runs; i++)
+  std::vector<bool> pools;
+  if (pool != "off")
+    {
+      pools.push_back (true);
+    }
+  if (pool != "on")
+    {
+      pools.push_back (false);
+    }
+  for (uint32_t p = 0; p < pools.size (); ++p)
     {
-      std::cout << std::setw (g_fwidth) << i;
+      if (pools[p])
+        {
+          EventImpl::EnablePool ();
+        }
+      else
+        {
+          EventImpl::DisablePool ();
+        }
+      LOG ("event pool: " << (pools[p] ? "on" : "off"));
 
+      // prime
+      DEB ("priming");
+      std::cout << std::left << std::setw (g_fwidth) << "(prime)";
       bench->RunBench ();
+
+      bench->SetPopulation (pop);
+      bench->SetTotal (total);
+      for (uint32_t i = 0; i < runs; i++)
+        {
+          std::cout << std::setw (g_fwidth) << i;
+
+          bench->RunBench ();
+        }
     }
 
   LOG ("");
@@ -0,0 +1,192 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Amiraslan Haghrah
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+// This program measures the cost of the common Time operations: the
+// factories, the arithmetic and comparisons, the scaling by a number
+// and the quotient of Times, and the int64x64_t multiplication and
+// division with operands which take the fast paths of the int128
+// implementation (integers, pure fractions) or the general path.
+// A checksum of the results is printed after each time, so that the
+// operations are not optimized away.
+// Before Simulator::Run the Time constructors record each Time, for a
+// later change of resolution, unless the resolution was fixed with
+// './waf configure --time-resolution'; this program never runs the
+// simulator, so it measures that cost too.
+// Sample usage:  ./waf --run 'bench-time --n=10000000'
+
+#include "ns3/command-line.h"
+#include "ns3/int64x64.h"
+#include "ns3/nstime.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Print a result line.
+ * \param name the operation
+ * \param n the number of operations
+ * \param ms the elapsed time
+ * \param sum the checksum of the results
+ */
+static void
+Report (std::string name, uint64_t n, int64_t ms, int64_t sum)
+{
+  std::cout << std::left << std::setw (32) << name
+            << std::right << std::setw (10) << std::fixed << std::setprecision (2)
+            << (n > 0 ? ms * 1000000.0 / n : 0.0) << " ns/op"
+            << "   sum " << sum << std::endl;
+}
+
+/**
+ * Time the multiplication and the division of int64x64_t values.
+ * \param name the kind of operands
+ * \param a the first operands
+ * \param b the second operands
+ * \param n the number of operations
+ */
+static void
+BenchInt64x64 (std::string name, const std::vector<int64x64_t> &a,
+               const std::vector<int64x64_t> &b, uint32_t n)
+{
+  SystemWallClockMs time;
+  std::size_t size = a.size ();
+  int64_t sum = 0;
+  time.Start ();
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      int64x64_t r = a[i % size] * b[(i + 1) % size];
+      sum += r.GetLow () >> 32;
+    }
+  Report ("int64x64 Mul, " + name, n, time.End (), sum);
+
+  sum = 0;
+  time.Start ();
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      int64x64_t r = a[i % size] / b[(i + 1) % size];
+      sum += r.GetLow () >> 32;
+    }
+  Report ("int64x64 Div, " + name, n, time.End (), sum);
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 10000000;
+
+  CommandLine cmd (__FILE__);
+  cmd.Usage ("Benchmark the Time and int64x64_t operations.");
+  cmd.AddValue ("n", "number of operations of each kind", n);
+  cmd.Parse (argc, argv);
+
+  std::cout << "operations " << n
+            << ", int64x64_t::implementation "
+            << (int64x64_t::implementation == int64x64_t::int128_impl ? "int128" :
+                int64x64_t::implementation == int64x64_t::cairo_impl ? "cairo" : "ld")
+#ifdef NS3_TIME_RESOLUTION
+            << ", fixed Time resolution"
+#endif
+            << std::endl;
+
+  // Operands which the optimizer cannot see through.
+  const std::size_t size = 1024;
+  std::vector<Time> times;
+  std::vector<double> doubles;
+  std::vector<int64x64_t> integers;
+  std::vector<int64x64_t> fractions;
+  std::vector<int64x64_t> generals;
+  for (std::size_t i = 0; i < size; ++i)
+    {
+      times.push_back (MicroSeconds (1 + i * 37));
+      doubles.push_back (1.0 + i * 0.001);
+      integers.push_back (int64x64_t (1 + static_cast<int64_t> (i % 97)));
+      fractions.push_back (int64x64_t (0, 0x0123456789abcdefULL * (i + 1)));
+      generals.push_back (int64x64_t (1 + static_cast<int64_t> (i % 13),
+                                      0xfedcba9876543210ULL ^ (i << 20)));
+    }
+
+  SystemWallClockMs time;
+  int64_t sum;
+
+  sum = 0;
+  time.Start ();
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      sum += MilliSeconds (i).GetTimeStep ();
+    }
+  Report ("MilliSeconds (integer)", n, time.End (), sum);
+
+  sum = 0;
+  time.Start ();
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      sum += Seconds (doubles[i % size]).GetTimeStep ();
+    }
+  Report ("Seconds (double)", n, time.End (), sum);
+
+  sum = 0;
+  time.Start ();
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      sum += (times[i % size] + times[(i + 1) % size]).GetTimeStep ();
+    }
+  Report ("Time + Time", n, time.End (), sum);
+
+  sum = 0;
+  time.Start ();
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      sum += times[i % size] < times[(i + 7) % size];
+    }
+  Report ("Time < Time", n, time.End (), sum);
+
+  sum = 0;
+  time.Start ();
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      sum += (times[i % size] * doubles[i % size]).GetTimeStep ();
+    }
+  Report ("Time * double", n, time.End (), sum);
+
+  sum = 0;
+  time.Start ();
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      sum += (times[i % size] * static_cast<int64_t> (i % 100)).GetTimeStep ();
+    }
+  Report ("Time * integer", n, time.End (), sum);
+
+  sum = 0;
+  time.Start ();
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      sum += (times[i % size] / times[(i + 1) % size]).GetLow () >> 32;
+    }
+  Report ("Time / Time", n, time.End (), sum);
+
+  BenchInt64x64 ("integer", generals, integers, n);
+  BenchInt64x64 ("fraction", fractions, fractions, n);
+  BenchInt64x64 ("general", generals, generals, n);
+
+  return 0;
+}
@@ -0,0 +1,74 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Amiraslan Haghrah
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+// This program converts a file written by ns3::BinaryTraceFile to one CSV
+// file per trace, or to one raw binary file per column of each trace.
+// Sample usage:
+//   ./waf --run 'binary-trace-convert --input=lte.btr --prefix=lte --format=csv'
+
+#include "ns3/command-line.h"
+#include "ns3/binary-trace-file.h"
+#include <iostream>
+#include <string>
+
+using namespace ns3;
+
+int main (int argc, char *argv[])
+{
+  std::string input;
+  std::string prefix;
+  std::string format = "csv";
+
+  CommandLine cmd (__FILE__);
+  cmd.Usage ("Convert a binary trace file to CSV or columnar files.");
+  cmd.AddValue ("input", "the binary trace file", input);
+  cmd.AddValue ("prefix", "the prefix of the output files; the input file name by default", prefix);
+  cmd.AddValue ("format", "csv, or columns for one raw file per column", format);
+  cmd.Parse (argc, argv);
+
+  if (input.empty ())
+    {
+      std::cerr << "no input file; see --help" << std::endl;
+      return 1;
+    }
+  if (prefix.empty ())
+    {
+      prefix = input;
+    }
+  bool ok;
+  if (format == "csv")
+    {
+      ok = BinaryTraceReader::ConvertToCsv (input, prefix);
+    }
+  else if (format == "columns")
+    {
+      ok = BinaryTraceReader::ConvertToColumns (input, prefix);
+    }
+  else
+    {
+      std::cerr << "unknown format " << format << "; see --help" << std::endl;
+      return 1;
+    }
+  if (!ok)
+    {
+      std::cerr << "cannot read " << input << ", or the file is truncated" << std::endl;
+      return 1;
+    }
+  return 0;
+}